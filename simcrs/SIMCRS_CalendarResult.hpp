@@ -0,0 +1,165 @@
+#ifndef __SIMCRS_SIMCRS_CALENDARRESULT_HPP
+#define __SIMCRS_SIMCRS_CALENDARRESULT_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <string>
+#include <vector>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+
+namespace SIMCRS {
+
+  // Forward declarations
+  class ShoppingManager;
+
+  /**
+   * @brief Lowest bookable fare for a given departure date, as one cell
+   * of a low-fare calendar.
+   */
+  struct CalendarEntryStruct {
+    friend class ShoppingManager;
+  public:
+    // ///////////////// Getters ///////////////////
+    /** Get the (preferred) departure date. */
+    const stdair::Date_T& getDepartureDate() const {
+      return _departureDate;
+    }
+
+    /** Get the lowest bookable fare. It is meaningful only when
+        hasFare() is true. */
+    const stdair::Fare_T& getLowestFare() const {
+      return _lowestFare;
+    }
+
+    /** State whether something can be booked for that date. */
+    bool hasFare() const {
+      return _hasFare;
+    }
+
+  public:
+    // /////////////// Display Methods /////////////////
+    /**
+     * Short display of the calendar entry.
+     */
+    const std::string describe() const {
+      std::ostringstream oStr;
+      oStr << _departureDate << ": ";
+      if (hasFare() == true) {
+        oStr << _lowestFare;
+      } else {
+        oStr << "-";
+      }
+      return oStr.str();
+    }
+
+  public:
+    // //////////// Constructors and Destructors /////////////
+    /**
+     * Constructor.
+     */
+    CalendarEntryStruct (const stdair::Date_T& iDepartureDate)
+      : _departureDate (iDepartureDate), _lowestFare (0.0),
+        _hasFare (false) {
+    }
+
+  private:
+    // //////////////// Attributes ///////////////////
+    /** (Preferred) departure date. */
+    stdair::Date_T _departureDate;
+
+    /** Lowest bookable fare. */
+    stdair::Fare_T _lowestFare;
+
+    /** Whether something can be booked for that date. */
+    bool _hasFare;
+  };
+
+  /**
+   * List of calendar entries, in departure date order.
+   */
+  typedef std::vector<CalendarEntryStruct> CalendarEntryList_T;
+
+  /**
+   * @brief Result of a calendar shopping request, as returned by
+   * SIMCRS_Service::shopCalendar(), i.e., the lowest bookable fare
+   * for every departure date of a date range.
+   */
+  struct CalendarResultStruct {
+    friend class ShoppingManager;
+  public:
+    // ///////////////// Getters ///////////////////
+    /** Get the calendar entries, one per departure date. */
+    const CalendarEntryList_T& getCalendarEntryList() const {
+      return _calendarEntryList;
+    }
+
+    /** Get the number of segment paths examined (over all the dates). */
+    const NbOfTravelSolutions_T& getNbOfSegmentPaths() const {
+      return _nbOfSegmentPaths;
+    }
+
+    /** Get the number of travel solutions which have not been given
+        their availability, as their fares could not improve on the
+        lowest fare found so far for their date. */
+    const NbOfTravelSolutions_T& getNbOfSkippedTravelSolutions() const {
+      return _nbOfSkippedTravelSolutions;
+    }
+
+  public:
+    // /////////////// Display Methods /////////////////
+    /**
+     * Short display of the calendar.
+     */
+    const std::string describe() const {
+      std::ostringstream oStr;
+      oStr << _calendarEntryList.size() << " departure dates, "
+           << _nbOfSegmentPaths << " segment paths, "
+           << _nbOfSkippedTravelSolutions
+           << " not given their availability";
+      return oStr.str();
+    }
+
+    /**
+     * Full display of the calendar (one line per departure date).
+     */
+    const std::string display() const {
+      std::ostringstream oStr;
+      oStr << describe() << std::endl;
+      for (CalendarEntryList_T::const_iterator itEntry =
+             _calendarEntryList.begin();
+           itEntry != _calendarEntryList.end(); ++itEntry) {
+        const CalendarEntryStruct& lCalendarEntry = *itEntry;
+        oStr << lCalendarEntry.describe() << std::endl;
+      }
+      return oStr.str();
+    }
+
+  public:
+    // //////////// Constructors and Destructors /////////////
+    /**
+     * Default constructor.
+     */
+    CalendarResultStruct()
+      : _nbOfSegmentPaths (0), _nbOfSkippedTravelSolutions (0) {
+    }
+
+  private:
+    // //////////////// Attributes ///////////////////
+    /** Calendar entries, one per departure date. */
+    CalendarEntryList_T _calendarEntryList;
+
+    /** Number of segment paths examined. */
+    NbOfTravelSolutions_T _nbOfSegmentPaths;
+
+    /** Number of travel solutions not given their availability. */
+    NbOfTravelSolutions_T _nbOfSkippedTravelSolutions;
+  };
+
+}
+#endif // __SIMCRS_SIMCRS_CALENDARRESULT_HPP
@@ -0,0 +1,130 @@
+#ifndef __SIMCRS_SIMCRS_DISPLAYFILTER_HPP
+#define __SIMCRS_SIMCRS_DISPLAYFILTER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <string>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+
+namespace SIMCRS {
+
+  /**
+   * @brief Filter of the flight-dates to be displayed (see the streaming
+   * SIMCRS_Service::csvDisplay() and list() methods), by airline, flight
+   * number and departure date range. By default, everything is
+   * displayed.
+   */
+  struct DisplayFilterStruct {
+  public:
+    // ///////////////// Getters ///////////////////
+    /** Get the airline code ("all" for all the airlines). */
+    const stdair::AirlineCode_T& getAirlineCode() const {
+      return _airlineCode;
+    }
+
+    /** Get the flight number (0 for all the flight numbers). */
+    const stdair::FlightNumber_T& getFlightNumber() const {
+      return _flightNumber;
+    }
+
+    /** Get the first departure date (not a date when unbounded). */
+    const stdair::Date_T& getStartDate() const {
+      return _startDate;
+    }
+
+    /** Get the last departure date (not a date when unbounded). */
+    const stdair::Date_T& getEndDate() const {
+      return _endDate;
+    }
+
+  public:
+    // ///////////////// Business Methods ///////////////////
+    /** State whether the given airline is to be displayed. */
+    bool matchesAirline (const stdair::AirlineCode_T& iAirlineCode) const {
+      return (_airlineCode == "all" || _airlineCode == iAirlineCode);
+    }
+
+    /** State whether the given flight number is to be displayed. */
+    bool matchesFlight (const stdair::FlightNumber_T& iFlightNumber) const {
+      return (_flightNumber == 0 || _flightNumber == iFlightNumber);
+    }
+
+    /** State whether the given departure date is to be displayed. */
+    bool matchesDate (const stdair::Date_T& iDepartureDate) const {
+      if (_startDate.is_not_a_date() == false
+          && iDepartureDate < _startDate) {
+        return false;
+      }
+      if (_endDate.is_not_a_date() == false && iDepartureDate > _endDate) {
+        return false;
+      }
+      return true;
+    }
+
+  public:
+    // /////////////// Display Methods /////////////////
+    /**
+     * Short display of the filter.
+     */
+    const std::string describe() const {
+      std::ostringstream oStr;
+      oStr << "airline: " << _airlineCode << ", flight: ";
+      if (_flightNumber == 0) {
+        oStr << "all";
+      } else {
+        oStr << _flightNumber;
+      }
+      oStr << ", dates: ";
+      if (_startDate.is_not_a_date() == false) {
+        oStr << _startDate;
+      }
+      oStr << " - ";
+      if (_endDate.is_not_a_date() == false) {
+        oStr << _endDate;
+      }
+      return oStr.str();
+    }
+
+  public:
+    // //////////// Constructors and Destructors /////////////
+    /**
+     * Constructor.
+     *
+     * @param const stdair::AirlineCode_T& Airline to be displayed ("all",
+     *        the default, for all the airlines).
+     * @param const stdair::FlightNumber_T& Flight number to be displayed
+     *        (0, the default, for all the flight numbers).
+     * @param const stdair::Date_T& First departure date to be displayed
+     *        (by default, unbounded).
+     * @param const stdair::Date_T& Last departure date to be displayed
+     *        (by default, unbounded).
+     */
+    DisplayFilterStruct (const stdair::AirlineCode_T& iAirlineCode = "all",
+                         const stdair::FlightNumber_T& iFlightNumber = 0,
+                         const stdair::Date_T& iStartDate = stdair::Date_T(),
+                         const stdair::Date_T& iEndDate = stdair::Date_T())
+      : _airlineCode (iAirlineCode), _flightNumber (iFlightNumber),
+        _startDate (iStartDate), _endDate (iEndDate) {
+    }
+
+  private:
+    // //////////////// Attributes ///////////////////
+    /** Airline code ("all" for all the airlines). */
+    stdair::AirlineCode_T _airlineCode;
+
+    /** Flight number (0 for all the flight numbers). */
+    stdair::FlightNumber_T _flightNumber;
+
+    /** First departure date (not a date when unbounded). */
+    stdair::Date_T _startDate;
+
+    /** Last departure date (not a date when unbounded). */
+    stdair::Date_T _endDate;
+  };
+
+}
+#endif // __SIMCRS_SIMCRS_DISPLAYFILTER_HPP
@@ -0,0 +1,218 @@
+#ifndef __SIMCRS_SIMCRS_MEMORYREPORT_HPP
+#define __SIMCRS_SIMCRS_MEMORYREPORT_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace SIMCRS {
+
+  // Forward declarations
+  class MemoryReportManager;
+
+  /**
+   * @brief Memory footprint of the objects of a given type, held by a
+   * given component (e.g., "airinv", "airtsp", "simfqt", "simcrs"),
+   * within a given structure (the "persistent" or "working" BOM tree,
+   * or the "simcrs" service structures).
+   *
+   * The number of bytes is an approximation: for the BOM objects, it
+   * is the size of the objects themselves plus their links within the
+   * BOM tree, not counting the heap memory they own (e.g., strings).
+   */
+  struct MemoryUsageStruct {
+  public:
+    // ///////////////// Getters ///////////////////
+    /** Get the component holding the objects. */
+    const std::string& getComponent() const {
+      return _component;
+    }
+
+    /** Get the structure holding the objects. */
+    const std::string& getStructure() const {
+      return _structure;
+    }
+
+    /** Get the type of the objects. */
+    const std::string& getType() const {
+      return _type;
+    }
+
+    /** Get the number of objects. */
+    const std::size_t& getNbOfObjects() const {
+      return _nbOfObjects;
+    }
+
+    /** Get the (approximate) number of bytes held by the objects. */
+    const std::size_t& getNbOfBytes() const {
+      return _nbOfBytes;
+    }
+
+  public:
+    // /////////////// Display Methods /////////////////
+    /**
+     * Short display of the memory usage.
+     */
+    const std::string describe() const {
+      std::ostringstream oStr;
+      oStr << _structure << " " << _component << " " << _type << ": "
+           << _nbOfObjects << " objects, " << _nbOfBytes << " bytes";
+      return oStr.str();
+    }
+
+  public:
+    // //////////// Constructors and Destructors /////////////
+    /**
+     * Constructor.
+     */
+    MemoryUsageStruct (const std::string& iComponent,
+                       const std::string& iStructure,
+                       const std::string& iType,
+                       const std::size_t& iNbOfObjects,
+                       const std::size_t& iNbOfBytes)
+      : _component (iComponent), _structure (iStructure), _type (iType),
+        _nbOfObjects (iNbOfObjects), _nbOfBytes (iNbOfBytes) {
+    }
+
+  private:
+    // //////////////// Attributes ///////////////////
+    /** Component holding the objects. */
+    std::string _component;
+
+    /** Structure holding the objects. */
+    std::string _structure;
+
+    /** Type of the objects. */
+    std::string _type;
+
+    /** Number of objects. */
+    std::size_t _nbOfObjects;
+
+    /** Approximate number of bytes held by the objects. */
+    std::size_t _nbOfBytes;
+  };
+
+  /**
+   * List of memory usages, by structure, component and type.
+   */
+  typedef std::vector<MemoryUsageStruct> MemoryUsageList_T;
+
+  /**
+   * @brief Memory footprint report of SimCRS, as returned by
+   * SIMCRS_Service::memoryReport(), i.e., the number of objects and
+   * approximate number of bytes, by type and by component, of the
+   * persistent and working BOM trees and of the SimCRS structures
+   * (symbol table, availability status table, fare quote cache and
+   * request arena).
+   */
+  struct MemoryReportStruct {
+    friend class MemoryReportManager;
+  public:
+    // ///////////////// Getters ///////////////////
+    /** Get the memory usages, by structure, component and type. */
+    const MemoryUsageList_T& getMemoryUsageList() const {
+      return _memoryUsageList;
+    }
+
+    /**
+     * Get the number of objects of the given type, within the given
+     * structure (e.g., "persistent", "FlightDate").
+     */
+    std::size_t getNbOfObjects (const std::string& iStructure,
+                                const std::string& iType) const {
+      std::size_t oNbOfObjects = 0;
+      for (MemoryUsageList_T::const_iterator itUsage =
+             _memoryUsageList.begin();
+           itUsage != _memoryUsageList.end(); ++itUsage) {
+        const MemoryUsageStruct& lMemoryUsage = *itUsage;
+        if (lMemoryUsage.getStructure() == iStructure
+            && lMemoryUsage.getType() == iType) {
+          oNbOfObjects += lMemoryUsage.getNbOfObjects();
+        }
+      }
+      return oNbOfObjects;
+    }
+
+    /**
+     * Get the number of bytes held by the given component (e.g.,
+     * "airinv"), within all the structures.
+     */
+    std::size_t getComponentNbOfBytes (const std::string& iComponent) const {
+      std::size_t oNbOfBytes = 0;
+      for (MemoryUsageList_T::const_iterator itUsage =
+             _memoryUsageList.begin();
+           itUsage != _memoryUsageList.end(); ++itUsage) {
+        const MemoryUsageStruct& lMemoryUsage = *itUsage;
+        if (lMemoryUsage.getComponent() == iComponent) {
+          oNbOfBytes += lMemoryUsage.getNbOfBytes();
+        }
+      }
+      return oNbOfBytes;
+    }
+
+    /** Get the total number of objects. */
+    std::size_t getNbOfObjects() const {
+      std::size_t oNbOfObjects = 0;
+      for (MemoryUsageList_T::const_iterator itUsage =
+             _memoryUsageList.begin();
+           itUsage != _memoryUsageList.end(); ++itUsage) {
+        oNbOfObjects += itUsage->getNbOfObjects();
+      }
+      return oNbOfObjects;
+    }
+
+    /** Get the total (approximate) number of bytes. */
+    std::size_t getNbOfBytes() const {
+      std::size_t oNbOfBytes = 0;
+      for (MemoryUsageList_T::const_iterator itUsage =
+             _memoryUsageList.begin();
+           itUsage != _memoryUsageList.end(); ++itUsage) {
+        oNbOfBytes += itUsage->getNbOfBytes();
+      }
+      return oNbOfBytes;
+    }
+
+  public:
+    // /////////////// Display Methods /////////////////
+    /**
+     * Short display of the report.
+     */
+    const std::string describe() const {
+      std::ostringstream oStr;
+      oStr << "Memory report: " << getNbOfObjects() << " objects, "
+           << getNbOfBytes() << " bytes (airinv: "
+           << getComponentNbOfBytes ("airinv") << ", airtsp: "
+           << getComponentNbOfBytes ("airtsp") << ", simfqt: "
+           << getComponentNbOfBytes ("simfqt") << ", simcrs: "
+           << getComponentNbOfBytes ("simcrs") << ")";
+      return oStr.str();
+    }
+
+    /**
+     * Full display of the report (one line per type of objects).
+     */
+    const std::string display() const {
+      std::ostringstream oStr;
+      oStr << describe() << std::endl;
+      for (MemoryUsageList_T::const_iterator itUsage =
+             _memoryUsageList.begin();
+           itUsage != _memoryUsageList.end(); ++itUsage) {
+        const MemoryUsageStruct& lMemoryUsage = *itUsage;
+        oStr << lMemoryUsage.describe() << std::endl;
+      }
+      return oStr.str();
+    }
+
+  private:
+    // //////////////// Attributes ///////////////////
+    /** Memory usages, by structure, component and type. */
+    MemoryUsageList_T _memoryUsageList;
+  };
+
+}
+#endif // __SIMCRS_SIMCRS_MEMORYREPORT_HPP
@@ -0,0 +1,128 @@
+#ifndef __SIMCRS_SIMCRS_REQUESTTRACE_HPP
+#define __SIMCRS_SIMCRS_REQUESTTRACE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <string>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+
+namespace SIMCRS {
+
+  /**
+   * @brief Timing breakdown of a single (shopping or sell) request,
+   * optionally filled by the SIMCRS_Service methods.
+   *
+   * The structure is of fixed size, so that filling it does not involve
+   * any memory allocation. It is reset by the SIMCRS_Service method it is
+   * given to, which also assigns it a (sequential) request identifier.
+   */
+  struct RequestTraceStruct {
+  public:
+    // /////////////// Type definitions /////////////////
+    /** Stages of the requests. */
+    typedef enum {
+      SEGMENT_PATH = 0,
+      PRUNING,
+      FARE_QUOTE,
+      AVAILABILITY,
+      SELL,
+      TOTAL,
+      LAST_VALUE
+    } EN_Stage;
+
+    /** Number of nanoseconds. */
+    typedef unsigned long long Nanoseconds_T;
+
+  public:
+    // //////////////// Attributes ///////////////////
+    /** Request identifier (assigned by SimCRS, in sequence). */
+    unsigned long _requestID;
+
+    /** Time (in nanoseconds) spent in each stage. */
+    Nanoseconds_T _stageTimeList[LAST_VALUE];
+
+    /** Number of segment paths (bare travel solutions) built. */
+    NbOfTravelSolutions_T _nbOfSegmentPaths;
+
+    /** Number of travel solutions fare-quoted. */
+    NbOfTravelSolutions_T _nbOfQuotedTravelSolutions;
+
+    /** Number of fare options found by the fare quote. */
+    NbOfFareOptions_T _nbOfFareOptions;
+
+    /** Number of travel solutions served by the fare quote cache. */
+    NbOfTravelSolutions_T _nbOfFareQuoteCacheHits;
+
+    /** Whether the request has been served by the (in-flight)
+        computation of an identical request (see request coalescing). */
+    bool _isCoalesced;
+
+  public:
+    // ///////////////// Getters ///////////////////
+    /** Get the time (in nanoseconds) spent in the given stage. */
+    const Nanoseconds_T& getStageTime (const EN_Stage& iStage) const {
+      return _stageTimeList[iStage];
+    }
+
+    /** Get the label of the given stage. */
+    static const char* getStageLabel (const EN_Stage& iStage) {
+      static const char* lLabels[LAST_VALUE] =
+        { "segment path", "pruning", "fare quote", "availability", "sell",
+          "total" };
+      return lLabels[iStage];
+    }
+
+  public:
+    // ///////////////// Business Methods ///////////////////
+    /** Reset the trace (the request identifier being given). */
+    void reset (const unsigned long& iRequestID) {
+      _requestID = iRequestID;
+      for (unsigned short idx = 0; idx != LAST_VALUE; ++idx) {
+        _stageTimeList[idx] = 0;
+      }
+      _nbOfSegmentPaths = 0;
+      _nbOfQuotedTravelSolutions = 0;
+      _nbOfFareOptions = 0;
+      _nbOfFareQuoteCacheHits = 0;
+      _isCoalesced = false;
+    }
+
+  public:
+    // /////////////// Display Methods /////////////////
+    /**
+     * Short display of the trace.
+     */
+    const std::string describe() const {
+      std::ostringstream oStr;
+      oStr << "Request #" << _requestID << ":";
+      for (unsigned short idx = 0; idx != LAST_VALUE; ++idx) {
+        const EN_Stage lStage = static_cast<EN_Stage> (idx);
+        oStr << " " << getStageLabel (lStage) << " "
+             << _stageTimeList[idx] << "ns,";
+      }
+      oStr << " " << _nbOfSegmentPaths << " segment paths, "
+           << _nbOfQuotedTravelSolutions << " travel solutions fare-quoted ("
+           << _nbOfFareQuoteCacheHits << " from the cache), "
+           << _nbOfFareOptions << " fare options";
+      if (_isCoalesced == true) {
+        oStr << " (coalesced)";
+      }
+      return oStr.str();
+    }
+
+  public:
+    // //////////// Constructors and Destructors /////////////
+    /**
+     * Default constructor.
+     */
+    RequestTraceStruct() {
+      reset (0);
+    }
+  };
+
+}
+#endif // __SIMCRS_SIMCRS_REQUESTTRACE_HPP
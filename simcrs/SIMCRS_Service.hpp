@@ -4,6 +4,11 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// STL
+#include <iosfwd>
+#include <string>
+// Boost
+#include <boost/property_tree/ptree_fwd.hpp>
 // StdAir
 #include <stdair/stdair_basic_types.hpp>
 #include <stdair/stdair_file.hpp>
@@ -17,6 +22,11 @@
 #include <airrac/AIRRAC_Types.hpp>
 // SimCRS
 #include <simcrs/SIMCRS_Types.hpp>
+#include <simcrs/SIMCRS_ShoppingResult.hpp>
+#include <simcrs/SIMCRS_CalendarResult.hpp>
+#include <simcrs/SIMCRS_RequestTrace.hpp>
+#include <simcrs/SIMCRS_MemoryReport.hpp>
+#include <simcrs/SIMCRS_DisplayFilter.hpp>
 
 /// Forward declarations
 namespace stdair {
@@ -24,6 +34,7 @@ namespace stdair {
   struct BasLogParams;
   struct BasDBParams;
   struct BookingRequestStruct;
+  struct TravelSolutionStruct;
   struct CancellationStruct;
   struct SnapshotStruct;
   struct RMEventStruct;
@@ -117,6 +128,119 @@ namespace SIMCRS {
                        const AIRRAC::YieldFilePath&,
                        const SIMFQT::FareFilePath&);
 
+    /**
+     * Import the schedule, O&D, FRAT5, FF disutility, yield and fare
+     * input files into a local SQLite network database (through SOCI),
+     * replacing its former content, if any. The BOM trees are left
+     * untouched. The input files are read through memory-mapped,
+     * zero-copy records (see CSVRecordReader); the components (AirTSP,
+     * AirInv, SimFQT) parsing file paths only, that is the way for those
+     * files to go through the SimCRS ingestion layer.
+     *
+     * @param const stdair::Filename_T& Filename of the SQLite database.
+     * @param const stdair::ScheduleFilePath Filename of the input schedule file.
+     * @param const stdair::ODFilePath Filename of the input O&D file.
+     * @param const stdair::FRAT5FilePath& Filename of the input FRAT5 file.
+     * @param const stdair::FFDisutilityFilePath& Filename of the input FF disutility file.
+     * @param const AIRRAC::YieldFilePath& Filename of the input yield file.
+     * @param const SIMFQT::FareFilePath& Filename of the input fare file.
+     * @return NetworkDatabaseStatsStruct Statistics of the import.
+     */
+    NetworkDatabaseStatsStruct
+    importNetworkDatabase (const stdair::Filename_T&,
+                           const stdair::ScheduleFilePath&,
+                           const stdair::ODFilePath&,
+                           const stdair::FRAT5FilePath&,
+                           const stdair::FFDisutilityFilePath&,
+                           const AIRRAC::YieldFilePath&,
+                           const SIMFQT::FareFilePath&);
+
+    /**
+     * Build the BOM trees from a SQLite network database (see
+     * importNetworkDatabase()), keeping only the flights of the given
+     * airlines, and the O&D, yield and fare records referring to those
+     * airlines only. The flight-periods of those airlines are fetched by
+     * indexed queries: the flight-dates of the other airlines are
+     * neither parsed nor held in memory.
+     *
+     * The components (AirTSP, AirInv, SimFQT) parse CSV files only: the
+     * selected records are extracted into the files of a private
+     * temporary directory, which are then parsed as by parseAndLoad();
+     * the directory is removed, whether the load succeeds or not.
+     *
+     * @param const stdair::Filename_T& Filename of the SQLite database.
+     * @param const stdair::AirlineCodeList_T& Airlines to be loaded (all
+     *        of them when the list is empty).
+     * @return NetworkDatabaseStatsStruct Statistics of the records loaded.
+     */
+    NetworkDatabaseStatsStruct
+    loadFromNetworkDatabase (const stdair::Filename_T&,
+                             const stdair::AirlineCodeList_T&);
+
+    /**
+     * Apply the changes of the given schedule delta file (flight-dates
+     * closed, re-opened or re-scheduled), without rebuilding the BOM
+     * trees. The work is proportional to the number of changes, and
+     * the bookings already made are kept.
+     *
+     * As the inventory is not rebuilt, only the flight-dates which
+     * already exist can be closed or re-opened to sale. The changes are
+     * forgotten when the BOM trees are rebuilt (e.g., by parseAndLoad()).
+     *
+     * @param const stdair::Filename_T& Filename of the schedule delta file
+     *        (see DeltaManager for its format).
+     * @return DeltaStatsStruct Statistics of the changes.
+     */
+    DeltaStatsStruct applyScheduleDelta (const stdair::Filename_T&);
+
+    /**
+     * Apply the changes of the given fare delta file (fare options added,
+     * removed or re-priced), without rebuilding the BOM trees. The
+     * changes apply on top of the fare quotes of SimFQT, and are
+     * forgotten when the BOM trees are rebuilt.
+     *
+     * @param const stdair::Filename_T& Filename of the fare delta file
+     *        (see DeltaManager for its format).
+     * @return DeltaStatsStruct Statistics of the changes.
+     */
+    DeltaStatsStruct applyFareDelta (const stdair::Filename_T&);
+
+    /**
+     * Publish new fares, while the shopping requests keep being served
+     * (read-copy-update).
+     *
+     * A new SimFQT service, with its own StdAir service (and BOM tree),
+     * is built from the given fare file. It then atomically replaces
+     * the current one: the fare quotes already in progress complete with
+     * the former fares, the following ones use the new fares. The fare
+     * quote results of the former fares are no longer served by the fare
+     * quote cache.
+     *
+     * The former SimFQT service is deleted when the last fare quote
+     * using it completes. Its StdAir service is then retired: as the
+     * destruction of any StdAir service cleans all the StdAir BOM
+     * objects, the retired StdAir services (and their BOM trees) are
+     * deleted only when the SimCRS service is finalised, and provided
+     * that it owns its StdAir service (otherwise, they are kept until
+     * the end of the process).
+     *
+     * As the StdAir logger and BOM factories are not synchronised, the
+     * computations of the (coalesced, see setRequestCoalescing())
+     * requests wait for the new fares to be built.
+     *
+     * The fare rule changes (see applyFareDelta()) keep applying on top
+     * of the new fares.
+     *
+     * @param const SIMFQT::FareFilePath& Filename of the input fare file.
+     */
+    void publishFares (const SIMFQT::FareFilePath&);
+
+    /**
+     * Get the version of the fares, i.e., the number of times new fares
+     * have been published (see publishFares()).
+     */
+    FareVersion_T getFareVersion() const;
+
     /**
      * Initialise the snapshot and RM events for the inventories.
      *
@@ -134,28 +258,323 @@ namespace SIMCRS {
     
   public:
     // /////////////// Business Methods /////////////////
+    /*
+     * The shopping and sell methods below optionally fill the given
+     * request trace (see RequestTraceStruct), with the time spent in
+     * each stage of the request. The trace is reset, and given a new
+     * request identifier, by the method; it is left untouched when no
+     * trace is given (NULL pointer, the default).
+     */
+
     /**
      * Construct the list of travel solutions corresponding to the
      * booking request.
      */
     stdair::TravelSolutionList_T 
-    calculateSegmentPathList (const stdair::BookingRequestStruct&);
+    calculateSegmentPathList (const stdair::BookingRequestStruct&,
+                              RequestTraceStruct* ioRequestTrace_ptr = NULL);
     
     /**
      * Calculate the fare of each travel solutions in the list.
      */
     void fareQuote (const stdair::BookingRequestStruct&,
-                    stdair::TravelSolutionList_T&);
+                    stdair::TravelSolutionList_T&,
+                    RequestTraceStruct* ioRequestTrace_ptr = NULL);
 
     /**
      * Compute the availability for each travel solution in the list.
      */
-    void calculateAvailability (stdair::TravelSolutionList_T&);
+    void calculateAvailability (stdair::TravelSolutionList_T&,
+                                RequestTraceStruct* ioRequestTrace_ptr = NULL);
     
+    /**
+     * Shop for the booking request, i.e., retrieve the bookable travel
+     * solutions, along with their bookable fare options.
+     *
+     * That is the single-pass equivalent of the
+     * calculateSegmentPathList(), fareQuote() and calculateAvailability()
+     * sequence: the stages are chained for each travel solution in turn,
+     * and the travel solutions which cannot be booked are dropped as soon
+     * as they are known to be so (in particular, when the
+     * availability-first pruning is set, before being fare-quoted when
+     * none of the booking classes of one of their segments is open).
+     *
+     * @param const stdair::BookingRequestStruct& Booking request.
+     * @return ShoppingResultStruct The bookable travel solutions.
+     */
+    ShoppingResultStruct shop (const stdair::BookingRequestStruct&,
+                               RequestTraceStruct* ioRequestTrace_ptr = NULL);
+
+    /**
+     * Shop for the booking request (see above), within the given latency
+     * budget. The time spent is checked before each travel solution and
+     * between its stages (fare quote and availability): once the budget
+     * is spent, the shopping stops and the bookable travel solutions
+     * found so far are returned, the result being flagged as truncated
+     * (see ShoppingResultStruct::isTruncated()). A null budget means no
+     * limit.
+     *
+     * Note that the segment paths are still built in one go (by AirTSP),
+     * whatever the budget.
+     *
+     * @param const stdair::BookingRequestStruct& Booking request.
+     * @param const stdair::Duration_T& Latency budget.
+     * @return ShoppingResultStruct The bookable travel solutions (found
+     *         within the latency budget).
+     */
+    ShoppingResultStruct shop (const stdair::BookingRequestStruct&,
+                               const stdair::Duration_T&,
+                               RequestTraceStruct* ioRequestTrace_ptr = NULL);
+
+    /**
+     * Shop for the booking request over a range of (preferred) departure
+     * dates, e.g., for a low-fare calendar, and retrieve the lowest
+     * bookable fare of each date.
+     *
+     * The result is the same as calling shop() for each departure date
+     * in turn, and keeping the lowest fare of its result. However, the
+     * availability of the segment-dates is checked only once for the
+     * whole range, and the travel solutions which cannot lower the fare
+     * of their date are not given their availability.
+     *
+     * @param const stdair::BookingRequestStruct& Booking request (its
+     *        preferred departure date is not taken into account).
+     * @param const stdair::DatePeriod_T& Range of departure dates.
+     * @return CalendarResultStruct The lowest bookable fare for every
+     *         departure date of the range (none for a null or reversed
+     *         range).
+     */
+    CalendarResultStruct
+    shopCalendar (const stdair::BookingRequestStruct&,
+                  const stdair::DatePeriod_T&,
+                  RequestTraceStruct* ioRequestTrace_ptr = NULL);
+
+    /**
+     * Remove, from the given list, the travel solutions which cannot be
+     * sold, because at least one of their segments has no booking class
+     * left open for the party of the booking request.
+     *
+     * That method is meant to be called before fareQuote(), so as not to
+     * fare-quote travel solutions which cannot be sold anyway. It relies
+     * on an upper bound of the availability, so that no travel solution
+     * which could be sold is ever removed.
+     *
+     * @param const stdair::BookingRequestStruct& Booking request.
+     * @param stdair::TravelSolutionList_T& List of travel solutions.
+     * @return NbOfTravelSolutions_T Number of travel solutions removed.
+     */
+    NbOfTravelSolutions_T
+    pruneTravelSolutionList (const stdair::BookingRequestStruct&,
+                             stdair::TravelSolutionList_T&);
+
+    /**
+     * Stream the travel solutions corresponding to the booking request,
+     * one at a time, through the segment path, fare quote and availability
+     * stages, down to the given visitor.
+     *
+     * That is an alternative to the calculateSegmentPathList(), fareQuote()
+     * and calculateAvailability() sequence, which does not materialise
+     * the whole list of fully-fledged travel solutions.
+     *
+     * When the availability-first pruning is set (see
+     * setAvailabilityFirstPruning()), the travel solutions which cannot
+     * be sold are neither fare-quoted nor handed over to the visitor.
+     *
+     * @param const stdair::BookingRequestStruct& Booking request.
+     * @param const TravelSolutionVisitor_T& Visitor (call-back) receiving
+     *        each travel solution. It returns false to stop the streaming.
+     * @return NbOfTravelSolutions_T Number of travel solutions delivered
+     *         to the visitor.
+     */
+    NbOfTravelSolutions_T
+    streamTravelSolutions (const stdair::BookingRequestStruct&,
+                           const TravelSolutionVisitor_T&,
+                           RequestTraceStruct* ioRequestTrace_ptr = NULL);
+
+    /**
+     * Set the way the availability is calculated, i.e., whether the
+     * airline inventory is queried for every availability request
+     * (SEAMLESS_AVAILABILITY, the default), or the availability is read
+     * from the availability status (AVS) table of the CRS
+     * (AVS_AVAILABILITY). The AVS table is then kept up to date by
+     * the changes of the airline inventory (sales, cancellations and
+     * optimisations) going through SimCRS, at once or in batches (see
+     * setAvailabilityPushInterval()).
+     */
+    void setAvailabilityMode (const AvailabilityMode_T&);
+
+    /**
+     * Set the number of changes of the airline inventory after which
+     * their availability is pushed into the AVS table, in one batch
+     * (1, the default, meaning at once). Meanwhile, the AVS-based
+     * availability is stale, as in a real CRS.
+     */
+    void setAvailabilityPushInterval (const unsigned int);
+
+    /**
+     * Push the availability of the changes of the airline inventory
+     * not pushed yet into the AVS table.
+     */
+    void flushAvailabilityStatuses();
+
+    /**
+     * Get the way the availability is calculated (seamless or AVS).
+     */
+    AvailabilityMode_T getAvailabilityMode() const;
+
+    /**
+     * Set whether streamTravelSolutions() and shop() discard the travel
+     * solutions which cannot be sold before fare-quoting them
+     * (availability-first pruning). That mode is off by default.
+     */
+    void setAvailabilityFirstPruning (const bool);
+
+    /**
+     * Get the statistics of the availability-first pruning (share of
+     * the fare quote work removed, estimation of the time saved),
+     * cumulated since the SimCRS service has been initialised.
+     */
+    PruningStatsStruct getPruningStats() const;
+
+    /**
+     * Set the capacity (maximal number of entries) of the fare quote
+     * cache. When enabled (i.e., with a capacity greater than 0), the
+     * fare quote results are kept, keyed by the fare-relevant fields of
+     * the booking request (origin, destination, point of sale, channel,
+     * trip type, stay duration, request date and cabin) and by the
+     * segment path, so that the travel solutions of subsequent requests
+     * sharing those fields are not fare-quoted again. The least recently
+     * used entries are evicted first, and the whole cache is dropped
+     * whenever the fares are (re-)loaded. The cache is disabled by
+     * default.
+     */
+    void setFareQuoteCacheCapacity (const std::size_t&);
+
+    /**
+     * Get the statistics (number of look-ups and of hits, evictions)
+     * of the fare quote cache.
+     */
+    FareQuoteCacheStatsStruct getFareQuoteCacheStats() const;
+
+    /**
+     * Set whether the identical concurrent requests of
+     * calculateSegmentPathList() and of fareQuote() are coalesced, i.e.,
+     * wait for a single in-flight computation and all receive (a copy
+     * of) its result. Two segment path requests are identical when they
+     * have the same origin, destination and preferred departure date;
+     * two fare quote requests, when they have the same fare-relevant
+     * fields (see setFareQuoteCacheCapacity()) and segment paths.
+     *
+     * With coalescing, those two methods may be called concurrently (and
+     * only those ones): the computations are then serialised, as the
+     * underlying components are not thread-safe. What is done outside
+     * of the computations is safe for concurrent requests: the request
+     * identifiers are allocated atomically, the current request trace is
+     * kept per thread, and the trace events and heap allocations are
+     * recorded per thread. Coalescing is off by default, and is meant to
+     * be set before any concurrent call. All the other methods of the
+     * service are single-threaded.
+     */
+    void setRequestCoalescing (const bool);
+
+    /**
+     * Get the coalescing statistics of the segment path requests.
+     */
+    CoalescingStatsStruct getSegmentPathCoalescingStats() const;
+
+    /**
+     * Get the coalescing statistics of the fare quote requests.
+     */
+    CoalescingStatsStruct getFareQuoteCoalescingStats() const;
+
+    /**
+     * Start or stop the recording of the trace events, i.e., of the
+     * begin and end of every shopping and sell request, of its stages
+     * and of the calls to the components SimCRS delegates to (AirTSP,
+     * SimFQT, AirInv). Each thread records into its own buffer. The
+     * recording is off by default.
+     */
+    void setTraceEventRecording (const bool);
+
+    /**
+     * Set the name of the file the recorded trace events are dumped into
+     * (see dumpTraceEvents()) when the service is finalised. By default,
+     * the trace events are not dumped at all.
+     */
+    void setTraceEventFilename (const stdair::Filename_T&);
+
+    /**
+     * Dump the trace events recorded so far, in the Chrome trace event
+     * (JSON) format, which can be loaded into chrome://tracing or
+     * Perfetto.
+     */
+    void dumpTraceEvents (std::ostream&) const;
+
+    /**
+     * Get the number of trace events recorded so far.
+     */
+    std::size_t getNbOfTraceEvents() const;
+
+    /**
+     * Discard the trace events recorded so far.
+     */
+    void clearTraceEvents();
+
+    /**
+     * Start or stop the counting of the heap allocations (number of
+     * allocations and of bytes) made by each shopping, sell and
+     * cancellation operation, including by the components SimCRS
+     * delegates to. The counting is off by default.
+     *
+     * The allocations are counted by a thread-local hook (replacing the
+     * global operator new and operator delete), which is compiled in only
+     * with the ENABLE_ALLOCATION_COUNTING CMake option (see
+     * isAllocationCountingSupported()).
+     */
+    void setAllocationCounting (const bool);
+
+    /**
+     * State whether the heap allocations can be counted, i.e., whether
+     * the allocation hook has been compiled in.
+     */
+    bool isAllocationCountingSupported() const;
+
+    /**
+     * Get the heap allocation statistics, by type of operation (e.g.,
+     * "shop", "sell"), cumulated since the counting has been started.
+     */
+    AllocationStatsList_T getAllocationStats() const;
+
+    /**
+     * Forget the heap allocation statistics gathered so far.
+     */
+    void clearAllocationStats();
+
+    /**
+     * Report the memory footprint of SimCRS, i.e., the number of objects
+     * and approximate number of bytes, by type and by component, of the
+     * persistent and working BOM trees (inventories and schedules,
+     * reachable universe, fare rules) and of the SimCRS structures
+     * (symbol table, availability status table, fare quote cache and
+     * request arena).
+     *
+     * The same report is returned, in JSON format, by jsonHandler() for
+     * the {"memory_report":{}} command.
+     */
+    MemoryReportStruct memoryReport() const;
+
+    /**
+     * Get the memory usage statistics (number of allocations, peak number
+     * of bytes) of the request arena, for the last shopping request
+     * (e.g., streamTravelSolutions()) served by the calling thread.
+     */
+    ArenaStatsStruct getLastRequestArenaStats() const;
+
     /**
      * Register a booking.
      */
-    bool sell (const stdair::TravelSolutionStruct&, const stdair::PartySize_T&);
+    bool sell (const stdair::TravelSolutionStruct&, const stdair::PartySize_T&,
+               RequestTraceStruct* ioRequestTrace_ptr = NULL);
 
     /**
      * Take inventory snapshots.
@@ -172,6 +591,117 @@ namespace SIMCRS {
      */
     void optimise (const stdair::RMEventStruct&);
 
+    /**
+     * Open (or create) the booking journal, into which the successful
+     * sells and cancellations are then recorded, so that the inventory
+     * state may be rebuilt after a restart (see replayBookingJournal()).
+     *
+     * The records are committed to disk by a background writer, by
+     * groups: the sells and cancellations only append them to memory.
+     * A record is durable once committed (see flushBookingJournal()).
+     *
+     * @param const stdair::Filename_T& Name of the journal file.
+     * @param const unsigned int Interval (in milliseconds) during which
+     *        the records are grouped, before being committed.
+     */
+    void openBookingJournal (const stdair::Filename_T&,
+                             const unsigned int iCommitInterval);
+
+    /**
+     * Open (or create) the booking journal, with the default commit
+     * interval (DEFAULT_JOURNAL_COMMIT_INTERVAL).
+     */
+    void openBookingJournal (const stdair::Filename_T&);
+
+    /**
+     * Wait until all the sells and cancellations made so far have been
+     * committed to the booking journal.
+     */
+    void flushBookingJournal();
+
+    /**
+     * Commit the pending records, and close the booking journal.
+     */
+    void closeBookingJournal();
+
+    /**
+     * Get the statistics of the booking journal (number of records and
+     * group commits, time spent in journaling on the sell path).
+     */
+    JournalStatsStruct getBookingJournalStats() const;
+
+    /**
+     * Rebuild the inventory state, by making again the sells and
+     * cancellations of the given booking journal, on the BOM tree just
+     * loaded. The replayed sells and cancellations are not journaled
+     * again. A journal ending with an incomplete record (e.g., written
+     * when the process crashed) is replayed up to that record.
+     *
+     * @param const stdair::Filename_T& Name of the journal file.
+     * @return JournalReplayStatsStruct Statistics of the replay.
+     */
+    JournalReplayStatsStruct replayBookingJournal (const stdair::Filename_T&);
+
+    /**
+     * Save the inventory state (booking counters of every booking class,
+     * revenue management controls and bid-price vectors of the
+     * leg-cabins, as set by optimise()) into the given binary checkpoint
+     * file, so that a simulation may be resumed from that point (see
+     * restore()).
+     *
+     * The inventory snapshots (see takeSnapshots()) are held by the
+     * AirInv component, which gives no access to them: they are not
+     * part of the checkpoint.
+     *
+     * @param const stdair::Filename_T& Name of the checkpoint file.
+     * @return CheckpointStatsStruct Statistics of the checkpoint.
+     */
+    CheckpointStatsStruct checkpoint (const stdair::Filename_T&) const;
+
+    /**
+     * Restore the inventory state from the given checkpoint file, onto
+     * the network just loaded (the same one as when the checkpoint was
+     * made), instead of simulating again up to that point. The counters
+     * are set as they were, whatever the sells made since the network
+     * was loaded. The schedule and fare changes (see
+     * applyScheduleDelta() and applyFareDelta()), and the fare quote
+     * cache, are cleared.
+     *
+     * @param const stdair::Filename_T& Name of the checkpoint file.
+     * @return CheckpointStatsStruct Statistics of the restore.
+     */
+    CheckpointStatsStruct restore (const stdair::Filename_T&);
+
+    /**
+     * Run what-if variants of the simulation, from its current state,
+     * each one in a child process forked from the current one (Linux
+     * and other POSIX systems). The children share the BOM trees with
+     * the current process, copy-on-write: every branch only copies the
+     * pages it writes. The state of the current process is left
+     * unchanged, and the branches do not record into the booking
+     * journal.
+     *
+     * The writer of the booking journal is stopped while branching.
+     * Every child is forked with the locks of the service held by the
+     * calling thread (the other threads being blocked meanwhile, e.g.,
+     * until their in-flight computation is over), and with the log
+     * stream flushed, so that the child inherits neither a lock held
+     * by a thread which does not exist in it, nor the buffered output
+     * of the parent. The log stream is known only when the StdAir
+     * service is owned; otherwise, it is up to the caller to flush it.
+     * The components SimCRS delegates to (AirTSP, SimFQT, AirInv) have
+     * no such protection.
+     *
+     * @param const WhatIfVariantList_T& Variants to be run.
+     * @param const unsigned int Maximal number of branches running at the
+     *        same time (0 for the number of processors).
+     * @return WhatIfResultList_T Results (metrics sent back by the
+     *         variants), in the order of the variants.
+     */
+    WhatIfResultList_T
+    runWhatIfBranches (const WhatIfVariantList_T&,
+                       const unsigned int iMaxNbOfConcurrentBranches = 0);
+
     /**
      * Register a booking.
      *
@@ -181,7 +711,34 @@ namespace SIMCRS {
      * @return bool Whether or not the sale was successfull
      */
     bool sell (const std::string& iSegmentDateKey, const stdair::ClassCode_T&,
-               const stdair::PartySize_T&);
+               const stdair::PartySize_T&,
+               RequestTraceStruct* ioRequestTrace_ptr = NULL);
+
+    /**
+     * Register a booking, the segment-date and booking class being given
+     * by their interned identifiers.
+     *
+     * @param const SegmentDateID_T& Identifier of the segment on which
+     *        the sale is made (see getSegmentDateID())
+     * @param const ClassCodeID_T& Identifier of the class where the sale
+     *        is made (see getClassCodeID())
+     * @param const stdair::PartySize_T& Party size
+     * @return bool Whether or not the sale was successfull
+     */
+    bool sell (const SegmentDateID_T&, const ClassCodeID_T&,
+               const stdair::PartySize_T&,
+               RequestTraceStruct* ioRequestTrace_ptr = NULL);
+
+    /**
+     * Get the availability of a booking class, the segment-date and
+     * booking class being given by their interned identifiers.
+     *
+     * @param const SegmentDateID_T& Identifier of the segment-date.
+     * @param const ClassCodeID_T& Identifier of the booking class.
+     * @return stdair::Availability_T Segment availability of that class.
+     */
+    stdair::Availability_T getAvailability (const SegmentDateID_T&,
+                                            const ClassCodeID_T&) const;
     
     /**
      * Build a sample BOM tree, and attach it to the BomRoot instance.
@@ -201,7 +758,9 @@ namespace SIMCRS {
 
     /**
      * Build all the complementary links in the given bom root object.
-     * \note Do nothing for now.
+     *
+     * For now, the airline, airport and booking class codes, as well as
+     * the segment-date keys, are interned into the SimCRS symbol table.
      */
     void buildComplementaryLinks (stdair::BomRoot&); 
 
@@ -260,11 +819,84 @@ namespace SIMCRS {
     buildSampleBookingRequest (const bool isForCRS = false);
 
 
+  public:
+    // //////////////// Symbol (interned code) support methods /////////////
+    /**
+     * Get the interned identifier of an airport code.
+     *
+     * The airline, airport and booking class codes, as well as the
+     * segment-date keys, are interned when the BOM tree is loaded (e.g.,
+     * by parseAndLoad()).
+     *
+     * @param const stdair::AirportCode_T& Airport code (e.g., "SIN").
+     * @return AirportID_T Identifier of that airport.
+     * @throw SymbolNotFoundException when the code is not known by SimCRS.
+     */
+    AirportID_T getAirportID (const stdair::AirportCode_T&) const;
+
+    /**
+     * Get the interned identifier of an airline code.
+     *
+     * @param const stdair::AirlineCode_T& Airline code (e.g., "SQ").
+     * @return AirlineID_T Identifier of that airline.
+     * @throw SymbolNotFoundException when the code is not known by SimCRS.
+     */
+    AirlineID_T getAirlineID (const stdair::AirlineCode_T&) const;
+
+    /**
+     * Get the interned identifier of a booking class code.
+     *
+     * @param const stdair::ClassCode_T& Booking class code (e.g., "Y").
+     * @return ClassCodeID_T Identifier of that booking class.
+     * @throw SymbolNotFoundException when the code is not known by SimCRS.
+     */
+    ClassCodeID_T getClassCodeID (const stdair::ClassCode_T&) const;
+
+    /**
+     * Get the interned identifier of a segment-date key, as found within
+     * the segment path of the travel solutions.
+     *
+     * The segment-date keys of the BOM tree are interned when it is
+     * loaded; the other ones are interned when they are first seen.
+     *
+     * @param const std::string& Segment-date key
+     *        (e.g., "SQ;12,2011-Jan-31;SIN,BKK;08:20:00").
+     * @return SegmentDateID_T Identifier of that segment-date.
+     * @throw SymbolNotFoundException when no such segment-date exists
+     *        within the BOM tree.
+     */
+    SegmentDateID_T getSegmentDateID (const std::string& iSegmentDateKey);
+
+    /**
+     * Get the segment path of a travel solution, expressed with interned
+     * segment-date identifiers.
+     *
+     * @param const stdair::TravelSolutionStruct& Travel solution.
+     * @param SegmentPathID_T& List of the segment-date identifiers.
+     *        It is emptied before being filled.
+     */
+    void getSegmentPathID (const stdair::TravelSolutionStruct&,
+                           SegmentPathID_T&);
+
+    /**
+     * Get the airport, airline, booking class or segment-date code
+     * corresponding to an interned identifier (mainly for display purposes).
+     *
+     * @param const SymbolID_T& Identifier.
+     * @return const std::string& Corresponding code.
+     */
+    const std::string& getAirportCode (const AirportID_T&) const;
+    const std::string& getAirlineCode (const AirlineID_T&) const;
+    const std::string& getClassCode (const ClassCodeID_T&) const;
+    const std::string& getSegmentDateKey (const SegmentDateID_T&) const;
+
+
   public:
     // //////////////// Export support methods /////////////////
     /**
-     * Dispatch the JSon command string to the AirInv service.
-     * (Only AirInv has json export commands for now).
+     * Dispatch the JSon command string to the AirInv service, except for
+     * the memory report command ({"memory_report":{}}), handled by
+     * SimCRS itself (see memoryReport()).
      * 
      * @param const stdair::JSONString& Input string which contained the JSon
      *        command string.
@@ -273,6 +905,26 @@ namespace SIMCRS {
      */
     std::string jsonHandler (const stdair::JSONString&) const;
 
+    /**
+     * Answer the JSon command string, streaming the answer into the given
+     * output stream (sink), rather than building it in memory.
+     *
+     * The inventory ({"list":{..}}) and flight-date ({"flight_date":{..}})
+     * export commands are answered by SimCRS, one flight-date at a time,
+     * and paginated: besides the optional "airline_code", "flight_number"
+     * and "departure_date" selection fields, they accept the optional
+     * "offset" and "limit" (number of flight-dates per page, 0 meaning
+     * no limit) fields, and report the total number of selected
+     * flight-dates and whether there are more pages. The memory report
+     * command is answered as by jsonHandler() above, and the other
+     * commands are dispatched to the AirInv service.
+     *
+     * @param const stdair::JSONString& Input string which contained the JSon
+     *        command string.
+     * @param std::ostream& Output stream in which the answer is written.
+     */
+    void jsonHandler (const stdair::JSONString&, std::ostream&) const;
+
   public:
     // //////////////// Display support methods /////////////////
     /**
@@ -324,6 +976,36 @@ namespace SIMCRS {
                             const stdair::FlightNumber_T&,
                             const stdair::Date_T& iDepartureDate) const;
 
+    /**
+     * Recursively display, in CSV format, the flight-dates (of the BOM
+     * tree) selected by the given filter, streaming them one at a time
+     * into the given output stream (e.g., a log file). Contrary to the
+     * string-returning csvDisplay(), the memory needed does not depend
+     * on the size of the BOM tree.
+     *
+     * @param std::ostream& Output stream in which the flight-dates are
+     *        dumped.
+     * @param const DisplayFilterStruct& Selection of the flight-dates,
+     *        by airline, flight number and departure dates (by default,
+     *        all of them).
+     */
+    void csvDisplay (std::ostream&,
+                     const DisplayFilterStruct& = DisplayFilterStruct()) const;
+
+    /**
+     * Recursively display (see above) the selected flight-dates, handing
+     * the display of each of them, as a chunk, to the given sink.
+     */
+    void csvDisplay (const DisplayChunkSink_T&,
+                     const DisplayFilterStruct& = DisplayFilterStruct()) const;
+
+    /**
+     * List the flight-dates (of the BOM tree) selected by the given
+     * filter, by inventory, streaming them into the given output stream.
+     */
+    void list (std::ostream&,
+               const DisplayFilterStruct& = DisplayFilterStruct()) const;
+
 
   private:
     // /////// Construction and Destruction helper methods ///////
@@ -414,6 +1096,51 @@ namespace SIMCRS {
     void finalise();
 
 
+  private:
+    // /////// Shopping helper methods ///////
+    /**
+     * Build the segment paths (bare travel solutions) corresponding to
+     * the booking request, into the given list (see
+     * calculateSegmentPathList()), filling the given request trace,
+     * if any.
+     */
+    void buildSegmentPathList (const stdair::BookingRequestStruct&,
+                               stdair::TravelSolutionList_T&,
+                               RequestTraceStruct*);
+
+    /**
+     * Fare-quote the given travel solutions (see fareQuote()), filling
+     * the given request trace, if any.
+     */
+    void quotePrices (const stdair::BookingRequestStruct&,
+                      stdair::TravelSolutionList_T&, RequestTraceStruct*);
+
+
+  private:
+    // /////// Availability status (AVS) helper methods ///////
+    /**
+     * When the availability is AVS-based, push the (new) availability of
+     * the segment-dates of the given segment path into the AVS table.
+     * That method is called after every change of the airline inventory
+     * (sale, cancellation).
+     */
+    void pushAvailabilityStatuses (const stdair::KeyList_T&);
+
+
+  private:
+    // /////// Export helper methods ///////
+    /**
+     * Parse the given JSon command string, i.e., a JSon object with a
+     * single member (e.g., {"memory_report":{}}), into the given tree.
+     *
+     * @return std::string Name of the command (e.g., "memory_report"),
+     *         or an empty string when the JSon command string is not
+     *         well-formed.
+     */
+    static std::string parseJSONCommand (const stdair::JSONString&,
+                                         boost::property_tree::ptree&);
+
+
   private:
     // ///////// Service Context /////////
     /**
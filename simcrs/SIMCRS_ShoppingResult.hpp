@@ -0,0 +1,244 @@
+#ifndef __SIMCRS_SIMCRS_SHOPPINGRESULT_HPP
+#define __SIMCRS_SIMCRS_SHOPPINGRESULT_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_inventory_types.hpp>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+
+namespace SIMCRS {
+
+  // Forward declarations
+  class ShoppingManager;
+
+  /**
+   * @brief Bookable fare option of a shopping result: its fare, its
+   * availability, and the booking class of each of its segments.
+   */
+  struct ShoppingFareOptionStruct {
+    /** Fare. */
+    stdair::Fare_T _fare;
+    /** Availability (number of seats left for that fare). */
+    stdair::Availability_T _availability;
+    /** Position, within the result, of the identifier of the booking
+        class of the first segment (see
+        ShoppingResultStruct::getClassCodeID()). */
+    unsigned int _firstClassIdx;
+  };
+
+  /**
+   * @brief Bookable travel solution of a shopping result: positions,
+   * within the result, of its segment-dates and of its fare options.
+   */
+  struct ShoppingSolutionStruct {
+    /** Position of the identifier of the first segment-date (see
+        ShoppingResultStruct::getSegmentDateID()). */
+    unsigned int _firstSegmentIdx;
+    /** Position of the first fare option (see
+        ShoppingResultStruct::getFareOption()). */
+    unsigned int _firstFareOptionIdx;
+    /** Number of segments. */
+    unsigned short _nbOfSegments;
+    /** Number of bookable fare options. */
+    unsigned short _nbOfFareOptions;
+  };
+
+  /**
+   * @brief Result of a (fused) shopping request, as returned by
+   * SIMCRS_Service::shop().
+   *
+   * Only the bookable travel solutions are kept, each with only its
+   * bookable fare options, i.e., the fare options with enough seats
+   * left for the party of the booking request.
+   *
+   * The result is kept compact: a travel solution is given by the
+   * (interned) identifiers of its segment-dates, and a fare option by
+   * its fare, its availability and the identifiers of its booking
+   * classes, all of them being stored in flat lists. The identifiers
+   * are those of the service having served the request (see, e.g.,
+   * SIMCRS_Service::getSegmentDateKey() and
+   * SIMCRS_Service::getClassCode()), and may be given as such to
+   * SIMCRS_Service::sell().
+   */
+  struct ShoppingResultStruct {
+    friend class ShoppingManager;
+  public:
+    // ///////////////// Getters ///////////////////
+    /** Get the number of bookable travel solutions. */
+    NbOfTravelSolutions_T getNbOfTravelSolutions() const {
+      return static_cast<NbOfTravelSolutions_T> (_solutionList.size());
+    }
+
+    /** Get the given bookable travel solution (from 0). */
+    const ShoppingSolutionStruct&
+    getTravelSolution (const NbOfTravelSolutions_T& iSolutionIdx) const {
+      assert (iSolutionIdx < _solutionList.size());
+      return _solutionList[iSolutionIdx];
+    }
+
+    /** Get the identifier of the segment-date of the given segment (from
+        0) of the given travel solution. */
+    const SegmentDateID_T&
+    getSegmentDateID (const ShoppingSolutionStruct& iSolution,
+                      const unsigned short iSegmentIdx) const {
+      assert (iSegmentIdx < iSolution._nbOfSegments);
+      return _segmentDateIDList[iSolution._firstSegmentIdx + iSegmentIdx];
+    }
+
+    /** Get the given bookable fare option (from 0) of the given travel
+        solution. */
+    const ShoppingFareOptionStruct&
+    getFareOption (const ShoppingSolutionStruct& iSolution,
+                   const unsigned short iFareOptionIdx) const {
+      assert (iFareOptionIdx < iSolution._nbOfFareOptions);
+      return _fareOptionList[iSolution._firstFareOptionIdx + iFareOptionIdx];
+    }
+
+    /** Get the identifier of the booking class of the given segment (from
+        0) of the given fare option. */
+    const ClassCodeID_T&
+    getClassCodeID (const ShoppingFareOptionStruct& iFareOption,
+                    const unsigned short iSegmentIdx) const {
+      assert (iFareOption._firstClassIdx + iSegmentIdx
+              < _classCodeIDList.size());
+      return _classCodeIDList[iFareOption._firstClassIdx + iSegmentIdx];
+    }
+
+    /** Get the number of segment paths examined. */
+    const NbOfTravelSolutions_T& getNbOfSegmentPaths() const {
+      return _nbOfSegmentPaths;
+    }
+
+    /** Get the number of travel solutions disqualified before having
+        been fare-quoted (no booking class open on some segment). */
+    const NbOfTravelSolutions_T& getNbOfPrunedTravelSolutions() const {
+      return _nbOfPrunedTravelSolutions;
+    }
+
+    /** Get the number of bookable fare options (over all the travel
+        solutions). */
+    const NbOfFareOptions_T& getNbOfFareOptions() const {
+      return _nbOfFareOptions;
+    }
+
+    /** State whether no travel solution can be booked. */
+    bool empty() const {
+      return _solutionList.empty();
+    }
+
+    /** State whether the shopping has been stopped before all the segment
+        paths have been examined, as the latency budget has been spent.
+        The result then holds the travel solutions found so far. */
+    bool isTruncated() const {
+      return _isTruncated;
+    }
+
+    /** Get the number of bytes taken by the result. */
+    std::size_t getNbOfBytes() const {
+      return (sizeof (ShoppingResultStruct)
+              + _solutionList.capacity() * sizeof (ShoppingSolutionStruct)
+              + _segmentDateIDList.capacity() * sizeof (SegmentDateID_T)
+              + _fareOptionList.capacity() * sizeof (ShoppingFareOptionStruct)
+              + _classCodeIDList.capacity() * sizeof (ClassCodeID_T));
+    }
+
+  public:
+    // /////////////// Display Methods /////////////////
+    /**
+     * Short display of the shopping result.
+     */
+    const std::string describe() const {
+      std::ostringstream oStr;
+      oStr << _solutionList.size() << " bookable travel solutions ("
+           << _nbOfFareOptions << " fare options) out of "
+           << _nbOfSegmentPaths << " segment paths, "
+           << _nbOfPrunedTravelSolutions << " pruned before fare quote";
+      if (_isTruncated == true) {
+        oStr << " (truncated)";
+      }
+      return oStr.str();
+    }
+
+    /**
+     * Full display of the shopping result (with the identifiers of the
+     * segment-dates and of the booking classes).
+     */
+    const std::string display() const {
+      std::ostringstream oStr;
+      oStr << describe() << std::endl;
+      for (std::vector<ShoppingSolutionStruct>::const_iterator itSolution =
+             _solutionList.begin(); itSolution != _solutionList.end();
+           ++itSolution) {
+        const ShoppingSolutionStruct& lSolution = *itSolution;
+        oStr << "Segment-dates:";
+        for (unsigned short idxSegment = 0;
+             idxSegment != lSolution._nbOfSegments; ++idxSegment) {
+          oStr << " #" << getSegmentDateID (lSolution, idxSegment);
+        }
+        oStr << std::endl;
+
+        for (unsigned short idxFO = 0; idxFO != lSolution._nbOfFareOptions;
+             ++idxFO) {
+          const ShoppingFareOptionStruct& lFareOption =
+            getFareOption (lSolution, idxFO);
+          oStr << "  Fare: " << lFareOption._fare << ", availability: "
+               << lFareOption._availability << ", classes:";
+          for (unsigned short idxSegment = 0;
+               idxSegment != lSolution._nbOfSegments; ++idxSegment) {
+            oStr << " #" << getClassCodeID (lFareOption, idxSegment);
+          }
+          oStr << std::endl;
+        }
+      }
+      return oStr.str();
+    }
+
+  public:
+    // //////////// Constructors and Destructors /////////////
+    /**
+     * Default constructor.
+     */
+    ShoppingResultStruct()
+      : _nbOfSegmentPaths (0), _nbOfPrunedTravelSolutions (0),
+        _nbOfFareOptions (0), _isTruncated (false) {
+    }
+
+  private:
+    // //////////////// Attributes ///////////////////
+    /** Bookable travel solutions. */
+    std::vector<ShoppingSolutionStruct> _solutionList;
+
+    /** Identifiers of the segment-dates of the travel solutions. */
+    SegmentPathID_T _segmentDateIDList;
+
+    /** Bookable fare options of the travel solutions. */
+    std::vector<ShoppingFareOptionStruct> _fareOptionList;
+
+    /** Identifiers of the booking classes of the fare options. */
+    std::vector<ClassCodeID_T> _classCodeIDList;
+
+    /** Number of segment paths examined. */
+    NbOfTravelSolutions_T _nbOfSegmentPaths;
+
+    /** Number of travel solutions disqualified before fare quote. */
+    NbOfTravelSolutions_T _nbOfPrunedTravelSolutions;
+
+    /** Number of bookable fare options. */
+    NbOfFareOptions_T _nbOfFareOptions;
+
+    /** Whether the latency budget has been spent before the end. */
+    bool _isTruncated;
+  };
+
+}
+#endif // __SIMCRS_SIMCRS_SHOPPINGRESULT_HPP
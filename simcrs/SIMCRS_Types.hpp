@@ -5,12 +5,24 @@
 // Import section
 // //////////////////////////////////////////////////////////////////////
 // STL
+#include <cstddef>
 #include <exception>
+#include <map>
 #include <string>
+#include <string_view>
+#include <vector>
 // Boost
 #include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
 // StdAir
 #include <stdair/stdair_exceptions.hpp>
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_inventory_types.hpp>
+
+// Forward declarations
+namespace stdair {
+  struct TravelSolutionStruct;
+}
 
 namespace SIMCRS {
 
@@ -31,6 +43,17 @@ namespace SIMCRS {
   class AvailabilityRetrievalException : public stdair::RootException {
   };
 
+  /**
+   * Specific exception related to codes (airports, airlines, classes or
+   * segment-dates) not known from the SimCRS symbol table.
+   */
+  class SymbolNotFoundException : public stdair::ObjectNotFoundException {
+  public:
+    /** Constructor. */
+    SymbolNotFoundException (const std::string& iWhat)
+      : stdair::ObjectNotFoundException (iWhat) {}
+  };
+
 
   // //////// Type definitions specific to SimCRS /////////
   /**
@@ -42,7 +65,484 @@ namespace SIMCRS {
    * (Smart) Pointer on the SimCRS service handler.
    */
   typedef boost::shared_ptr<SIMCRS_Service> SIMCRS_ServicePtr_T;
-  
+
+  /**
+   * Dense integer identifier of a code interned within the SimCRS
+   * symbol table. The identifiers of a given kind of code (e.g., airports)
+   * range from 0 to the number of such codes known by SimCRS.
+   */
+  typedef unsigned int SymbolID_T;
+
+  /**
+   * Interned identifier of an airport code (e.g., "SIN").
+   */
+  typedef SymbolID_T AirportID_T;
+
+  /**
+   * Interned identifier of an airline code (e.g., "SQ").
+   */
+  typedef SymbolID_T AirlineID_T;
+
+  /**
+   * Interned identifier of a booking class code (e.g., "Y").
+   */
+  typedef SymbolID_T ClassCodeID_T;
+
+  /**
+   * Interned identifier of a segment-date key
+   * (e.g., "SQ;12,2011-Jan-31;SIN,BKK;08:20:00").
+   */
+  typedef SymbolID_T SegmentDateID_T;
+
+  /**
+   * Segment path (list of segment-dates) expressed with interned
+   * identifiers.
+   */
+  typedef std::vector<SegmentDateID_T> SegmentPathID_T;
+
+  /**
+   * Number of travel solutions.
+   */
+  typedef unsigned int NbOfTravelSolutions_T;
+
+  /**
+   * Number of fare options.
+   */
+  typedef unsigned int NbOfFareOptions_T;
+
+  /**
+   * Version of the fares (SimFQT service instance) used by the CRS,
+   * incremented every time new fares are published (see
+   * SIMCRS_Service::publishFares()).
+   */
+  typedef unsigned long FareVersion_T;
+
+  /**
+   * Way the availability is calculated by the CRS:
+   * <ul>
+   *   <li>SEAMLESS_AVAILABILITY: the airline inventory (AirInv) is queried
+   *       for every availability request;</li>
+   *   <li>AVS_AVAILABILITY: the availability is read from the
+   *       availability status (AVS) table of the CRS, which the airline
+   *       inventory pushes its changes to (after sales, cancellations
+   *       and optimisations), possibly in batches and thus with some
+   *       staleness.</li>
+   * </ul>
+   */
+  typedef enum {
+    SEAMLESS_AVAILABILITY = 0,
+    AVS_AVAILABILITY
+  } AvailabilityMode_T;
+
+  /**
+   * Availability status (number of seats left) of a booking class,
+   * as held within the availability status (AVS) table of the CRS.
+   */
+  typedef unsigned short AvailabilityStatus_T;
+
+  /**
+   * Memory usage statistics of the request arena, i.e., of the memory
+   * allocated by SimCRS while serving a single (shopping) request.
+   */
+  struct ArenaStatsStruct {
+    /** Number of allocations served by the arena. */
+    std::size_t _nbOfAllocations;
+    /** Number of bytes handed out by the arena, and still in use at the
+        end of the request (the nested requests, e.g., the fare quotes
+        of a shopping request, give their memory back when over). */
+    std::size_t _allocatedBytes;
+    /** Peak number of bytes in use during the request. */
+    std::size_t _peakBytes;
+    /** Number of bytes reserved from the system by the arena. */
+    std::size_t _reservedBytes;
+    /** Number of memory blocks reserved from the system by the arena. */
+    std::size_t _nbOfBlocks;
+
+    /** Default constructor. */
+    ArenaStatsStruct()
+      : _nbOfAllocations (0), _allocatedBytes (0), _peakBytes (0),
+        _reservedBytes (0), _nbOfBlocks (0) {
+    }
+  };
+
+  /**
+   * Statistics of the availability-first pruning, i.e., of the travel
+   * solutions discarded, before being fare-quoted, because none of the
+   * booking classes of at least one of their segments can be sold.
+   * Those statistics are cumulated over the shopping requests.
+   */
+  struct PruningStatsStruct {
+    /** Number of travel solutions checked by the pruning. */
+    NbOfTravelSolutions_T _nbOfTravelSolutions;
+    /** Number of travel solutions pruned (hence, not fare-quoted). */
+    NbOfTravelSolutions_T _nbOfPrunedTravelSolutions;
+    /** Time (in seconds) spent in checking the availability upper bound. */
+    double _pruningTime;
+    /** Number of travel solutions fare-quoted. */
+    NbOfTravelSolutions_T _nbOfQuotedTravelSolutions;
+    /** Time (in seconds) spent in fare-quoting the travel solutions. */
+    double _fareQuoteTime;
+
+    /** Default constructor. */
+    PruningStatsStruct()
+      : _nbOfTravelSolutions (0), _nbOfPrunedTravelSolutions (0),
+        _pruningTime (0.0), _nbOfQuotedTravelSolutions (0),
+        _fareQuoteTime (0.0) {
+    }
+
+    /** Share (between 0 and 1) of the fare quote work removed. */
+    double getPrunedShare() const {
+      if (_nbOfTravelSolutions == 0) {
+        return 0.0;
+      }
+      return (static_cast<double> (_nbOfPrunedTravelSolutions)
+              / static_cast<double> (_nbOfTravelSolutions));
+    }
+
+    /** Estimation of the time (in seconds) saved by the pruning, i.e.,
+        the time it would have taken to fare-quote the pruned travel
+        solutions, minus the time spent in pruning. */
+    double getSavedTime() const {
+      if (_nbOfQuotedTravelSolutions == 0) {
+        return -_pruningTime;
+      }
+      const double lAvgFareQuoteTime =
+        _fareQuoteTime / static_cast<double> (_nbOfQuotedTravelSolutions);
+      return (lAvgFareQuoteTime * _nbOfPrunedTravelSolutions - _pruningTime);
+    }
+  };
+
+  /**
+   * Statistics of the fare quote cache, cumulated since the SimCRS
+   * service has been initialised.
+   */
+  struct FareQuoteCacheStatsStruct {
+    /** Number of look-ups (i.e., of travel solutions to be fare-quoted). */
+    unsigned long _nbOfLookups;
+    /** Number of look-ups served by the cache (hence, not fare-quoted). */
+    unsigned long _nbOfHits;
+    /** Number of fare quote results stored into the cache. */
+    unsigned long _nbOfInsertions;
+    /** Number of entries evicted to keep the cache within its capacity. */
+    unsigned long _nbOfEvictions;
+    /** Number of times the cache has been emptied (e.g., when the fares
+        have been reloaded). */
+    unsigned long _nbOfFlushes;
+    /** Number of entries currently held by the cache. */
+    std::size_t _nbOfEntries;
+
+    /** Default constructor. */
+    FareQuoteCacheStatsStruct()
+      : _nbOfLookups (0), _nbOfHits (0), _nbOfInsertions (0),
+        _nbOfEvictions (0), _nbOfFlushes (0), _nbOfEntries (0) {
+    }
+
+    /** Share (between 0 and 1) of the look-ups served by the cache. */
+    double getHitRate() const {
+      if (_nbOfLookups == 0) {
+        return 0.0;
+      }
+      return (static_cast<double> (_nbOfHits)
+              / static_cast<double> (_nbOfLookups));
+    }
+  };
+
+  /**
+   * Statistics of the coalescing of identical concurrent requests,
+   * cumulated since the SimCRS service has been initialised.
+   */
+  struct CoalescingStatsStruct {
+    /** Number of requests. */
+    unsigned long _nbOfRequests;
+    /** Number of requests served by the computation of another one. */
+    unsigned long _nbOfCoalescedRequests;
+    /** Number of computations actually run. */
+    unsigned long _nbOfComputations;
+
+    /** Default constructor. */
+    CoalescingStatsStruct()
+      : _nbOfRequests (0), _nbOfCoalescedRequests (0), _nbOfComputations (0) {
+    }
+
+    /** Share (between 0 and 1) of the requests served by the computation
+        of another one. */
+    double getCoalescingRatio() const {
+      if (_nbOfRequests == 0) {
+        return 0.0;
+      }
+      return (static_cast<double> (_nbOfCoalescedRequests)
+              / static_cast<double> (_nbOfRequests));
+    }
+  };
+
+  /**
+   * Heap allocation statistics of a given (type of) SimCRS operation,
+   * e.g., shop() or sell(), cumulated since the allocation counting has
+   * been started (see SIMCRS_Service::setAllocationCounting()).
+   */
+  struct AllocationStatsStruct {
+    /** Number of operations. */
+    unsigned long _nbOfOperations;
+    /** Number of heap allocations (calls to operator new). */
+    unsigned long _nbOfAllocations;
+    /** Number of bytes allocated on the heap. */
+    unsigned long long _allocatedBytes;
+    /** Number of heap deallocations (calls to operator delete). */
+    unsigned long _nbOfDeallocations;
+
+    /** Default constructor. */
+    AllocationStatsStruct()
+      : _nbOfOperations (0), _nbOfAllocations (0), _allocatedBytes (0),
+        _nbOfDeallocations (0) {
+    }
+
+    /** Average number of heap allocations per operation. */
+    double getAverageNbOfAllocations() const {
+      if (_nbOfOperations == 0) {
+        return 0.0;
+      }
+      return (static_cast<double> (_nbOfAllocations)
+              / static_cast<double> (_nbOfOperations));
+    }
+  };
+
+  /**
+   * Heap allocation statistics, by (type of) SimCRS operation.
+   */
+  typedef std::map<std::string, AllocationStatsStruct> AllocationStatsList_T;
+
+  /**
+   * Visitor (call-back) receiving, one at a time, the travel solutions
+   * streamed by SimCRS, once they have been fare-quoted and their
+   * availability has been calculated.
+   *
+   * The travel solution is given by (non-constant) reference, so that
+   * the visitor may take it over (e.g., by swapping or splicing it).
+   * It is discarded by SimCRS as soon as the visitor returns.
+   * The visitor returns false to stop the streaming.
+   */
+  typedef boost::function<bool (stdair::TravelSolutionStruct&)>
+  TravelSolutionVisitor_T;
+
+  /**
+   * Sink (call-back) receiving, one chunk at a time, a display streamed
+   * by SimCRS (see the SIMCRS_Service::csvDisplay() overloads). A chunk
+   * holds the display of at most one flight-date, and is discarded by
+   * SimCRS as soon as the sink returns.
+   */
+  typedef boost::function<void (const std::string&)> DisplayChunkSink_T;
+
+  /**
+   * Statistics of the application of a schedule or fare delta file
+   * (see the SIMCRS_Service::applyScheduleDelta() and applyFareDelta()
+   * methods).
+   */
+  struct DeltaStatsStruct {
+    /** Number of changes read from the delta file. */
+    unsigned int _nbOfChanges;
+    /** Number of changes applied. */
+    unsigned int _nbOfAppliedChanges;
+    /** Number of changes which could not be applied (e.g., referring to
+        flight-dates which do not exist). */
+    unsigned int _nbOfRejectedChanges;
+    /** Number of flight-dates closed or re-opened to sale. */
+    unsigned int _nbOfUpdatedFlightDates;
+    /** Number of bytes of the delta file. */
+    std::size_t _nbOfBytes;
+    /** Time (in seconds) spent in reading (memory-mapping and tokenising)
+        the delta file and in applying its changes. */
+    double _loadTime;
+
+    /** Default constructor. */
+    DeltaStatsStruct()
+      : _nbOfChanges (0), _nbOfAppliedChanges (0), _nbOfRejectedChanges (0),
+        _nbOfUpdatedFlightDates (0), _nbOfBytes (0), _loadTime (0.0) {
+    }
+
+    /** Load throughput, in megabytes (10^6 bytes) per second. */
+    double getThroughput() const {
+      if (_loadTime <= 0.0) {
+        return 0.0;
+      }
+      return (static_cast<double> (_nbOfBytes) / 1e6 / _loadTime);
+    }
+  };
+
+  /**
+   * Fields of a record (line) of a CSV input file, as views on the
+   * (memory-mapped) content of the file: the fields are not copied.
+   */
+  typedef std::vector<std::string_view> CSVFieldList_T;
+
+  /**
+   * Statistics of the import of the input files into a SQLite network
+   * database, or of the loading of the BOM trees from such a database
+   * (see SIMCRS_Service::importNetworkDatabase() and
+   * loadFromNetworkDatabase()).
+   */
+  struct NetworkDatabaseStatsStruct {
+    /** Number of records, of all the input files. */
+    unsigned long _nbOfRecords;
+    /** Number of schedule records (flight-periods). */
+    unsigned long _nbOfScheduleRecords;
+
+    /** Default constructor. */
+    NetworkDatabaseStatsStruct()
+      : _nbOfRecords (0), _nbOfScheduleRecords (0) {
+    }
+  };
+
+  /**
+   * Statistics of the booking journal, cumulated since it has been
+   * opened (see SIMCRS_Service::openBookingJournal()).
+   */
+  struct JournalStatsStruct {
+    /** Number of records (sells and cancellations) appended. */
+    unsigned long _nbOfRecords;
+    /** Number of records written and synchronised to disk. */
+    unsigned long _nbOfCommittedRecords;
+    /** Number of group commits, i.e., of synchronisations to disk. */
+    unsigned long _nbOfCommits;
+    /** Number of group commits which have failed (e.g., disk full). */
+    unsigned long _nbOfFailedCommits;
+    /** Number of bytes written to disk. */
+    unsigned long long _nbOfBytes;
+    /** Time (in seconds) spent, on the sell and cancellation paths, in
+        appending the records to the journal. */
+    double _appendTime;
+    /** Time (in seconds) spent, by the background writer, in writing
+        and synchronising the records. */
+    double _commitTime;
+
+    /** Default constructor. */
+    JournalStatsStruct()
+      : _nbOfRecords (0), _nbOfCommittedRecords (0), _nbOfCommits (0),
+        _nbOfFailedCommits (0), _nbOfBytes (0), _appendTime (0.0),
+        _commitTime (0.0) {
+    }
+
+    /** Average number of records per group commit. */
+    double getAverageGroupSize() const {
+      if (_nbOfCommits == 0) {
+        return 0.0;
+      }
+      return (static_cast<double> (_nbOfCommittedRecords)
+              / static_cast<double> (_nbOfCommits));
+    }
+
+    /** Average time (in seconds) spent in appending a record. */
+    double getAverageAppendTime() const {
+      if (_nbOfRecords == 0) {
+        return 0.0;
+      }
+      return (_appendTime / static_cast<double> (_nbOfRecords));
+    }
+  };
+
+  /**
+   * Statistics of the replay of a booking journal (see
+   * SIMCRS_Service::replayBookingJournal()).
+   */
+  struct JournalReplayStatsStruct {
+    /** Number of (complete) records read from the journal. */
+    unsigned long _nbOfRecords;
+    /** Number of records applied on the inventory. */
+    unsigned long _nbOfAppliedRecords;
+    /** Number of records which could not be applied (e.g., referring to
+        booking classes which do not exist). */
+    unsigned long _nbOfFailedRecords;
+    /** Whether the journal ends with an incomplete or corrupted record
+        (e.g., after a crash in the middle of a write), which has been
+        ignored. */
+    bool _isTruncated;
+
+    /** Default constructor. */
+    JournalReplayStatsStruct()
+      : _nbOfRecords (0), _nbOfAppliedRecords (0), _nbOfFailedRecords (0),
+        _isTruncated (false) {
+    }
+  };
+
+  /**
+   * Statistics of a checkpoint of the inventory state, or of its restore
+   * (see SIMCRS_Service::checkpoint() and SIMCRS_Service::restore()).
+   */
+  struct CheckpointStatsStruct {
+    /** Number of segment-dates checkpointed (or restored). */
+    unsigned long _nbOfSegmentDates;
+    /** Number of booking classes checkpointed (or restored). */
+    unsigned long _nbOfBookingClasses;
+    /** Number of leg-cabins checkpointed (or restored). */
+    unsigned long _nbOfLegCabins;
+    /** Number of segment-dates of the checkpoint which do not exist in
+        the BOM tree being restored (restore only). */
+    unsigned long _nbOfUnmatchedSegmentDates;
+    /** Number of booking classes whose counters could not be restored,
+        as they do not exist in the BOM tree being restored (restore
+        only). */
+    unsigned long _nbOfFailedBookingClasses;
+    /** Size of the checkpoint file, in bytes. */
+    unsigned long long _nbOfBytes;
+    /** Time spent (in seconds) for the checkpoint (or restore). */
+    double _elapsedTime;
+
+    /** Default constructor. */
+    CheckpointStatsStruct()
+      : _nbOfSegmentDates (0), _nbOfBookingClasses (0), _nbOfLegCabins (0),
+        _nbOfUnmatchedSegmentDates (0), _nbOfFailedBookingClasses (0),
+        _nbOfBytes (0), _elapsedTime (0.0) {
+    }
+  };
+
+  /**
+   * Metrics computed by a what-if branch (e.g., revenue, load factor),
+   * sent back to the process having branched.
+   */
+  typedef std::vector<double> WhatIfMetricList_T;
+
+  /**
+   * Variant (call-back) of a what-if branch (see
+   * SIMCRS_Service::runWhatIfBranches()). It is run, in a child process,
+   * on the SimCRS service as it was when branched (e.g., calling
+   * optimise() with other revenue management settings, then simulating
+   * further), and fills the metrics to be sent back.
+   */
+  typedef boost::function<void (SIMCRS_Service&, WhatIfMetricList_T&)>
+  WhatIfVariant_T;
+
+  /**
+   * List of what-if variants.
+   */
+  typedef std::vector<WhatIfVariant_T> WhatIfVariantList_T;
+
+  /**
+   * Result of a what-if branch.
+   */
+  struct WhatIfResultStruct {
+    /** Whether the variant has run to completion (it has neither thrown,
+        nor crashed). */
+    bool _isSuccessful;
+    /** Metrics computed by the variant. */
+    WhatIfMetricList_T _metricList;
+    /** Time spent (in seconds) by the variant. */
+    double _elapsedTime;
+    /** Estimate (in bytes) of the memory made private to the branch, i.e.,
+        of the pages it has written (one page fault each), the other
+        pages being shared with the process having branched. */
+    unsigned long long _privateMemorySize;
+
+    /** Default constructor. */
+    WhatIfResultStruct()
+      : _isSuccessful (false), _elapsedTime (0.0), _privateMemorySize (0) {
+    }
+  };
+
+  /**
+   * List of the results of what-if branches, in the order of the
+   * variants.
+   */
+  typedef std::vector<WhatIfResultStruct> WhatIfResultList_T;
+
 }
 #endif // __SIMCRS_SIMCRS_TYPES_HPP
 
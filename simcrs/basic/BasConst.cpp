@@ -9,4 +9,41 @@ namespace SIMCRS {
   /** Default CRS code for the SIMCRS_Service. */
   const std::string DEFAULT_CRS_CODE = "1S";
 
+  /** Identifier returned when looking up a code not (yet) interned. */
+  const SymbolID_T DEFAULT_NULL_SYMBOL_ID = static_cast<SymbolID_T> (-1);
+
+  /** Default size (in bytes) of the memory blocks of the request arena. */
+  const std::size_t DEFAULT_ARENA_BLOCK_SIZE = 64 * 1024;
+
+  /** Default capacity (in number of entries) of the fare quote cache.
+      The cache is disabled when its capacity is 0. */
+  const std::size_t DEFAULT_FARE_QUOTE_CACHE_CAPACITY = 0;
+
+  /** Default number of events initially reserved in the trace event
+      buffer of each thread. */
+  const std::size_t DEFAULT_TRACE_EVENT_BUFFER_SIZE = 4096;
+
+  /** Approximate number of bytes taken by the link of a BOM object to
+      its parent, i.e., by a list node and a map node (keyed by the
+      business key of the object). */
+  const std::size_t BOM_LINK_SIZE =
+    3 * sizeof (void*) + 4 * sizeof (void*) + sizeof (std::string);
+
+  /** Default number of flight-dates per page of the streamed JSon
+      exports (see SIMCRS_Service::jsonHandler()). */
+  const std::size_t DEFAULT_JSON_EXPORT_PAGE_SIZE = 100;
+
+  /** Default interval (in milliseconds) during which the records of the
+      booking journal are grouped, before being committed to disk. */
+  const unsigned int DEFAULT_JOURNAL_COMMIT_INTERVAL = 10;
+
+  /** Size (in bytes) of the records pending in the booking journal
+      above which they are committed without waiting any longer. */
+  const std::size_t DEFAULT_JOURNAL_GROUP_COMMIT_SIZE = 64 * 1024;
+
+  /** Default number of inventory changes (sales, cancellations and
+      optimisations) after which the availability of the changed
+      segment-dates is pushed into the AVS table (1: at once). */
+  const unsigned int DEFAULT_AVS_PUSH_INTERVAL = 1;
+
 }
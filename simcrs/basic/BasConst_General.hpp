@@ -4,8 +4,46 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
 
 namespace SIMCRS {
 
+  /** Identifier returned when looking up a code not (yet) interned. */
+  extern const SymbolID_T DEFAULT_NULL_SYMBOL_ID;
+
+  /** Default size (in bytes) of the memory blocks of the request arena. */
+  extern const std::size_t DEFAULT_ARENA_BLOCK_SIZE;
+
+  /** Default capacity (in number of entries) of the fare quote cache.
+      The cache is disabled when its capacity is 0. */
+  extern const std::size_t DEFAULT_FARE_QUOTE_CACHE_CAPACITY;
+
+  /** Default number of events initially reserved in the trace event
+      buffer of each thread. */
+  extern const std::size_t DEFAULT_TRACE_EVENT_BUFFER_SIZE;
+
+  /** Approximate number of bytes taken by the link of a BOM object to
+      its parent, i.e., by a list node and a map node (keyed by the
+      business key of the object). */
+  extern const std::size_t BOM_LINK_SIZE;
+
+  /** Default number of flight-dates per page of the streamed JSon
+      exports (see SIMCRS_Service::jsonHandler()). */
+  extern const std::size_t DEFAULT_JSON_EXPORT_PAGE_SIZE;
+
+  /** Default interval (in milliseconds) during which the records of the
+      booking journal are grouped, before being committed to disk. */
+  extern const unsigned int DEFAULT_JOURNAL_COMMIT_INTERVAL;
+
+  /** Size (in bytes) of the records pending in the booking journal
+      above which they are committed without waiting any longer. */
+  extern const std::size_t DEFAULT_JOURNAL_GROUP_COMMIT_SIZE;
+
+  /** Default number of inventory changes (sales, cancellations and
+      optimisations) after which the availability of the changed
+      segment-dates is pushed into the AVS table (1: at once). */
+  extern const unsigned int DEFAULT_AVS_PUSH_INTERVAL;
+
 }
 #endif // __SIMCRS_BAS_BASCONST_GENERAL_HPP
@@ -0,0 +1,43 @@
+#ifndef __SIMCRS_BAS_BASPROBES_HPP
+#define __SIMCRS_BAS_BASPROBES_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+
+/**
+ * @file BasProbes.hpp
+ *
+ * Static (USDT, i.e., SystemTap-compatible) probes of SimCRS, placed at
+ * the entry and exit of the business methods of SIMCRS_Service and of
+ * the DistributionManager functions. They are listed, e.g., with
+ * 'bpftrace -l "usdt:/path/to/libsimcrs.so:simcrs:*"', and can be
+ * attached to by bpftrace, perf or SystemTap. A double underscore in the
+ * name of a probe shows as a dash (e.g., "shop-entry").
+ *
+ * The probes are compiled in only when SIMCRS_ENABLE_USDT_PROBES is
+ * defined (see the ENABLE_USDT_PROBES CMake option), which requires the
+ * sys/sdt.h header (e.g., from the systemtap-sdt-dev(el) package).
+ * Otherwise, they expand to nothing, and their arguments are not even
+ * evaluated. When compiled in, an idle probe is a single no-op
+ * instruction.
+ *
+ * The arguments of the probes must be integers (or pointers).
+ */
+#if defined(SIMCRS_ENABLE_USDT_PROBES)
+#include <sys/sdt.h>
+
+#define SIMCRS_PROBE0(iName) DTRACE_PROBE (simcrs, iName)
+#define SIMCRS_PROBE1(iName, iArg1) DTRACE_PROBE1 (simcrs, iName, iArg1)
+#define SIMCRS_PROBE2(iName, iArg1, iArg2)      \
+  DTRACE_PROBE2 (simcrs, iName, iArg1, iArg2)
+
+#else // SIMCRS_ENABLE_USDT_PROBES
+
+#define SIMCRS_PROBE0(iName) do {} while (0)
+#define SIMCRS_PROBE1(iName, iArg1) do {} while (0)
+#define SIMCRS_PROBE2(iName, iArg1, iArg2) do {} while (0)
+
+#endif // SIMCRS_ENABLE_USDT_PROBES
+
+#endif // __SIMCRS_BAS_BASPROBES_HPP
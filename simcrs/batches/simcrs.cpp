@@ -66,6 +66,13 @@ const std::string K_SIMCRS_DEFAULT_FARE_INPUT_FILENAME (STDAIR_SAMPLE_DIR
  */
 const bool K_SIMCRS_DEFAULT_BUILT_IN_INPUT = false;
 
+/**
+ * Default for the availability-first pruning, i.e., for discarding the
+ * travel solutions which cannot be sold before pricing them (see the
+ * -r/--prune option).
+ */
+const bool K_SIMCRS_DEFAULT_PRUNING = false;
+
 /**
  * Default name and location for the MySQL database.
  */
@@ -88,7 +95,7 @@ const int K_SIMCRS_EARLY_RETURN_STATUS = 99;
 
 /** Read and parse the command line options. */
 int readConfiguration (int argc, char* argv[],
-                       bool& ioIsBuiltin,
+                       bool& ioIsBuiltin, bool& ioPruneFirst,
                        stdair::Filename_T& ioScheduleInputFilename,
                        stdair::Filename_T& ioOnDInputFilename,
                        stdair::Filename_T& ioFRAT5Filename,
@@ -102,6 +109,9 @@ int readConfiguration (int argc, char* argv[],
   // Default for the built-in input
   ioIsBuiltin = K_SIMCRS_DEFAULT_BUILT_IN_INPUT;
 
+  // Default for the availability-first pruning
+  ioPruneFirst = K_SIMCRS_DEFAULT_PRUNING;
+
   // Declare a group of options that will be allowed only on command line
   boost::program_options::options_description generic ("Generic options");
   generic.add_options()
@@ -115,6 +125,8 @@ int readConfiguration (int argc, char* argv[],
   config.add_options()
     ("builtin,b",
      "The sample BOM tree can be either built-in or parsed from input files. In that latter case, the input files must be specified as well (e.g., -s/--schedule,  -o/--ond, -f/--fare, -y/--yield)")
+    ("prune,r",
+     "Discard the travel solutions which cannot be sold, before pricing them")
     ("schedule,s",
      boost::program_options::value< std::string >(&ioScheduleInputFilename)->default_value(K_SIMCRS_DEFAULT_SCHEDULE_INPUT_FILENAME),
      "(CVS) input file for the schedules")
@@ -204,6 +216,14 @@ int readConfiguration (int argc, char* argv[],
   const std::string isBuiltinStr = (ioIsBuiltin == true)?"yes":"no";
   std::cout << "The BOM should be built-in? " << isBuiltinStr << std::endl;
 
+  if (vm.count ("prune")) {
+    ioPruneFirst = true;
+  }
+  const std::string isPruneFirstStr = (ioPruneFirst == true)?"yes":"no";
+  std::cout << "The travel solutions which cannot be sold should be "
+            << "discarded before being priced? " << isPruneFirstStr
+            << std::endl;
+
   //
   std::ostringstream oErrorMessageStr;
   oErrorMessageStr << "Either the -b/--builtin option, or the combination of "
@@ -316,6 +336,10 @@ int main (int argc, char* argv[]) {
   // input file
   bool isBuiltin;
 
+  // State whether the travel solutions which cannot be sold should be
+  // discarded before being priced
+  bool isPruneFirst;
+
   // Schedule input filename
   stdair::Filename_T lScheduleInputFilename;
     
@@ -349,7 +373,7 @@ int main (int argc, char* argv[]) {
     
   // Call the command-line option parser
   const int lOptionParserStatus = 
-    readConfiguration (argc, argv, isBuiltin,
+    readConfiguration (argc, argv, isBuiltin, isPruneFirst,
                        lScheduleInputFilename, lOnDInputFilename,
                        lFRAT5InputFilename, lFFDisutilityInputFilename,
                        lYieldInputFilename, lFareInputFilename, lLogFilename,
@@ -410,9 +434,36 @@ int main (int argc, char* argv[]) {
     return -1;
   }
 
+  // Discard the travel solutions which cannot be sold, before pricing
+  // them, if so required
+  if (isPruneFirst == true) {
+    simcrsService.pruneTravelSolutionList (lBookingRequest,
+                                           lTravelSolutionList);
+
+    // Check whether everything was fine
+    if (lTravelSolutionList.empty() == true) {
+      STDAIR_LOG_ERROR ("No travel solution can be sold for: "
+                        << lBookingRequest.display());
+      return -1;
+    }
+  }
+
   // Price the travel solution
   simcrsService.fareQuote (lBookingRequest, lTravelSolutionList);
 
+  // DEBUG
+  if (isPruneFirst == true) {
+    const SIMCRS::PruningStatsStruct& lPruningStats =
+      simcrsService.getPruningStats();
+    STDAIR_LOG_DEBUG ("Availability-first pruning: "
+                      << lPruningStats._nbOfPrunedTravelSolutions
+                      << " out of " << lPruningStats._nbOfTravelSolutions
+                      << " travel solutions pruned ("
+                      << 100.0 * lPruningStats.getPrunedShare()
+                      << "% of the fare quote work), estimated time saved: "
+                      << lPruningStats.getSavedTime() << "s");
+  }
+
   // Choose a random travel solution: the first one.
   stdair::TravelSolutionStruct& lChosenTravelSolution =
     lTravelSolutionList.front();
@@ -449,9 +500,8 @@ int main (int argc, char* argv[]) {
   STDAIR_LOG_DEBUG ("Sale ('" << lBookingRequest << "'): "
                     << " successful? " << isSellSuccessful);
 
-  // DEBUG: Display the whole BOM tree
-  const std::string& lCSVDump = simcrsService.csvDisplay();
-  STDAIR_LOG_DEBUG (lCSVDump);
+  // DEBUG: Display the whole BOM tree, streaming it into the log file
+  simcrsService.csvDisplay (logOutputFile);
 
   // Close the Log outputFile
   logOutputFile.close();
@@ -0,0 +1,164 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cstdlib>
+#include <new>
+// SimCRS
+#include <simcrs/bom/AllocationCounter.hpp>
+
+namespace SIMCRS {
+
+  namespace {
+    /**
+     * Allocations made by the calling thread, within the scope of the
+     * current operation. That structure is constant-initialised, so that
+     * it can be used from within operator new.
+     */
+    struct ThreadAllocationCount {
+      bool _isCounting;
+      unsigned long _nbOfAllocations;
+      unsigned long long _allocatedBytes;
+      unsigned long _nbOfDeallocations;
+    };
+    thread_local ThreadAllocationCount tlAllocationCount = { false, 0, 0, 0 };
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  AllocationCounter::AllocationCounter() : _isEnabled (false) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  AllocationCounter::AllocationCounter (const AllocationCounter&)
+    : _isEnabled (false) {
+    assert (false);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  AllocationCounter::~AllocationCounter() {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool AllocationCounter::isHookCompiledIn() {
+#if defined(SIMCRS_ENABLE_ALLOCATION_COUNTING)
+    return true;
+#else // SIMCRS_ENABLE_ALLOCATION_COUNTING
+    return false;
+#endif // SIMCRS_ENABLE_ALLOCATION_COUNTING
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  AllocationStatsList_T AllocationCounter::getStats() const {
+    std::lock_guard<std::mutex> lGuard (_mutex);
+    return _statsList;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void AllocationCounter::add (const char* iOperation,
+                               const AllocationStatsStruct& iOperationStats) {
+    std::lock_guard<std::mutex> lGuard (_mutex);
+    AllocationStatsStruct& lStats = _statsList[iOperation];
+    lStats._nbOfOperations += iOperationStats._nbOfOperations;
+    lStats._nbOfAllocations += iOperationStats._nbOfAllocations;
+    lStats._allocatedBytes += iOperationStats._allocatedBytes;
+    lStats._nbOfDeallocations += iOperationStats._nbOfDeallocations;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void AllocationCounter::clear() {
+    std::lock_guard<std::mutex> lGuard (_mutex);
+    _statsList.clear();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void AllocationCounter::lockBeforeFork() {
+    _mutex.lock();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void AllocationCounter::unlockAfterFork() {
+    _mutex.unlock();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  AllocationCountScope::
+  AllocationCountScope (AllocationCounter& ioAllocationCounter,
+                        const char* iOperation)
+    : _allocationCounter_ptr (NULL), _operation (iOperation) {
+    if (ioAllocationCounter.isEnabled() == false
+        || tlAllocationCount._isCounting == true) {
+      return;
+    }
+
+    _allocationCounter_ptr = &ioAllocationCounter;
+    tlAllocationCount._nbOfAllocations = 0;
+    tlAllocationCount._allocatedBytes = 0;
+    tlAllocationCount._nbOfDeallocations = 0;
+    tlAllocationCount._isCounting = true;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  AllocationCountScope::~AllocationCountScope() {
+    if (_allocationCounter_ptr == NULL) {
+      return;
+    }
+
+    // Stop counting, before the statistics are updated (which may
+    // allocate)
+    tlAllocationCount._isCounting = false;
+
+    AllocationStatsStruct lOperationStats;
+    lOperationStats._nbOfOperations = 1;
+    lOperationStats._nbOfAllocations = tlAllocationCount._nbOfAllocations;
+    lOperationStats._allocatedBytes = tlAllocationCount._allocatedBytes;
+    lOperationStats._nbOfDeallocations = tlAllocationCount._nbOfDeallocations;
+    _allocationCounter_ptr->add (_operation, lOperationStats);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  AllocationCountScope::AllocationCountScope (const AllocationCountScope&)
+    : _allocationCounter_ptr (NULL), _operation (NULL) {
+    assert (false);
+  }
+
+}
+
+#if defined(SIMCRS_ENABLE_ALLOCATION_COUNTING)
+/**
+ * Allocation hook: replacement of the global (throwing) operator new and
+ * of operator delete. The other (array, nothrow and sized) forms, as
+ * provided by the C++ run-time library, rely on those two. The
+ * over-aligned forms are not counted.
+ */
+
+// //////////////////////////////////////////////////////////////////////
+void* operator new (std::size_t iSize) {
+  void* oMemory_ptr = std::malloc (iSize == 0 ? 1 : iSize);
+  if (oMemory_ptr == NULL) {
+    throw std::bad_alloc();
+  }
+
+  SIMCRS::ThreadAllocationCount& lAllocationCount =
+    SIMCRS::tlAllocationCount;
+  if (lAllocationCount._isCounting == true) {
+    ++lAllocationCount._nbOfAllocations;
+    lAllocationCount._allocatedBytes += iSize;
+  }
+  return oMemory_ptr;
+}
+
+// //////////////////////////////////////////////////////////////////////
+void operator delete (void* ioMemory_ptr) noexcept {
+  if (ioMemory_ptr == NULL) {
+    return;
+  }
+
+  SIMCRS::ThreadAllocationCount& lAllocationCount =
+    SIMCRS::tlAllocationCount;
+  if (lAllocationCount._isCounting == true) {
+    ++lAllocationCount._nbOfDeallocations;
+  }
+  std::free (ioMemory_ptr);
+}
+#endif // SIMCRS_ENABLE_ALLOCATION_COUNTING
@@ -0,0 +1,144 @@
+#ifndef __SIMCRS_BOM_ALLOCATIONCOUNTER_HPP
+#define __SIMCRS_BOM_ALLOCATIONCOUNTER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <atomic>
+#include <mutex>
+#include <string>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+
+namespace SIMCRS {
+
+  /**
+   * @brief Counter of the heap allocations made by the SimCRS operations
+   * (e.g., shop() or sell()), by type of operation.
+   *
+   * The allocations are counted by a (thread-local) hook, i.e., by the
+   * replacement of the global operator new and operator delete, which
+   * is compiled in only when SIMCRS_ENABLE_ALLOCATION_COUNTING is defined
+   * (see the ENABLE_ALLOCATION_COUNTING CMake option). Otherwise, no
+   * allocation is ever counted (see isHookCompiledIn()).
+   *
+   * Even with the hook compiled in, the allocations are counted only
+   * when the counter is enabled (it is disabled by default), and only
+   * within the scope of an operation (see AllocationCountScope), on the
+   * thread serving it. Everything allocated by the operation is counted,
+   * including by the components SimCRS delegates to (AirTSP, SimFQT,
+   * AirInv) and by the logger.
+   */
+  class AllocationCounter {
+  public:
+    // ///////////////// Getters ///////////////////
+    /**
+     * State whether the allocations are being counted.
+     */
+    bool isEnabled() const {
+      return _isEnabled.load (std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the allocation statistics, by type of operation.
+     */
+    AllocationStatsList_T getStats() const;
+
+    /**
+     * State whether the allocation hook has been compiled in, i.e.,
+     * whether the allocations can be counted at all.
+     */
+    static bool isHookCompiledIn();
+
+  public:
+    // ///////////////// Setters ///////////////////
+    /**
+     * Start or stop the counting of the allocations. The statistics
+     * gathered so far are kept.
+     */
+    void setEnabled (const bool iIsEnabled) {
+      _isEnabled.store (iIsEnabled, std::memory_order_relaxed);
+    }
+
+  public:
+    // ///////////////// Business Methods ///////////////////
+    /**
+     * Add the allocations of an operation to the statistics of its type.
+     */
+    void add (const char* iOperation,
+              const AllocationStatsStruct& iOperationStats);
+
+    /**
+     * Forget the statistics gathered so far.
+     */
+    void clear();
+
+    /**
+     * Take the lock of the statistics before forking the process, so
+     * that the child does not inherit it in the middle of an update.
+     */
+    void lockBeforeFork();
+
+    /**
+     * Release the lock taken by lockBeforeFork(), in the parent as well
+     * as in the child process (where it is held by the copy of the
+     * forking thread).
+     */
+    void unlockAfterFork();
+
+  public:
+    // //////////// Constructors and Destructors /////////////
+    /**
+     * Default constructor.
+     */
+    AllocationCounter();
+
+    /**
+     * Destructor.
+     */
+    ~AllocationCounter();
+
+  private:
+    /**
+     * Copy constructor (not to be used).
+     */
+    AllocationCounter (const AllocationCounter&);
+
+  private:
+    // //////////////// Attributes ///////////////////
+    /** Whether the allocations are being counted. */
+    std::atomic<bool> _isEnabled;
+
+    /** Lock of the statistics (the operations may run concurrently). */
+    mutable std::mutex _mutex;
+
+    /** Allocation statistics, by type of operation. */
+    AllocationStatsList_T _statsList;
+  };
+
+  /**
+   * @brief Guard counting the heap allocations made, by the calling
+   * thread, within its scope, and adding them to the statistics of the
+   * given type of operation. Nothing is counted when the counter is
+   * disabled, nor within the scope of another (enclosing) guard: the
+   * allocations are ascribed to the outermost operation.
+   */
+  class AllocationCountScope {
+  public:
+    /** Constructor. */
+    AllocationCountScope (AllocationCounter&, const char* iOperation);
+    /** Destructor. */
+    ~AllocationCountScope();
+  private:
+    /** Copy constructor (not to be used). */
+    AllocationCountScope (const AllocationCountScope&);
+  private:
+    /** Counter (NULL when not counting). */
+    AllocationCounter* _allocationCounter_ptr;
+    /** Type of the operation. */
+    const char* _operation;
+  };
+
+}
+#endif // __SIMCRS_BOM_ALLOCATIONCOUNTER_HPP
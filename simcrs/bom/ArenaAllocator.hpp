@@ -0,0 +1,113 @@
+#ifndef __SIMCRS_BOM_ARENAALLOCATOR_HPP
+#define __SIMCRS_BOM_ARENAALLOCATOR_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cstddef>
+#include <list>
+#include <vector>
+// SimCRS
+#include <simcrs/bom/RequestArena.hpp>
+
+namespace SIMCRS {
+
+  /**
+   * @brief STL allocator drawing its memory from a RequestArena.
+   *
+   * The de-allocation is a no-op: the memory is given back at the end of
+   * the request (see RequestArenaScope). Hence, the containers using that
+   * allocator must not outlive the (possibly nested) request.
+   */
+  template <typename T>
+  class ArenaAllocator {
+    template <typename U> friend class ArenaAllocator;
+  public:
+    // /////////////// Type definitions /////////////////
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind {
+      typedef ArenaAllocator<U> other;
+    };
+
+  public:
+    // //////////// Constructors and Destructors /////////////
+    /**
+     * Main constructor.
+     */
+    explicit ArenaAllocator (RequestArena& ioArena) : _arena (&ioArena) {
+    }
+
+    /**
+     * Converting constructor (e.g., from the allocator of the elements
+     * to the allocator of the list nodes).
+     */
+    template <typename U>
+    ArenaAllocator (const ArenaAllocator<U>& iAllocator)
+      : _arena (iAllocator._arena) {
+    }
+
+  public:
+    // /////////////// Business Methods /////////////////
+    /**
+     * Allocate the memory for the given number of objects.
+     */
+    T* allocate (const size_type iNbOfObjects, const void* = 0) {
+      assert (_arena != NULL);
+      return static_cast<T*> (_arena->allocate (iNbOfObjects * sizeof (T),
+                                                alignof (T)));
+    }
+
+    /**
+     * Nothing to be done: the memory is given back by
+     * RequestArena::endRequest().
+     */
+    void deallocate (T*, const size_type) {
+    }
+
+    /**
+     * Both allocators draw from the same arena.
+     */
+    template <typename U>
+    bool operator== (const ArenaAllocator<U>& iAllocator) const {
+      return (_arena == iAllocator._arena);
+    }
+
+    template <typename U>
+    bool operator!= (const ArenaAllocator<U>& iAllocator) const {
+      return (_arena != iAllocator._arena);
+    }
+
+  private:
+    // //////////////// Attributes ///////////////////
+    /** Arena the memory is drawn from. */
+    RequestArena* _arena;
+  };
+
+  /**
+   * Vector drawing its memory from a request arena.
+   */
+  template <typename T>
+  struct ArenaVector {
+    typedef std::vector<T, ArenaAllocator<T> > Type;
+  };
+
+  /**
+   * List drawing its memory from a request arena.
+   */
+  template <typename T>
+  struct ArenaList {
+    typedef std::list<T, ArenaAllocator<T> > Type;
+  };
+
+}
+#endif // __SIMCRS_BOM_ARENAALLOCATOR_HPP
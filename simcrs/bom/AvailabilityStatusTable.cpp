@@ -0,0 +1,302 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+// SimCRS
+#include <simcrs/basic/BasConst_General.hpp>
+#include <simcrs/bom/AvailabilityStatusTable.hpp>
+
+namespace SIMCRS {
+
+  // ////////////////////////////////////////////////////////////////////
+  const AvailabilityStatus_T AvailabilityStatusTable::K_UNKNOWN_STATUS =
+    static_cast<AvailabilityStatus_T> (-1);
+
+  // ////////////////////////////////////////////////////////////////////
+  const AvailabilityStatus_T AvailabilityStatusTable::K_MAX_STATUS =
+    static_cast<AvailabilityStatus_T> (-2);
+
+  // ////////////////////////////////////////////////////////////////////
+  AvailabilityStatusTable::AvailabilityStatusTable()
+    : _block_ptr (NULL), _nbOfReaders (0), _nbOfPushes (0),
+      _pushInterval (DEFAULT_AVS_PUSH_INTERVAL), _nbOfPendingChanges (0),
+      _isFullPushPending (false) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  AvailabilityStatusTable::
+  AvailabilityStatusTable (const AvailabilityStatusTable&)
+    : _block_ptr (NULL), _nbOfReaders (0), _nbOfPushes (0),
+      _pushInterval (DEFAULT_AVS_PUSH_INTERVAL), _nbOfPendingChanges (0),
+      _isFullPushPending (false) {
+    assert (false);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  AvailabilityStatusTable::~AvailabilityStatusTable() {
+    clear();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void AvailabilityStatusTable::
+  reserve (const SegmentDateID_T& iNbOfSegmentDates,
+           const ClassCodeID_T& iNbOfClassCodes) {
+    const StatusBlock* lFormerBlock_ptr = _block_ptr.load();
+    SegmentDateID_T lNbOfSegmentDates = iNbOfSegmentDates;
+    ClassCodeID_T lNbOfClassCodes = iNbOfClassCodes;
+    if (lFormerBlock_ptr != NULL) {
+      if (iNbOfSegmentDates <= lFormerBlock_ptr->_nbOfSegmentDates
+          && iNbOfClassCodes <= lFormerBlock_ptr->_nbOfClassCodes) {
+        // The former blocks may no longer be read
+        if (_blockList.size() > 1) {
+          reclaimBlocks();
+        }
+        return;
+      }
+
+      // Grow geometrically (in either dimension), so that few blocks are
+      // ever built
+      const SegmentDateID_T& lFormerNbOfSegmentDates =
+        lFormerBlock_ptr->_nbOfSegmentDates;
+      if (lNbOfSegmentDates <= lFormerNbOfSegmentDates) {
+        lNbOfSegmentDates = lFormerNbOfSegmentDates;
+      } else if (lNbOfSegmentDates < 2 * lFormerNbOfSegmentDates) {
+        lNbOfSegmentDates = 2 * lFormerNbOfSegmentDates;
+      }
+      const ClassCodeID_T& lFormerNbOfClassCodes =
+        lFormerBlock_ptr->_nbOfClassCodes;
+      if (lNbOfClassCodes <= lFormerNbOfClassCodes) {
+        lNbOfClassCodes = lFormerNbOfClassCodes;
+      } else if (lNbOfClassCodes < 2 * lFormerNbOfClassCodes) {
+        lNbOfClassCodes = 2 * lFormerNbOfClassCodes;
+      }
+    }
+
+    // Build the new block, with the statuses of the former one
+    StatusBlock* lBlock_ptr = new StatusBlock();
+    lBlock_ptr->_nbOfSegmentDates = lNbOfSegmentDates;
+    lBlock_ptr->_nbOfClassCodes = lNbOfClassCodes;
+    const std::size_t lNbOfStatuses =
+      static_cast<std::size_t> (lNbOfSegmentDates) * lNbOfClassCodes;
+    lBlock_ptr->_statusArray =
+      new std::atomic<AvailabilityStatus_T>[lNbOfStatuses];
+    lBlock_ptr->_pushedFlagArray = new std::atomic<bool>[lNbOfSegmentDates];
+    for (SegmentDateID_T lSegmentID = 0; lSegmentID != lNbOfSegmentDates;
+         ++lSegmentID) {
+      const bool hasFormerRow = (lFormerBlock_ptr != NULL
+                                 && lSegmentID
+                                 < lFormerBlock_ptr->_nbOfSegmentDates);
+      lBlock_ptr->_pushedFlagArray[lSegmentID].
+        store (hasFormerRow == true
+               && lFormerBlock_ptr->_pushedFlagArray[lSegmentID].load());
+
+      for (ClassCodeID_T lClassID = 0; lClassID != lNbOfClassCodes;
+           ++lClassID) {
+        AvailabilityStatus_T lStatus = K_UNKNOWN_STATUS;
+        if (hasFormerRow == true
+            && lClassID < lFormerBlock_ptr->_nbOfClassCodes) {
+          lStatus = lFormerBlock_ptr->
+            _statusArray[static_cast<std::size_t> (lSegmentID)
+                         * lFormerBlock_ptr->_nbOfClassCodes
+                         + lClassID].load();
+        }
+        lBlock_ptr->_statusArray[static_cast<std::size_t> (lSegmentID)
+                                 * lNbOfClassCodes + lClassID].store (lStatus);
+      }
+    }
+
+    // Publish it; the former one may still be read, and is given back
+    // only once no reader is left
+    _blockList.push_back (lBlock_ptr);
+    _block_ptr.store (lBlock_ptr);
+    reclaimBlocks();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void AvailabilityStatusTable::reclaimBlocks() {
+    /**
+     * A reader registers itself before loading the current block. Hence,
+     * when no reader is registered once the current block has been
+     * published, the readers to come can only see the current block.
+     */
+    if (_nbOfReaders.load() != 0) {
+      return;
+    }
+
+    assert (_blockList.empty() == false);
+    StatusBlockList_T::iterator itCurrent = _blockList.end();
+    --itCurrent;
+    for (StatusBlockList_T::iterator itBlock = _blockList.begin();
+         itBlock != itCurrent; ++itBlock) {
+      deleteBlock (*itBlock);
+    }
+    _blockList.erase (_blockList.begin(), itCurrent);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void AvailabilityStatusTable::deleteBlock (StatusBlock* ioBlock_ptr) {
+    assert (ioBlock_ptr != NULL);
+    delete[] ioBlock_ptr->_statusArray;
+    delete[] ioBlock_ptr->_pushedFlagArray;
+    delete ioBlock_ptr;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void AvailabilityStatusTable::
+  setStatus (const SegmentDateID_T& iSegmentID, const ClassCodeID_T& iClassID,
+             const stdair::Availability_T& iAvailability) {
+    reserve (iSegmentID + 1, iClassID + 1);
+    const StatusBlock* lBlock_ptr = _block_ptr.load();
+    assert (lBlock_ptr != NULL);
+
+    AvailabilityStatus_T lStatus = 0;
+    if (iAvailability >= K_MAX_STATUS) {
+      lStatus = K_MAX_STATUS;
+    } else if (iAvailability > 0) {
+      lStatus = static_cast<AvailabilityStatus_T> (iAvailability);
+    }
+    const std::size_t lIndex =
+      static_cast<std::size_t> (iSegmentID) * lBlock_ptr->_nbOfClassCodes
+      + iClassID;
+    lBlock_ptr->_statusArray[lIndex].store (lStatus);
+    lBlock_ptr->_pushedFlagArray[iSegmentID].store (true);
+
+    ++_nbOfPushes;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void AvailabilityStatusTable::
+  clearSegmentDate (const SegmentDateID_T& iSegmentID) {
+    const StatusBlock* lBlock_ptr = _block_ptr.load();
+    if (lBlock_ptr == NULL || iSegmentID >= lBlock_ptr->_nbOfSegmentDates) {
+      return;
+    }
+
+    lBlock_ptr->_pushedFlagArray[iSegmentID].store (false);
+    const std::size_t lFirstIndex =
+      static_cast<std::size_t> (iSegmentID) * lBlock_ptr->_nbOfClassCodes;
+    for (ClassCodeID_T lClassID = 0;
+         lClassID != lBlock_ptr->_nbOfClassCodes; ++lClassID) {
+      lBlock_ptr->_statusArray[lFirstIndex + lClassID].
+        store (K_UNKNOWN_STATUS);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void AvailabilityStatusTable::resetStatuses() {
+    const StatusBlock* lBlock_ptr = _block_ptr.load();
+    if (lBlock_ptr == NULL) {
+      return;
+    }
+
+    for (SegmentDateID_T lSegmentID = 0;
+         lSegmentID != lBlock_ptr->_nbOfSegmentDates; ++lSegmentID) {
+      clearSegmentDate (lSegmentID);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void AvailabilityStatusTable::
+  setPushInterval (const unsigned int iPushInterval) {
+    _pushInterval = (iPushInterval > 0) ? iPushInterval : 1;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool AvailabilityStatusTable::
+  addPendingSegmentDate (const SegmentDateID_T& iSegmentID) {
+    if (_isFullPushPending == false) {
+      _pendingSegmentDateList.push_back (iSegmentID);
+    }
+    ++_nbOfPendingChanges;
+    return (_nbOfPendingChanges >= _pushInterval);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool AvailabilityStatusTable::addPendingFullPush() {
+    // All the segment-dates are to be pushed anyway
+    _isFullPushPending = true;
+    _pendingSegmentDateList.clear();
+    ++_nbOfPendingChanges;
+    return (_nbOfPendingChanges >= _pushInterval);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void AvailabilityStatusTable::clearPendingPushes() {
+    _pendingSegmentDateList.clear();
+    _isFullPushPending = false;
+    _nbOfPendingChanges = 0;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  std::size_t AvailabilityStatusTable::getNbOfStatuses() const {
+    const ReaderScope lReaderScope (_nbOfReaders);
+    const StatusBlock* lBlock_ptr = _block_ptr.load();
+    if (lBlock_ptr == NULL) {
+      return 0;
+    }
+
+    std::size_t oNbOfStatuses = 0;
+    const std::size_t lNbOfStatuses =
+      static_cast<std::size_t> (lBlock_ptr->_nbOfSegmentDates)
+      * lBlock_ptr->_nbOfClassCodes;
+    for (std::size_t idx = 0; idx != lNbOfStatuses; ++idx) {
+      if (lBlock_ptr->_statusArray[idx].load() != K_UNKNOWN_STATUS) {
+        ++oNbOfStatuses;
+      }
+    }
+    return oNbOfStatuses;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  std::size_t AvailabilityStatusTable::getNbOfBytes() const {
+    std::size_t oNbOfBytes = sizeof (AvailabilityStatusTable)
+      + _blockList.capacity() * sizeof (StatusBlock*)
+      + _pendingSegmentDateList.capacity() * sizeof (SegmentDateID_T);
+    for (StatusBlockList_T::const_iterator itBlock = _blockList.begin();
+         itBlock != _blockList.end(); ++itBlock) {
+      const StatusBlock* lBlock_ptr = *itBlock;
+      assert (lBlock_ptr != NULL);
+      oNbOfBytes += sizeof (StatusBlock)
+        + static_cast<std::size_t> (lBlock_ptr->_nbOfSegmentDates)
+        * (lBlock_ptr->_nbOfClassCodes
+           * sizeof (std::atomic<AvailabilityStatus_T>)
+           + sizeof (std::atomic<bool>));
+    }
+    return oNbOfBytes;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void AvailabilityStatusTable::clear() {
+    _block_ptr.store (NULL);
+    for (StatusBlockList_T::iterator itBlock = _blockList.begin();
+         itBlock != _blockList.end(); ++itBlock) {
+      deleteBlock (*itBlock);
+    }
+    _blockList.clear();
+    clearPendingPushes();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string AvailabilityStatusTable::describe() const {
+    unsigned int lNbOfSegmentDates = 0;
+    const ReaderScope lReaderScope (_nbOfReaders);
+    const StatusBlock* lBlock_ptr = _block_ptr.load();
+    if (lBlock_ptr != NULL) {
+      for (SegmentDateID_T lSegmentID = 0;
+           lSegmentID != lBlock_ptr->_nbOfSegmentDates; ++lSegmentID) {
+        if (lBlock_ptr->_pushedFlagArray[lSegmentID].load() == true) {
+          ++lNbOfSegmentDates;
+        }
+      }
+    }
+
+    std::ostringstream oStr;
+    oStr << "AVS table: " << lNbOfSegmentDates << " segment-dates, "
+         << _nbOfPushes << " availability statuses pushed so far, "
+         << _nbOfPendingChanges << " inventory changes pending";
+    return oStr.str();
+  }
+
+}
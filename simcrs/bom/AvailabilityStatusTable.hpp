@@ -0,0 +1,293 @@
+#ifndef __SIMCRS_BOM_AVAILABILITYSTATUSTABLE_HPP
+#define __SIMCRS_BOM_AVAILABILITYSTATUSTABLE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+
+namespace SIMCRS {
+
+  /**
+   * @brief Availability status (AVS) table of the CRS, i.e., the
+   * availability of the booking classes, as last pushed by the airline
+   * inventory.
+   *
+   * The table is indexed by the interned identifiers of the segment-dates
+   * and booking class codes, so that an availability look-up is a mere
+   * array indexing, without any lock nor any call to the airline
+   * inventory.
+   *
+   * The statuses are held within a single block, sized from the number
+   * of segment-dates and booking class codes known when the table is
+   * (re-)built (see reserve()). When it has to grow, a larger block
+   * (twice as large in the dimension which is exceeded) is filled and
+   * then published (by an atomic pointer swap): a reader never sees the
+   * storage move under its feet, and the pushes (made by one thread at a
+   * time) may go on while the table is read. The readers register
+   * themselves (by an atomic counter) while they read, and the former
+   * blocks are given back by the pushes as soon as no reader is left.
+   *
+   * The pushes may also be deferred (see setPushInterval()): the changed
+   * segment-dates are then recorded as pending, and their availability
+   * is pushed in one batch, every given number of inventory changes.
+   * Meanwhile, the table serves the former (stale) availability.
+   */
+  class AvailabilityStatusTable {
+  public:
+    // ///////////////// Getters ///////////////////
+    /**
+     * State whether the availability of the given segment-date has
+     * been pushed.
+     */
+    bool hasSegmentDate (const SegmentDateID_T& iSegmentID) const {
+      const ReaderScope lReaderScope (_nbOfReaders);
+      const StatusBlock* lBlock_ptr = _block_ptr.load();
+      return (lBlock_ptr != NULL
+              && iSegmentID < lBlock_ptr->_nbOfSegmentDates
+              && lBlock_ptr->_pushedFlagArray[iSegmentID].load() == true);
+    }
+
+    /**
+     * Get the availability status of the given booking class.
+     *
+     * @return AvailabilityStatus_T The availability status, or
+     *         K_UNKNOWN_STATUS when that booking class has not been pushed.
+     */
+    AvailabilityStatus_T getStatus (const SegmentDateID_T& iSegmentID,
+                                    const ClassCodeID_T& iClassID) const {
+      const ReaderScope lReaderScope (_nbOfReaders);
+      const StatusBlock* lBlock_ptr = _block_ptr.load();
+      if (lBlock_ptr == NULL || iSegmentID >= lBlock_ptr->_nbOfSegmentDates
+          || iClassID >= lBlock_ptr->_nbOfClassCodes) {
+        return K_UNKNOWN_STATUS;
+      }
+      const std::size_t lIndex =
+        static_cast<std::size_t> (iSegmentID) * lBlock_ptr->_nbOfClassCodes
+        + iClassID;
+      return lBlock_ptr->_statusArray[lIndex].load();
+    }
+
+    /**
+     * Get the number of availability statuses pushed so far.
+     */
+    unsigned long getNbOfPushes() const {
+      return _nbOfPushes;
+    }
+
+    /**
+     * Get the number of availability statuses currently held.
+     */
+    std::size_t getNbOfStatuses() const;
+
+    /**
+     * Get the (approximate) number of bytes held by the table.
+     */
+    std::size_t getNbOfBytes() const;
+
+    /**
+     * Get the number of inventory changes after which the pending pushes
+     * are made.
+     */
+    unsigned int getPushInterval() const {
+      return _pushInterval;
+    }
+
+    /**
+     * Get the number of inventory changes not pushed yet.
+     */
+    unsigned int getNbOfPendingChanges() const {
+      return _nbOfPendingChanges;
+    }
+
+    /**
+     * Get the list of the segment-dates changed since the last pushes
+     * (possibly with duplicates).
+     */
+    const std::vector<SegmentDateID_T>& getPendingSegmentDateList() const {
+      return _pendingSegmentDateList;
+    }
+
+    /**
+     * State whether all the segment-dates have to be pushed again (e.g.,
+     * after an optimisation).
+     */
+    bool isFullPushPending() const {
+      return _isFullPushPending;
+    }
+
+  public:
+    // ///////////////// Business Methods ///////////////////
+    /**
+     * Make room for (at least) the given numbers of segment-dates and of
+     * booking class codes.
+     */
+    void reserve (const SegmentDateID_T& iNbOfSegmentDates,
+                  const ClassCodeID_T& iNbOfClassCodes);
+
+    /**
+     * Push the availability of a booking class. The availability is
+     * truncated to an integral number of seats (negative availabilities,
+     * in case of over-booking, being reported as 0).
+     */
+    void setStatus (const SegmentDateID_T&, const ClassCodeID_T&,
+                    const stdair::Availability_T&);
+
+    /**
+     * Forget the availability statuses of the given segment-date.
+     */
+    void clearSegmentDate (const SegmentDateID_T&);
+
+    /**
+     * Forget the availability statuses of all the segment-dates, keeping
+     * the storage (so that it may still be read meanwhile).
+     */
+    void resetStatuses();
+
+    /**
+     * Set the number of inventory changes after which the pending pushes
+     * are made (1, the default, meaning at once).
+     */
+    void setPushInterval (const unsigned int);
+
+    /**
+     * Record a change of the given segment-date, to be pushed later.
+     *
+     * @return bool Whether the pending pushes are now due.
+     */
+    bool addPendingSegmentDate (const SegmentDateID_T&);
+
+    /**
+     * Record a change of (possibly) all the segment-dates, to be pushed
+     * later.
+     *
+     * @return bool Whether the pending pushes are now due.
+     */
+    bool addPendingFullPush();
+
+    /**
+     * Forget the pending pushes, once made.
+     */
+    void clearPendingPushes();
+
+    /**
+     * Forget all the availability statuses, and give the storage back.
+     * The table must not be read meanwhile (e.g., it is cleared when
+     * the BOM tree is rebuilt).
+     */
+    void clear();
+
+  public:
+    // /////////////// Display Methods /////////////////
+    /**
+     * Short display of the table.
+     */
+    const std::string describe() const;
+
+  public:
+    // //////////// Constructors and Destructors /////////////
+    /**
+     * Default constructor.
+     */
+    AvailabilityStatusTable();
+
+    /**
+     * Destructor.
+     */
+    ~AvailabilityStatusTable();
+
+  private:
+    /**
+     * Copy constructor (not to be used).
+     */
+    AvailabilityStatusTable (const AvailabilityStatusTable&);
+
+  private:
+    // //////////////// Support Methods ///////////////////
+    /**
+     * Give back the former blocks, when no reader may still read them.
+     */
+    void reclaimBlocks();
+
+  public:
+    /** Status of the booking classes not pushed (yet). */
+    static const AvailabilityStatus_T K_UNKNOWN_STATUS;
+
+    /** Highest availability status which can be held. */
+    static const AvailabilityStatus_T K_MAX_STATUS;
+
+  private:
+    // /////////////// Type definitions /////////////////
+    /** Block of statuses, indexed by segment-date identifier and then by
+        class code identifier. */
+    struct StatusBlock {
+      /** Number of segment-dates (rows). */
+      SegmentDateID_T _nbOfSegmentDates;
+      /** Number of booking class codes (columns). */
+      ClassCodeID_T _nbOfClassCodes;
+      /** Statuses. */
+      std::atomic<AvailabilityStatus_T>* _statusArray;
+      /** Whether the availability of each segment-date has been pushed. */
+      std::atomic<bool>* _pushedFlagArray;
+    };
+
+    /** List of the blocks (the current one being the last one). */
+    typedef std::vector<StatusBlock*> StatusBlockList_T;
+
+    /** Registration of a reader, for the lifetime of the scope. */
+    class ReaderScope {
+    public:
+      explicit ReaderScope (std::atomic<unsigned int>& ioNbOfReaders)
+        : _nbOfReaders (ioNbOfReaders) {
+        ++_nbOfReaders;
+      }
+      ~ReaderScope() {
+        --_nbOfReaders;
+      }
+    private:
+      ReaderScope (const ReaderScope&);
+      std::atomic<unsigned int>& _nbOfReaders;
+    };
+
+    /** Give back the storage of the given block. */
+    static void deleteBlock (StatusBlock*);
+
+  private:
+    // //////////////// Attributes ///////////////////
+    /** Current block of statuses, read without any lock. */
+    std::atomic<const StatusBlock*> _block_ptr;
+
+    /** All the blocks, the former ones being kept as long as they may
+        still be read. */
+    StatusBlockList_T _blockList;
+
+    /** Number of readers currently reading the table. */
+    mutable std::atomic<unsigned int> _nbOfReaders;
+
+    /** Number of availability statuses pushed so far. */
+    unsigned long _nbOfPushes;
+
+    /** Number of inventory changes after which the pending pushes are
+        made. */
+    unsigned int _pushInterval;
+
+    /** Number of inventory changes not pushed yet. */
+    unsigned int _nbOfPendingChanges;
+
+    /** Segment-dates changed since the last pushes. */
+    std::vector<SegmentDateID_T> _pendingSegmentDateList;
+
+    /** Whether all the segment-dates have to be pushed again. */
+    bool _isFullPushPending;
+  };
+
+}
+#endif // __SIMCRS_BOM_AVAILABILITYSTATUSTABLE_HPP
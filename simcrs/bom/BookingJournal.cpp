@@ -0,0 +1,431 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+// POSIX
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+// StdAir
+#include <stdair/stdair_exceptions.hpp>
+#include <stdair/service/Logger.hpp>
+// SimCRS
+#include <simcrs/basic/BasConst_General.hpp>
+#include <simcrs/bom/BookingJournal.hpp>
+
+namespace SIMCRS {
+
+  namespace {
+    /** Signature starting the journal files. */
+    const char K_JOURNAL_SIGNATURE[] = "SIMCRSJ1";
+
+    /** Size (in bytes) of the signature. */
+    const std::size_t K_JOURNAL_SIGNATURE_SIZE = 8;
+
+    /** Size (in bytes) of the fixed part of a record payload. */
+    const std::size_t K_RECORD_FIXED_SIZE =
+      sizeof (char) + sizeof (double) + sizeof (std::uint16_t)
+      + sizeof (std::uint8_t);
+
+    /** Checksum (FNV-1a) of the given bytes. */
+    std::uint32_t checksum (const char* iData_ptr, const std::size_t iSize) {
+      std::uint32_t oHash = 2166136261U;
+      for (std::size_t idx = 0; idx != iSize; ++idx) {
+        oHash ^= static_cast<unsigned char> (iData_ptr[idx]);
+        oHash *= 16777619U;
+      }
+      return oHash;
+    }
+
+    /** Append the bytes of the given value to the given buffer. */
+    template <typename VALUE>
+    void appendValue (const VALUE& iValue, std::string& ioBuffer) {
+      ioBuffer.append (reinterpret_cast<const char*> (&iValue),
+                       sizeof (VALUE));
+    }
+
+    /** Read a value at the given position of the given content. */
+    template <typename VALUE>
+    VALUE readValue (const std::string_view& iContent,
+                     const std::size_t iPosition) {
+      VALUE oValue;
+      std::memcpy (&oValue, iContent.data() + iPosition, sizeof (VALUE));
+      return oValue;
+    }
+
+    /** Write the whole given buffer into the given file. */
+    bool writeAll (const int iFileDescriptor, const std::string& iBuffer) {
+      const char* lData_ptr = iBuffer.data();
+      std::size_t lLeft = iBuffer.size();
+      while (lLeft != 0) {
+        const ssize_t lWritten = ::write (iFileDescriptor, lData_ptr, lLeft);
+        if (lWritten < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          return false;
+        }
+        lData_ptr += lWritten;
+        lLeft -= static_cast<std::size_t> (lWritten);
+      }
+      return true;
+    }
+
+    /** Time elapsed (in seconds) since the given time point. */
+    double elapsedSince (const std::chrono::steady_clock::time_point& iStart) {
+      const std::chrono::duration<double> lElapsed =
+        std::chrono::steady_clock::now() - iStart;
+      return lElapsed.count();
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  BookingJournal::BookingJournal()
+    : _fileDescriptor (-1), _isOpen (false),
+      _commitInterval (DEFAULT_JOURNAL_COMMIT_INTERVAL),
+      _nbOfPendingRecords (0), _appendedSequence (0), _committedSequence (0),
+      _flushSequence (0), _isStopping (false) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  BookingJournal::BookingJournal (const BookingJournal&)
+    : _fileDescriptor (-1), _isOpen (false), _commitInterval (0),
+      _nbOfPendingRecords (0), _appendedSequence (0), _committedSequence (0),
+      _flushSequence (0), _isStopping (false) {
+    assert (false);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  BookingJournal::~BookingJournal() {
+    close();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool BookingJournal::isOpen() const {
+    return _isOpen.load();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  JournalStatsStruct BookingJournal::getStats() const {
+    std::lock_guard<std::mutex> lLock (_mutex);
+    return _stats;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  std::string_view BookingJournal::getSignature() {
+    return std::string_view (K_JOURNAL_SIGNATURE, K_JOURNAL_SIGNATURE_SIZE);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BookingJournal::open (const stdair::Filename_T& iFilename,
+                             const unsigned int iCommitInterval) {
+    // A journal already open is closed first
+    close();
+
+    const int lFileDescriptor =
+      ::open (iFilename.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (lFileDescriptor < 0) {
+      std::ostringstream oMessage;
+      oMessage << "The booking journal '" << iFilename
+               << "' can not be opened for writing";
+      STDAIR_LOG_ERROR (oMessage.str());
+      throw stdair::FileNotFoundException (oMessage.str());
+    }
+
+    // A new journal starts with the signature; an existing one must
+    // start with it
+    struct stat lFileStatus;
+    const bool isEmpty = (::fstat (lFileDescriptor, &lFileStatus) == 0
+                          && lFileStatus.st_size == 0);
+    char lSignature[K_JOURNAL_SIGNATURE_SIZE];
+    const bool isValid = (isEmpty == true
+                          ? (writeAll (lFileDescriptor,
+                                       std::string (getSignature()))
+                             && ::fdatasync (lFileDescriptor) == 0)
+                          : (::pread (lFileDescriptor, lSignature,
+                                      K_JOURNAL_SIGNATURE_SIZE, 0)
+                             == static_cast<ssize_t> (K_JOURNAL_SIGNATURE_SIZE)
+                             && getSignature()
+                             == std::string_view (lSignature,
+                                                  K_JOURNAL_SIGNATURE_SIZE)));
+    if (isValid == false) {
+      ::close (lFileDescriptor);
+      std::ostringstream oMessage;
+      oMessage << "The file '" << iFilename << "' is not a booking journal";
+      STDAIR_LOG_ERROR (oMessage.str());
+      throw stdair::ParserException (oMessage.str());
+    }
+
+    {
+      std::lock_guard<std::mutex> lLock (_mutex);
+      _filename = iFilename;
+      _fileDescriptor = lFileDescriptor;
+      _commitInterval = iCommitInterval;
+      _stats = JournalStatsStruct();
+      _isStopping = false;
+      _isOpen = true;
+    }
+    _writerThread = std::thread (&BookingJournal::runWriter, this);
+
+    STDAIR_LOG_DEBUG ("The booking journal '" << iFilename
+                      << "' is open, with a commit interval of "
+                      << iCommitInterval << " ms");
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BookingJournal::append (const JournalRecordStruct& iRecord) {
+    if (_isOpen.load() == false) {
+      return;
+    }
+    const std::chrono::steady_clock::time_point lStart =
+      std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lLock (_mutex);
+    if (_fileDescriptor < 0) {
+      return;
+    }
+    serialise (iRecord, _pendingBuffer);
+    ++_nbOfPendingRecords;
+    ++_appendedSequence;
+    ++_stats._nbOfRecords;
+
+    // A large group is committed without waiting for the interval
+    if (_pendingBuffer.size() >= DEFAULT_JOURNAL_GROUP_COMMIT_SIZE) {
+      _writerCondition.notify_one();
+    }
+    _stats._appendTime += elapsedSince (lStart);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BookingJournal::flush() {
+    std::unique_lock<std::mutex> lLock (_mutex);
+    if (_fileDescriptor < 0) {
+      return;
+    }
+
+    const unsigned long lTargetSequence = _appendedSequence;
+    if (_flushSequence < lTargetSequence) {
+      _flushSequence = lTargetSequence;
+      _writerCondition.notify_one();
+    }
+    _commitCondition.wait (lLock, [this, lTargetSequence] {
+        return (_committedSequence >= lTargetSequence);
+      });
+
+    if (_stats._nbOfFailedCommits != 0) {
+      std::ostringstream oMessage;
+      oMessage << "The booking journal '" << _filename << "' is incomplete: "
+               << _stats._nbOfFailedCommits << " commit(s) have failed";
+      throw stdair::RootException (oMessage.str());
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BookingJournal::close() {
+    {
+      std::lock_guard<std::mutex> lLock (_mutex);
+      if (_fileDescriptor < 0) {
+        return;
+      }
+      _isStopping = true;
+      _isOpen = false;
+      _writerCondition.notify_one();
+    }
+
+    // The writer commits the pending records before stopping; when it
+    // has been suspended, they are committed by the calling thread
+    if (_writerThread.joinable() == true) {
+      _writerThread.join();
+    } else {
+      runWriter();
+    }
+
+    std::lock_guard<std::mutex> lLock (_mutex);
+    ::close (_fileDescriptor);
+    _fileDescriptor = -1;
+    _filename.clear();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BookingJournal::suspendWriter() {
+    {
+      std::lock_guard<std::mutex> lLock (_mutex);
+      if (_fileDescriptor < 0 || _writerThread.joinable() == false) {
+        return;
+      }
+      _isStopping = true;
+      _writerCondition.notify_one();
+    }
+
+    // The writer commits the pending records before stopping
+    _writerThread.join();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BookingJournal::resumeWriter() {
+    std::lock_guard<std::mutex> lLock (_mutex);
+    if (_fileDescriptor < 0 || _writerThread.joinable() == true) {
+      return;
+    }
+    _isStopping = false;
+    _writerThread = std::thread (&BookingJournal::runWriter, this);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BookingJournal::lockBeforeFork() {
+    _mutex.lock();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BookingJournal::unlockAfterFork() {
+    _mutex.unlock();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BookingJournal::detachAfterFork() {
+    // The lock has been taken, when forking, by the thread which the
+    // child is a copy of
+    _isOpen = false;
+    _fileDescriptor = -1;
+    _pendingBuffer.clear();
+    _nbOfPendingRecords = 0;
+    _mutex.unlock();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BookingJournal::runWriter() {
+    std::string lCommitBuffer;
+
+    std::unique_lock<std::mutex> lLock (_mutex);
+    while (true) {
+      if (_pendingBuffer.empty() == true) {
+        if (_isStopping == true) {
+          break;
+        }
+        _writerCondition.wait (lLock);
+        continue;
+      }
+
+      // Let the group grow during the commit interval, unless the
+      // records are awaited, or the group is already large enough
+      const std::chrono::milliseconds lCommitInterval (_commitInterval);
+      _writerCondition.wait_for (lLock, lCommitInterval, [this] {
+          return (_isStopping == true
+                  || _flushSequence > _committedSequence
+                  || (_pendingBuffer.size()
+                      >= DEFAULT_JOURNAL_GROUP_COMMIT_SIZE));
+        });
+
+      // Take the group over, and commit it without holding the mutex
+      lCommitBuffer.swap (_pendingBuffer);
+      const unsigned long lNbOfRecords = _nbOfPendingRecords;
+      const unsigned long lSequence = _appendedSequence;
+      _nbOfPendingRecords = 0;
+      const int lFileDescriptor = _fileDescriptor;
+      lLock.unlock();
+
+      const std::chrono::steady_clock::time_point lStart =
+        std::chrono::steady_clock::now();
+      const bool isCommitted = (writeAll (lFileDescriptor, lCommitBuffer)
+                                && ::fdatasync (lFileDescriptor) == 0);
+      const double lCommitTime = elapsedSince (lStart);
+
+      lLock.lock();
+      if (isCommitted == true) {
+        ++_stats._nbOfCommits;
+        _stats._nbOfCommittedRecords += lNbOfRecords;
+        _stats._nbOfBytes += lCommitBuffer.size();
+      } else {
+        // The logger can not be used from this thread: the failure is
+        // reported by the next flush
+        ++_stats._nbOfFailedCommits;
+      }
+      _stats._commitTime += lCommitTime;
+      _committedSequence = lSequence;
+      _commitCondition.notify_all();
+      lCommitBuffer.clear();
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BookingJournal::serialise (const JournalRecordStruct& iRecord,
+                                  std::string& ioBuffer) {
+    const std::uint16_t lKeySize =
+      static_cast<std::uint16_t> (iRecord._segmentDateKey.size());
+    const std::uint8_t lClassCodeSize =
+      static_cast<std::uint8_t> (iRecord._classCode.size());
+    const std::uint32_t lPayloadSize =
+      static_cast<std::uint32_t> (K_RECORD_FIXED_SIZE + lKeySize
+                                  + lClassCodeSize);
+    const double lPartySize = iRecord._partySize;
+
+    appendValue (lPayloadSize, ioBuffer);
+    const std::size_t lPayloadPosition = ioBuffer.size();
+    ioBuffer.push_back (iRecord._recordType);
+    appendValue (lPartySize, ioBuffer);
+    appendValue (lKeySize, ioBuffer);
+    ioBuffer.append (iRecord._segmentDateKey, 0, lKeySize);
+    appendValue (lClassCodeSize, ioBuffer);
+    ioBuffer.append (iRecord._classCode, 0, lClassCodeSize);
+    const std::uint32_t lChecksum =
+      checksum (ioBuffer.data() + lPayloadPosition, lPayloadSize);
+    appendValue (lChecksum, ioBuffer);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool BookingJournal::deserialise (std::string_view& ioContent,
+                                    JournalRecordStruct& ioRecord) {
+    // Payload size
+    const std::size_t lSizeSize = sizeof (std::uint32_t);
+    if (ioContent.size() < lSizeSize) {
+      return false;
+    }
+    const std::uint32_t lPayloadSize =
+      readValue<std::uint32_t> (ioContent, 0);
+    const std::size_t lRecordSize = lSizeSize + lPayloadSize + lSizeSize;
+    if (lPayloadSize < K_RECORD_FIXED_SIZE || ioContent.size() < lRecordSize) {
+      return false;
+    }
+
+    // Checksum
+    const std::string_view lPayload = ioContent.substr (lSizeSize,
+                                                        lPayloadSize);
+    const std::uint32_t lChecksum =
+      readValue<std::uint32_t> (ioContent, lSizeSize + lPayloadSize);
+    if (checksum (lPayload.data(), lPayload.size()) != lChecksum) {
+      return false;
+    }
+
+    // Fields
+    std::size_t lPosition = 0;
+    ioRecord._recordType = lPayload[lPosition];
+    lPosition += sizeof (char);
+    ioRecord._partySize = readValue<double> (lPayload, lPosition);
+    lPosition += sizeof (double);
+    const std::uint16_t lKeySize =
+      readValue<std::uint16_t> (lPayload, lPosition);
+    lPosition += sizeof (std::uint16_t);
+    if (lPosition + lKeySize + sizeof (std::uint8_t) > lPayload.size()) {
+      return false;
+    }
+    ioRecord._segmentDateKey.assign (lPayload.data() + lPosition, lKeySize);
+    lPosition += lKeySize;
+    const std::uint8_t lClassCodeSize =
+      readValue<std::uint8_t> (lPayload, lPosition);
+    lPosition += sizeof (std::uint8_t);
+    if (lPosition + lClassCodeSize != lPayload.size()) {
+      return false;
+    }
+    ioRecord._classCode.assign (lPayload.data() + lPosition, lClassCodeSize);
+
+    ioContent.remove_prefix (lRecordSize);
+    return true;
+  }
+
+}
@@ -0,0 +1,244 @@
+#ifndef __SIMCRS_BOM_BOOKINGJOURNAL_HPP
+#define __SIMCRS_BOM_BOOKINGJOURNAL_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+
+namespace SIMCRS {
+
+  /**
+   * @brief Record of the booking journal: a sell or a cancellation of
+   * seats of a booking class of a segment-date.
+   */
+  struct JournalRecordStruct {
+    /** Type of the record: SELL ('S') or CANCELLATION ('C'). */
+    char _recordType;
+    /** Key of the segment-date (e.g., "SQ;12,2011-Jan-31;SIN,BKK;08:20"). */
+    std::string _segmentDateKey;
+    /** Code of the booking class (e.g., "Y"). */
+    stdair::ClassCode_T _classCode;
+    /** Number of seats sold or cancelled. */
+    stdair::PartySize_T _partySize;
+
+    /** Record types. */
+    static const char SELL = 'S';
+    static const char CANCELLATION = 'C';
+  };
+
+  /**
+   * @brief Append-only, binary journal of the sells and cancellations
+   * made through SimCRS, from which the inventory state may be rebuilt
+   * after a restart (see JournalManager).
+   *
+   * The records are appended, on the sell and cancellation paths, to an
+   * in-memory buffer only. A background writer commits them to disk by
+   * groups: it waits for the commit interval (or for the buffer to
+   * exceed the group commit size), then writes the whole group, and
+   * synchronises the file once (fdatasync) for all its records.
+   *
+   * The journal starts with an 8-byte signature ("SIMCRSJ1"). Every
+   * record is made, in the native byte order, of its (32-bit) payload
+   * size, of its payload (record type, party size, segment-date key and
+   * class code) and of a (32-bit) checksum of the payload, so that an
+   * incomplete record, written when the process crashed, is detected.
+   */
+  class BookingJournal {
+  public:
+    // ///////////////// Getters ///////////////////
+    /**
+     * State whether the journal is open.
+     */
+    bool isOpen() const;
+
+    /**
+     * Get the name of the journal file (empty when it is not open).
+     */
+    const stdair::Filename_T& getFilename() const {
+      return _filename;
+    }
+
+    /**
+     * Get the statistics of the journal, since it has been opened.
+     */
+    JournalStatsStruct getStats() const;
+
+  public:
+    // ///////////////// Business Methods ///////////////////
+    /**
+     * Open (or create) the given journal file, the new records being
+     * appended to the former ones, and start the background writer.
+     *
+     * @param const stdair::Filename_T& Name of the journal file.
+     * @param const unsigned int Commit interval, in milliseconds.
+     * @exception stdair::FileNotFoundException The file can not be
+     *            opened for writing.
+     * @exception stdair::ParserException The file is not a journal.
+     */
+    void open (const stdair::Filename_T&, const unsigned int iCommitInterval);
+
+    /**
+     * Append a record. The record is durable only once committed (see
+     * flush()).
+     */
+    void append (const JournalRecordStruct&);
+
+    /**
+     * Wait until all the records appended so far have been committed.
+     *
+     * @exception stdair::RootException A commit has failed.
+     */
+    void flush();
+
+    /**
+     * Commit the pending records, stop the background writer and close
+     * the journal file (does nothing when the journal is not open).
+     */
+    void close();
+
+    /**
+     * Commit the pending records and stop the background writer, the
+     * journal being kept open (e.g., before forking the process). The
+     * records appended meanwhile are kept pending, until the writer is
+     * started again (see resumeWriter()).
+     */
+    void suspendWriter();
+
+    /**
+     * Start the background writer again, after suspendWriter() (does
+     * nothing when the journal is not open, or when the writer is
+     * running).
+     */
+    void resumeWriter();
+
+    /**
+     * Take the lock of the journal before forking the process, so that
+     * the child does not inherit it in the middle of an append. It is
+     * then released by unlockAfterFork() (in the parent process) or by
+     * detachAfterFork() (in the child process).
+     */
+    void lockBeforeFork();
+
+    /**
+     * Release the lock taken by lockBeforeFork(), in the parent process.
+     */
+    void unlockAfterFork();
+
+    /**
+     * Detach, in a child process forked from the one having opened the
+     * journal, from that journal: the sells and cancellations of the
+     * child are no longer recorded. The journal must have been locked
+     * when forking (see lockBeforeFork()); the lock is released. The
+     * background writer does not exist in the child, which must
+     * therefore end without destroying the journal (e.g., through
+     * _exit()).
+     */
+    void detachAfterFork();
+
+  public:
+    // ///////////////// Serialisation ///////////////////
+    /**
+     * Get the signature starting the journal files.
+     */
+    static std::string_view getSignature();
+
+    /**
+     * Serialise the given record, at the end of the given buffer.
+     */
+    static void serialise (const JournalRecordStruct&, std::string&);
+
+    /**
+     * Read the record at the beginning of the given content, and remove
+     * it from that content.
+     *
+     * @return bool Whether a complete, valid record has been read.
+     */
+    static bool deserialise (std::string_view&, JournalRecordStruct&);
+
+  public:
+    // //////////// Constructors and Destructors /////////////
+    /**
+     * Default constructor (the journal is not open).
+     */
+    BookingJournal();
+
+    /**
+     * Destructor, closing the journal.
+     */
+    ~BookingJournal();
+
+  private:
+    /**
+     * Copy constructor (not to be used).
+     */
+    BookingJournal (const BookingJournal&);
+
+  private:
+    /**
+     * Loop of the background writer.
+     */
+    void runWriter();
+
+  private:
+    // //////////////// Attributes ///////////////////
+    /** Name of the journal file. */
+    stdair::Filename_T _filename;
+
+    /** File descriptor of the journal file (-1 when not open). */
+    int _fileDescriptor;
+
+    /** Whether the journal is open (read without the mutex, so that the
+        sells do not wait when there is no journal). */
+    std::atomic<bool> _isOpen;
+
+    /** Commit interval, in milliseconds. */
+    unsigned int _commitInterval;
+
+    /** Mutex protecting the attributes below. */
+    mutable std::mutex _mutex;
+
+    /** Condition signalled to the background writer. */
+    std::condition_variable _writerCondition;
+
+    /** Condition signalled when records have been committed. */
+    std::condition_variable _commitCondition;
+
+    /** Serialised records appended, not yet handed to the writer. */
+    std::string _pendingBuffer;
+
+    /** Number of records held by the pending buffer. */
+    unsigned long _nbOfPendingRecords;
+
+    /** Number of records (ever) appended. */
+    unsigned long _appendedSequence;
+
+    /** Number of records (ever) committed, or whose commit has failed. */
+    unsigned long _committedSequence;
+
+    /** Number of records to be committed without waiting any longer. */
+    unsigned long _flushSequence;
+
+    /** Whether the background writer has to stop. */
+    bool _isStopping;
+
+    /** Statistics. */
+    JournalStatsStruct _stats;
+
+    /** Background writer. */
+    std::thread _writerThread;
+  };
+
+}
+#endif // __SIMCRS_BOM_BOOKINGJOURNAL_HPP
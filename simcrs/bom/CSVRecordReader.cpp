@@ -0,0 +1,83 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cstring>
+// SimCRS
+#include <simcrs/bom/CSVRecordReader.hpp>
+
+namespace SIMCRS {
+
+  namespace {
+    /** State whether the given character is a blank. */
+    bool isBlank (const char iChar) {
+      return (iChar == ' ' || iChar == '\t' || iChar == '\r');
+    }
+
+    /** Trim the given view from its surrounding blanks. */
+    std::string_view trim (const std::string_view& iView) {
+      std::size_t lBegin = 0;
+      std::size_t lEnd = iView.size();
+      while (lBegin != lEnd && isBlank (iView[lBegin]) == true) {
+        ++lBegin;
+      }
+      while (lEnd != lBegin && isBlank (iView[lEnd - 1]) == true) {
+        --lEnd;
+      }
+      return iView.substr (lBegin, lEnd - lBegin);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  CSVRecordReader::CSVRecordReader (const std::string_view& iContent,
+                                    const char iSeparator)
+    : _content (iContent), _separator (iSeparator), _position (0),
+      _lineNumber (0) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool CSVRecordReader::next (CSVFieldList_T& ioFieldList) {
+    ioFieldList.clear();
+
+    const char* lContent_ptr = _content.data();
+    const std::size_t lContentSize = _content.size();
+    while (_position < lContentSize) {
+      // Delimit the line, without copying it
+      const char* lLineBegin_ptr = lContent_ptr + _position;
+      const std::size_t lLeft = lContentSize - _position;
+      const char* lLineEnd_ptr = static_cast<const char*>
+        (std::memchr (lLineBegin_ptr, '\n', lLeft));
+      const std::size_t lLineSize = (lLineEnd_ptr != NULL
+                                     ? lLineEnd_ptr - lLineBegin_ptr : lLeft);
+      _position += lLineSize + 1;
+      ++_lineNumber;
+
+      // Skip the blank and comment lines
+      _record = trim (std::string_view (lLineBegin_ptr, lLineSize));
+      if (_record.empty() == true || _record[0] == '#') {
+        continue;
+      }
+
+      // Split the record into its fields
+      std::size_t lFieldBegin = 0;
+      while (true) {
+        const std::size_t lFieldEnd = _record.find (_separator, lFieldBegin);
+        if (lFieldEnd == std::string_view::npos) {
+          ioFieldList.push_back (trim (_record.substr (lFieldBegin)));
+          break;
+        }
+        ioFieldList.push_back (trim (_record.substr (lFieldBegin,
+                                                     lFieldEnd
+                                                     - lFieldBegin)));
+        lFieldBegin = lFieldEnd + 1;
+      }
+      assert (ioFieldList.empty() == false);
+      return true;
+    }
+
+    _record = std::string_view();
+    return false;
+  }
+
+}
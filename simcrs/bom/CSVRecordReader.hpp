@@ -0,0 +1,83 @@
+#ifndef __SIMCRS_BOM_CSVRECORDREADER_HPP
+#define __SIMCRS_BOM_CSVRECORDREADER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstddef>
+#include <string_view>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+
+namespace SIMCRS {
+
+  /**
+   * @brief Zero-copy reader of the records of a CSV content (typically,
+   * of a MappedFile).
+   *
+   * The records are the lines of the content, except the blank ones and
+   * the ones starting with '#' (comments). Their fields are separated by
+   * the given separator, and trimmed from the surrounding blanks. Both
+   * the records and the fields are views on the content, which must
+   * therefore outlive them.
+   */
+  class CSVRecordReader {
+  public:
+    // ///////////////// Getters ///////////////////
+    /**
+     * Get the number (starting at 1) of the line of the current record.
+     */
+    unsigned int getLineNumber() const {
+      return _lineNumber;
+    }
+
+    /**
+     * Get the current record (the whole line, trimmed).
+     */
+    const std::string_view& getRecord() const {
+      return _record;
+    }
+
+  public:
+    // ///////////////// Business Methods ///////////////////
+    /**
+     * Read the next record, and split it into its fields.
+     *
+     * @param CSVFieldList_T& List to be filled (after having been
+     *        emptied) with the fields of the record.
+     * @return bool Whether a record has been read (false at the end of
+     *         the content).
+     */
+    bool next (CSVFieldList_T&);
+
+  public:
+    // //////////// Constructors and Destructors /////////////
+    /**
+     * Constructor.
+     *
+     * @param const std::string_view& Content to be read.
+     * @param const char Separator of the fields.
+     */
+    CSVRecordReader (const std::string_view&, const char iSeparator = ';');
+
+  private:
+    // //////////////// Attributes ///////////////////
+    /** Content being read. */
+    std::string_view _content;
+
+    /** Separator of the fields. */
+    char _separator;
+
+    /** Position, within the content, of the next line to be read. */
+    std::size_t _position;
+
+    /** Number of the line of the current record. */
+    unsigned int _lineNumber;
+
+    /** Current record. */
+    std::string_view _record;
+  };
+
+}
+#endif // __SIMCRS_BOM_CSVRECORDREADER_HPP
@@ -0,0 +1,116 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+// SimCRS
+#include <simcrs/basic/BasConst_General.hpp>
+#include <simcrs/bom/CodeDictionary.hpp>
+
+namespace SIMCRS {
+
+  // ////////////////////////////////////////////////////////////////////
+  CodeDictionary::CodeDictionary() {
+    assert (false);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  CodeDictionary::CodeDictionary (const std::string& iName) : _name (iName) {
+    clear();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  CodeDictionary::~CodeDictionary() {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void CodeDictionary::clear() {
+    _codeIDMap.clear();
+    _codeList.clear();
+    for (unsigned short idx = 0; idx != K_NB_OF_CHARS; ++idx) {
+      _charIDArray[idx] = DEFAULT_NULL_SYMBOL_ID;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  SymbolID_T CodeDictionary::intern (const std::string& iCode) {
+    // Check whether that code has already been interned
+    const CodeIDMap_T::const_iterator itCode = _codeIDMap.find (iCode);
+    if (itCode != _codeIDMap.end()) {
+      return itCode->second;
+    }
+
+    // Allocate the next identifier
+    const SymbolID_T oID = size();
+    _codeList.push_back (iCode);
+    _codeIDMap.insert (CodeIDMap_T::value_type (iCode, oID));
+
+    // One-character codes (e.g., booking class codes) can also be looked up
+    // directly through the look-up array
+    if (iCode.size() == 1) {
+      _charIDArray[static_cast<unsigned char> (iCode[0])] = oID;
+    }
+
+    return oID;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  SymbolID_T CodeDictionary::find (const std::string& iCode) const {
+    if (iCode.size() == 1) {
+      return find (iCode[0]);
+    }
+
+    const CodeIDMap_T::const_iterator itCode = _codeIDMap.find (iCode);
+    if (itCode == _codeIDMap.end()) {
+      return DEFAULT_NULL_SYMBOL_ID;
+    }
+    return itCode->second;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string& CodeDictionary::getCode (const SymbolID_T& iID) const {
+    if (iID >= size()) {
+      std::ostringstream oStr;
+      oStr << "The " << _name << " identifier " << iID
+           << " has not been interned by SimCRS";
+      throw SymbolNotFoundException (oStr.str());
+    }
+    return _codeList[iID];
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  std::size_t CodeDictionary::getNbOfBytes() const {
+    // Each code is held twice: by the list and (as key) by the map
+    std::size_t oNbOfBytes = sizeof (CodeDictionary)
+      + _codeList.capacity() * sizeof (std::string)
+      + _codeIDMap.bucket_count() * sizeof (void*)
+      + _codeIDMap.size() * (sizeof (CodeIDMap_T::value_type) + sizeof (void*));
+    for (CodeList_T::const_iterator itCode = _codeList.begin();
+         itCode != _codeList.end(); ++itCode) {
+      oNbOfBytes += 2 * itCode->size();
+    }
+    return oNbOfBytes;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void CodeDictionary::toStream (std::ostream& ioOut) const {
+    ioOut << describe() << ": ";
+    SymbolID_T lID = 0;
+    for (CodeList_T::const_iterator itCode = _codeList.begin();
+         itCode != _codeList.end(); ++itCode, ++lID) {
+      if (lID != 0) {
+        ioOut << ", ";
+      }
+      ioOut << *itCode << "=" << lID;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string CodeDictionary::describe() const {
+    std::ostringstream oStr;
+    oStr << _name << " codes (" << size() << ")";
+    return oStr.str();
+  }
+
+}
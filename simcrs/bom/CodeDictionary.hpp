@@ -0,0 +1,137 @@
+#ifndef __SIMCRS_BOM_CODEDICTIONARY_HPP
+#define __SIMCRS_BOM_CODEDICTIONARY_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iosfwd>
+#include <string>
+#include <vector>
+// Boost
+#include <boost/unordered_map.hpp>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+
+namespace SIMCRS {
+
+  /**
+   * @brief Dictionary turning the codes of a given kind (e.g., airport
+   * codes) into dense integer identifiers, and back.
+   *
+   * The identifiers are allocated in sequence, starting from 0, so that
+   * they can directly be used as indices within arrays. One-character
+   * codes (e.g., booking class codes) can moreover be looked up by a
+   * simple array indexing, without any hashing.
+   */
+  class CodeDictionary {
+  public:
+    // /////////////// Business Methods /////////////////
+    /**
+     * Get the identifier of the given code, allocating a new one when
+     * that code is not known yet.
+     */
+    SymbolID_T intern (const std::string&);
+
+    /**
+     * Get the identifier of the given code.
+     *
+     * @return SymbolID_T The identifier, or DEFAULT_NULL_SYMBOL_ID when
+     *         that code has never been interned.
+     */
+    SymbolID_T find (const std::string&) const;
+
+    /**
+     * Get the identifier of the given one-character code.
+     *
+     * @return SymbolID_T The identifier, or DEFAULT_NULL_SYMBOL_ID when
+     *         that code has never been interned.
+     */
+    SymbolID_T find (const char iCode) const {
+      return _charIDArray[static_cast<unsigned char> (iCode)];
+    }
+
+    /**
+     * Get the code corresponding to the given identifier.
+     */
+    const std::string& getCode (const SymbolID_T& iID) const;
+
+    /**
+     * Get the number of codes interned so far.
+     */
+    SymbolID_T size() const {
+      return static_cast<SymbolID_T> (_codeList.size());
+    }
+
+    /**
+     * Get the (approximate) number of bytes held by the dictionary,
+     * including the characters of the codes and the hashing overhead.
+     */
+    std::size_t getNbOfBytes() const;
+
+    /**
+     * Forget all the codes.
+     */
+    void clear();
+
+  public:
+    // /////////////// Display Methods /////////////////
+    /**
+     * Dump the dictionary into an output stream.
+     */
+    void toStream (std::ostream&) const;
+
+    /**
+     * Short display of the dictionary.
+     */
+    const std::string describe() const;
+
+  public:
+    // //////////// Constructors and Destructors /////////////
+    /**
+     * Main constructor.
+     *
+     * @param const std::string& Name of the kind of codes (e.g., "airport"),
+     *        only used for display purposes.
+     */
+    CodeDictionary (const std::string& iName);
+
+    /**
+     * Destructor.
+     */
+    ~CodeDictionary();
+
+  private:
+    /**
+     * Default constructor (not to be used).
+     */
+    CodeDictionary();
+
+  private:
+    // /////////////// Type definitions /////////////////
+    /** Map from the codes to their identifiers. */
+    typedef boost::unordered_map<std::string, SymbolID_T> CodeIDMap_T;
+
+    /** List of codes, indexed by their identifiers. */
+    typedef std::vector<std::string> CodeList_T;
+
+    /** Number of slots of the look-up array for one-character codes. */
+    static const unsigned short K_NB_OF_CHARS = 256;
+
+  private:
+    // //////////////// Attributes ///////////////////
+    /** Name of the kind of codes. */
+    std::string _name;
+
+    /** Map from the codes to their identifiers. */
+    CodeIDMap_T _codeIDMap;
+
+    /** List of codes, indexed by their identifiers. */
+    CodeList_T _codeList;
+
+    /** Identifiers of the one-character codes, indexed by character. */
+    SymbolID_T _charIDArray[K_NB_OF_CHARS];
+  };
+
+}
+#endif // __SIMCRS_BOM_CODEDICTIONARY_HPP
@@ -0,0 +1,161 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+// SimCRS
+#include <simcrs/bom/DeltaOverlay.hpp>
+
+namespace SIMCRS {
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string FareDeltaStruct::describe() const {
+    std::ostringstream oStr;
+    oStr << _operation << " " << _origin << "-" << _destination << " ["
+         << _startDate << "; " << _endDate << "] " << _pos << " "
+         << _channel << " " << _airlineCode << " " << _classPath;
+    if (_operation != '-') {
+      oStr << " " << _fare;
+    }
+    return oStr.str();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool FareDeltaStruct::hasSameScope (const FareDeltaStruct& iFareDelta) const {
+    return (_origin == iFareDelta._origin
+            && _destination == iFareDelta._destination
+            && _startDate == iFareDelta._startDate
+            && _endDate == iFareDelta._endDate
+            && _pos == iFareDelta._pos && _channel == iFareDelta._channel
+            && _airlineCode == iFareDelta._airlineCode
+            && _classPath == iFareDelta._classPath);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DeltaOverlay::DeltaOverlay() {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DeltaOverlay::DeltaOverlay (const DeltaOverlay&) {
+    assert (false);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DeltaOverlay::~DeltaOverlay() {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DeltaOverlay::buildODKey (const stdair::AirportCode_T& iOrigin,
+                                 const stdair::AirportCode_T& iDestination,
+                                 std::string& ioKey) {
+    ioKey = iOrigin;
+    ioKey += '-';
+    ioKey += iDestination;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const FareDeltaList_T* DeltaOverlay::
+  getFareDeltaList (const stdair::AirportCode_T& iOrigin,
+                    const stdair::AirportCode_T& iDestination) const {
+    if (_fareDeltaMap.empty() == true) {
+      return NULL;
+    }
+
+    std::string lODKey;
+    buildODKey (iOrigin, iDestination, lODKey);
+    const FareDeltaMap_T::const_iterator itDeltaList =
+      _fareDeltaMap.find (lODKey);
+    if (itDeltaList == _fareDeltaMap.end()) {
+      return NULL;
+    }
+    return &itDeltaList->second;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  std::size_t DeltaOverlay::getNbOfFareDeltas() const {
+    std::size_t oNbOfFareDeltas = 0;
+    for (FareDeltaMap_T::const_iterator itDeltaList = _fareDeltaMap.begin();
+         itDeltaList != _fareDeltaMap.end(); ++itDeltaList) {
+      oNbOfFareDeltas += itDeltaList->second.size();
+    }
+    return oNbOfFareDeltas;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  std::size_t DeltaOverlay::getNbOfBytes() const {
+    std::size_t oNbOfBytes = sizeof (DeltaOverlay)
+      + _closedFlightDateSet.bucket_count() * sizeof (void*)
+      + _closedFlightDateSet.size() * 2 * sizeof (void*)
+      + _fareDeltaMap.bucket_count() * sizeof (void*);
+    for (FareDeltaMap_T::const_iterator itDeltaList = _fareDeltaMap.begin();
+         itDeltaList != _fareDeltaMap.end(); ++itDeltaList) {
+      const FareDeltaList_T& lFareDeltaList = itDeltaList->second;
+      oNbOfBytes += sizeof (FareDeltaMap_T::value_type) + 2 * sizeof (void*)
+        + lFareDeltaList.capacity() * sizeof (FareDeltaStruct);
+      for (FareDeltaList_T::const_iterator itDelta = lFareDeltaList.begin();
+           itDelta != lFareDeltaList.end(); ++itDelta) {
+        oNbOfBytes += itDelta->_classPath.capacity();
+      }
+    }
+    return oNbOfBytes;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool DeltaOverlay::close (const stdair::FlightDate& iFlightDate) {
+    return _closedFlightDateSet.insert (&iFlightDate).second;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool DeltaOverlay::open (const stdair::FlightDate& iFlightDate) {
+    return (_closedFlightDateSet.erase (&iFlightDate) != 0);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DeltaOverlay::addFareDelta (const FareDeltaStruct& iFareDelta) {
+    std::string lODKey;
+    buildODKey (iFareDelta._origin, iFareDelta._destination, lODKey);
+    FareDeltaList_T& lFareDeltaList = _fareDeltaMap[lODKey];
+
+    /**
+     * Drop the former changes made moot by that one: a fare change
+     * overrides the former fare changes of the very same fare options,
+     * and a removal all their former changes (including the additions).
+     */
+    const char& lOperation = iFareDelta._operation;
+    if (lOperation != '+') {
+      FareDeltaList_T::iterator itLast = lFareDeltaList.begin();
+      for (FareDeltaList_T::iterator itDelta = lFareDeltaList.begin();
+           itDelta != lFareDeltaList.end(); ++itDelta) {
+        const bool isSuperseded = ((lOperation == '-'
+                                    || itDelta->_operation == '~')
+                                   && itDelta->hasSameScope (iFareDelta));
+        if (isSuperseded == false) {
+          if (itLast != itDelta) {
+            *itLast = *itDelta;
+          }
+          ++itLast;
+        }
+      }
+      lFareDeltaList.erase (itLast, lFareDeltaList.end());
+    }
+
+    lFareDeltaList.push_back (iFareDelta);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DeltaOverlay::clear() {
+    _closedFlightDateSet.clear();
+    _fareDeltaMap.clear();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string DeltaOverlay::describe() const {
+    std::ostringstream oStr;
+    oStr << "Delta overlay: " << _closedFlightDateSet.size()
+         << " closed flight-dates, " << getNbOfFareDeltas()
+         << " fare rule changes";
+    return oStr.str();
+  }
+
+}
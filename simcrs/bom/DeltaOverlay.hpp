@@ -0,0 +1,222 @@
+#ifndef __SIMCRS_BOM_DELTAOVERLAY_HPP
+#define __SIMCRS_BOM_DELTAOVERLAY_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstddef>
+#include <string>
+#include <vector>
+// Boost
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+
+// Forward declarations
+namespace stdair {
+  class FlightDate;
+}
+
+namespace SIMCRS {
+
+  /**
+   * @brief Fare rule change, read from a fare delta file (see
+   * SIMCRS_Service::applyFareDelta()). The change applies to the fare
+   * options of the travel solutions of the booking requests matching
+   * its origin, destination, departure date range, point of sale and
+   * channel, and operated by its airline. A "*" matches any point of
+   * sale, channel, airline or class path.
+   */
+  struct FareDeltaStruct {
+    /** Operation: '+' (add a fare option), '-' (remove the matching
+        fare options) or '~' (change the fare of the matching ones). */
+    char _operation;
+    /** Origin of the booking requests. */
+    stdair::AirportCode_T _origin;
+    /** Destination of the booking requests. */
+    stdair::AirportCode_T _destination;
+    /** First preferred departure date of the booking requests. */
+    stdair::Date_T _startDate;
+    /** Last preferred departure date of the booking requests. */
+    stdair::Date_T _endDate;
+    /** Point of sale of the booking requests. */
+    stdair::AirportCode_T _pos;
+    /** Channel of the booking requests. */
+    stdair::ChannelLabel_T _channel;
+    /** Airline operating the (first segment of the) travel solutions. */
+    stdair::AirlineCode_T _airlineCode;
+    /** Class path of the fare options (one class per segment, separated
+        by '/', e.g., "Y/M"). */
+    std::string _classPath;
+    /** Fare (not used when removing fare options). */
+    stdair::Fare_T _fare;
+
+    /** State whether the given change applies to the very same fare
+        options, i.e., whether all its fields but the operation and the
+        fare are the same. */
+    bool hasSameScope (const FareDeltaStruct&) const;
+
+    /** Short display of the change. */
+    const std::string describe() const;
+  };
+
+  /**
+   * List of fare rule changes, in the order they have been read.
+   */
+  typedef std::vector<FareDeltaStruct> FareDeltaList_T;
+
+  /**
+   * @brief Schedule and fare changes applied, by SimCRS, on top of the
+   * BOM trees loaded by AirTSP, AirInv and SimFQT (see the
+   * SIMCRS_Service::applyScheduleDelta() and applyFareDelta() methods):
+   * the flight-dates closed to sale, and the fare rule changes.
+   *
+   * The flight-dates are referred to by their objects in the (working)
+   * BOM tree; the overlay must therefore be cleared when that BOM tree
+   * is (re-)built.
+   *
+   * The fare rule changes are kept by origin and destination, so that a
+   * fare quote only goes through the changes of its booking request. A
+   * change of some fare options supersedes (and drops) the former
+   * changes it makes moot, i.e., the former fare changes of the very
+   * same fare options, and, for a removal, all their former changes.
+   */
+  class DeltaOverlay {
+  public:
+    // ///////////////// Getters ///////////////////
+    /**
+     * State whether the given flight-date has been closed to sale.
+     */
+    bool isClosed (const stdair::FlightDate& iFlightDate) const {
+      return (_closedFlightDateSet.find (&iFlightDate)
+              != _closedFlightDateSet.end());
+    }
+
+    /**
+     * State whether some flight-dates have been closed to sale.
+     */
+    bool hasClosedFlightDates() const {
+      return (_closedFlightDateSet.empty() == false);
+    }
+
+    /**
+     * Get the number of flight-dates closed to sale.
+     */
+    std::size_t getNbOfClosedFlightDates() const {
+      return _closedFlightDateSet.size();
+    }
+
+    /**
+     * State whether some fare rule changes have been made.
+     */
+    bool hasFareDeltas() const {
+      return (_fareDeltaMap.empty() == false);
+    }
+
+    /**
+     * Get the fare rule changes for the given origin and destination, in
+     * the order they have been read.
+     *
+     * @return const FareDeltaList_T* The changes, or NULL when there is
+     *         none for that origin and destination.
+     */
+    const FareDeltaList_T*
+    getFareDeltaList (const stdair::AirportCode_T& iOrigin,
+                      const stdair::AirportCode_T& iDestination) const;
+
+    /**
+     * Get the number of fare rule changes kept.
+     */
+    std::size_t getNbOfFareDeltas() const;
+
+    /**
+     * Get the (approximate) number of bytes held by the overlay.
+     */
+    std::size_t getNbOfBytes() const;
+
+  public:
+    // ///////////////// Business Methods ///////////////////
+    /**
+     * Close the given flight-date to sale.
+     *
+     * @return bool Whether the flight-date was open.
+     */
+    bool close (const stdair::FlightDate&);
+
+    /**
+     * Re-open the given flight-date to sale.
+     *
+     * @return bool Whether the flight-date was closed.
+     */
+    bool open (const stdair::FlightDate&);
+
+    /**
+     * Add a fare rule change, applied after the former ones (dropping
+     * the former ones it supersedes).
+     */
+    void addFareDelta (const FareDeltaStruct&);
+
+    /**
+     * Forget all the changes (e.g., when the BOM tree has been rebuilt).
+     */
+    void clear();
+
+  public:
+    // /////////////// Display Methods /////////////////
+    /**
+     * Short display of the overlay.
+     */
+    const std::string describe() const;
+
+  public:
+    // //////////// Constructors and Destructors /////////////
+    /**
+     * Default constructor.
+     */
+    DeltaOverlay();
+
+    /**
+     * Destructor.
+     */
+    ~DeltaOverlay();
+
+  private:
+    /**
+     * Copy constructor (not to be used).
+     */
+    DeltaOverlay (const DeltaOverlay&);
+
+  private:
+    // /////////////// Type definitions /////////////////
+    /** Set of flight-dates. */
+    typedef boost::unordered_set<const stdair::FlightDate*> FlightDateSet_T;
+
+    /** Fare rule changes, by origin and destination (e.g., "SIN-BKK"). */
+    typedef boost::unordered_map<std::string, FareDeltaList_T> FareDeltaMap_T;
+
+  private:
+    // //////////////// Support Methods ///////////////////
+    /**
+     * Build the key of the given origin and destination (e.g.,
+     * "SIN-BKK").
+     */
+    static void buildODKey (const stdair::AirportCode_T& iOrigin,
+                            const stdair::AirportCode_T& iDestination,
+                            std::string& ioKey);
+
+  private:
+    // //////////////// Attributes ///////////////////
+    /** Flight-dates closed to sale. */
+    FlightDateSet_T _closedFlightDateSet;
+
+    /** Fare rule changes, by origin and destination, in the order they
+        have been read. */
+    FareDeltaMap_T _fareDeltaMap;
+  };
+
+}
+#endif // __SIMCRS_BOM_DELTAOVERLAY_HPP
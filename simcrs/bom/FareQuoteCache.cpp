@@ -0,0 +1,142 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+// StdAir
+#include <stdair/bom/FareOptionStruct.hpp>
+// SimCRS
+#include <simcrs/basic/BasConst_General.hpp>
+#include <simcrs/bom/FareQuoteCache.hpp>
+
+namespace SIMCRS {
+
+  // ////////////////////////////////////////////////////////////////////
+  FareQuoteCache::FareQuoteCache (const std::size_t& iCapacity)
+    : _capacity (iCapacity) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  FareQuoteCache::FareQuoteCache()
+    : _capacity (DEFAULT_FARE_QUOTE_CACHE_CAPACITY) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  FareQuoteCache::FareQuoteCache (const FareQuoteCache&)
+    : _capacity (DEFAULT_FARE_QUOTE_CACHE_CAPACITY) {
+    assert (false);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  FareQuoteCache::~FareQuoteCache() {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  FareQuoteCacheStatsStruct FareQuoteCache::getStats() const {
+    FareQuoteCacheStatsStruct oStats = _stats;
+    oStats._nbOfEntries = _entryMap.size();
+    return oStats;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  std::size_t FareQuoteCache::getNbOfBytes() const {
+    // The list nodes hold two links, the map nodes a single one
+    std::size_t oNbOfBytes = sizeof (FareQuoteCache)
+      + _entryMap.bucket_count() * sizeof (void*)
+      + _entryMap.size() * (sizeof (EntryMap_T::value_type) + sizeof (void*));
+    for (EntryList_T::const_iterator itEntry = _entryList.begin();
+         itEntry != _entryList.end(); ++itEntry) {
+      const Entry& lEntry = *itEntry;
+      oNbOfBytes += sizeof (Entry) + 2 * sizeof (void*)
+        + 2 * lEntry._key.size()
+        + (lEntry._fareOptionList.size()
+           * (sizeof (stdair::FareOptionStruct) + 2 * sizeof (void*)));
+    }
+    return oNbOfBytes;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool FareQuoteCache::find (const std::string& iKey,
+                             stdair::FareOptionList_T& ioFareOptionList) {
+    ++_stats._nbOfLookups;
+
+    EntryMap_T::const_iterator itEntry = _entryMap.find (iKey);
+    if (itEntry == _entryMap.end()) {
+      return false;
+    }
+    ++_stats._nbOfHits;
+
+    // That entry becomes the most recently used one
+    const EntryList_T::iterator& itListEntry = itEntry->second;
+    _entryList.splice (_entryList.begin(), _entryList, itListEntry);
+
+    ioFareOptionList = itListEntry->_fareOptionList;
+    return true;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void FareQuoteCache::
+  insert (const std::string& iKey,
+          const stdair::FareOptionList_T& iFareOptionList) {
+    if (_capacity == 0) {
+      return;
+    }
+
+    EntryMap_T::iterator itEntry = _entryMap.find (iKey);
+    if (itEntry != _entryMap.end()) {
+      // Refresh the existing entry
+      EntryList_T::iterator& itListEntry = itEntry->second;
+      itListEntry->_fareOptionList = iFareOptionList;
+      _entryList.splice (_entryList.begin(), _entryList, itListEntry);
+      return;
+    }
+
+    // Make room for the new entry
+    evict (_capacity - 1);
+
+    _entryList.push_front (Entry());
+    Entry& lEntry = _entryList.front();
+    lEntry._key = iKey;
+    lEntry._fareOptionList = iFareOptionList;
+    _entryMap.insert (EntryMap_T::value_type (iKey, _entryList.begin()));
+    ++_stats._nbOfInsertions;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void FareQuoteCache::evict (const std::size_t& iNbOfEntries) {
+    while (_entryMap.size() > iNbOfEntries) {
+      assert (_entryList.empty() == false);
+      const Entry& lEntry = _entryList.back();
+      _entryMap.erase (lEntry._key);
+      _entryList.pop_back();
+      ++_stats._nbOfEvictions;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void FareQuoteCache::setCapacity (const std::size_t& iCapacity) {
+    _capacity = iCapacity;
+    evict (_capacity);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void FareQuoteCache::clear() {
+    _entryMap.clear();
+    _entryList.clear();
+    ++_stats._nbOfFlushes;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string FareQuoteCache::describe() const {
+    const FareQuoteCacheStatsStruct lStats = getStats();
+    std::ostringstream oStr;
+    oStr << "Fare quote cache: " << lStats._nbOfEntries << " entries (capacity: "
+         << _capacity << "), " << lStats._nbOfHits << " hits out of "
+         << lStats._nbOfLookups << " look-ups (hit rate: "
+         << lStats.getHitRate() << "), " << lStats._nbOfEvictions
+         << " evictions, " << lStats._nbOfFlushes << " flushes";
+    return oStr.str();
+  }
+
+}
@@ -0,0 +1,156 @@
+#ifndef __SIMCRS_BOM_FAREQUOTECACHE_HPP
+#define __SIMCRS_BOM_FAREQUOTECACHE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstddef>
+#include <list>
+#include <string>
+// Boost
+#include <boost/unordered_map.hpp>
+// StdAir
+#include <stdair/bom/FareOptionTypes.hpp>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+
+namespace SIMCRS {
+
+  /**
+   * @brief Cache of the fare quote results, i.e., of the fare options
+   * of the travel solutions, keyed by a fingerprint of the fare-relevant
+   * fields of the booking request and of the segment path.
+   *
+   * The cache holds at most a given number of entries, the least
+   * recently used ones being evicted first. A capacity of 0 disables
+   * the cache.
+   */
+  class FareQuoteCache {
+  public:
+    // ///////////////// Getters ///////////////////
+    /**
+     * Get the maximal number of entries.
+     */
+    const std::size_t& getCapacity() const {
+      return _capacity;
+    }
+
+    /**
+     * State whether the cache is enabled (i.e., whether its capacity
+     * is not 0).
+     */
+    bool isEnabled() const {
+      return (_capacity != 0);
+    }
+
+    /**
+     * Get the statistics of the cache.
+     */
+    FareQuoteCacheStatsStruct getStats() const;
+
+    /**
+     * Get the (approximate) number of bytes held by the cache, i.e., by
+     * its entries (fingerprints and fare options) and their index.
+     */
+    std::size_t getNbOfBytes() const;
+
+  public:
+    // ///////////////// Business Methods ///////////////////
+    /**
+     * Look up the fare options corresponding to the given fingerprint
+     * and, when found, copy them into the given list.
+     *
+     * @return bool Whether the fingerprint has been found.
+     */
+    bool find (const std::string&, stdair::FareOptionList_T&);
+
+    /**
+     * Store the fare options corresponding to the given fingerprint,
+     * evicting the least recently used entries if needed.
+     */
+    void insert (const std::string&, const stdair::FareOptionList_T&);
+
+    /**
+     * Set the maximal number of entries, evicting the least recently used
+     * entries if needed.
+     */
+    void setCapacity (const std::size_t&);
+
+    /**
+     * Forget all the entries (e.g., when the fares have been reloaded).
+     */
+    void clear();
+
+  public:
+    // /////////////// Display Methods /////////////////
+    /**
+     * Short display of the cache.
+     */
+    const std::string describe() const;
+
+  public:
+    // //////////// Constructors and Destructors /////////////
+    /**
+     * Main constructor.
+     *
+     * @param const std::size_t& Maximal number of entries.
+     */
+    FareQuoteCache (const std::size_t& iCapacity);
+
+    /**
+     * Default constructor.
+     */
+    FareQuoteCache();
+
+    /**
+     * Destructor.
+     */
+    ~FareQuoteCache();
+
+  private:
+    /**
+     * Copy constructor (not to be used).
+     */
+    FareQuoteCache (const FareQuoteCache&);
+
+    /**
+     * Evict the least recently used entries, until there are no more
+     * than the given number of entries left.
+     */
+    void evict (const std::size_t&);
+
+  private:
+    // /////////////// Type definitions /////////////////
+    /** Entry of the cache. */
+    struct Entry {
+      /** Fingerprint. */
+      std::string _key;
+      /** Fare options. */
+      stdair::FareOptionList_T _fareOptionList;
+    };
+
+    /** Entries, from the most recently used to the least recently used. */
+    typedef std::list<Entry> EntryList_T;
+
+    /** Index of the entries, by fingerprint. */
+    typedef boost::unordered_map<std::string,
+                                 EntryList_T::iterator> EntryMap_T;
+
+  private:
+    // //////////////// Attributes ///////////////////
+    /** Maximal number of entries. */
+    std::size_t _capacity;
+
+    /** Entries, from the most recently used to the least recently used. */
+    EntryList_T _entryList;
+
+    /** Index of the entries, by fingerprint. */
+    EntryMap_T _entryMap;
+
+    /** Statistics (the number of entries being taken from the list). */
+    FareQuoteCacheStatsStruct _stats;
+  };
+
+}
+#endif // __SIMCRS_BOM_FAREQUOTECACHE_HPP
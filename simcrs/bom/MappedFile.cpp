@@ -0,0 +1,85 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+// POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+// StdAir
+#include <stdair/stdair_exceptions.hpp>
+#include <stdair/basic/BasFileMgr.hpp>
+#include <stdair/service/Logger.hpp>
+// SimCRS
+#include <simcrs/bom/MappedFile.hpp>
+
+namespace SIMCRS {
+
+  namespace {
+    /** Report that the given file can not be mapped. */
+    void throwNotMapped (const stdair::Filename_T& iFilename) {
+      std::ostringstream oMessage;
+      oMessage << "The file '" << iFilename
+               << "' does not exist or can not be read";
+      STDAIR_LOG_ERROR (oMessage.str());
+      throw stdair::FileNotFoundException (oMessage.str());
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  MappedFile::MappedFile (const stdair::Filename_T& iFilename)
+    : _filename (iFilename), _data (NULL), _size (0) {
+
+    if (stdair::BasFileMgr::doesExistAndIsReadable (iFilename) == false) {
+      throwNotMapped (iFilename);
+    }
+
+    const int lFileDescriptor = ::open (iFilename.c_str(), O_RDONLY);
+    if (lFileDescriptor < 0) {
+      throwNotMapped (iFilename);
+    }
+
+    struct stat lFileStatus;
+    if (::fstat (lFileDescriptor, &lFileStatus) != 0) {
+      ::close (lFileDescriptor);
+      throwNotMapped (iFilename);
+    }
+
+    // An empty file can not be mapped: its content is just empty
+    _size = static_cast<std::size_t> (lFileStatus.st_size);
+    if (_size == 0) {
+      ::close (lFileDescriptor);
+      return;
+    }
+
+    void* lMapping_ptr = ::mmap (NULL, _size, PROT_READ, MAP_PRIVATE,
+                                 lFileDescriptor, 0);
+    // The mapping holds its own reference on the file
+    ::close (lFileDescriptor);
+    if (lMapping_ptr == MAP_FAILED) {
+      _size = 0;
+      throwNotMapped (iFilename);
+    }
+
+    // The files are read from their beginning to their end, only once
+    ::madvise (lMapping_ptr, _size, MADV_SEQUENTIAL);
+    _data = static_cast<const char*> (lMapping_ptr);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  MappedFile::MappedFile (const MappedFile&)
+    : _data (NULL), _size (0) {
+    assert (false);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  MappedFile::~MappedFile() {
+    if (_data != NULL) {
+      ::munmap (const_cast<char*> (_data), _size);
+    }
+  }
+
+}
@@ -0,0 +1,82 @@
+#ifndef __SIMCRS_BOM_MAPPEDFILE_HPP
+#define __SIMCRS_BOM_MAPPEDFILE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstddef>
+#include <string_view>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+
+namespace SIMCRS {
+
+  /**
+   * @brief Read-only memory mapping of a whole (input) file.
+   *
+   * The content of the file is read directly from the pages of the
+   * operating system: it is neither copied into stream buffers nor into
+   * strings. The mapping is released when the object is destroyed; the
+   * views on the content must therefore not outlive it.
+   */
+  class MappedFile {
+  public:
+    // ///////////////// Getters ///////////////////
+    /**
+     * Get the name of the file.
+     */
+    const stdair::Filename_T& getFilename() const {
+      return _filename;
+    }
+
+    /**
+     * Get the content of the file (empty for an empty file).
+     */
+    std::string_view getContent() const {
+      return std::string_view (_data, _size);
+    }
+
+    /**
+     * Get the size, in bytes, of the file.
+     */
+    std::size_t getSize() const {
+      return _size;
+    }
+
+  public:
+    // //////////// Constructors and Destructors /////////////
+    /**
+     * Constructor, mapping the given file.
+     *
+     * @param const stdair::Filename_T& Name of the file.
+     * @exception stdair::FileNotFoundException The file does not exist,
+     *            or can not be read or mapped.
+     */
+    MappedFile (const stdair::Filename_T&);
+
+    /**
+     * Destructor, releasing the mapping.
+     */
+    ~MappedFile();
+
+  private:
+    /**
+     * Copy constructor (not to be used).
+     */
+    MappedFile (const MappedFile&);
+
+  private:
+    // //////////////// Attributes ///////////////////
+    /** Name of the file. */
+    stdair::Filename_T _filename;
+
+    /** Start of the mapping (NULL for an empty file). */
+    const char* _data;
+
+    /** Size, in bytes, of the mapping. */
+    std::size_t _size;
+  };
+
+}
+#endif // __SIMCRS_BOM_MAPPEDFILE_HPP
@@ -0,0 +1,173 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+#include <new>
+// SimCRS
+#include <simcrs/basic/BasConst_General.hpp>
+#include <simcrs/bom/RequestArena.hpp>
+
+namespace SIMCRS {
+
+  // ////////////////////////////////////////////////////////////////////
+  RequestArena::RequestArena (const std::size_t iBlockSize)
+    : _blockSize (iBlockSize), _currentBlockIdx (0), _offset (0),
+      _reservedBytes (0), _nbOfAllocations (0), _allocatedBytes (0),
+      _peakBytes (0), _nbOfOpenRequests (0) {
+    assert (_blockSize > 0);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  RequestArena::RequestArena()
+    : _blockSize (DEFAULT_ARENA_BLOCK_SIZE), _currentBlockIdx (0),
+      _offset (0), _reservedBytes (0), _nbOfAllocations (0),
+      _allocatedBytes (0), _peakBytes (0), _nbOfOpenRequests (0) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  RequestArena::RequestArena (const RequestArena&)
+    : _blockSize (DEFAULT_ARENA_BLOCK_SIZE), _currentBlockIdx (0),
+      _offset (0), _reservedBytes (0), _nbOfAllocations (0),
+      _allocatedBytes (0), _peakBytes (0), _nbOfOpenRequests (0) {
+    assert (false);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  RequestArena::~RequestArena() {
+    clear();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void RequestArena::moveToNextBlock (const std::size_t iMinSize) {
+    // Re-use the blocks kept from the former requests, when large enough
+    if (_blockList.empty() == false) {
+      for (++_currentBlockIdx; _currentBlockIdx < _blockList.size();
+           ++_currentBlockIdx) {
+        if (_blockList[_currentBlockIdx]._size >= iMinSize) {
+          _offset = 0;
+          return;
+        }
+      }
+    }
+
+    // Reserve a new block from the system
+    Block lBlock;
+    lBlock._size = (iMinSize > _blockSize) ? iMinSize : _blockSize;
+    lBlock._data = static_cast<char*> (::operator new (lBlock._size));
+    _blockList.push_back (lBlock);
+    _reservedBytes += lBlock._size;
+
+    _currentBlockIdx = _blockList.size() - 1;
+    _offset = 0;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void* RequestArena::allocate (const std::size_t iSize,
+                                const std::size_t iAlignment) {
+    assert (iAlignment > 0 && (iAlignment & (iAlignment - 1)) == 0);
+
+    if (_blockList.empty() == true) {
+      moveToNextBlock (iSize + iAlignment);
+    }
+
+    // Align the offset within the current block
+    const Block* lBlock_ptr = &_blockList[_currentBlockIdx];
+    std::size_t lAddress =
+      reinterpret_cast<std::size_t> (lBlock_ptr->_data) + _offset;
+    std::size_t lPadding = (iAlignment - (lAddress & (iAlignment - 1)))
+      & (iAlignment - 1);
+
+    if (_offset + lPadding + iSize > lBlock_ptr->_size) {
+      moveToNextBlock (iSize + iAlignment);
+      lBlock_ptr = &_blockList[_currentBlockIdx];
+      lAddress = reinterpret_cast<std::size_t> (lBlock_ptr->_data);
+      lPadding = (iAlignment - (lAddress & (iAlignment - 1)))
+        & (iAlignment - 1);
+    }
+
+    void* oChunk_ptr = lBlock_ptr->_data + _offset + lPadding;
+    _offset += lPadding + iSize;
+
+    ++_nbOfAllocations;
+    _allocatedBytes += iSize;
+    if (_allocatedBytes > _peakBytes) {
+      _peakBytes = _allocatedBytes;
+    }
+
+    return oChunk_ptr;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  RequestArena::Marker RequestArena::beginRequest() {
+    ++_nbOfOpenRequests;
+
+    Marker oMarker;
+    oMarker._blockIdx = _currentBlockIdx;
+    oMarker._offset = _offset;
+    oMarker._allocatedBytes = _allocatedBytes;
+    return oMarker;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void RequestArena::endRequest (const Marker& iMarker) {
+    assert (_nbOfOpenRequests > 0);
+    --_nbOfOpenRequests;
+
+    // The outermost request gives all the memory back
+    if (_nbOfOpenRequests == 0) {
+      reset();
+      return;
+    }
+
+    // A nested request only gives back what it has allocated
+    _currentBlockIdx = iMarker._blockIdx;
+    _offset = iMarker._offset;
+    _allocatedBytes = iMarker._allocatedBytes;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  ArenaStatsStruct RequestArena::getCurrentRequestStats() const {
+    ArenaStatsStruct oStats;
+    oStats._nbOfAllocations = _nbOfAllocations;
+    oStats._allocatedBytes = _allocatedBytes;
+    oStats._peakBytes = _peakBytes;
+    oStats._reservedBytes = _reservedBytes;
+    oStats._nbOfBlocks = _blockList.size();
+    return oStats;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void RequestArena::reset() {
+    _lastRequestStats = getCurrentRequestStats();
+
+    _currentBlockIdx = 0;
+    _offset = 0;
+    _nbOfAllocations = 0;
+    _allocatedBytes = 0;
+    _peakBytes = 0;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void RequestArena::clear() {
+    for (BlockList_T::iterator itBlock = _blockList.begin();
+         itBlock != _blockList.end(); ++itBlock) {
+      ::operator delete (itBlock->_data);
+    }
+    _blockList.clear();
+    _reservedBytes = 0;
+    reset();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string RequestArena::describe() const {
+    std::ostringstream oStr;
+    oStr << "Request arena: " << _blockList.size() << " blocks ("
+         << _reservedBytes << " bytes reserved); last request: "
+         << _lastRequestStats._nbOfAllocations << " allocations, "
+         << _lastRequestStats._peakBytes << " bytes at peak";
+    return oStr.str();
+  }
+
+}
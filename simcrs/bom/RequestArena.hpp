@@ -0,0 +1,219 @@
+#ifndef __SIMCRS_BOM_REQUESTARENA_HPP
+#define __SIMCRS_BOM_REQUESTARENA_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+
+namespace SIMCRS {
+
+  /**
+   * @brief Monotonic (bump) memory arena, holding the short-lived objects
+   * allocated while serving a single (shopping) request.
+   *
+   * Memory is carved out of large blocks, by simply moving an offset
+   * forward. Nothing is released individually: all the memory is given
+   * back at once by reset(), at the end of the request. The blocks are
+   * kept from one request to the next, so that a steady workload no
+   * longer hits the system allocator at all.
+   *
+   * The requests may be nested (e.g., a fare quote within a shopping
+   * request): the memory allocated by a nested request is given back
+   * at its end (see RequestArenaScope), the one of the enclosing request
+   * being kept.
+   */
+  class RequestArena {
+  public:
+    // /////////////// Type definitions /////////////////
+    /**
+     * Position of the arena, i.e., amount of memory in use, at the
+     * beginning of a (nested) request.
+     */
+    struct Marker {
+      /** Index of the block currently carved out. */
+      std::size_t _blockIdx;
+      /** Offset of the free memory within that block. */
+      std::size_t _offset;
+      /** Number of bytes handed out so far. */
+      std::size_t _allocatedBytes;
+    };
+
+  public:
+    // /////////////// Business Methods /////////////////
+    /**
+     * Allocate a (properly aligned) memory chunk of the given size.
+     */
+    void* allocate (const std::size_t iSize, const std::size_t iAlignment);
+
+    /**
+     * Begin a (possibly nested) request.
+     *
+     * @return Marker Position of the arena, to be given back to
+     *         endRequest().
+     */
+    Marker beginRequest();
+
+    /**
+     * End the request begun at the given position. The memory allocated
+     * by that request is given back: when it is the outermost request,
+     * the arena is reset (see reset()); otherwise, the arena is rolled
+     * back to the given position.
+     */
+    void endRequest (const Marker&);
+
+    /**
+     * Release, at once, all the memory allocated since the last reset.
+     * The usage statistics of the request just finished are kept,
+     * and can be retrieved with getLastRequestStats().
+     */
+    void reset();
+
+    /**
+     * Release the memory blocks back to the system.
+     */
+    void clear();
+
+  public:
+    // ///////////////// Getters ///////////////////
+    /**
+     * Get the usage statistics of the current request.
+     */
+    ArenaStatsStruct getCurrentRequestStats() const;
+
+    /**
+     * Get the usage statistics of the last completed request.
+     */
+    const ArenaStatsStruct& getLastRequestStats() const {
+      return _lastRequestStats;
+    }
+
+    /**
+     * Get the number of bytes reserved from the system (all blocks).
+     */
+    std::size_t getReservedBytes() const {
+      return _reservedBytes;
+    }
+
+    /**
+     * Get the number of memory blocks reserved from the system.
+     */
+    std::size_t getNbOfBlocks() const {
+      return _blockList.size();
+    }
+
+  public:
+    // /////////////// Display Methods /////////////////
+    /**
+     * Short display of the arena.
+     */
+    const std::string describe() const;
+
+  public:
+    // //////////// Constructors and Destructors /////////////
+    /**
+     * Main constructor.
+     *
+     * @param const std::size_t Size of the memory blocks.
+     */
+    RequestArena (const std::size_t iBlockSize);
+
+    /**
+     * Default constructor.
+     */
+    RequestArena();
+
+    /**
+     * Destructor.
+     */
+    ~RequestArena();
+
+  private:
+    /**
+     * Copy constructor (not to be used).
+     */
+    RequestArena (const RequestArena&);
+
+    /**
+     * Make the next block (at least as large as the given size) current.
+     */
+    void moveToNextBlock (const std::size_t iMinSize);
+
+  private:
+    // /////////////// Type definitions /////////////////
+    /** Memory block. */
+    struct Block {
+      char* _data;
+      std::size_t _size;
+    };
+
+    /** List of memory blocks. */
+    typedef std::vector<Block> BlockList_T;
+
+  private:
+    // //////////////// Attributes ///////////////////
+    /** Default size of the memory blocks. */
+    std::size_t _blockSize;
+
+    /** Memory blocks, reserved from the system. */
+    BlockList_T _blockList;
+
+    /** Index of the block currently carved out. */
+    std::size_t _currentBlockIdx;
+
+    /** Offset of the free memory within the current block. */
+    std::size_t _offset;
+
+    /** Number of bytes reserved from the system. */
+    std::size_t _reservedBytes;
+
+    /** Number of allocations served since the last reset. */
+    std::size_t _nbOfAllocations;
+
+    /** Number of bytes handed out since the last reset, and still in use
+        (i.e., not given back by the end of a nested request). */
+    std::size_t _allocatedBytes;
+
+    /** Peak number of bytes in use since the last reset. */
+    std::size_t _peakBytes;
+
+    /** Number of requests in progress (nested ones included). */
+    std::size_t _nbOfOpenRequests;
+
+    /** Usage statistics of the last completed request. */
+    ArenaStatsStruct _lastRequestStats;
+  };
+
+  /**
+   * @brief Guard giving the memory of a request back to the arena when
+   * going out of scope, i.e., at the end of the request (even when an
+   * exception is thrown).
+   */
+  class RequestArenaScope {
+  public:
+    /** Constructor. */
+    explicit RequestArenaScope (RequestArena& ioArena)
+      : _arena (ioArena), _marker (ioArena.beginRequest()) {
+    }
+    /** Destructor. */
+    ~RequestArenaScope() {
+      _arena.endRequest (_marker);
+    }
+  private:
+    /** Copy constructor (not to be used). */
+    RequestArenaScope (const RequestArenaScope&);
+  private:
+    /** Arena of the request. */
+    RequestArena& _arena;
+    /** Position of the arena at the beginning of the request. */
+    const RequestArena::Marker _marker;
+  };
+
+}
+#endif // __SIMCRS_BOM_REQUESTARENA_HPP
@@ -0,0 +1,84 @@
+#ifndef __SIMCRS_BOM_REQUESTTRACETIMER_HPP
+#define __SIMCRS_BOM_REQUESTTRACETIMER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstddef>
+#include <chrono>
+// SimCRS
+#include <simcrs/SIMCRS_RequestTrace.hpp>
+
+namespace SIMCRS {
+
+  /**
+   * @brief Guard adding the time spent within its scope to the given
+   * stage of a request trace. Nothing is measured when no request trace
+   * is given (NULL pointer).
+   */
+  class RequestTraceTimer {
+  public:
+    /** Constructor. */
+    RequestTraceTimer (RequestTraceStruct* ioRequestTrace_ptr,
+                       const RequestTraceStruct::EN_Stage& iStage)
+      : _stageTime_ptr (NULL) {
+      if (ioRequestTrace_ptr != NULL) {
+        _stageTime_ptr = &ioRequestTrace_ptr->_stageTimeList[iStage];
+        _startTime = Clock_T::now();
+      }
+    }
+    /** Destructor. */
+    ~RequestTraceTimer() {
+      if (_stageTime_ptr != NULL) {
+        const Clock_T::duration lElapsed = Clock_T::now() - _startTime;
+        const std::chrono::nanoseconds lElapsedNs =
+          std::chrono::duration_cast<std::chrono::nanoseconds> (lElapsed);
+        *_stageTime_ptr += lElapsedNs.count();
+      }
+    }
+  private:
+    /** Copy constructor (not to be used). */
+    RequestTraceTimer (const RequestTraceTimer&);
+  private:
+    /** Monotonic clock. */
+    typedef std::chrono::steady_clock Clock_T;
+    /** Time of the stage to be increased (NULL when not tracing). */
+    RequestTraceStruct::Nanoseconds_T* _stageTime_ptr;
+    /** Start time. */
+    Clock_T::time_point _startTime;
+  };
+
+  /**
+   * @brief Guard making the given request trace the current one (i.e.,
+   * the one filled by the SimCRS commands) within its scope, the former
+   * current request trace being restored at the end of the scope. The
+   * current request trace is a thread-local one (see
+   * SIMCRS_ServiceContext::getCurrentRequestTraceRef()): the guard is
+   * to be destroyed by the thread which has built it.
+   */
+  class RequestTraceScope {
+  public:
+    /** Constructor. */
+    RequestTraceScope (RequestTraceStruct*& ioCurrentRequestTrace_ptr,
+                       RequestTraceStruct* iRequestTrace_ptr)
+      : _currentRequestTrace_ptr (ioCurrentRequestTrace_ptr),
+        _formerRequestTrace_ptr (ioCurrentRequestTrace_ptr) {
+      _currentRequestTrace_ptr = iRequestTrace_ptr;
+    }
+    /** Destructor. */
+    ~RequestTraceScope() {
+      _currentRequestTrace_ptr = _formerRequestTrace_ptr;
+    }
+  private:
+    /** Copy constructor (not to be used). */
+    RequestTraceScope (const RequestTraceScope&);
+  private:
+    /** Current request trace. */
+    RequestTraceStruct*& _currentRequestTrace_ptr;
+    /** Former current request trace. */
+    RequestTraceStruct* _formerRequestTrace_ptr;
+  };
+
+}
+#endif // __SIMCRS_BOM_REQUESTTRACETIMER_HPP
@@ -0,0 +1,116 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <new>
+// StdAir
+#include <stdair/bom/TravelSolutionStruct.hpp>
+// SimCRS
+#include <simcrs/bom/SingleFlightGroup.hpp>
+
+namespace SIMCRS {
+
+  // ////////////////////////////////////////////////////////////////////
+  SingleFlightGroup::SingleFlightGroup (std::mutex& ioComputationMutex)
+    : _computationMutex (ioComputationMutex) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  SingleFlightGroup::~SingleFlightGroup() {
+    assert (_callMap.empty() == true);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  CoalescingStatsStruct SingleFlightGroup::getStats() const {
+    std::lock_guard<std::mutex> lGuard (_mutex);
+    return _stats;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool SingleFlightGroup::run (const std::string& iKey,
+                               const Computation_T& iComputation,
+                               stdair::TravelSolutionList_T& ioResult) {
+    std::unique_lock<std::mutex> lLock (_mutex);
+    ++_stats._nbOfRequests;
+
+    /**
+     * Join the in-flight computation for the same key, if any. Should
+     * that computation fail, a new one is looked for (or run).
+     */
+    CallPtr_T lCall_ptr;
+    CallMap_T::iterator itCall = _callMap.find (iKey);
+    while (itCall != _callMap.end()) {
+      const CallPtr_T lInFlightCall_ptr = itCall->second;
+      assert (lInFlightCall_ptr != NULL);
+      ++lInFlightCall_ptr->_nbOfWaiters;
+      while (lInFlightCall_ptr->_isDone == false) {
+        _doneCondition.wait (lLock);
+      }
+
+      if (lInFlightCall_ptr->_hasFailed == false) {
+        ++_stats._nbOfCoalescedRequests;
+        ioResult = lInFlightCall_ptr->_result;
+        return true;
+      }
+      itCall = _callMap.find (iKey);
+    }
+
+    // Run the computation, for all the requests joining it
+    lCall_ptr.reset (new Call());
+    lCall_ptr->_isDone = false;
+    lCall_ptr->_hasFailed = false;
+    lCall_ptr->_nbOfWaiters = 0;
+    _callMap.insert (CallMap_T::value_type (iKey, lCall_ptr));
+    ++_stats._nbOfComputations;
+    lLock.unlock();
+
+    try {
+      std::lock_guard<std::mutex> lComputationGuard (_computationMutex);
+      iComputation (ioResult);
+
+    } catch (...) {
+      lLock.lock();
+      lCall_ptr->_hasFailed = true;
+      lCall_ptr->_isDone = true;
+      _callMap.erase (iKey);
+      _doneCondition.notify_all();
+      throw;
+    }
+
+    // Hand the result over to the waiting requests
+    lLock.lock();
+    if (lCall_ptr->_nbOfWaiters != 0) {
+      lCall_ptr->_result = ioResult;
+    }
+    lCall_ptr->_isDone = true;
+    _callMap.erase (iKey);
+    _doneCondition.notify_all();
+
+    return false;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SingleFlightGroup::lockBeforeFork() {
+    _mutex.lock();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SingleFlightGroup::unlockAfterFork() {
+    _mutex.unlock();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SingleFlightGroup::resetAfterFork() {
+    _callMap.clear();
+
+    // The condition may still count the waiters of the parent threads:
+    // it is built again (without being destroyed, as it is waited for)
+    new (&_doneCondition) std::condition_variable();
+
+    // The lock has been taken, when forking, by the thread which the
+    // child is a copy of
+    _mutex.unlock();
+  }
+
+}
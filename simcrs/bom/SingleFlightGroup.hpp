@@ -0,0 +1,150 @@
+#ifndef __SIMCRS_BOM_SINGLEFLIGHTGROUP_HPP
+#define __SIMCRS_BOM_SINGLEFLIGHTGROUP_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+// Boost
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+// StdAir
+#include <stdair/bom/TravelSolutionTypes.hpp>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+
+namespace SIMCRS {
+
+  /**
+   * @brief Single-flight (request coalescing) layer: the concurrent
+   * requests sharing the same key wait for a single (in-flight)
+   * computation, and all receive its result, i.e., a list of travel
+   * solutions.
+   *
+   * The SimCRS components (AirTSP, SimFQT, the logger) cannot be used
+   * concurrently. Hence, the computations themselves are serialised,
+   * by a mutex which may be shared by several groups: the coalescing
+   * removes the duplicate computations, not the serialisation.
+   */
+  class SingleFlightGroup {
+  public:
+    // /////////////// Type definitions /////////////////
+    /**
+     * Computation filling the given list of travel solutions.
+     */
+    typedef boost::function<void (stdair::TravelSolutionList_T&)>
+    Computation_T;
+
+  public:
+    // ///////////////// Getters ///////////////////
+    /**
+     * Get the coalescing statistics.
+     */
+    CoalescingStatsStruct getStats() const;
+
+  public:
+    // ///////////////// Business Methods ///////////////////
+    /**
+     * Get the result corresponding to the given key, into the given list.
+     *
+     * When a computation for the same key is in flight, wait for it to
+     * complete and take a copy of its result. Otherwise, run the given
+     * computation (once the computation mutex is free), and hand its
+     * result over to the requests which have joined it in the meantime.
+     * When a computation fails (throws), its waiting requests run their
+     * own computation.
+     *
+     * @return bool Whether the result has been taken from the computation
+     *         of another request.
+     */
+    bool run (const std::string&, const Computation_T&,
+              stdair::TravelSolutionList_T&);
+
+    /**
+     * Take the lock of the group before forking the process (the
+     * computation mutex, shared by several groups, is left to its
+     * owner).
+     */
+    void lockBeforeFork();
+
+    /**
+     * Release the lock taken by lockBeforeFork(), in the parent process.
+     */
+    void unlockAfterFork();
+
+    /**
+     * Reset the group in the child process, after forking: the
+     * in-flight computations, run by the other threads of the parent,
+     * will never be over in the child, and are forgotten (along with
+     * the requests waiting for them). The lock taken by
+     * lockBeforeFork() is released.
+     */
+    void resetAfterFork();
+
+  public:
+    // //////////// Constructors and Destructors /////////////
+    /**
+     * Constructor.
+     *
+     * @param std::mutex& Mutex serialising the computations.
+     */
+    SingleFlightGroup (std::mutex& ioComputationMutex);
+
+    /**
+     * Destructor.
+     */
+    ~SingleFlightGroup();
+
+  private:
+    /**
+     * Default constructor (not to be used).
+     */
+    SingleFlightGroup();
+
+    /**
+     * Copy constructor (not to be used).
+     */
+    SingleFlightGroup (const SingleFlightGroup&);
+
+  private:
+    // /////////////// Type definitions /////////////////
+    /** In-flight computation. */
+    struct Call {
+      /** Whether the computation is over. */
+      bool _isDone;
+      /** Whether the computation has failed. */
+      bool _hasFailed;
+      /** Number of requests waiting for the result. */
+      unsigned int _nbOfWaiters;
+      /** Result (copied only when some requests are waiting for it). */
+      stdair::TravelSolutionList_T _result;
+    };
+    typedef boost::shared_ptr<Call> CallPtr_T;
+
+    /** In-flight computations, by key. */
+    typedef std::map<std::string, CallPtr_T> CallMap_T;
+
+  private:
+    // //////////////// Attributes ///////////////////
+    /** Mutex serialising the computations. */
+    std::mutex& _computationMutex;
+
+    /** Mutex protecting the in-flight computations and the statistics. */
+    mutable std::mutex _mutex;
+
+    /** Condition signalled whenever an in-flight computation is over. */
+    std::condition_variable _doneCondition;
+
+    /** In-flight computations. */
+    CallMap_T _callMap;
+
+    /** Coalescing statistics. */
+    CoalescingStatsStruct _stats;
+  };
+
+}
+#endif // __SIMCRS_BOM_SINGLEFLIGHTGROUP_HPP
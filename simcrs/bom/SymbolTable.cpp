@@ -0,0 +1,151 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+// SimCRS
+#include <simcrs/basic/BasConst_General.hpp>
+#include <simcrs/bom/SymbolTable.hpp>
+
+namespace SIMCRS {
+
+  // ////////////////////////////////////////////////////////////////////
+  SymbolTable::SymbolTable()
+    : _airportDictionary ("airport"), _airlineDictionary ("airline"),
+      _classCodeDictionary ("booking class"),
+      _segmentDateDictionary ("segment-date") {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  SymbolTable::SymbolTable (const SymbolTable&)
+    : _airportDictionary ("airport"), _airlineDictionary ("airline"),
+      _classCodeDictionary ("booking class"),
+      _segmentDateDictionary ("segment-date") {
+    assert (false);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  SymbolTable::~SymbolTable() {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::SegmentDate* SymbolTable::
+  getSegmentDate (const SegmentDateID_T& iSegmentID) const {
+    if (iSegmentID >= _segmentDateBindingList.size()) {
+      return NULL;
+    }
+    return _segmentDateBindingList[iSegmentID]._segmentDate;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  AirportID_T SymbolTable::
+  getBoardingPointID (const SegmentDateID_T& iSegmentID) const {
+    if (iSegmentID >= _segmentDateBindingList.size()) {
+      return DEFAULT_NULL_SYMBOL_ID;
+    }
+    return _segmentDateBindingList[iSegmentID]._boardingPointID;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  AirportID_T SymbolTable::
+  getOffPointID (const SegmentDateID_T& iSegmentID) const {
+    if (iSegmentID >= _segmentDateBindingList.size()) {
+      return DEFAULT_NULL_SYMBOL_ID;
+    }
+    return _segmentDateBindingList[iSegmentID]._offPointID;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  std::size_t SymbolTable::getNbOfBytes() const {
+    // The dictionaries account for their own (embedded) size
+    std::size_t oNbOfBytes = sizeof (SymbolTable)
+      - 4 * sizeof (CodeDictionary)
+      + _airportDictionary.getNbOfBytes()
+      + _airlineDictionary.getNbOfBytes()
+      + _classCodeDictionary.getNbOfBytes()
+      + _segmentDateDictionary.getNbOfBytes()
+      + _segmentDateBindingList.capacity() * sizeof (SegmentDateBinding);
+    for (SegmentDateBindingList_T::const_iterator itBinding =
+           _segmentDateBindingList.begin();
+         itBinding != _segmentDateBindingList.end(); ++itBinding) {
+      oNbOfBytes += (itBinding->_bookingClassArray.capacity()
+                     * sizeof (stdair::BookingClass*));
+    }
+    return oNbOfBytes;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SymbolTable::bindSegmentDate (const SegmentDateID_T& iSegmentID,
+                                     stdair::SegmentDate& ioSegmentDate,
+                                     const AirportID_T& iBoardingPointID,
+                                     const AirportID_T& iOffPointID) {
+    assert (iSegmentID < _segmentDateDictionary.size());
+
+    // Make room for all the segment-dates interned so far
+    if (iSegmentID >= _segmentDateBindingList.size()) {
+      SegmentDateBinding lEmptyBinding;
+      lEmptyBinding._segmentDate = NULL;
+      lEmptyBinding._boardingPointID = DEFAULT_NULL_SYMBOL_ID;
+      lEmptyBinding._offPointID = DEFAULT_NULL_SYMBOL_ID;
+      _segmentDateBindingList.resize (_segmentDateDictionary.size(),
+                                      lEmptyBinding);
+    }
+
+    SegmentDateBinding& lBinding = _segmentDateBindingList[iSegmentID];
+    lBinding._segmentDate = &ioSegmentDate;
+    lBinding._boardingPointID = iBoardingPointID;
+    lBinding._offPointID = iOffPointID;
+    lBinding._bookingClassArray.clear();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SymbolTable::bindBookingClass (const SegmentDateID_T& iSegmentID,
+                                      const ClassCodeID_T& iClassID,
+                                      stdair::BookingClass& ioBookingClass) {
+    assert (iSegmentID < _segmentDateBindingList.size());
+    BookingClassArray_T& lClassArray =
+      _segmentDateBindingList[iSegmentID]._bookingClassArray;
+
+    if (iClassID >= lClassArray.size()) {
+      lClassArray.resize (iClassID + 1, NULL);
+    }
+    lClassArray[iClassID] = &ioBookingClass;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SymbolTable::unbindSegmentDates() {
+    _segmentDateBindingList.clear();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SymbolTable::clear() {
+    _airportDictionary.clear();
+    _airlineDictionary.clear();
+    _classCodeDictionary.clear();
+    _segmentDateDictionary.clear();
+    _segmentDateBindingList.clear();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SymbolTable::toStream (std::ostream& ioOut) const {
+    _airportDictionary.toStream (ioOut);
+    ioOut << std::endl;
+    _airlineDictionary.toStream (ioOut);
+    ioOut << std::endl;
+    _classCodeDictionary.toStream (ioOut);
+    ioOut << std::endl;
+    ioOut << _segmentDateDictionary.describe() << std::endl;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string SymbolTable::describe() const {
+    std::ostringstream oStr;
+    oStr << "Symbol table: " << _airportDictionary.describe()
+         << ", " << _airlineDictionary.describe()
+         << ", " << _classCodeDictionary.describe()
+         << ", " << _segmentDateDictionary.describe();
+    return oStr.str();
+  }
+
+}
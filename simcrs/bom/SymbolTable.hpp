@@ -0,0 +1,214 @@
+#ifndef __SIMCRS_BOM_SYMBOLTABLE_HPP
+#define __SIMCRS_BOM_SYMBOLTABLE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iosfwd>
+#include <string>
+#include <vector>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+#include <simcrs/bom/CodeDictionary.hpp>
+
+// Forward declarations
+namespace stdair {
+  class SegmentDate;
+  class BookingClass;
+}
+
+namespace SIMCRS {
+
+  /**
+   * @brief SimCRS-wide table of the interned codes (airports, airlines,
+   * booking classes and segment-dates).
+   *
+   * Once a segment-date has been bound to its (inventory) BOM object,
+   * its booking classes can be retrieved by a mere array indexing,
+   * with the interned class code identifier as index.
+   */
+  class SymbolTable {
+  public:
+    // ///////////////// Getters ///////////////////
+    /** Get the dictionary of the airport codes. */
+    CodeDictionary& getAirportDictionary() {
+      return _airportDictionary;
+    }
+
+    /** Get the dictionary of the airport codes. */
+    const CodeDictionary& getAirportDictionary() const {
+      return _airportDictionary;
+    }
+
+    /** Get the dictionary of the airline codes. */
+    CodeDictionary& getAirlineDictionary() {
+      return _airlineDictionary;
+    }
+
+    /** Get the dictionary of the airline codes. */
+    const CodeDictionary& getAirlineDictionary() const {
+      return _airlineDictionary;
+    }
+
+    /** Get the dictionary of the booking class codes. */
+    CodeDictionary& getClassCodeDictionary() {
+      return _classCodeDictionary;
+    }
+
+    /** Get the dictionary of the booking class codes. */
+    const CodeDictionary& getClassCodeDictionary() const {
+      return _classCodeDictionary;
+    }
+
+    /** Get the dictionary of the segment-date keys. */
+    CodeDictionary& getSegmentDateDictionary() {
+      return _segmentDateDictionary;
+    }
+
+    /** Get the dictionary of the segment-date keys. */
+    const CodeDictionary& getSegmentDateDictionary() const {
+      return _segmentDateDictionary;
+    }
+
+    /**
+     * Get the segment-date BOM object bound to the given identifier.
+     *
+     * @return stdair::SegmentDate* The segment-date, or NULL when no
+     *         BOM object has been bound to that identifier.
+     */
+    stdair::SegmentDate* getSegmentDate (const SegmentDateID_T&) const;
+
+    /**
+     * Get the booking class BOM object corresponding to the given
+     * segment-date and booking class code identifiers.
+     *
+     * @return stdair::BookingClass* The booking class, or NULL when
+     *         no such booking class has been bound.
+     */
+    stdair::BookingClass* getBookingClass (const SegmentDateID_T& iSegmentID,
+                                           const ClassCodeID_T& iClassID) const {
+      if (iSegmentID >= _segmentDateBindingList.size()) {
+        return NULL;
+      }
+      const BookingClassArray_T& lClassArray =
+        _segmentDateBindingList[iSegmentID]._bookingClassArray;
+      if (iClassID >= lClassArray.size()) {
+        return NULL;
+      }
+      return lClassArray[iClassID];
+    }
+
+    /**
+     * Get the boarding point identifier of the given (bound) segment-date.
+     */
+    AirportID_T getBoardingPointID (const SegmentDateID_T&) const;
+
+    /**
+     * Get the off point identifier of the given (bound) segment-date.
+     */
+    AirportID_T getOffPointID (const SegmentDateID_T&) const;
+
+    /**
+     * Get the (approximate) number of bytes held by the symbol table,
+     * i.e., by its dictionaries and segment-date bindings.
+     */
+    std::size_t getNbOfBytes() const;
+
+  public:
+    // ///////////////// Business Methods ///////////////////
+    /**
+     * Bind a segment-date identifier to the corresponding BOM object.
+     *
+     * @param const SegmentDateID_T& Identifier of the segment-date.
+     * @param stdair::SegmentDate& Segment-date BOM object.
+     * @param const AirportID_T& Identifier of the boarding point.
+     * @param const AirportID_T& Identifier of the off point.
+     */
+    void bindSegmentDate (const SegmentDateID_T&, stdair::SegmentDate&,
+                          const AirportID_T&, const AirportID_T&);
+
+    /**
+     * Bind a booking class to an already bound segment-date.
+     */
+    void bindBookingClass (const SegmentDateID_T&, const ClassCodeID_T&,
+                           stdair::BookingClass&);
+
+    /**
+     * Forget all the segment-date bindings, for instance when the BOM
+     * tree is re-built (the BOM objects are then no longer valid).
+     * The segment-date keys stay interned.
+     */
+    void unbindSegmentDates();
+
+    /**
+     * Forget all the interned codes and bindings.
+     */
+    void clear();
+
+  public:
+    // /////////////// Display Methods /////////////////
+    /**
+     * Dump the symbol table into an output stream.
+     */
+    void toStream (std::ostream&) const;
+
+    /**
+     * Short display of the symbol table.
+     */
+    const std::string describe() const;
+
+  public:
+    // //////////// Constructors and Destructors /////////////
+    /**
+     * Default constructor.
+     */
+    SymbolTable();
+
+    /**
+     * Destructor.
+     */
+    ~SymbolTable();
+
+  private:
+    /**
+     * Copy constructor (not to be used).
+     */
+    SymbolTable (const SymbolTable&);
+
+  private:
+    // /////////////// Type definitions /////////////////
+    /** Booking classes of a segment-date, indexed by class code identifier. */
+    typedef std::vector<stdair::BookingClass*> BookingClassArray_T;
+
+    /** Binding of a segment-date identifier to the BOM objects. */
+    struct SegmentDateBinding {
+      stdair::SegmentDate* _segmentDate;
+      AirportID_T _boardingPointID;
+      AirportID_T _offPointID;
+      BookingClassArray_T _bookingClassArray;
+    };
+
+    /** Bindings, indexed by segment-date identifier. */
+    typedef std::vector<SegmentDateBinding> SegmentDateBindingList_T;
+
+  private:
+    // //////////////// Attributes ///////////////////
+    /** Airport codes. */
+    CodeDictionary _airportDictionary;
+
+    /** Airline codes. */
+    CodeDictionary _airlineDictionary;
+
+    /** Booking class codes. */
+    CodeDictionary _classCodeDictionary;
+
+    /** Segment-date keys. */
+    CodeDictionary _segmentDateDictionary;
+
+    /** Bindings of the segment-dates to the BOM objects. */
+    SegmentDateBindingList_T _segmentDateBindingList;
+  };
+
+}
+#endif // __SIMCRS_BOM_SYMBOLTABLE_HPP
@@ -0,0 +1,204 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <fstream>
+#include <ostream>
+// SimCRS
+#include <simcrs/basic/BasConst_General.hpp>
+#include <simcrs/bom/TraceEventRecorder.hpp>
+
+namespace SIMCRS {
+
+  namespace {
+    /** Last recorder identifier handed out. */
+    std::atomic<unsigned long> gLastRecorderID (0);
+
+    /**
+     * Buffer of the calling thread, for the last recorder it has
+     * recorded events with (so that the look-up of the buffer is done
+     * only once per thread and recorder).
+     */
+    struct ThreadBufferCache {
+      unsigned long _recorderID;
+      void* _threadBuffer_ptr;
+    };
+    thread_local ThreadBufferCache tlThreadBufferCache = { 0, NULL };
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  TraceEventRecorder::TraceEventRecorder()
+    : _recorderID (++gLastRecorderID), _originTime (Clock_T::now()),
+      _isEnabled (false) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  TraceEventRecorder::TraceEventRecorder (const TraceEventRecorder&)
+    : _recorderID (++gLastRecorderID), _originTime (Clock_T::now()),
+      _isEnabled (false) {
+    assert (false);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  TraceEventRecorder::~TraceEventRecorder() {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  std::size_t TraceEventRecorder::getNbOfEvents() const {
+    std::size_t oNbOfEvents = 0;
+    std::lock_guard<std::mutex> lGuard (_mutex);
+    for (ThreadBufferList_T::const_iterator itBuffer =
+           _threadBufferList.begin();
+         itBuffer != _threadBufferList.end(); ++itBuffer) {
+      const ThreadBufferPtr_T& lThreadBuffer_ptr = *itBuffer;
+      assert (lThreadBuffer_ptr != NULL);
+      std::lock_guard<std::mutex> lBufferGuard (lThreadBuffer_ptr->_mutex);
+      oNbOfEvents += lThreadBuffer_ptr->_eventList.size();
+    }
+    return oNbOfEvents;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  TraceEventRecorder::ThreadBuffer& TraceEventRecorder::getThreadBuffer() {
+    if (tlThreadBufferCache._recorderID == _recorderID) {
+      assert (tlThreadBufferCache._threadBuffer_ptr != NULL);
+      return *static_cast<ThreadBuffer*> (tlThreadBufferCache.
+                                          _threadBuffer_ptr);
+    }
+
+    // Look for the buffer of the calling thread, creating it if needed
+    const std::thread::id lThreadID = std::this_thread::get_id();
+    ThreadBuffer* lThreadBuffer_ptr = NULL;
+    std::lock_guard<std::mutex> lGuard (_mutex);
+    for (ThreadBufferList_T::const_iterator itBuffer =
+           _threadBufferList.begin();
+         itBuffer != _threadBufferList.end(); ++itBuffer) {
+      const ThreadBufferPtr_T& lBuffer_ptr = *itBuffer;
+      assert (lBuffer_ptr != NULL);
+      if (lBuffer_ptr->_threadID == lThreadID) {
+        lThreadBuffer_ptr = lBuffer_ptr.get();
+        break;
+      }
+    }
+
+    if (lThreadBuffer_ptr == NULL) {
+      const ThreadBufferPtr_T lBuffer_ptr (new ThreadBuffer());
+      lBuffer_ptr->_threadID = lThreadID;
+      lBuffer_ptr->_threadNumber = _threadBufferList.size() + 1;
+      lBuffer_ptr->_eventList.reserve (DEFAULT_TRACE_EVENT_BUFFER_SIZE);
+      _threadBufferList.push_back (lBuffer_ptr);
+      lThreadBuffer_ptr = lBuffer_ptr.get();
+    }
+
+    tlThreadBufferCache._recorderID = _recorderID;
+    tlThreadBufferCache._threadBuffer_ptr = lThreadBuffer_ptr;
+    return *lThreadBuffer_ptr;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void TraceEventRecorder::doRecord (const char* iName,
+                                     const char* iCategory,
+                                     const char iPhase) {
+    const Clock_T::duration lElapsed = Clock_T::now() - _originTime;
+    const std::chrono::nanoseconds lElapsedNs =
+      std::chrono::duration_cast<std::chrono::nanoseconds> (lElapsed);
+
+    Event lEvent;
+    lEvent._name = iName;
+    lEvent._category = iCategory;
+    lEvent._phase = iPhase;
+    lEvent._time = lElapsedNs.count();
+
+    ThreadBuffer& lThreadBuffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lBufferGuard (lThreadBuffer._mutex);
+    lThreadBuffer._eventList.push_back (lEvent);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void TraceEventRecorder::clear() {
+    std::lock_guard<std::mutex> lGuard (_mutex);
+    for (ThreadBufferList_T::const_iterator itBuffer =
+           _threadBufferList.begin();
+         itBuffer != _threadBufferList.end(); ++itBuffer) {
+      const ThreadBufferPtr_T& lThreadBuffer_ptr = *itBuffer;
+      assert (lThreadBuffer_ptr != NULL);
+      std::lock_guard<std::mutex> lBufferGuard (lThreadBuffer_ptr->_mutex);
+      lThreadBuffer_ptr->_eventList.clear();
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void TraceEventRecorder::dump (std::ostream& oStream) const {
+    /**
+     * The times are given in microseconds (with a nanosecond precision),
+     * as expected by the Chrome trace event format. The events of each
+     * thread are in chronological order.
+     */
+    oStream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    bool isFirstEvent = true;
+    std::lock_guard<std::mutex> lGuard (_mutex);
+    for (ThreadBufferList_T::const_iterator itBuffer =
+           _threadBufferList.begin();
+         itBuffer != _threadBufferList.end(); ++itBuffer) {
+      const ThreadBufferPtr_T& lThreadBuffer_ptr = *itBuffer;
+      assert (lThreadBuffer_ptr != NULL);
+      const ThreadBuffer& lThreadBuffer = *lThreadBuffer_ptr;
+
+      std::lock_guard<std::mutex> lBufferGuard (lThreadBuffer._mutex);
+      for (std::vector<Event>::const_iterator itEvent =
+             lThreadBuffer._eventList.begin();
+           itEvent != lThreadBuffer._eventList.end(); ++itEvent) {
+        const Event& lEvent = *itEvent;
+        if (isFirstEvent == false) {
+          oStream << ",";
+        }
+        isFirstEvent = false;
+
+        oStream << "\n{\"name\":\"" << lEvent._name << "\",\"cat\":\""
+                << lEvent._category << "\",\"ph\":\"" << lEvent._phase
+                << "\",\"ts\":" << lEvent._time / 1000 << "."
+                << static_cast<char> ('0' + lEvent._time / 100 % 10)
+                << static_cast<char> ('0' + lEvent._time / 10 % 10)
+                << static_cast<char> ('0' + lEvent._time % 10)
+                << ",\"pid\":1,\"tid\":" << lThreadBuffer._threadNumber
+                << "}";
+      }
+    }
+
+    oStream << "\n]}\n";
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void TraceEventRecorder::dump (const std::string& iFilename) const {
+    std::ofstream lTraceFile (iFilename.c_str());
+    dump (lTraceFile);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void TraceEventRecorder::lockBeforeFork() {
+    // Same order as when dumping or clearing the events
+    _mutex.lock();
+    for (ThreadBufferList_T::const_iterator itBuffer =
+           _threadBufferList.begin();
+         itBuffer != _threadBufferList.end(); ++itBuffer) {
+      const ThreadBufferPtr_T& lThreadBuffer_ptr = *itBuffer;
+      assert (lThreadBuffer_ptr != NULL);
+      lThreadBuffer_ptr->_mutex.lock();
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void TraceEventRecorder::unlockAfterFork() {
+    for (ThreadBufferList_T::const_iterator itBuffer =
+           _threadBufferList.begin();
+         itBuffer != _threadBufferList.end(); ++itBuffer) {
+      const ThreadBufferPtr_T& lThreadBuffer_ptr = *itBuffer;
+      assert (lThreadBuffer_ptr != NULL);
+      lThreadBuffer_ptr->_mutex.unlock();
+    }
+    _mutex.unlock();
+  }
+
+}
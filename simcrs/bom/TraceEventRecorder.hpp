@@ -0,0 +1,228 @@
+#ifndef __SIMCRS_BOM_TRACEEVENTRECORDER_HPP
+#define __SIMCRS_BOM_TRACEEVENTRECORDER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+// Boost
+#include <boost/shared_ptr.hpp>
+
+namespace SIMCRS {
+
+  /**
+   * @brief Recorder of trace events, i.e., of the begin and end of the
+   * stages of the requests served by SimCRS (and of the calls to the
+   * components it delegates to), to be dumped in the Chrome trace event
+   * (JSON) format, which can be loaded into chrome://tracing or Perfetto.
+   *
+   * Each thread records into its own buffer, so that the threads do not
+   * contend with each other while recording (the lock of a buffer is
+   * only taken by another thread when dumping or clearing the events).
+   * When the recording is disabled (the default), recording an event
+   * costs a single (atomic) flag check.
+   */
+  class TraceEventRecorder {
+    friend class TraceEventScope;
+  public:
+    // /////////////// Type definitions /////////////////
+    /** Number of nanoseconds, since the creation of the recorder. */
+    typedef unsigned long long Nanoseconds_T;
+
+    /**
+     * Trace event. The name and category are expected to be string
+     * literals (they are neither copied nor escaped).
+     */
+    struct Event {
+      /** Name of the stage. */
+      const char* _name;
+      /** Category of the stage (e.g., "simcrs", "airtsp"). */
+      const char* _category;
+      /** Phase of the event ('B' for begin, 'E' for end). */
+      char _phase;
+      /** Time of the event. */
+      Nanoseconds_T _time;
+    };
+
+  public:
+    // ///////////////// Getters ///////////////////
+    /**
+     * State whether the events are being recorded.
+     */
+    bool isEnabled() const {
+      return _isEnabled.load (std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the number of events recorded so far (by all the threads).
+     */
+    std::size_t getNbOfEvents() const;
+
+  public:
+    // ///////////////// Setters ///////////////////
+    /**
+     * Start or stop the recording of the events. The events recorded
+     * so far are kept.
+     */
+    void setEnabled (const bool iIsEnabled) {
+      _isEnabled.store (iIsEnabled, std::memory_order_relaxed);
+    }
+
+  public:
+    // ///////////////// Business Methods ///////////////////
+    /**
+     * Record an event into the buffer of the calling thread, when the
+     * recording is enabled.
+     */
+    void record (const char* iName, const char* iCategory,
+                 const char iPhase) {
+      if (isEnabled() == true) {
+        doRecord (iName, iCategory, iPhase);
+      }
+    }
+
+    /**
+     * Discard the events recorded so far.
+     */
+    void clear();
+
+    /**
+     * Dump the events recorded so far, in the Chrome trace event (JSON)
+     * format, into the given output stream.
+     */
+    void dump (std::ostream&) const;
+
+    /**
+     * Dump the events recorded so far (see above) into the given file.
+     */
+    void dump (const std::string& iFilename) const;
+
+    /**
+     * Take the locks of the recorder (of the list of the thread buffers,
+     * then of every buffer) before forking the process, so that the
+     * child does not inherit them in the middle of a recording.
+     */
+    void lockBeforeFork();
+
+    /**
+     * Release the locks taken by lockBeforeFork(), in the parent as well
+     * as in the child process (where they are held by the copy of the
+     * forking thread).
+     */
+    void unlockAfterFork();
+
+  public:
+    // //////////// Constructors and Destructors /////////////
+    /**
+     * Default constructor.
+     */
+    TraceEventRecorder();
+
+    /**
+     * Destructor.
+     */
+    ~TraceEventRecorder();
+
+  private:
+    /**
+     * Copy constructor (not to be used).
+     */
+    TraceEventRecorder (const TraceEventRecorder&);
+
+  private:
+    // /////////////// Type definitions /////////////////
+    /** Monotonic clock. */
+    typedef std::chrono::steady_clock Clock_T;
+
+    /** Buffer of the events recorded by a given thread. */
+    struct ThreadBuffer {
+      /** Thread recording into the buffer. */
+      std::thread::id _threadID;
+      /** Sequential identifier of the thread, as shown in the trace. */
+      unsigned int _threadNumber;
+      /** Lock of the buffer (only contended while dumping/clearing). */
+      mutable std::mutex _mutex;
+      /** Recorded events. */
+      std::vector<Event> _eventList;
+    };
+    typedef boost::shared_ptr<ThreadBuffer> ThreadBufferPtr_T;
+    typedef std::list<ThreadBufferPtr_T> ThreadBufferList_T;
+
+  private:
+    // ///////////////// Business Methods ///////////////////
+    /**
+     * Record an event into the buffer of the calling thread.
+     */
+    void doRecord (const char* iName, const char* iCategory,
+                   const char iPhase);
+
+    /**
+     * Get the buffer of the calling thread, creating it if needed.
+     */
+    ThreadBuffer& getThreadBuffer();
+
+  private:
+    // //////////////// Attributes ///////////////////
+    /** Identifier of the recorder (distinct for all the recorders). */
+    const unsigned long _recorderID;
+
+    /** Time origin of the events. */
+    const Clock_T::time_point _originTime;
+
+    /** Whether the events are being recorded. */
+    std::atomic<bool> _isEnabled;
+
+    /** Lock of the list of the thread buffers. */
+    mutable std::mutex _mutex;
+
+    /** Buffers of the threads having recorded events. */
+    ThreadBufferList_T _threadBufferList;
+  };
+
+  /**
+   * @brief Guard recording the begin and end events of a stage, at the
+   * beginning and end of its scope. Nothing is recorded when the
+   * recording is disabled at the beginning of the scope; otherwise, the
+   * end event is always recorded, so that the events stay balanced.
+   */
+  class TraceEventScope {
+  public:
+    /** Constructor. */
+    TraceEventScope (TraceEventRecorder& ioTraceEventRecorder,
+                     const char* iName, const char* iCategory)
+      : _traceEventRecorder_ptr (NULL), _name (iName),
+        _category (iCategory) {
+      if (ioTraceEventRecorder.isEnabled() == true) {
+        _traceEventRecorder_ptr = &ioTraceEventRecorder;
+        _traceEventRecorder_ptr->doRecord (_name, _category, 'B');
+      }
+    }
+    /** Destructor. */
+    ~TraceEventScope() {
+      if (_traceEventRecorder_ptr != NULL) {
+        _traceEventRecorder_ptr->doRecord (_name, _category, 'E');
+      }
+    }
+  private:
+    /** Copy constructor (not to be used). */
+    TraceEventScope (const TraceEventScope&);
+  private:
+    /** Recorder (NULL when not recording). */
+    TraceEventRecorder* _traceEventRecorder_ptr;
+    /** Name of the stage. */
+    const char* _name;
+    /** Category of the stage. */
+    const char* _category;
+  };
+
+}
+#endif // __SIMCRS_BOM_TRACEEVENTRECORDER_HPP
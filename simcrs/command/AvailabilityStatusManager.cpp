@@ -0,0 +1,299 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <algorithm>
+#include <cassert>
+#include <list>
+#include <vector>
+// StdAir
+#include <stdair/bom/BookingClass.hpp>
+#include <stdair/bom/FareOptionStruct.hpp>
+#include <stdair/bom/TravelSolutionStruct.hpp>
+#include <stdair/service/Logger.hpp>
+// Airline Inventory
+#include <airinv/AIRINV_Master_Service.hpp>
+// SimCRS
+#include <simcrs/basic/BasConst_General.hpp>
+#include <simcrs/bom/SymbolTable.hpp>
+#include <simcrs/bom/AvailabilityStatusTable.hpp>
+#include <simcrs/command/SymbolManager.hpp>
+#include <simcrs/command/AvailabilityStatusManager.hpp>
+
+namespace SIMCRS {
+
+  // ////////////////////////////////////////////////////////////////////
+  void AvailabilityStatusManager::
+  pushSegmentDate (const SymbolTable& iSymbolTable,
+                   AvailabilityStatusTable& ioAvailabilityStatusTable,
+                   const SegmentDateID_T& iSegmentDateID) {
+    if (iSymbolTable.getSegmentDate (iSegmentDateID) == NULL) {
+      return;
+    }
+
+    // Make room for all the segment-dates and class codes known so far
+    const ClassCodeID_T lNbOfClassCodes =
+      iSymbolTable.getClassCodeDictionary().size();
+    ioAvailabilityStatusTable.
+      reserve (iSymbolTable.getSegmentDateDictionary().size(),
+               lNbOfClassCodes);
+    for (ClassCodeID_T lClassCodeID = 0; lClassCodeID != lNbOfClassCodes;
+         ++lClassCodeID) {
+      const stdair::BookingClass* lBookingClass_ptr =
+        iSymbolTable.getBookingClass (iSegmentDateID, lClassCodeID);
+      if (lBookingClass_ptr == NULL) {
+        continue;
+      }
+      ioAvailabilityStatusTable.
+        setStatus (iSegmentDateID, lClassCodeID,
+                   lBookingClass_ptr->getSegmentAvailability());
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void AvailabilityStatusManager::
+  pushSegmentPath (const stdair::BomRoot& iBomRoot,
+                   SymbolTable& ioSymbolTable,
+                   AvailabilityStatusTable& ioAvailabilityStatusTable,
+                   const stdair::KeyList_T& iSegmentPath) {
+    for (stdair::KeyList_T::const_iterator itKey = iSegmentPath.begin();
+         itKey != iSegmentPath.end(); ++itKey) {
+      const std::string& lSegmentDateKey = *itKey;
+      const SegmentDateID_T lSegmentDateID =
+        SymbolManager::internSegmentDate (iBomRoot, ioSymbolTable,
+                                          lSegmentDateKey);
+      pushSegmentDate (ioSymbolTable, ioAvailabilityStatusTable,
+                       lSegmentDateID);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void AvailabilityStatusManager::
+  pushAll (const SymbolTable& iSymbolTable,
+           AvailabilityStatusTable& ioAvailabilityStatusTable) {
+    // The storage is kept (and, if needed, enlarged), as it may be read
+    // meanwhile
+    const SegmentDateID_T lNbOfSegmentDates =
+      iSymbolTable.getSegmentDateDictionary().size();
+    ioAvailabilityStatusTable.
+      reserve (lNbOfSegmentDates, iSymbolTable.getClassCodeDictionary().size());
+    ioAvailabilityStatusTable.resetStatuses();
+    for (SegmentDateID_T lSegmentDateID = 0;
+         lSegmentDateID != lNbOfSegmentDates; ++lSegmentDateID) {
+      pushSegmentDate (iSymbolTable, ioAvailabilityStatusTable,
+                       lSegmentDateID);
+    }
+    ioAvailabilityStatusTable.clearPendingPushes();
+
+    // DEBUG
+    STDAIR_LOG_DEBUG (ioAvailabilityStatusTable.describe());
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void AvailabilityStatusManager::
+  notifySegmentDate (const SymbolTable& iSymbolTable,
+                     AvailabilityStatusTable& ioAvailabilityStatusTable,
+                     const SegmentDateID_T& iSegmentDateID) {
+    const bool areDue =
+      ioAvailabilityStatusTable.addPendingSegmentDate (iSegmentDateID);
+    if (areDue == true) {
+      flush (iSymbolTable, ioAvailabilityStatusTable);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void AvailabilityStatusManager::
+  notifySegmentPath (const stdair::BomRoot& iBomRoot,
+                     SymbolTable& ioSymbolTable,
+                     AvailabilityStatusTable& ioAvailabilityStatusTable,
+                     const stdair::KeyList_T& iSegmentPath) {
+    // The changes of a segment path count as a single change
+    bool areDue = false;
+    for (stdair::KeyList_T::const_iterator itKey = iSegmentPath.begin();
+         itKey != iSegmentPath.end(); ++itKey) {
+      const std::string& lSegmentDateKey = *itKey;
+      const SegmentDateID_T lSegmentDateID =
+        SymbolManager::internSegmentDate (iBomRoot, ioSymbolTable,
+                                          lSegmentDateKey);
+      if (itKey == iSegmentPath.begin()) {
+        areDue =
+          ioAvailabilityStatusTable.addPendingSegmentDate (lSegmentDateID);
+      } else {
+        ioAvailabilityStatusTable.addPendingSegmentDate (lSegmentDateID);
+      }
+    }
+    if (areDue == true) {
+      flush (ioSymbolTable, ioAvailabilityStatusTable);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void AvailabilityStatusManager::
+  notifyAll (const SymbolTable& iSymbolTable,
+             AvailabilityStatusTable& ioAvailabilityStatusTable) {
+    const bool areDue = ioAvailabilityStatusTable.addPendingFullPush();
+    if (areDue == true) {
+      flush (iSymbolTable, ioAvailabilityStatusTable);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void AvailabilityStatusManager::
+  flush (const SymbolTable& iSymbolTable,
+         AvailabilityStatusTable& ioAvailabilityStatusTable) {
+    if (ioAvailabilityStatusTable.isFullPushPending() == true) {
+      pushAll (iSymbolTable, ioAvailabilityStatusTable);
+      return;
+    }
+
+    // A segment-date changed several times is pushed only once
+    std::vector<SegmentDateID_T> lSegmentDateIDList =
+      ioAvailabilityStatusTable.getPendingSegmentDateList();
+    std::sort (lSegmentDateIDList.begin(), lSegmentDateIDList.end());
+    lSegmentDateIDList.erase (std::unique (lSegmentDateIDList.begin(),
+                                           lSegmentDateIDList.end()),
+                              lSegmentDateIDList.end());
+    for (std::vector<SegmentDateID_T>::const_iterator itSegmentDateID =
+           lSegmentDateIDList.begin();
+         itSegmentDateID != lSegmentDateIDList.end(); ++itSegmentDateID) {
+      pushSegmentDate (iSymbolTable, ioAvailabilityStatusTable,
+                       *itSegmentDateID);
+    }
+    ioAvailabilityStatusTable.clearPendingPushes();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool AvailabilityStatusManager::
+  calculateAvailability (const SymbolTable& iSymbolTable,
+                         const AvailabilityStatusTable& iAvailabilityStatusTable,
+                         stdair::TravelSolutionStruct& ioTravelSolution) {
+    typedef std::list<stdair::ClassAvailabilityMap_T> ClassAvlMapList_T;
+    typedef std::list<stdair::ClassObjectIDMap_T> ClassIDMapList_T;
+    typedef std::vector<SegmentDateID_T> SegmentIDList_T;
+
+    const CodeDictionary& lClassCodeDictionary =
+      iSymbolTable.getClassCodeDictionary();
+
+    // Read the availability of the booking classes of every segment-date
+    ClassAvlMapList_T lClassAvlMapList;
+    ClassIDMapList_T lClassIDMapList;
+    SegmentIDList_T lSegmentIDList;
+    const stdair::KeyList_T& lSegmentPath = ioTravelSolution.getSegmentPath();
+    for (stdair::KeyList_T::const_iterator itKey = lSegmentPath.begin();
+         itKey != lSegmentPath.end(); ++itKey) {
+      const std::string& lSegmentDateKey = *itKey;
+      const SegmentDateID_T lSegmentDateID =
+        SymbolManager::findSegmentDate (iSymbolTable, lSegmentDateKey);
+      if (lSegmentDateID == DEFAULT_NULL_SYMBOL_ID
+          || iAvailabilityStatusTable.hasSegmentDate (lSegmentDateID)
+          == false) {
+        return false;
+      }
+      lSegmentIDList.push_back (lSegmentDateID);
+
+      const ClassCodeID_T lNbOfClassCodes = lClassCodeDictionary.size();
+      stdair::ClassAvailabilityMap_T lClassAvlMap;
+      stdair::ClassObjectIDMap_T lClassIDMap;
+      for (ClassCodeID_T lClassCodeID = 0; lClassCodeID != lNbOfClassCodes;
+           ++lClassCodeID) {
+        const AvailabilityStatus_T lStatus =
+          iAvailabilityStatusTable.getStatus (lSegmentDateID, lClassCodeID);
+        stdair::BookingClass* lBookingClass_ptr =
+          iSymbolTable.getBookingClass (lSegmentDateID, lClassCodeID);
+        if (lStatus == AvailabilityStatusTable::K_UNKNOWN_STATUS
+            || lBookingClass_ptr == NULL) {
+          continue;
+        }
+
+        const stdair::ClassCode_T& lClassCode =
+          lClassCodeDictionary.getCode (lClassCodeID);
+        const stdair::Availability_T lAvailability (lStatus);
+        lClassAvlMap.insert (stdair::ClassAvailabilityMap_T::
+                             value_type (lClassCode, lAvailability));
+        const stdair::BookingClassID_T lClassID (*lBookingClass_ptr);
+        lClassIDMap.insert (stdair::ClassObjectIDMap_T::
+                            value_type (lClassCode, lClassID));
+      }
+      lClassAvlMapList.push_back (lClassAvlMap);
+      lClassIDMapList.push_back (lClassIDMap);
+    }
+
+    // Fill the travel solution
+    ClassIDMapList_T::const_iterator itClassIDMap = lClassIDMapList.begin();
+    for (ClassAvlMapList_T::const_iterator itClassAvlMap =
+           lClassAvlMapList.begin();
+         itClassAvlMap != lClassAvlMapList.end();
+         ++itClassAvlMap, ++itClassIDMap) {
+      ioTravelSolution.addClassAvailabilityMap (*itClassAvlMap);
+      ioTravelSolution.addClassObjectIDMap (*itClassIDMap);
+    }
+
+    // The availability of a fare option is the lowest availability
+    // of the booking classes of its class path
+    stdair::FareOptionList_T& lFareOptionList =
+      ioTravelSolution.getFareOptionListRef();
+    for (stdair::FareOptionList_T::iterator itFO = lFareOptionList.begin();
+         itFO != lFareOptionList.end(); ++itFO) {
+      stdair::FareOptionStruct& lFareOption = *itFO;
+      const stdair::ClassList_StringList_T& lClassPath =
+        lFareOption.getClassPath();
+
+      AvailabilityStatus_T lMinStatus = AvailabilityStatusTable::K_MAX_STATUS;
+      SegmentIDList_T::const_iterator itSegmentID = lSegmentIDList.begin();
+      for (stdair::ClassList_StringList_T::const_iterator itClassList =
+             lClassPath.begin();
+           itClassList != lClassPath.end()
+             && itSegmentID != lSegmentIDList.end();
+           ++itClassList, ++itSegmentID) {
+        const stdair::ClassList_String_T& lClassList = *itClassList;
+        assert (lClassList.empty() == false);
+        const ClassCodeID_T lClassCodeID =
+          lClassCodeDictionary.find (lClassList.at(0));
+        AvailabilityStatus_T lStatus =
+          iAvailabilityStatusTable.getStatus (*itSegmentID, lClassCodeID);
+        if (lStatus == AvailabilityStatusTable::K_UNKNOWN_STATUS) {
+          lStatus = 0;
+        }
+        if (lStatus < lMinStatus) {
+          lMinStatus = lStatus;
+        }
+      }
+
+      lFareOption.setAvailability (lMinStatus);
+    }
+
+    return true;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void AvailabilityStatusManager::
+  calculateAvailability (AIRINV::AIRINV_Master_Service& ioAIRINV_Master_Service,
+                         const stdair::BomRoot& iBomRoot,
+                         SymbolTable& ioSymbolTable,
+                         AvailabilityStatusTable& ioAvailabilityStatusTable,
+                         stdair::TravelSolutionList_T& ioTravelSolutionList) {
+    for (stdair::TravelSolutionList_T::iterator itTS =
+           ioTravelSolutionList.begin();
+         itTS != ioTravelSolutionList.end(); ++itTS) {
+      stdair::TravelSolutionStruct& lCurrentTravelSolution = *itTS;
+
+      const bool isFromAVS =
+        calculateAvailability (ioSymbolTable, ioAvailabilityStatusTable,
+                               lCurrentTravelSolution);
+      if (isFromAVS == true) {
+        continue;
+      }
+
+      // Not all the segment-dates are known from the AVS table:
+      // forward the work to the airline inventory, and have it push
+      // the availability of those segment-dates, for the next requests
+      ioAIRINV_Master_Service.calculateAvailability (lCurrentTravelSolution);
+
+      const stdair::KeyList_T& lSegmentPath =
+        lCurrentTravelSolution.getSegmentPath();
+      pushSegmentPath (iBomRoot, ioSymbolTable, ioAvailabilityStatusTable,
+                       lSegmentPath);
+    }
+  }
+
+}
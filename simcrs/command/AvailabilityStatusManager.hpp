@@ -0,0 +1,132 @@
+#ifndef __SIMCRS_CMD_AVAILABILITYSTATUSMANAGER_HPP
+#define __SIMCRS_CMD_AVAILABILITYSTATUSMANAGER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/bom/TravelSolutionTypes.hpp>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+
+// Forward declarations
+namespace stdair {
+  class BomRoot;
+  struct TravelSolutionStruct;
+}
+
+namespace AIRINV {
+  class AIRINV_Master_Service;
+}
+
+namespace SIMCRS {
+
+  // Forward declarations
+  class SymbolTable;
+  class AvailabilityStatusTable;
+
+  /**
+   * @brief Command handling the availability status (AVS) table of the
+   * CRS: pushes of the availability changes of the airline inventory,
+   * and availability calculation from that table.
+   */
+  class AvailabilityStatusManager {
+    friend class SIMCRS_Service;
+    friend class ShoppingManager;
+  private:
+    /**
+     * Push the current availability of all the booking classes of the
+     * given (bound) segment-date into the AVS table.
+     */
+    static void pushSegmentDate (const SymbolTable&, AvailabilityStatusTable&,
+                                 const SegmentDateID_T&);
+
+    /**
+     * Push the current availability of all the booking classes of the
+     * segment-dates of the given segment path into the AVS table.
+     */
+    static void pushSegmentPath (const stdair::BomRoot&, SymbolTable&,
+                                 AvailabilityStatusTable&,
+                                 const stdair::KeyList_T&);
+
+    /**
+     * (Re-)Build the whole AVS table, from all the segment-dates bound
+     * within the symbol table. The pending pushes, if any, are thereby
+     * made.
+     */
+    static void pushAll (const SymbolTable&, AvailabilityStatusTable&);
+
+    /**
+     * Record a change of the airline inventory (e.g., a sale) on the
+     * given segment-date. Its availability is pushed into the AVS table
+     * at once or, when the pushes are deferred (see
+     * AvailabilityStatusTable::setPushInterval()), with the next batch.
+     */
+    static void notifySegmentDate (const SymbolTable&,
+                                   AvailabilityStatusTable&,
+                                   const SegmentDateID_T&);
+
+    /**
+     * Record a change of the airline inventory (e.g., a cancellation) on
+     * the segment-dates of the given segment path (see
+     * notifySegmentDate()).
+     */
+    static void notifySegmentPath (const stdair::BomRoot&, SymbolTable&,
+                                   AvailabilityStatusTable&,
+                                   const stdair::KeyList_T&);
+
+    /**
+     * Record a change of the airline inventory which may affect any
+     * segment-date (e.g., an optimisation): the whole AVS table is pushed
+     * again, at once or with the next batch (see notifySegmentDate()).
+     */
+    static void notifyAll (const SymbolTable&, AvailabilityStatusTable&);
+
+    /**
+     * Make the pending pushes, i.e., push the availability of the
+     * segment-dates changed since the last pushes.
+     */
+    static void flush (const SymbolTable&, AvailabilityStatusTable&);
+
+    /**
+     * Calculate the availability of the given travel solutions from the
+     * AVS table, rather than by querying the airline inventory. The
+     * travel solutions with segment-dates not (yet) held by the AVS
+     * table are handed over to the airline inventory, which then pushes
+     * the availability of those segment-dates (initial load). From then
+     * on, the AVS table is updated only by the pushes following the
+     * changes of the airline inventory.
+     */
+    static void calculateAvailability (AIRINV::AIRINV_Master_Service&,
+                                       const stdair::BomRoot&, SymbolTable&,
+                                       AvailabilityStatusTable&,
+                                       stdair::TravelSolutionList_T&);
+
+  private:
+    /**
+     * Calculate the availability of the given travel solution from the
+     * AVS table: the availability of the booking classes of every
+     * segment, as well as the availability of the fare options (i.e.,
+     * the lowest availability along their class paths).
+     *
+     * The AVS table and the symbol table are only read (the segment-dates
+     * are looked up, not interned).
+     *
+     * @return bool Whether all the segment-dates are held by the AVS
+     *         table. When not, the travel solution is left untouched.
+     */
+    static bool calculateAvailability (const SymbolTable&,
+                                       const AvailabilityStatusTable&,
+                                       stdair::TravelSolutionStruct&);
+
+  private:
+    /** Constructors. */
+    AvailabilityStatusManager() {}
+    AvailabilityStatusManager(const AvailabilityStatusManager&) {}
+    /** Destructor. */
+    ~AvailabilityStatusManager() {}
+  };
+
+}
+#endif // __SIMCRS_CMD_AVAILABILITYSTATUSMANAGER_HPP
@@ -0,0 +1,166 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+// StdAir
+#include <stdair/bom/BomManager.hpp>
+#include <stdair/bom/BomRoot.hpp>
+#include <stdair/bom/Inventory.hpp>
+#include <stdair/bom/FlightDate.hpp>
+#include <stdair/bom/LegDate.hpp>
+#include <stdair/bom/LegCabin.hpp>
+#include <stdair/bom/SegmentDate.hpp>
+#include <stdair/bom/SegmentCabin.hpp>
+#include <stdair/bom/BookingClass.hpp>
+// SimCRS
+#include <simcrs/command/BookingClassCollector.hpp>
+
+namespace SIMCRS {
+
+  // ////////////////////////////////////////////////////////////////////
+  void BookingClassCollector::
+  collect (const stdair::BomRoot& iBomRoot,
+           const stdair::AirlineCode_T& iAirlineCode,
+           SegmentDateClassesList_T& ioSegmentDateList) {
+    if (stdair::BomManager::hasList<stdair::Inventory> (iBomRoot) == false) {
+      return;
+    }
+
+    // Browse the inventories
+    const stdair::InventoryList_T& lInventoryList =
+      stdair::BomManager::getList<stdair::Inventory> (iBomRoot);
+    for (stdair::InventoryList_T::const_iterator itInv = lInventoryList.begin();
+         itInv != lInventoryList.end(); ++itInv) {
+      const stdair::Inventory* lInv_ptr = *itInv;
+      assert (lInv_ptr != NULL);
+
+      if ((iAirlineCode.empty() == false
+           && lInv_ptr->getAirlineCode() != iAirlineCode)
+          || stdair::BomManager::hasList<stdair::FlightDate> (*lInv_ptr)
+          == false) {
+        continue;
+      }
+
+      // Browse the flight-dates
+      const stdair::FlightDateList_T& lFlightDateList =
+        stdair::BomManager::getList<stdair::FlightDate> (*lInv_ptr);
+      for (stdair::FlightDateList_T::const_iterator itFD =
+             lFlightDateList.begin(); itFD != lFlightDateList.end(); ++itFD) {
+        const stdair::FlightDate* lFD_ptr = *itFD;
+        assert (lFD_ptr != NULL);
+
+        if (stdair::BomManager::hasList<stdair::SegmentDate> (*lFD_ptr)
+            == false) {
+          continue;
+        }
+
+        // Browse the segment-dates
+        const stdair::SegmentDateList_T& lSegmentDateList =
+          stdair::BomManager::getList<stdair::SegmentDate> (*lFD_ptr);
+        for (stdair::SegmentDateList_T::const_iterator itSD =
+               lSegmentDateList.begin();
+             itSD != lSegmentDateList.end(); ++itSD) {
+          const stdair::SegmentDate* lSD_ptr = *itSD;
+          assert (lSD_ptr != NULL);
+
+          SegmentDateClassesStruct lSegmentDateClasses;
+          lSegmentDateClasses._key = lInv_ptr->describeKey() + ";"
+            + lFD_ptr->describeKey() + ";" + lSD_ptr->describeKey();
+
+          if (stdair::BomManager::hasList<stdair::SegmentCabin> (*lSD_ptr)
+              == true) {
+            // Browse the segment-cabins and their booking classes
+            const stdair::SegmentCabinList_T& lSegmentCabinList =
+              stdair::BomManager::getList<stdair::SegmentCabin> (*lSD_ptr);
+            for (stdair::SegmentCabinList_T::const_iterator itSC =
+                   lSegmentCabinList.begin();
+                 itSC != lSegmentCabinList.end(); ++itSC) {
+              const stdair::SegmentCabin* lSC_ptr = *itSC;
+              assert (lSC_ptr != NULL);
+
+              if (stdair::BomManager::hasList<stdair::BookingClass> (*lSC_ptr)
+                  == false) {
+                continue;
+              }
+
+              const stdair::BookingClassList_T& lBookingClassList =
+                stdair::BomManager::getList<stdair::BookingClass> (*lSC_ptr);
+              lSegmentDateClasses._bookingClassList.
+                insert (lSegmentDateClasses._bookingClassList.end(),
+                        lBookingClassList.begin(), lBookingClassList.end());
+            }
+          }
+
+          ioSegmentDateList.push_back (lSegmentDateClasses);
+        }
+      }
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BookingClassCollector::
+  collectLegCabins (const stdair::BomRoot& iBomRoot,
+                    LegCabinKeyList_T& ioLegCabinList) {
+    if (stdair::BomManager::hasList<stdair::Inventory> (iBomRoot) == false) {
+      return;
+    }
+
+    // Browse the inventories
+    const stdair::InventoryList_T& lInventoryList =
+      stdair::BomManager::getList<stdair::Inventory> (iBomRoot);
+    for (stdair::InventoryList_T::const_iterator itInv = lInventoryList.begin();
+         itInv != lInventoryList.end(); ++itInv) {
+      const stdair::Inventory* lInv_ptr = *itInv;
+      assert (lInv_ptr != NULL);
+
+      if (stdair::BomManager::hasList<stdair::FlightDate> (*lInv_ptr)
+          == false) {
+        continue;
+      }
+
+      // Browse the flight-dates
+      const stdair::FlightDateList_T& lFlightDateList =
+        stdair::BomManager::getList<stdair::FlightDate> (*lInv_ptr);
+      for (stdair::FlightDateList_T::const_iterator itFD =
+             lFlightDateList.begin(); itFD != lFlightDateList.end(); ++itFD) {
+        const stdair::FlightDate* lFD_ptr = *itFD;
+        assert (lFD_ptr != NULL);
+
+        if (stdair::BomManager::hasList<stdair::LegDate> (*lFD_ptr) == false) {
+          continue;
+        }
+
+        // Browse the leg-dates and their leg-cabins
+        const stdair::LegDateList_T& lLegDateList =
+          stdair::BomManager::getList<stdair::LegDate> (*lFD_ptr);
+        for (stdair::LegDateList_T::const_iterator itLD = lLegDateList.begin();
+             itLD != lLegDateList.end(); ++itLD) {
+          const stdair::LegDate* lLD_ptr = *itLD;
+          assert (lLD_ptr != NULL);
+
+          if (stdair::BomManager::hasList<stdair::LegCabin> (*lLD_ptr)
+              == false) {
+            continue;
+          }
+
+          const stdair::LegCabinList_T& lLegCabinList =
+            stdair::BomManager::getList<stdair::LegCabin> (*lLD_ptr);
+          for (stdair::LegCabinList_T::const_iterator itLC =
+                 lLegCabinList.begin(); itLC != lLegCabinList.end(); ++itLC) {
+            stdair::LegCabin* lLC_ptr = *itLC;
+            assert (lLC_ptr != NULL);
+
+            LegCabinKeyStruct lLegCabinKey;
+            lLegCabinKey._key = lInv_ptr->describeKey() + ";"
+              + lFD_ptr->describeKey() + ";" + lLD_ptr->describeKey() + ";"
+              + lLC_ptr->describeKey();
+            lLegCabinKey._legCabin_ptr = lLC_ptr;
+            ioLegCabinList.push_back (lLegCabinKey);
+          }
+        }
+      }
+    }
+  }
+
+}
@@ -0,0 +1,93 @@
+#ifndef __SIMCRS_CMD_BOOKINGCLASSCOLLECTOR_HPP
+#define __SIMCRS_CMD_BOOKINGCLASSCOLLECTOR_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <vector>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+
+// Forward declarations
+namespace stdair {
+  class BomRoot;
+  class BookingClass;
+  class LegCabin;
+}
+
+namespace SIMCRS {
+
+  /**
+   * @brief Booking classes of a segment-date, with the key of the latter
+   * (keys of its inventory, flight-date and segment-date, which do not
+   * depend on the process having loaded the BOM tree).
+   */
+  struct SegmentDateClassesStruct {
+    /** Key of the segment-date. */
+    std::string _key;
+    /** Booking classes of all the segment-cabins of the segment-date. */
+    std::vector<stdair::BookingClass*> _bookingClassList;
+  };
+
+  /**
+   * List of segment-dates, with their booking classes.
+   */
+  typedef std::vector<SegmentDateClassesStruct> SegmentDateClassesList_T;
+
+  /**
+   * @brief Leg-cabin, with its key (keys of its inventory, flight-date,
+   * leg-date and leg-cabin).
+   */
+  struct LegCabinKeyStruct {
+    /** Key of the leg-cabin. */
+    std::string _key;
+    /** Leg-cabin. */
+    stdair::LegCabin* _legCabin_ptr;
+  };
+
+  /**
+   * List of leg-cabins, with their keys.
+   */
+  typedef std::vector<LegCabinKeyStruct> LegCabinKeyList_T;
+
+  /**
+   * @brief Command collecting the booking classes of the segment-dates
+   * of a BOM tree, in the order of the latter.
+   */
+  class BookingClassCollector {
+    friend class CheckpointManager;
+  private:
+    /**
+     * Collect the booking classes of the segment-dates of the given BOM
+     * tree.
+     *
+     * @param const stdair::BomRoot& (Working) BOM tree.
+     * @param const stdair::AirlineCode_T& Code of the airline whose
+     *        segment-dates are collected (all of them when empty).
+     * @param SegmentDateClassesList_T& List to be filled.
+     */
+    static void collect (const stdair::BomRoot&,
+                         const stdair::AirlineCode_T&,
+                         SegmentDateClassesList_T&);
+
+    /**
+     * Collect the leg-cabins of the flight-dates of the given BOM tree
+     * (of all the airlines).
+     *
+     * @param const stdair::BomRoot& (Working) BOM tree.
+     * @param LegCabinKeyList_T& List to be filled.
+     */
+    static void collectLegCabins (const stdair::BomRoot&, LegCabinKeyList_T&);
+
+  private:
+    /** Constructors. */
+    BookingClassCollector() {}
+    BookingClassCollector(const BookingClassCollector&) {}
+    /** Destructor. */
+    ~BookingClassCollector() {}
+  };
+
+}
+#endif // __SIMCRS_CMD_BOOKINGCLASSCOLLECTOR_HPP
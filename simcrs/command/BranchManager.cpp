@@ -0,0 +1,247 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+// POSIX
+#include <errno.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+// StdAir
+#include <stdair/basic/BasChronometer.hpp>
+#include <stdair/service/Logger.hpp>
+// SimCRS
+#include <simcrs/command/BranchManager.hpp>
+#include <simcrs/service/SIMCRS_ServiceContext.hpp>
+
+namespace SIMCRS {
+
+  namespace {
+    /** Child process running a branch, and the pipe it writes into. */
+    struct BranchProcessStruct {
+      pid_t _processID;
+      int _readFileDescriptor;
+    };
+
+    /** Append the bytes of the given value to the given buffer. */
+    template <typename VALUE>
+    void appendValue (const VALUE& iValue, std::string& ioBuffer) {
+      ioBuffer.append (reinterpret_cast<const char*> (&iValue),
+                       sizeof (VALUE));
+    }
+
+    /**
+     * Read a value at the given position of the given buffer, and move
+     * the position after it.
+     *
+     * @return bool Whether the buffer was large enough.
+     */
+    template <typename VALUE>
+    bool readValue (const std::string& iBuffer, std::size_t& ioPosition,
+                    VALUE& oValue) {
+      if (iBuffer.size() - ioPosition < sizeof (VALUE)) {
+        return false;
+      }
+      std::memcpy (&oValue, iBuffer.data() + ioPosition, sizeof (VALUE));
+      ioPosition += sizeof (VALUE);
+      return true;
+    }
+
+    /** Number of minor page faults of the current process so far. */
+    long getNbOfMinorPageFaults() {
+      struct rusage lUsage;
+      ::getrusage (RUSAGE_SELF, &lUsage);
+      return lUsage.ru_minflt;
+    }
+
+    /**
+     * Run the given variant in the (child) current process, and write its
+     * result into the given file descriptor.
+     */
+    void runBranch (SIMCRS_Service& ioSIMCRS_Service,
+                    const WhatIfVariant_T& iVariant,
+                    const int iWriteFileDescriptor) {
+      const long lNbOfPageFaults = getNbOfMinorPageFaults();
+      stdair::BasChronometer lBranchChronometer;
+      lBranchChronometer.start();
+
+      WhatIfMetricList_T lMetricList;
+      std::uint8_t isSuccessful = 1;
+      try {
+        iVariant (ioSIMCRS_Service, lMetricList);
+
+      } catch (...) {
+        isSuccessful = 0;
+      }
+
+      const double lElapsedTime = lBranchChronometer.elapsed();
+      const long lNbOfBranchPageFaults =
+        getNbOfMinorPageFaults() - lNbOfPageFaults;
+      const std::uint64_t lPrivateMemorySize =
+        static_cast<std::uint64_t> (lNbOfBranchPageFaults)
+        * static_cast<std::uint64_t> (::sysconf (_SC_PAGESIZE));
+
+      // Result: success flag, elapsed time, private memory size, number of
+      // metrics and metrics
+      std::string lBuffer;
+      appendValue (isSuccessful, lBuffer);
+      appendValue (lElapsedTime, lBuffer);
+      appendValue (lPrivateMemorySize, lBuffer);
+      appendValue (static_cast<std::uint32_t> (lMetricList.size()), lBuffer);
+      for (WhatIfMetricList_T::const_iterator itMetric = lMetricList.begin();
+           itMetric != lMetricList.end(); ++itMetric) {
+        appendValue (*itMetric, lBuffer);
+      }
+
+      const char* lData_ptr = lBuffer.data();
+      std::size_t lLeft = lBuffer.size();
+      while (lLeft != 0) {
+        const ssize_t lWritten =
+          ::write (iWriteFileDescriptor, lData_ptr, lLeft);
+        if (lWritten < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          break;
+        }
+        lData_ptr += lWritten;
+        lLeft -= static_cast<std::size_t> (lWritten);
+      }
+    }
+
+    /**
+     * Read the result sent by the given child process, until it closes
+     * its pipe, then wait for that process to end.
+     */
+    WhatIfResultStruct readBranch (const BranchProcessStruct& iProcess) {
+      WhatIfResultStruct oResult;
+
+      std::string lBuffer;
+      char lChunk[4096];
+      while (true) {
+        const ssize_t lRead =
+          ::read (iProcess._readFileDescriptor, lChunk, sizeof (lChunk));
+        if (lRead < 0 && errno == EINTR) {
+          continue;
+        }
+        if (lRead <= 0) {
+          break;
+        }
+        lBuffer.append (lChunk, static_cast<std::size_t> (lRead));
+      }
+      ::close (iProcess._readFileDescriptor);
+
+      int lStatus = 0;
+      while (::waitpid (iProcess._processID, &lStatus, 0) < 0
+             && errno == EINTR) {
+      }
+      const bool hasExited = (WIFEXITED (lStatus)
+                              && WEXITSTATUS (lStatus) == 0);
+
+      // A branch which has crashed may have sent an incomplete result
+      std::size_t lPosition = 0;
+      std::uint8_t isSuccessful = 0;
+      std::uint64_t lPrivateMemorySize = 0;
+      std::uint32_t lNbOfMetrics = 0;
+      if (hasExited == false
+          || readValue (lBuffer, lPosition, isSuccessful) == false
+          || readValue (lBuffer, lPosition, oResult._elapsedTime) == false
+          || readValue (lBuffer, lPosition, lPrivateMemorySize) == false
+          || readValue (lBuffer, lPosition, lNbOfMetrics) == false
+          || lBuffer.size() - lPosition != lNbOfMetrics * sizeof (double)) {
+        return WhatIfResultStruct();
+      }
+
+      oResult._isSuccessful = (isSuccessful != 0);
+      oResult._privateMemorySize = lPrivateMemorySize;
+      oResult._metricList.resize (lNbOfMetrics);
+      for (std::uint32_t idx = 0; idx != lNbOfMetrics; ++idx) {
+        readValue (lBuffer, lPosition, oResult._metricList[idx]);
+      }
+      return oResult;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  WhatIfResultList_T BranchManager::
+  runBranches (SIMCRS_Service& ioSIMCRS_Service,
+               SIMCRS_ServiceContext& ioSIMCRS_ServiceContext,
+               const WhatIfVariantList_T& iVariantList,
+               const unsigned int iMaxNbOfConcurrentBranches) {
+    assert (iMaxNbOfConcurrentBranches != 0);
+    WhatIfResultList_T oResultList (iVariantList.size());
+
+    // The branches are run by batches of concurrent child processes
+    std::size_t idxBatch = 0;
+    while (idxBatch != iVariantList.size()) {
+      const std::size_t lBatchEnd =
+        std::min (iVariantList.size(),
+                  idxBatch + iMaxNbOfConcurrentBranches);
+
+      std::vector<BranchProcessStruct> lProcessList;
+      std::vector<std::size_t> lVariantIndexList;
+      for (std::size_t idx = idxBatch; idx != lBatchEnd; ++idx) {
+        int lPipe[2];
+        if (::pipe (lPipe) != 0) {
+          STDAIR_LOG_ERROR ("No pipe can be created for the what-if "
+                            << "branch #" << idx);
+          continue;
+        }
+
+        // The child must inherit neither a lock held by another thread,
+        // nor the buffered log output of the parent
+        ioSIMCRS_ServiceContext.lockBeforeFork();
+        const pid_t lProcessID = ::fork();
+        if (lProcessID == 0) {
+          // Child: run the variant, send the result back, and end without
+          // destroying the objects shared with the parent
+          ioSIMCRS_ServiceContext.resetAfterFork();
+          ::close (lPipe[0]);
+          runBranch (ioSIMCRS_Service, iVariantList[idx], lPipe[1]);
+          ::close (lPipe[1]);
+
+          // What the variant has logged would be lost by _exit()
+          ioSIMCRS_ServiceContext.flushLogStream();
+          ::_exit (0);
+        }
+        ioSIMCRS_ServiceContext.unlockAfterFork();
+
+        ::close (lPipe[1]);
+        if (lProcessID < 0) {
+          ::close (lPipe[0]);
+          STDAIR_LOG_ERROR ("The what-if branch #" << idx
+                            << " can not be forked");
+          continue;
+        }
+
+        BranchProcessStruct lProcess;
+        lProcess._processID = lProcessID;
+        lProcess._readFileDescriptor = lPipe[0];
+        lProcessList.push_back (lProcess);
+        lVariantIndexList.push_back (idx);
+      }
+
+      // Collect the results of the batch
+      for (std::size_t idxProcess = 0; idxProcess != lProcessList.size();
+           ++idxProcess) {
+        const std::size_t idx = lVariantIndexList[idxProcess];
+        oResultList[idx] = readBranch (lProcessList[idxProcess]);
+        if (oResultList[idx]._isSuccessful == false) {
+          STDAIR_LOG_DEBUG ("The what-if branch #" << idx << " has failed");
+        }
+      }
+
+      idxBatch = lBatchEnd;
+    }
+
+    return oResultList;
+  }
+
+}
@@ -0,0 +1,62 @@
+#ifndef __SIMCRS_CMD_BRANCHMANAGER_HPP
+#define __SIMCRS_CMD_BRANCHMANAGER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+
+namespace SIMCRS {
+
+  // Forward declarations
+  class SIMCRS_Service;
+  class SIMCRS_ServiceContext;
+
+  /**
+   * @brief Command running what-if variants of a simulation, each one in
+   * a child process forked from the current one.
+   *
+   * The children share, copy-on-write, the memory (and thus the BOM
+   * trees) of the current process: a branch only copies the pages it
+   * writes. Every child runs its variant, sends its metrics back through
+   * a pipe, and ends (through _exit(), without destroying the objects
+   * it shares with the current process).
+   *
+   * Every child is forked with all the locks of the service context
+   * held by the calling thread, and with the log stream flushed (see
+   * SIMCRS_ServiceContext::lockBeforeFork()); the child then resets the
+   * state left by the other threads of the parent, and releases those
+   * locks.
+   */
+  class BranchManager {
+    friend class SIMCRS_Service;
+  private:
+    /**
+     * Run the given variants, each one in its own child process (where
+     * only the calling thread exists).
+     *
+     * @param SIMCRS_Service& Service to be branched.
+     * @param SIMCRS_ServiceContext& Context of the service, locked when
+     *        forking, and reset in the children (which, e.g., detach
+     *        from its booking journal).
+     * @param const WhatIfVariantList_T& Variants to be run.
+     * @param const unsigned int Maximal number of children running at
+     *        the same time.
+     * @return WhatIfResultList_T Results, in the order of the variants.
+     */
+    static WhatIfResultList_T runBranches (SIMCRS_Service&,
+                                           SIMCRS_ServiceContext&,
+                                           const WhatIfVariantList_T&,
+                                           const unsigned int);
+
+  private:
+    /** Constructors. */
+    BranchManager() {}
+    BranchManager(const BranchManager&) {}
+    /** Destructor. */
+    ~BranchManager() {}
+  };
+
+}
+#endif // __SIMCRS_CMD_BRANCHMANAGER_HPP
@@ -0,0 +1,453 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+// StdAir
+#include <stdair/stdair_exceptions.hpp>
+#include <stdair/basic/BasChronometer.hpp>
+#include <stdair/bom/BomManager.hpp>
+#include <stdair/bom/BookingClass.hpp>
+#include <stdair/bom/SegmentCabin.hpp>
+#include <stdair/bom/LegCabin.hpp>
+#include <stdair/service/Logger.hpp>
+// SimCRS
+#include <simcrs/bom/MappedFile.hpp>
+#include <simcrs/command/BookingClassCollector.hpp>
+#include <simcrs/command/CheckpointManager.hpp>
+
+namespace SIMCRS {
+
+  namespace {
+    /** Signature starting the checkpoint files (the version 1 did not
+        hold the leg-cabins). */
+    const char K_CHECKPOINT_SIGNATURE[] = "SIMCRSC2";
+
+    /** Size (in bytes) of the signature. */
+    const std::size_t K_CHECKPOINT_SIGNATURE_SIZE = 8;
+
+    /** Number of counters checkpointed for every booking class. */
+    const std::size_t K_NB_OF_CLASS_COUNTERS = 7;
+
+    /** Checkpointed state of a booking class. */
+    struct BookingClassStateStruct {
+      stdair::ClassCode_T _classCode;
+      double _counterList[K_NB_OF_CLASS_COUNTERS];
+    };
+    typedef std::vector<BookingClassStateStruct> BookingClassStateList_T;
+
+    /** Checkpointed state of the segment-dates, by key. */
+    typedef std::unordered_map<std::string,
+                               BookingClassStateList_T> CheckpointMap_T;
+
+    /** Checkpointed state of a leg-cabin. */
+    struct LegCabinStateStruct {
+      stdair::BidPrice_T _currentBidPrice;
+      stdair::BidPrice_T _previousBidPrice;
+      stdair::BidPriceVector_T _bidPriceVector;
+    };
+
+    /** Checkpointed state of the leg-cabins, by key. */
+    typedef std::unordered_map<std::string,
+                               LegCabinStateStruct> LegCabinStateMap_T;
+
+    /** Checksum (FNV-1a) of the given bytes. */
+    std::uint32_t checksum (const char* iData_ptr, const std::size_t iSize) {
+      std::uint32_t oHash = 2166136261U;
+      for (std::size_t idx = 0; idx != iSize; ++idx) {
+        oHash ^= static_cast<unsigned char> (iData_ptr[idx]);
+        oHash *= 16777619U;
+      }
+      return oHash;
+    }
+
+    /** Append the bytes of the given value to the given buffer. */
+    template <typename VALUE>
+    void appendValue (const VALUE& iValue, std::string& ioBuffer) {
+      ioBuffer.append (reinterpret_cast<const char*> (&iValue),
+                       sizeof (VALUE));
+    }
+
+    /**
+     * Read a value at the beginning of the given content, and remove it
+     * from that content.
+     *
+     * @return bool Whether the content was large enough.
+     */
+    template <typename VALUE>
+    bool readValue (std::string_view& ioContent, VALUE& oValue) {
+      if (ioContent.size() < sizeof (VALUE)) {
+        return false;
+      }
+      std::memcpy (&oValue, ioContent.data(), sizeof (VALUE));
+      ioContent.remove_prefix (sizeof (VALUE));
+      return true;
+    }
+
+    /**
+     * Read a string, of the given size, at the beginning of the given
+     * content, and remove it from that content.
+     */
+    bool readString (std::string_view& ioContent, const std::size_t iSize,
+                     std::string& oString) {
+      if (ioContent.size() < iSize) {
+        return false;
+      }
+      oString.assign (ioContent.data(), iSize);
+      ioContent.remove_prefix (iSize);
+      return true;
+    }
+
+    /** Report that the given file is not a (complete) checkpoint. */
+    void throwNotACheckpoint (const stdair::Filename_T& iFilename) {
+      std::ostringstream oMessage;
+      oMessage << "The file '" << iFilename
+               << "' is not a complete SimCRS checkpoint";
+      STDAIR_LOG_ERROR (oMessage.str());
+      throw stdair::ParserException (oMessage.str());
+    }
+
+    /**
+     * Read the checkpointed leg-cabins from the given content (after the
+     * segment-dates).
+     */
+    bool readLegCabins (std::string_view& ioContent,
+                        LegCabinStateMap_T& ioLegCabinStateMap) {
+      std::uint32_t lNbOfLegCabins = 0;
+      if (readValue (ioContent, lNbOfLegCabins) == false) {
+        return false;
+      }
+
+      for (std::uint32_t idxLC = 0; idxLC != lNbOfLegCabins; ++idxLC) {
+        std::uint16_t lKeySize = 0;
+        std::string lKey;
+        if (readValue (ioContent, lKeySize) == false
+            || readString (ioContent, lKeySize, lKey) == false) {
+          return false;
+        }
+
+        LegCabinStateStruct& lState = ioLegCabinStateMap[lKey];
+        std::uint32_t lNbOfBidPrices = 0;
+        if (readValue (ioContent, lState._currentBidPrice) == false
+            || readValue (ioContent, lState._previousBidPrice) == false
+            || readValue (ioContent, lNbOfBidPrices) == false
+            || ioContent.size()
+               < lNbOfBidPrices * sizeof (stdair::BidPrice_T)) {
+          return false;
+        }
+        lState._bidPriceVector.resize (lNbOfBidPrices);
+        for (std::uint32_t idxBP = 0; idxBP != lNbOfBidPrices; ++idxBP) {
+          readValue (ioContent, lState._bidPriceVector[idxBP]);
+        }
+      }
+      return true;
+    }
+
+    /**
+     * Read the checkpointed segment-dates and leg-cabins from the given
+     * content (after the signature, and before the checksum).
+     */
+    bool readCheckpoint (std::string_view& ioContent,
+                         CheckpointMap_T& ioCheckpointMap,
+                         unsigned long& ioNbOfBookingClasses,
+                         LegCabinStateMap_T& ioLegCabinStateMap) {
+      std::uint32_t lNbOfSegmentDates = 0;
+      if (readValue (ioContent, lNbOfSegmentDates) == false) {
+        return false;
+      }
+
+      for (std::uint32_t idxSD = 0; idxSD != lNbOfSegmentDates; ++idxSD) {
+        std::uint16_t lKeySize = 0;
+        std::string lKey;
+        std::uint16_t lNbOfClasses = 0;
+        if (readValue (ioContent, lKeySize) == false
+            || readString (ioContent, lKeySize, lKey) == false
+            || readValue (ioContent, lNbOfClasses) == false) {
+          return false;
+        }
+
+        BookingClassStateList_T& lBookingClassStateList =
+          ioCheckpointMap[lKey];
+        lBookingClassStateList.resize (lNbOfClasses);
+        for (std::uint16_t idxBC = 0; idxBC != lNbOfClasses; ++idxBC) {
+          BookingClassStateStruct& lState = lBookingClassStateList[idxBC];
+          std::uint8_t lClassCodeSize = 0;
+          if (readValue (ioContent, lClassCodeSize) == false
+              || readString (ioContent, lClassCodeSize,
+                             lState._classCode) == false) {
+            return false;
+          }
+          for (std::size_t idxCounter = 0;
+               idxCounter != K_NB_OF_CLASS_COUNTERS; ++idxCounter) {
+            if (readValue (ioContent,
+                           lState._counterList[idxCounter]) == false) {
+              return false;
+            }
+          }
+        }
+        ioNbOfBookingClasses += lNbOfClasses;
+      }
+
+      return (readLegCabins (ioContent, ioLegCabinStateMap) == true
+              && ioContent.empty() == true);
+    }
+
+    /**
+     * Restore the state of the given booking class. Its counters are
+     * written as they were, whatever they currently are; the committed
+     * spaces of its segment-cabin and leg-cabins are updated by the
+     * same number of bookings, as a sell (or cancellation) would.
+     */
+    void restoreBookingClass (const BookingClassStateStruct& iState,
+                              stdair::BookingClass& ioBookingClass) {
+      // Cancellations (which also decrease the bookings), then bookings,
+      // by differences (possibly negative) with the current counters
+      const stdair::NbOfBookings_T lFormerNbOfBookings =
+        ioBookingClass.getNbOfBookings();
+      ioBookingClass.cancel (iState._counterList[1]
+                             - ioBookingClass.getNbOfCancellations());
+      ioBookingClass.sell (iState._counterList[0]
+                           - ioBookingClass.getNbOfBookings());
+
+      const stdair::NbOfBookings_T lNbOfBookings =
+        iState._counterList[0] - lFormerNbOfBookings;
+      stdair::SegmentCabin* lSegmentCabin_ptr = stdair::BomManager::
+        getParentPtr<stdair::SegmentCabin> (ioBookingClass);
+      if (lNbOfBookings != 0.0 && lSegmentCabin_ptr != NULL) {
+        lSegmentCabin_ptr->updateFromReservation (lNbOfBookings);
+        if (stdair::BomManager::
+            hasList<stdair::LegCabin> (*lSegmentCabin_ptr) == true) {
+          const stdair::LegCabinList_T& lLegCabinList = stdair::BomManager::
+            getList<stdair::LegCabin> (*lSegmentCabin_ptr);
+          for (stdair::LegCabinList_T::const_iterator itLC =
+                 lLegCabinList.begin(); itLC != lLegCabinList.end(); ++itLC) {
+            assert (*itLC != NULL);
+            (*itLC)->updateFromReservation (lNbOfBookings);
+          }
+        }
+      }
+
+      // Revenue management controls, as set by the optimisations
+      ioBookingClass.setAuthorizationLevel (iState._counterList[2]);
+      ioBookingClass.setProtection (iState._counterList[3]);
+      ioBookingClass.setCumulatedProtection (iState._counterList[4]);
+      ioBookingClass.setCumulatedBookingLimit (iState._counterList[5]);
+      ioBookingClass.setSegmentAvailability (iState._counterList[6]);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  CheckpointStatsStruct CheckpointManager::
+  checkpoint (const stdair::Filename_T& iFilename,
+              const stdair::BomRoot& iBomRoot) {
+    CheckpointStatsStruct oCheckpointStats;
+    stdair::BasChronometer lCheckpointChronometer;
+    lCheckpointChronometer.start();
+
+    SegmentDateClassesList_T lSegmentDateList;
+    const stdair::AirlineCode_T lAllAirlineCodes;
+    BookingClassCollector::collect (iBomRoot, lAllAirlineCodes,
+                                    lSegmentDateList);
+
+    // Serialise the state of the booking classes
+    std::string lBuffer (K_CHECKPOINT_SIGNATURE, K_CHECKPOINT_SIGNATURE_SIZE);
+    appendValue (static_cast<std::uint32_t> (lSegmentDateList.size()),
+                 lBuffer);
+    for (SegmentDateClassesList_T::const_iterator itSD =
+           lSegmentDateList.begin(); itSD != lSegmentDateList.end(); ++itSD) {
+      const std::vector<stdair::BookingClass*>& lBookingClassList =
+        itSD->_bookingClassList;
+      appendValue (static_cast<std::uint16_t> (itSD->_key.size()), lBuffer);
+      lBuffer.append (itSD->_key);
+      appendValue (static_cast<std::uint16_t> (lBookingClassList.size()),
+                   lBuffer);
+
+      for (std::vector<stdair::BookingClass*>::const_iterator itBC =
+             lBookingClassList.begin(); itBC != lBookingClassList.end();
+           ++itBC) {
+        const stdair::BookingClass* lBC_ptr = *itBC;
+        assert (lBC_ptr != NULL);
+        const stdair::ClassCode_T& lClassCode = lBC_ptr->getClassCode();
+        appendValue (static_cast<std::uint8_t> (lClassCode.size()), lBuffer);
+        lBuffer.append (lClassCode);
+
+        const double lCounterList[K_NB_OF_CLASS_COUNTERS] = {
+          lBC_ptr->getNbOfBookings(), lBC_ptr->getNbOfCancellations(),
+          lBC_ptr->getAuthorizationLevel(), lBC_ptr->getProtection(),
+          lBC_ptr->getCumulatedProtection(),
+          lBC_ptr->getCumulatedBookingLimit(),
+          lBC_ptr->getSegmentAvailability()
+        };
+        lBuffer.append (reinterpret_cast<const char*> (lCounterList),
+                        sizeof (lCounterList));
+      }
+      oCheckpointStats._nbOfBookingClasses += lBookingClassList.size();
+    }
+    oCheckpointStats._nbOfSegmentDates = lSegmentDateList.size();
+
+    // Serialise the revenue management state of the leg-cabins, as set
+    // by the optimisations
+    LegCabinKeyList_T lLegCabinList;
+    BookingClassCollector::collectLegCabins (iBomRoot, lLegCabinList);
+    appendValue (static_cast<std::uint32_t> (lLegCabinList.size()), lBuffer);
+    for (LegCabinKeyList_T::const_iterator itLC = lLegCabinList.begin();
+         itLC != lLegCabinList.end(); ++itLC) {
+      const stdair::LegCabin* lLC_ptr = itLC->_legCabin_ptr;
+      assert (lLC_ptr != NULL);
+      appendValue (static_cast<std::uint16_t> (itLC->_key.size()), lBuffer);
+      lBuffer.append (itLC->_key);
+      appendValue (lLC_ptr->getCurrentBidPrice(), lBuffer);
+      appendValue (lLC_ptr->getPreviousBidPrice(), lBuffer);
+      const stdair::BidPriceVector_T& lBidPriceVector =
+        lLC_ptr->getBidPriceVector();
+      appendValue (static_cast<std::uint32_t> (lBidPriceVector.size()),
+                   lBuffer);
+      if (lBidPriceVector.empty() == false) {
+        lBuffer.append (reinterpret_cast<const char*> (&lBidPriceVector[0]),
+                        lBidPriceVector.size() * sizeof (stdair::BidPrice_T));
+      }
+    }
+    oCheckpointStats._nbOfLegCabins = lLegCabinList.size();
+
+    appendValue (checksum (lBuffer.data() + K_CHECKPOINT_SIGNATURE_SIZE,
+                           lBuffer.size() - K_CHECKPOINT_SIGNATURE_SIZE),
+                 lBuffer);
+
+    // Write the checkpoint aside, then replace the former one
+    const stdair::Filename_T lTemporaryFilename (iFilename + ".tmp");
+    std::ofstream lCheckpointFile (lTemporaryFilename.c_str(),
+                                   std::ios::binary | std::ios::trunc);
+    lCheckpointFile.write (lBuffer.data(), lBuffer.size());
+    lCheckpointFile.close();
+    if (lCheckpointFile.fail() == true
+        || std::rename (lTemporaryFilename.c_str(), iFilename.c_str()) != 0) {
+      std::remove (lTemporaryFilename.c_str());
+      std::ostringstream oMessage;
+      oMessage << "The checkpoint file '" << iFilename
+               << "' can not be written";
+      STDAIR_LOG_ERROR (oMessage.str());
+      throw stdair::FileNotFoundException (oMessage.str());
+    }
+
+    oCheckpointStats._nbOfBytes = lBuffer.size();
+    oCheckpointStats._elapsedTime = lCheckpointChronometer.elapsed();
+    return oCheckpointStats;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  CheckpointStatsStruct CheckpointManager::
+  restore (const stdair::Filename_T& iFilename,
+           const stdair::BomRoot& iBomRoot) {
+    CheckpointStatsStruct oRestoreStats;
+    stdair::BasChronometer lRestoreChronometer;
+    lRestoreChronometer.start();
+
+    // Check the signature and the checksum
+    const MappedFile lCheckpointFile (iFilename);
+    std::string_view lContent = lCheckpointFile.getContent();
+    const std::string_view lSignature (K_CHECKPOINT_SIGNATURE,
+                                       K_CHECKPOINT_SIGNATURE_SIZE);
+    if (lContent.size() < lSignature.size() + sizeof (std::uint32_t)
+        || lContent.substr (0, lSignature.size()) != lSignature) {
+      throwNotACheckpoint (iFilename);
+    }
+    lContent.remove_prefix (lSignature.size());
+    std::uint32_t lChecksum = 0;
+    std::string_view lChecksumView =
+      lContent.substr (lContent.size() - sizeof (std::uint32_t));
+    readValue (lChecksumView, lChecksum);
+    lContent.remove_suffix (sizeof (std::uint32_t));
+    if (checksum (lContent.data(), lContent.size()) != lChecksum) {
+      throwNotACheckpoint (iFilename);
+    }
+
+    // Read the checkpointed state
+    CheckpointMap_T lCheckpointMap;
+    unsigned long lNbOfBookingClasses = 0;
+    LegCabinStateMap_T lLegCabinStateMap;
+    if (readCheckpoint (lContent, lCheckpointMap, lNbOfBookingClasses,
+                        lLegCabinStateMap) == false) {
+      throwNotACheckpoint (iFilename);
+    }
+
+    // Restore it onto the segment-dates of the BOM tree
+    SegmentDateClassesList_T lSegmentDateList;
+    const stdair::AirlineCode_T lAllAirlineCodes;
+    BookingClassCollector::collect (iBomRoot, lAllAirlineCodes,
+                                    lSegmentDateList);
+    unsigned long lNbOfMatchedBookingClasses = 0;
+    for (SegmentDateClassesList_T::const_iterator itSD =
+           lSegmentDateList.begin(); itSD != lSegmentDateList.end(); ++itSD) {
+      CheckpointMap_T::const_iterator itState =
+        lCheckpointMap.find (itSD->_key);
+      if (itState == lCheckpointMap.end()) {
+        continue;
+      }
+      ++oRestoreStats._nbOfSegmentDates;
+
+      const std::vector<stdair::BookingClass*>& lBookingClassList =
+        itSD->_bookingClassList;
+      const BookingClassStateList_T& lStateList = itState->second;
+      for (BookingClassStateList_T::const_iterator itBCState =
+             lStateList.begin(); itBCState != lStateList.end(); ++itBCState) {
+        stdair::BookingClass* lBC_ptr = NULL;
+        for (std::vector<stdair::BookingClass*>::const_iterator itBC =
+               lBookingClassList.begin(); itBC != lBookingClassList.end();
+             ++itBC) {
+          assert (*itBC != NULL);
+          if ((*itBC)->getClassCode() == itBCState->_classCode) {
+            lBC_ptr = *itBC;
+            break;
+          }
+        }
+        if (lBC_ptr == NULL) {
+          continue;
+        }
+        ++lNbOfMatchedBookingClasses;
+
+        restoreBookingClass (*itBCState, *lBC_ptr);
+        ++oRestoreStats._nbOfBookingClasses;
+      }
+    }
+
+    // Restore the bid prices of the leg-cabins, once their committed
+    // spaces have been updated
+    LegCabinKeyList_T lLegCabinList;
+    BookingClassCollector::collectLegCabins (iBomRoot, lLegCabinList);
+    for (LegCabinKeyList_T::const_iterator itLC = lLegCabinList.begin();
+         itLC != lLegCabinList.end(); ++itLC) {
+      LegCabinStateMap_T::const_iterator itState =
+        lLegCabinStateMap.find (itLC->_key);
+      if (itState == lLegCabinStateMap.end()) {
+        continue;
+      }
+      stdair::LegCabin* lLC_ptr = itLC->_legCabin_ptr;
+      assert (lLC_ptr != NULL);
+      const LegCabinStateStruct& lState = itState->second;
+      lLC_ptr->getBidPriceVector() = lState._bidPriceVector;
+      lLC_ptr->setCurrentBidPrice (lState._currentBidPrice);
+      lLC_ptr->setPreviousBidPrice (lState._previousBidPrice);
+      ++oRestoreStats._nbOfLegCabins;
+    }
+
+    // The booking classes of the checkpoint, which no longer exist in the
+    // BOM tree, can not be restored either
+    oRestoreStats._nbOfUnmatchedSegmentDates =
+      lCheckpointMap.size() - oRestoreStats._nbOfSegmentDates;
+    oRestoreStats._nbOfFailedBookingClasses +=
+      lNbOfBookingClasses - lNbOfMatchedBookingClasses;
+    oRestoreStats._nbOfBytes = lCheckpointFile.getSize();
+    oRestoreStats._elapsedTime = lRestoreChronometer.elapsed();
+    return oRestoreStats;
+  }
+
+}
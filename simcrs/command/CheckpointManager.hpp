@@ -0,0 +1,85 @@
+#ifndef __SIMCRS_CMD_CHECKPOINTMANAGER_HPP
+#define __SIMCRS_CMD_CHECKPOINTMANAGER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+
+// Forward declarations
+namespace stdair {
+  class BomRoot;
+}
+
+namespace SIMCRS {
+
+  /**
+   * @brief Command saving the inventory state into a binary checkpoint
+   * file, and restoring it onto a freshly loaded network.
+   *
+   * For every booking class of every segment-date, the checkpoint holds
+   * the booking counters (bookings and cancellations) and the revenue
+   * management controls (authorisation level, protections, booking
+   * limit and segment availability), as set by the sells and by the
+   * optimisations. For every leg-cabin, it holds the revenue management
+   * state set by the optimisations (bid-price vector, current and
+   * previous bid prices). The segment-dates and leg-cabins are referred
+   * to by the keys of their inventory, flight-date and segment-date (or
+   * leg-date and leg-cabin), so that the network being restored may
+   * have been loaded in another process.
+   *
+   * The file is made of an 8-byte signature ("SIMCRSC2"), of the number
+   * of segment-dates, of the segment-dates (key, number of booking
+   * classes and, for every booking class, its code and counters), of
+   * the number of leg-cabins, of the leg-cabins (key, bid prices and
+   * bid-price vector) and of a (32-bit) checksum of all of them, in the
+   * native byte order.
+   */
+  class CheckpointManager {
+    friend class SIMCRS_Service;
+  private:
+    /**
+     * Save the state of the inventory into the given checkpoint file.
+     * The file is written aside, then renamed, so that a former
+     * checkpoint is replaced only by a complete one.
+     *
+     * @param const stdair::Filename_T& Name of the checkpoint file.
+     * @param const stdair::BomRoot& (Working) BOM tree.
+     * @return CheckpointStatsStruct Statistics of the checkpoint.
+     * @exception stdair::FileNotFoundException The file can not be
+     *            written.
+     */
+    static CheckpointStatsStruct checkpoint (const stdair::Filename_T&,
+                                             const stdair::BomRoot&);
+
+    /**
+     * Restore the state of the inventory from the given checkpoint file.
+     * The booking counters and revenue management controls of the
+     * booking classes, and the bid prices of the leg-cabins, are set as
+     * they were, whatever their current values; the committed spaces of
+     * the segment-cabins and leg-cabins are updated accordingly.
+     *
+     * @param const stdair::Filename_T& Name of the checkpoint file.
+     * @param const stdair::BomRoot& (Working) BOM tree, holding the same
+     *        network as the one having been checkpointed.
+     * @return CheckpointStatsStruct Statistics of the restore.
+     * @exception stdair::FileNotFoundException
+     * @exception stdair::ParserException The file is not a (complete)
+     *            checkpoint.
+     */
+    static CheckpointStatsStruct restore (const stdair::Filename_T&,
+                                          const stdair::BomRoot&);
+
+  private:
+    /** Constructors. */
+    CheckpointManager() {}
+    CheckpointManager(const CheckpointManager&) {}
+    /** Destructor. */
+    ~CheckpointManager() {}
+  };
+
+}
+#endif // __SIMCRS_CMD_CHECKPOINTMANAGER_HPP
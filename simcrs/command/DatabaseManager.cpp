@@ -0,0 +1,362 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <system_error>
+// SOCI
+#include <soci/soci.h>
+#include <soci/sqlite3/soci-sqlite3.h>
+// StdAir
+#include <stdair/stdair_exceptions.hpp>
+#include <stdair/service/Logger.hpp>
+// SimCRS
+#include <simcrs/bom/MappedFile.hpp>
+#include <simcrs/bom/CSVRecordReader.hpp>
+#include <simcrs/command/DatabaseManager.hpp>
+
+namespace SIMCRS {
+
+  namespace {
+    /** Types of the input files, in the order of the filename lists. */
+    const char* K_INPUT_FILE_TYPE_LIST[] = {
+      "schedule", "od", "frat5", "ffdisutility", "yield", "fare"
+    };
+
+    /** Number of types of input files. */
+    const std::size_t K_NB_OF_INPUT_FILE_TYPES = 6;
+
+    /** Index of the schedule within the filename lists. */
+    const std::size_t K_SCHEDULE_FILE_IDX = 0;
+
+    /** Open a session on the given SQLite database. */
+    void openSession (const stdair::Filename_T& iDBFilename,
+                      soci::session& ioSession) {
+      try {
+        ioSession.open (soci::sqlite3, iDBFilename);
+
+      } catch (const std::exception& lError) {
+        std::ostringstream oMessage;
+        oMessage << "The SQLite database '" << iDBFilename
+                 << "' can not be opened: " << lError.what();
+        STDAIR_LOG_ERROR (oMessage.str());
+        throw stdair::SQLDatabaseConnectionImpossibleException (oMessage.str());
+      }
+    }
+
+    /** Set of airline codes. */
+    typedef std::set<std::string> AirlineCodeSet_T;
+
+    /** Get the airline code heading the given token, when it is one of
+        the given set, possibly followed by a flight number (e.g., 'SQ'
+        or 'SQ11'); an empty string otherwise. */
+    std::string getAirlineCode (const std::string_view& iToken,
+                                const AirlineCodeSet_T& iAirlineCodeSet) {
+      std::string_view::size_type lCodeSize = iToken.size();
+      while (lCodeSize > 0 && iToken[lCodeSize - 1] >= '0'
+             && iToken[lCodeSize - 1] <= '9') {
+        --lCodeSize;
+      }
+      const std::string lAirlineCode (iToken.substr (0, lCodeSize));
+      if (iAirlineCodeSet.find (lAirlineCode) == iAirlineCodeSet.end()) {
+        return std::string();
+      }
+      return lAirlineCode;
+    }
+
+    /** Build the (space-separated, sorted) list of the airline codes, of
+        the given set, which the given record refers to (e.g., the
+        airlines of a fare rule). The fields are split into tokens on
+        blanks, commas and slashes. */
+    std::string buildAirlineCodeList (const CSVFieldList_T& iFieldList,
+                                      const AirlineCodeSet_T& iAirlineCodeSet) {
+      AirlineCodeSet_T lAirlineCodeSet;
+      for (CSVFieldList_T::const_iterator itField = iFieldList.begin();
+           itField != iFieldList.end(); ++itField) {
+        const std::string_view& lField = *itField;
+        std::string_view::size_type lTokenBegin = 0;
+        while (lTokenBegin < lField.size()) {
+          std::string_view::size_type lTokenEnd =
+            lField.find_first_of (" \t,/", lTokenBegin);
+          if (lTokenEnd == std::string_view::npos) {
+            lTokenEnd = lField.size();
+          }
+          const std::string lAirlineCode =
+            getAirlineCode (lField.substr (lTokenBegin,
+                                           lTokenEnd - lTokenBegin),
+                            iAirlineCodeSet);
+          if (lAirlineCode.empty() == false) {
+            lAirlineCodeSet.insert (lAirlineCode);
+          }
+          lTokenBegin = lTokenEnd + 1;
+        }
+      }
+
+      std::string oAirlineCodeList;
+      for (AirlineCodeSet_T::const_iterator itCode = lAirlineCodeSet.begin();
+           itCode != lAirlineCodeSet.end(); ++itCode) {
+        if (oAirlineCodeList.empty() == false) {
+          oAirlineCodeList += ' ';
+        }
+        oAirlineCodeList += *itCode;
+      }
+      return oAirlineCodeList;
+    }
+
+    /** State whether all the airlines of the given (space-separated)
+        list belong to the given set. */
+    bool areAllSelected (const std::string& iAirlineCodeList,
+                         const AirlineCodeSet_T& iAirlineCodeSet) {
+      std::istringstream lCodeStream (iAirlineCodeList);
+      std::string lAirlineCode;
+      while (lCodeStream >> lAirlineCode) {
+        if (iAirlineCodeSet.find (lAirlineCode) == iAirlineCodeSet.end()) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /** Report an output file which can not be written. */
+    void throwOutputError (const stdair::Filename_T& iFilename) {
+      std::ostringstream oMessage;
+      oMessage << "The file '" << iFilename << "' can not be written";
+      STDAIR_LOG_ERROR (oMessage.str());
+      throw stdair::FileNotFoundException (oMessage.str());
+    }
+
+    /** Report an error raised by the given SQLite database. */
+    void throwDatabaseError (const stdair::Filename_T& iDBFilename,
+                             const soci::soci_error& iError) {
+      std::ostringstream oMessage;
+      oMessage << "Error with the SQLite database '" << iDBFilename
+               << "': " << iError.what();
+      STDAIR_LOG_ERROR (oMessage.str());
+      throw stdair::SQLDatabaseException (oMessage.str());
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  NetworkDatabaseStatsStruct DatabaseManager::
+  importFiles (const stdair::Filename_T& iDBFilename,
+               const std::vector<stdair::Filename_T>& iInputFilenameList) {
+    assert (iInputFilenameList.size() == K_NB_OF_INPUT_FILE_TYPES);
+    NetworkDatabaseStatsStruct oDatabaseStats;
+
+    soci::session lSession;
+    openSession (iDBFilename, lSession);
+    try {
+      // The transaction is rolled back when an exception is thrown
+      soci::transaction lTransaction (lSession);
+      lSession << "drop table if exists input_record";
+      lSession << "create table input_record ("
+               << "file_type varchar(16) not null, "
+               << "line_number integer not null, "
+               << "airline_code varchar(3) not null, "
+               << "airline_code_list text not null, "
+               << "record text not null)";
+      lSession << "create index input_record_idx on input_record "
+               << "(file_type, airline_code, line_number)";
+
+      std::string lFileType;
+      int lLineNumber = 0;
+      std::string lAirlineCode;
+      std::string lAirlineCodeList;
+      std::string lRecord;
+      soci::statement lInsertStatement =
+        (lSession.prepare << "insert into input_record "
+         << "(file_type, line_number, airline_code, airline_code_list, "
+         << "record) values (:file_type, :line_number, :airline_code, "
+         << ":airline_code_list, :record)",
+         soci::use (lFileType), soci::use (lLineNumber),
+         soci::use (lAirlineCode), soci::use (lAirlineCodeList),
+         soci::use (lRecord));
+
+      // Airlines of the network, i.e., of the schedule (imported first)
+      AirlineCodeSet_T lNetworkAirlineCodeSet;
+
+      for (std::size_t idx = 0; idx != K_NB_OF_INPUT_FILE_TYPES; ++idx) {
+        lFileType = K_INPUT_FILE_TYPE_LIST[idx];
+        const MappedFile lInputFile (iInputFilenameList[idx]);
+        CSVRecordReader lRecordReader (lInputFile.getContent());
+        CSVFieldList_T lFieldList;
+        while (lRecordReader.next (lFieldList) == true) {
+          lLineNumber = lRecordReader.getLineNumber();
+          // The first field of the schedule records is the airline code;
+          // the other records may refer to the airlines of the network
+          // anywhere (e.g., the airlines of a fare rule)
+          lAirlineCode.clear();
+          if (idx == K_SCHEDULE_FILE_IDX) {
+            lAirlineCode = lFieldList.front();
+            lAirlineCodeList = lAirlineCode;
+            lNetworkAirlineCodeSet.insert (lAirlineCode);
+            ++oDatabaseStats._nbOfScheduleRecords;
+          } else {
+            lAirlineCodeList =
+              buildAirlineCodeList (lFieldList, lNetworkAirlineCodeSet);
+          }
+          lRecord = lRecordReader.getRecord();
+          lInsertStatement.execute (true);
+          ++oDatabaseStats._nbOfRecords;
+        }
+      }
+
+      lTransaction.commit();
+
+    } catch (const soci::soci_error& lError) {
+      throwDatabaseError (iDBFilename, lError);
+    }
+
+    STDAIR_LOG_DEBUG ("Imported " << oDatabaseStats._nbOfRecords
+                      << " records (among which "
+                      << oDatabaseStats._nbOfScheduleRecords
+                      << " flight-periods) into '" << iDBFilename << "'");
+    return oDatabaseStats;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  NetworkDatabaseStatsStruct DatabaseManager::
+  extractFiles (const stdair::Filename_T& iDBFilename,
+                const stdair::AirlineCodeList_T& iAirlineCodeList,
+                const std::vector<stdair::Filename_T>& iOutputFilenameList) {
+    assert (iOutputFilenameList.size() == K_NB_OF_INPUT_FILE_TYPES);
+    NetworkDatabaseStatsStruct oDatabaseStats;
+
+    const AirlineCodeSet_T lSelectedAirlineCodeSet (iAirlineCodeList.begin(),
+                                                    iAirlineCodeList.end());
+    soci::session lSession;
+    openSession (iDBFilename, lSession);
+    try {
+      std::string lFileType;
+      std::string lAirlineCodeList;
+      std::string lRecord;
+      for (std::size_t idx = 0; idx != K_NB_OF_INPUT_FILE_TYPES; ++idx) {
+        lFileType = K_INPUT_FILE_TYPE_LIST[idx];
+        const stdair::Filename_T& lOutputFilename = iOutputFilenameList[idx];
+        std::ofstream lOutputFile (lOutputFilename.c_str());
+        if (lOutputFile.is_open() == false) {
+          throwOutputError (lOutputFilename);
+        }
+
+        // The whole file, unless only some airlines are to be kept
+        unsigned long lNbOfRecords = 0;
+        if (iAirlineCodeList.empty() == true) {
+          soci::statement lSelectStatement =
+            (lSession.prepare << "select record from input_record "
+             << "where file_type = :file_type order by line_number",
+             soci::into (lRecord), soci::use (lFileType));
+          lSelectStatement.execute();
+          while (lSelectStatement.fetch() == true) {
+            lOutputFile << lRecord << '\n';
+            ++lNbOfRecords;
+          }
+
+        } else if (idx != K_SCHEDULE_FILE_IDX) {
+          // The records referring to other airlines (e.g., the fare
+          // rules of other airlines, or of interline travels with them)
+          // are dropped
+          soci::statement lSelectStatement =
+            (lSession.prepare << "select airline_code_list, record "
+             << "from input_record where file_type = :file_type "
+             << "order by line_number",
+             soci::into (lAirlineCodeList), soci::into (lRecord),
+             soci::use (lFileType));
+          lSelectStatement.execute();
+          while (lSelectStatement.fetch() == true) {
+            if (areAllSelected (lAirlineCodeList,
+                                lSelectedAirlineCodeSet) == false) {
+              continue;
+            }
+            lOutputFile << lRecord << '\n';
+            ++lNbOfRecords;
+          }
+
+        } else {
+          // Indexed look-up of the flight-periods of each airline
+          stdair::AirlineCode_T lAirlineCode;
+          soci::statement lSelectStatement =
+            (lSession.prepare << "select record from input_record "
+             << "where file_type = :file_type "
+             << "and airline_code = :airline_code order by line_number",
+             soci::into (lRecord), soci::use (lFileType),
+             soci::use (lAirlineCode));
+          for (stdair::AirlineCodeList_T::const_iterator itAirlineCode =
+                 iAirlineCodeList.begin();
+               itAirlineCode != iAirlineCodeList.end(); ++itAirlineCode) {
+            lAirlineCode = *itAirlineCode;
+            lSelectStatement.execute();
+            while (lSelectStatement.fetch() == true) {
+              lOutputFile << lRecord << '\n';
+              ++lNbOfRecords;
+            }
+          }
+        }
+
+        // Report the files which could not be fully written (e.g., full
+        // disk)
+        lOutputFile.close();
+        if (lOutputFile.fail() == true) {
+          throwOutputError (lOutputFilename);
+        }
+
+        oDatabaseStats._nbOfRecords += lNbOfRecords;
+        if (idx == K_SCHEDULE_FILE_IDX) {
+          oDatabaseStats._nbOfScheduleRecords = lNbOfRecords;
+        }
+      }
+
+    } catch (const soci::soci_error& lError) {
+      throwDatabaseError (iDBFilename, lError);
+    }
+
+    STDAIR_LOG_DEBUG ("Extracted " << oDatabaseStats._nbOfRecords
+                      << " records (among which "
+                      << oDatabaseStats._nbOfScheduleRecords
+                      << " flight-periods) from '" << iDBFilename << "'");
+    return oDatabaseStats;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Filename_T DatabaseManager::createExtractDirectory() {
+    // A private (mode 0700) directory, with a unique name: the extracted
+    // files can neither be guessed beforehand nor read by other users
+    const std::filesystem::path lTemplate =
+      std::filesystem::temp_directory_path() / "simcrs_XXXXXX";
+    std::string lDirectory = lTemplate.string();
+    if (::mkdtemp (&lDirectory[0]) == NULL) {
+      throwOutputError (lDirectory);
+    }
+    return lDirectory;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  std::vector<stdair::Filename_T> DatabaseManager::
+  buildExtractFilenameList (const stdair::Filename_T& iDirectory) {
+    const std::filesystem::path lDirectory (iDirectory);
+    std::vector<stdair::Filename_T> oFilenameList;
+    for (std::size_t idx = 0; idx != K_NB_OF_INPUT_FILE_TYPES; ++idx) {
+      const std::string lFilename =
+        std::string (K_INPUT_FILE_TYPE_LIST[idx]) + ".csv";
+      oFilenameList.push_back ((lDirectory / lFilename).string());
+    }
+    return oFilenameList;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DatabaseManager::
+  removeExtractDirectory (const stdair::Filename_T& iDirectory) {
+    // Called when unwinding as well: the errors are only logged
+    std::error_code lError;
+    std::filesystem::remove_all (iDirectory, lError);
+    if (lError) {
+      STDAIR_LOG_ERROR ("The directory '" << iDirectory
+                        << "' can not be removed: " << lError.message());
+    }
+  }
+
+}
@@ -0,0 +1,104 @@
+#ifndef __SIMCRS_CMD_DATABASEMANAGER_HPP
+#define __SIMCRS_CMD_DATABASEMANAGER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <vector>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+
+namespace SIMCRS {
+
+  /**
+   * @brief Command storing the input files (schedule, O&D, FRAT5,
+   * FF disutility, yield and fare) into a local SQLite network database,
+   * through SOCI, and extracting them back.
+   *
+   * The records of all the input files are held by a single table,
+   * input_record, with their file type, line number, airline code (for
+   * the schedule records) and list of the airlines (of the schedule)
+   * they refer to (e.g., the airlines of a fare rule). That table is
+   * indexed by file type and airline code, so that the flight-periods
+   * of the selected airlines are fetched without scanning the whole
+   * schedule.
+   *
+   * The lists of filenames are given in the order of the file types:
+   * schedule, O&D, FRAT5, FF disutility, yield and fare.
+   */
+  class DatabaseManager {
+    friend class SIMCRS_Service;
+  private:
+    /**
+     * Import the given input files into the given SQLite database,
+     * replacing its former content (if any). The import is done within
+     * a single transaction: nothing is changed if a file can not be read.
+     *
+     * @param const stdair::Filename_T& Filename of the SQLite database.
+     * @param const std::vector<stdair::Filename_T>& Filenames of the
+     *        input files.
+     * @return NetworkDatabaseStatsStruct Statistics of the import.
+     * @exception stdair::SQLDatabaseConnectionImpossibleException
+     * @exception stdair::SQLDatabaseException
+     * @exception stdair::FileNotFoundException
+     */
+    static NetworkDatabaseStatsStruct
+    importFiles (const stdair::Filename_T&,
+                 const std::vector<stdair::Filename_T>&);
+
+    /**
+     * Extract, from the given SQLite database, the input files, keeping
+     * only the records of the given airlines (all of them when the list
+     * is empty): the flight-periods of those airlines, and the O&D,
+     * yield and fare records referring to those airlines only (the
+     * records referring to no airline, e.g., FRAT5 curves, being kept).
+     *
+     * @param const stdair::Filename_T& Filename of the SQLite database.
+     * @param const stdair::AirlineCodeList_T& Airlines to be kept.
+     * @param const std::vector<stdair::Filename_T>& Filenames of the
+     *        (CSV) files to be written.
+     * @return NetworkDatabaseStatsStruct Statistics of the extraction.
+     * @exception stdair::SQLDatabaseConnectionImpossibleException
+     * @exception stdair::SQLDatabaseException
+     * @exception stdair::FileNotFoundException When a file can not be
+     *            written.
+     */
+    static NetworkDatabaseStatsStruct
+    extractFiles (const stdair::Filename_T&, const stdair::AirlineCodeList_T&,
+                  const std::vector<stdair::Filename_T>&);
+
+    /**
+     * Create a private temporary directory (see mkdtemp()), into which
+     * the input files are extracted.
+     *
+     * @return stdair::Filename_T Path of the directory.
+     * @exception stdair::FileNotFoundException When the directory can
+     *            not be created.
+     */
+    static stdair::Filename_T createExtractDirectory();
+
+    /**
+     * Build the list of the filenames of the files into which the input
+     * files are extracted, within the given (temporary) directory.
+     */
+    static std::vector<stdair::Filename_T>
+    buildExtractFilenameList (const stdair::Filename_T&);
+
+    /**
+     * Remove the given (temporary) directory, along with its files.
+     */
+    static void removeExtractDirectory (const stdair::Filename_T&);
+
+  private:
+    /** Constructors. */
+    DatabaseManager() {}
+    DatabaseManager(const DatabaseManager&) {}
+    /** Destructor. */
+    ~DatabaseManager() {}
+  };
+
+}
+#endif // __SIMCRS_CMD_DATABASEMANAGER_HPP
@@ -0,0 +1,567 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <algorithm>
+#include <cassert>
+#include <sstream>
+#include <stdexcept>
+// Boost
+#include <boost/lexical_cast.hpp>
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+// StdAir
+#include <stdair/stdair_exceptions.hpp>
+#include <stdair/basic/BasChronometer.hpp>
+#include <stdair/bom/BomManager.hpp>
+#include <stdair/bom/BomRetriever.hpp>
+#include <stdair/bom/BomRoot.hpp>
+#include <stdair/bom/Inventory.hpp>
+#include <stdair/bom/FlightDate.hpp>
+#include <stdair/bom/SegmentDate.hpp>
+#include <stdair/bom/BookingRequestStruct.hpp>
+#include <stdair/bom/FareOptionStruct.hpp>
+#include <stdair/bom/TravelSolutionStruct.hpp>
+#include <stdair/service/Logger.hpp>
+// SimCRS
+#include <simcrs/basic/BasConst_General.hpp>
+#include <simcrs/bom/SymbolTable.hpp>
+#include <simcrs/bom/DeltaOverlay.hpp>
+#include <simcrs/bom/MappedFile.hpp>
+#include <simcrs/bom/CSVRecordReader.hpp>
+#include <simcrs/command/SymbolManager.hpp>
+#include <simcrs/command/DeltaManager.hpp>
+
+namespace SIMCRS {
+
+  namespace {
+    /** Number of fields of the lines of the schedule delta files (and
+        of the modifications of flight periods, which add the days of
+        operation). */
+    const std::size_t K_NB_OF_SCHEDULE_DELTA_FIELDS = 5;
+    const std::size_t K_NB_OF_SCHEDULE_MODIFICATION_FIELDS = 6;
+
+    /** Number of fields of the lines of the fare delta files. */
+    const std::size_t K_NB_OF_FARE_DELTA_FIELDS = 10;
+
+    /** State whether the given field matches the given value. */
+    bool matchesField (const std::string& iField, const std::string& iValue) {
+      return (iField == "*" || iField == iValue);
+    }
+
+    /** State whether the given days of operation (e.g., '1111100') are
+        well-formed. */
+    bool isValidDaysOfOperation (const std::string_view& iDays) {
+      if (iDays.size() != 7) {
+        return false;
+      }
+      for (std::string_view::const_iterator itDay = iDays.begin();
+           itDay != iDays.end(); ++itDay) {
+        if (*itDay != '0' && *itDay != '1') {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /** Split the given class path (e.g., 'M/Y') into its class lists,
+        one per segment. */
+    void splitClassPath (const std::string& iClassPath,
+                         std::vector<std::string>& ioClassListList) {
+      ioClassListList.clear();
+      boost::algorithm::split (ioClassListList, iClassPath,
+                               boost::algorithm::is_any_of ("/"));
+    }
+
+    /** State whether the given class path is well-formed, i.e., made of
+        non-empty class lists. */
+    bool isValidClassPath (const std::string& iClassPath) {
+      std::vector<std::string> lClassListList;
+      splitClassPath (iClassPath, lClassListList);
+      for (std::vector<std::string>::const_iterator itClassList =
+             lClassListList.begin();
+           itClassList != lClassListList.end(); ++itClassList) {
+        if (itClassList->empty() == true
+            || itClassList->find ('*') != std::string::npos) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /** Get the departure date of the given segment-date key (e.g.,
+        'SQ;11,2010-Feb-08;SIN,BKK'). */
+    bool getDepartureDate (const std::string& iSegmentDateKey,
+                           stdair::Date_T& ioDepartureDate) {
+      const std::string::size_type lDateBegin = iSegmentDateKey.find (',');
+      if (lDateBegin == std::string::npos) {
+        return false;
+      }
+      const std::string::size_type lDateEnd =
+        iSegmentDateKey.find (';', lDateBegin);
+      try {
+        ioDepartureDate = boost::gregorian::from_string
+          (iSegmentDateKey.substr (lDateBegin + 1,
+                                   lDateEnd - lDateBegin - 1));
+      } catch (const std::exception&) {
+        return false;
+      }
+      return true;
+    }
+
+    /** Build the message of the exception for a malformed line. */
+    std::string describeLine (const stdair::Filename_T& iFilename,
+                              const unsigned int iLineNumber,
+                              const std::string_view& iLine) {
+      std::ostringstream oStr;
+      oStr << iFilename << ":" << iLineNumber << ": '" << iLine << "'";
+      return oStr.str();
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DeltaStatsStruct DeltaManager::
+  applyScheduleDelta (const stdair::Filename_T& iFilename,
+                      const stdair::BomRoot& iBomRoot,
+                      DeltaOverlay& ioDeltaOverlay) {
+    DeltaStatsStruct oDeltaStats;
+    stdair::BasChronometer lLoadChronometer;
+    lLoadChronometer.start();
+    const MappedFile lDeltaFile (iFilename);
+    oDeltaStats._nbOfBytes = lDeltaFile.getSize();
+    CSVRecordReader lRecordReader (lDeltaFile.getContent());
+
+    CSVFieldList_T lFieldList;
+    while (lRecordReader.next (lFieldList) == true) {
+      const unsigned int lLineNumber = lRecordReader.getLineNumber();
+      const std::string_view& lLine = lRecordReader.getRecord();
+
+      // Parse the change
+      char lOperation = ' ';
+      stdair::FlightNumber_T lFlightNumber = 0;
+      stdair::Date_T lStartDate;
+      stdair::Date_T lEndDate;
+      std::string lDaysOfOperation;
+      try {
+        if (lFieldList.empty() == true || lFieldList[0].size() != 1) {
+          throw std::invalid_argument ("wrong operation");
+        }
+        lOperation = lFieldList[0][0];
+
+        // Only the modifications of flight periods have days of operation
+        const std::size_t lNbOfFields = (lOperation == '~'
+                                         ? K_NB_OF_SCHEDULE_MODIFICATION_FIELDS
+                                         : K_NB_OF_SCHEDULE_DELTA_FIELDS);
+        if (lFieldList.size() != lNbOfFields) {
+          throw std::invalid_argument ("wrong number of fields");
+        }
+        lFlightNumber = boost::lexical_cast<stdair::FlightNumber_T>
+          (std::string (lFieldList[2]));
+        lStartDate =
+          boost::gregorian::from_string (std::string (lFieldList[3]));
+        lEndDate = boost::gregorian::from_string (std::string (lFieldList[4]));
+        if (lOperation == '~') {
+          if (isValidDaysOfOperation (lFieldList[5]) == false) {
+            throw std::invalid_argument ("wrong days of operation");
+          }
+          lDaysOfOperation = lFieldList[5];
+        }
+
+      } catch (const std::exception&) {
+        // Invalid number of fields, flight number, date or days
+        const std::string lMessage =
+          "Malformed schedule change at " + describeLine (iFilename,
+                                                          lLineNumber, lLine);
+        STDAIR_LOG_ERROR (lMessage);
+        throw stdair::ParserException (lMessage);
+      }
+
+      if (lOperation != '+' && lOperation != '-' && lOperation != '~') {
+        const std::string lMessage =
+          "Unknown schedule change at " + describeLine (iFilename,
+                                                        lLineNumber, lLine);
+        STDAIR_LOG_ERROR (lMessage);
+        throw stdair::ParserException (lMessage);
+      }
+      ++oDeltaStats._nbOfChanges;
+
+      // Apply the change on the flight-dates of the inventory, if any
+      const stdair::AirlineCode_T lAirlineCode (lFieldList[1]);
+      const stdair::Inventory* lInventory_ptr =
+        stdair::BomRetriever::retrieveInventoryFromKey (iBomRoot,
+                                                        lAirlineCode);
+      const bool isApplied = (lInventory_ptr != NULL
+                              && applyScheduleChange (*lInventory_ptr,
+                                                      lOperation,
+                                                      lFlightNumber,
+                                                      lStartDate, lEndDate,
+                                                      lDaysOfOperation,
+                                                      ioDeltaOverlay,
+                                                      oDeltaStats) == true);
+      if (isApplied == true) {
+        ++oDeltaStats._nbOfAppliedChanges;
+
+      } else {
+        // New flights can not be added, as the inventory is not rebuilt
+        ++oDeltaStats._nbOfRejectedChanges;
+        STDAIR_LOG_DEBUG ("No flight-date for the schedule change at "
+                          << describeLine (iFilename, lLineNumber, lLine));
+      }
+    }
+
+    oDeltaStats._loadTime = lLoadChronometer.elapsed();
+    return oDeltaStats;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool DeltaManager::
+  applyScheduleChange (const stdair::Inventory& iInventory,
+                       const char iOperation,
+                       const stdair::FlightNumber_T& iFlightNumber,
+                       const stdair::Date_T& iStartDate,
+                       const stdair::Date_T& iEndDate,
+                       const std::string& iDaysOfOperation,
+                       DeltaOverlay& ioDeltaOverlay,
+                       DeltaStatsStruct& ioDeltaStats) {
+    bool hasFlightDate = false;
+
+    // Only the flight-dates of the flight within the date range are
+    // looked up
+    for (stdair::Date_T lDate = iStartDate; lDate <= iEndDate;
+         lDate += boost::gregorian::days (1)) {
+      const stdair::FlightDate* lFlightDate_ptr =
+        stdair::BomRetriever::retrieveFlightDateFromKey (iInventory,
+                                                         iFlightNumber, lDate);
+      if (lFlightDate_ptr == NULL) {
+        continue;
+      }
+      hasFlightDate = true;
+
+      bool isToBeOpen = (iOperation == '+');
+      if (iOperation == '~') {
+        // The days of operation start on Monday (day #1 of the week)
+        const unsigned short lDayOfWeek =
+          (lDate.day_of_week().as_number() + 6) % 7;
+        assert (lDayOfWeek < iDaysOfOperation.size());
+        isToBeOpen = (iDaysOfOperation[lDayOfWeek] == '1');
+      }
+      const bool hasChanged = (isToBeOpen == true
+                               ? ioDeltaOverlay.open (*lFlightDate_ptr)
+                               : ioDeltaOverlay.close (*lFlightDate_ptr));
+      if (hasChanged == true) {
+        ++ioDeltaStats._nbOfUpdatedFlightDates;
+      }
+    }
+    return hasFlightDate;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DeltaStatsStruct DeltaManager::
+  applyFareDelta (const stdair::Filename_T& iFilename,
+                  DeltaOverlay& ioDeltaOverlay) {
+    DeltaStatsStruct oDeltaStats;
+    stdair::BasChronometer lLoadChronometer;
+    lLoadChronometer.start();
+    const MappedFile lDeltaFile (iFilename);
+    oDeltaStats._nbOfBytes = lDeltaFile.getSize();
+    CSVRecordReader lRecordReader (lDeltaFile.getContent());
+
+    CSVFieldList_T lFieldList;
+    while (lRecordReader.next (lFieldList) == true) {
+      const unsigned int lLineNumber = lRecordReader.getLineNumber();
+      const std::string_view& lLine = lRecordReader.getRecord();
+
+      // Parse the change
+      FareDeltaStruct lFareDelta;
+      try {
+        if (lFieldList.size() != K_NB_OF_FARE_DELTA_FIELDS
+            || lFieldList[0].size() != 1) {
+          throw std::invalid_argument ("wrong number of fields");
+        }
+        lFareDelta._operation = lFieldList[0][0];
+        lFareDelta._origin = lFieldList[1];
+        lFareDelta._destination = lFieldList[2];
+        lFareDelta._startDate =
+          boost::gregorian::from_string (std::string (lFieldList[3]));
+        lFareDelta._endDate =
+          boost::gregorian::from_string (std::string (lFieldList[4]));
+        lFareDelta._pos = lFieldList[5];
+        lFareDelta._channel = lFieldList[6];
+        lFareDelta._airlineCode = lFieldList[7];
+        lFareDelta._classPath = lFieldList[8];
+        lFareDelta._fare =
+          boost::lexical_cast<stdair::Fare_T> (std::string (lFieldList[9]));
+
+      } catch (const std::exception&) {
+        // Invalid number of fields, date or fare
+        const std::string lMessage =
+          "Malformed fare change at " + describeLine (iFilename,
+                                                      lLineNumber, lLine);
+        STDAIR_LOG_ERROR (lMessage);
+        throw stdair::ParserException (lMessage);
+      }
+
+      // A new fare option needs a full class path, the other changes
+      // may apply to all the class paths
+      const char& lOperation = lFareDelta._operation;
+      const bool isValidClassPathField =
+        (isValidClassPath (lFareDelta._classPath) == true
+         || (lOperation != '+' && lFareDelta._classPath == "*"));
+      if ((lOperation != '+' && lOperation != '-' && lOperation != '~')
+          || isValidClassPathField == false) {
+        const std::string lMessage =
+          "Unknown fare change at " + describeLine (iFilename,
+                                                    lLineNumber, lLine);
+        STDAIR_LOG_ERROR (lMessage);
+        throw stdair::ParserException (lMessage);
+      }
+      ++oDeltaStats._nbOfChanges;
+
+      // The change is applied on the fare quote results
+      ioDeltaOverlay.addFareDelta (lFareDelta);
+      ++oDeltaStats._nbOfAppliedChanges;
+    }
+
+    oDeltaStats._loadTime = lLoadChronometer.elapsed();
+    return oDeltaStats;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool DeltaManager::isOpen (const stdair::BomRoot& iBomRoot,
+                             const SymbolTable& iSymbolTable,
+                             const DeltaOverlay& iDeltaOverlay,
+                             const stdair::KeyList_T& iSegmentPath) {
+    if (iDeltaOverlay.hasClosedFlightDates() == false) {
+      return true;
+    }
+
+    for (stdair::KeyList_T::const_iterator itKey = iSegmentPath.begin();
+         itKey != iSegmentPath.end(); ++itKey) {
+      const std::string& lSegmentDateKey = *itKey;
+
+      // Most of the time, the segment-date has already been bound;
+      // otherwise, it is retrieved from the BOM tree
+      const SegmentDateID_T lSegmentDateID =
+        SymbolManager::findSegmentDate (iSymbolTable, lSegmentDateKey);
+      const stdair::SegmentDate* lSegmentDate_ptr =
+        (lSegmentDateID != DEFAULT_NULL_SYMBOL_ID
+         ? iSymbolTable.getSegmentDate (lSegmentDateID) : NULL);
+      if (lSegmentDate_ptr == NULL) {
+        lSegmentDate_ptr = stdair::BomRetriever::
+          retrieveSegmentDateFromLongKey (iBomRoot, lSegmentDateKey);
+      }
+
+      // Nothing is known about an unknown segment-date: keep it
+      if (lSegmentDate_ptr == NULL) {
+        continue;
+      }
+      const stdair::FlightDate* lFlightDate_ptr = stdair::BomManager::
+        getParentPtr<stdair::FlightDate> (*lSegmentDate_ptr);
+      assert (lFlightDate_ptr != NULL);
+      if (iDeltaOverlay.isClosed (*lFlightDate_ptr) == true) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool DeltaManager::isOpen (const SymbolTable& iSymbolTable,
+                             const DeltaOverlay& iDeltaOverlay,
+                             const SegmentDateID_T& iSegmentDateID) {
+    if (iDeltaOverlay.hasClosedFlightDates() == false) {
+      return true;
+    }
+
+    // Nothing is known about an unbound segment-date: keep it
+    const stdair::SegmentDate* lSegmentDate_ptr =
+      iSymbolTable.getSegmentDate (iSegmentDateID);
+    if (lSegmentDate_ptr == NULL) {
+      return true;
+    }
+
+    const stdair::FlightDate* lFlightDate_ptr =
+      stdair::BomManager::getParentPtr<stdair::FlightDate> (*lSegmentDate_ptr);
+    assert (lFlightDate_ptr != NULL);
+    return (iDeltaOverlay.isClosed (*lFlightDate_ptr) == false);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  NbOfTravelSolutions_T DeltaManager::
+  removeClosedTravelSolutions (const stdair::BomRoot& iBomRoot,
+                               const SymbolTable& iSymbolTable,
+                               const DeltaOverlay& iDeltaOverlay,
+                               stdair::TravelSolutionList_T& ioTSList) {
+    NbOfTravelSolutions_T oNbOfRemovedTravelSolutions = 0;
+    if (iDeltaOverlay.hasClosedFlightDates() == false) {
+      return oNbOfRemovedTravelSolutions;
+    }
+
+    stdair::TravelSolutionList_T::iterator itTS = ioTSList.begin();
+    while (itTS != ioTSList.end()) {
+      const stdair::TravelSolutionStruct& lTravelSolution = *itTS;
+      if (isOpen (iBomRoot, iSymbolTable, iDeltaOverlay,
+                  lTravelSolution.getSegmentPath()) == true) {
+        ++itTS;
+        continue;
+      }
+      itTS = ioTSList.erase (itTS);
+      ++oNbOfRemovedTravelSolutions;
+    }
+    return oNbOfRemovedTravelSolutions;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool DeltaManager::
+  getFirstFlightDate (const SymbolTable& iSymbolTable,
+                      const stdair::TravelSolutionStruct& iTravelSolution,
+                      stdair::AirlineCode_T& ioAirlineCode,
+                      stdair::Date_T& ioDepartureDate) {
+    const stdair::KeyList_T& lSegmentPath = iTravelSolution.getSegmentPath();
+    if (lSegmentPath.empty() == true) {
+      return false;
+    }
+
+    // Most of the time, the first segment-date is bound to the BOM tree
+    const std::string& lSegmentDateKey = lSegmentPath.front();
+    const SegmentDateID_T lSegmentDateID =
+      SymbolManager::findSegmentDate (iSymbolTable, lSegmentDateKey);
+    const stdair::SegmentDate* lSegmentDate_ptr =
+      (lSegmentDateID != DEFAULT_NULL_SYMBOL_ID
+       ? iSymbolTable.getSegmentDate (lSegmentDateID) : NULL);
+    if (lSegmentDate_ptr != NULL) {
+      const stdair::FlightDate* lFlightDate_ptr = stdair::BomManager::
+        getParentPtr<stdair::FlightDate> (*lSegmentDate_ptr);
+      assert (lFlightDate_ptr != NULL);
+      ioAirlineCode = lFlightDate_ptr->getAirlineCode();
+      ioDepartureDate = lFlightDate_ptr->getDepartureDate();
+      return true;
+    }
+
+    // Otherwise, they are read from the key of the segment-date (e.g.,
+    // 'SQ;11,2010-Feb-08;SIN,BKK')
+    if (getDepartureDate (lSegmentDateKey, ioDepartureDate) == false) {
+      return false;
+    }
+    ioAirlineCode = lSegmentDateKey.substr (0, lSegmentDateKey.find (';'));
+    return true;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool DeltaManager::
+  matches (const FareDeltaStruct& iFareDelta,
+           const stdair::BookingRequestStruct& iBookingRequest,
+           const stdair::AirlineCode_T& iAirlineCode,
+           const stdair::Date_T& iDepartureDate) {
+    // The origin and destination are the ones of the fare rule changes
+    // (see DeltaOverlay::getFareDeltaList())
+    assert (iFareDelta._origin == iBookingRequest.getOrigin()
+            && iFareDelta._destination == iBookingRequest.getDestination());
+    return (matchesField (iFareDelta._pos, iBookingRequest.getPOS()) == true
+            && matchesField (iFareDelta._channel,
+                             iBookingRequest.getBookingChannel()) == true
+            && iDepartureDate >= iFareDelta._startDate
+            && iDepartureDate <= iFareDelta._endDate
+            && matchesField (iFareDelta._airlineCode, iAirlineCode) == true);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DeltaManager::
+  applyFareDeltas (const SymbolTable& iSymbolTable,
+                   const DeltaOverlay& iDeltaOverlay,
+                   const stdair::BookingRequestStruct& iBookingRequest,
+                   stdair::TravelSolutionList_T& ioTSList) {
+    // Only the changes of the origin and destination of the booking
+    // request are gone through
+    const FareDeltaList_T* lFareDeltaList_ptr =
+      iDeltaOverlay.getFareDeltaList (iBookingRequest.getOrigin(),
+                                      iBookingRequest.getDestination());
+    if (lFareDeltaList_ptr == NULL) {
+      return;
+    }
+    const FareDeltaList_T& lFareDeltaList = *lFareDeltaList_ptr;
+
+    std::string lClassPath;
+    std::vector<std::string> lClassListList;
+    for (stdair::TravelSolutionList_T::iterator itTS = ioTSList.begin();
+         itTS != ioTSList.end(); ++itTS) {
+      stdair::TravelSolutionStruct& lTravelSolution = *itTS;
+      stdair::FareOptionList_T& lFareOptionList =
+        lTravelSolution.getFareOptionListRef();
+
+      // The airline and the departure date are the ones of the first
+      // flight-date, the travel solution possibly departing on another
+      // date than the preferred one (e.g., calendar shopping)
+      stdair::AirlineCode_T lAirlineCode;
+      stdair::Date_T lDepartureDate;
+      if (getFirstFlightDate (iSymbolTable, lTravelSolution, lAirlineCode,
+                              lDepartureDate) == false) {
+        continue;
+      }
+
+      for (FareDeltaList_T::const_iterator itDelta = lFareDeltaList.begin();
+           itDelta != lFareDeltaList.end(); ++itDelta) {
+        const FareDeltaStruct& lFareDelta = *itDelta;
+        if (matches (lFareDelta, iBookingRequest, lAirlineCode,
+                     lDepartureDate) == false) {
+          continue;
+        }
+
+        if (lFareDelta._operation == '+') {
+          // The class path must give a class list for every segment
+          splitClassPath (lFareDelta._classPath, lClassListList);
+          if (lClassListList.size()
+              != lTravelSolution.getSegmentPath().size()
+              || std::find (lClassListList.begin(), lClassListList.end(),
+                            std::string()) != lClassListList.end()) {
+            continue;
+          }
+
+          stdair::FareOptionStruct lFareOption;
+          for (std::vector<std::string>::const_iterator itClassList =
+                 lClassListList.begin();
+               itClassList != lClassListList.end(); ++itClassList) {
+            lFareOption.addClassList (*itClassList);
+          }
+          lFareOption.setFare (lFareDelta._fare);
+          lFareOptionList.push_back (lFareOption);
+          continue;
+        }
+
+        // Remove, or change the fare of, the matching fare options
+        const bool isAnyClassPath = (lFareDelta._classPath == "*");
+        stdair::FareOptionList_T::iterator itFO = lFareOptionList.begin();
+        while (itFO != lFareOptionList.end()) {
+          stdair::FareOptionStruct& lFareOption = *itFO;
+          lClassPath.clear();
+          const stdair::ClassList_StringList_T& lClassListList =
+            lFareOption.getClassPath();
+          for (stdair::ClassList_StringList_T::const_iterator itClassList =
+                 lClassListList.begin();
+               isAnyClassPath == false && itClassList != lClassListList.end();
+               ++itClassList) {
+            if (itClassList != lClassListList.begin()) {
+              lClassPath += '/';
+            }
+            lClassPath += *itClassList;
+          }
+
+          if (isAnyClassPath == false
+              && lFareDelta._classPath != lClassPath) {
+            ++itFO;
+            continue;
+          }
+
+          if (lFareDelta._operation == '-') {
+            itFO = lFareOptionList.erase (itFO);
+          } else {
+            assert (lFareDelta._operation == '~');
+            lFareOption.setFare (lFareDelta._fare);
+            ++itFO;
+          }
+        }
+      }
+    }
+  }
+
+}
@@ -0,0 +1,172 @@
+#ifndef __SIMCRS_CMD_DELTAMANAGER_HPP
+#define __SIMCRS_CMD_DELTAMANAGER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <vector>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/bom/TravelSolutionTypes.hpp>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+
+// Forward declarations
+namespace stdair {
+  class BomRoot;
+  class Inventory;
+  struct BookingRequestStruct;
+  struct TravelSolutionStruct;
+}
+
+namespace SIMCRS {
+
+  // Forward declarations
+  class SymbolTable;
+  class DeltaOverlay;
+  struct FareDeltaStruct;
+
+  /**
+   * @brief Command applying the schedule and fare delta files, i.e.,
+   * small lists of changes, on top of the BOM trees already loaded, so
+   * that the whole SimCRS service does not have to be rebuilt.
+   *
+   * Neither AirTSP, AirInv nor SimFQT can be patched in place: the
+   * changes are kept by SimCRS, within its delta overlay, and applied
+   * on the results of those components. The inventory is left
+   * untouched, so that the bookings already made are kept.
+   *
+   * The delta files hold one change per line, the fields being separated
+   * by semi-colons. The empty lines and the lines starting with '#' are
+   * ignored (see CSVRecordReader). The lines of the schedule delta files
+   * read:
+   * <pre>
+   *   operation; airline; flight number; start date; end date[; days]
+   * </pre>
+   * where the operation is '-' (the flight-dates within the date range
+   * are closed to sale), '+' (they are re-opened) or '~' (the flight
+   * period is modified within the date range: the flight-dates departing
+   * on the given days of operation are re-opened, the other ones are
+   * closed). The days of operation, given for '~' only, are seven '0' or
+   * '1' flags, from Monday to Sunday (e.g., '1111100'). Only the
+   * flight-dates of the flight within the date range are visited.
+   * The lines of the fare delta files read:
+   * <pre>
+   *   operation; origin; destination; start date; end date; POS;
+   *   channel; airline; class path; fare
+   * </pre>
+   * (see FareDeltaStruct). The date range applies to the departure date
+   * of the travel solutions.
+   */
+  class DeltaManager {
+    friend class SIMCRS_Service;
+    friend class ShoppingManager;
+  private:
+    /**
+     * Apply the changes of the given schedule delta file on the
+     * flight-dates of the given (working) BOM tree.
+     *
+     * @return DeltaStatsStruct Statistics of the changes.
+     */
+    static DeltaStatsStruct applyScheduleDelta (const stdair::Filename_T&,
+                                                const stdair::BomRoot&,
+                                                DeltaOverlay&);
+
+    /**
+     * Add the changes of the given fare delta file to the delta overlay.
+     *
+     * @return DeltaStatsStruct Statistics of the changes.
+     */
+    static DeltaStatsStruct applyFareDelta (const stdair::Filename_T&,
+                                            DeltaOverlay&);
+
+    /**
+     * State whether all the segment-dates of the given segment path
+     * belong to flight-dates open to sale. The segment-dates are only
+     * looked up (they are not interned), so that the symbol table is not
+     * written.
+     */
+    static bool isOpen (const stdair::BomRoot&, const SymbolTable&,
+                        const DeltaOverlay&, const stdair::KeyList_T&);
+
+    /**
+     * State whether the given segment-date belongs to a flight-date
+     * open to sale.
+     */
+    static bool isOpen (const SymbolTable&, const DeltaOverlay&,
+                        const SegmentDateID_T&);
+
+    /**
+     * Remove, from the given list, the travel solutions going through
+     * flight-dates closed to sale.
+     *
+     * @return NbOfTravelSolutions_T Number of travel solutions removed.
+     */
+    static NbOfTravelSolutions_T
+    removeClosedTravelSolutions (const stdair::BomRoot&, const SymbolTable&,
+                                 const DeltaOverlay&,
+                                 stdair::TravelSolutionList_T&);
+
+    /**
+     * Apply the fare rule changes on the fare options of the given
+     * (fare-quoted) travel solutions. Only the changes of the origin and
+     * destination of the booking request are gone through, and the
+     * first flight-date of each travel solution is taken from the BOM
+     * tree (through the symbol table), rather than parsed from its key.
+     */
+    static void applyFareDeltas (const SymbolTable&, const DeltaOverlay&,
+                                 const stdair::BookingRequestStruct&,
+                                 stdair::TravelSolutionList_T&);
+
+  private:
+    /**
+     * Open or close the flight-dates of the given flight, according to
+     * the given schedule change.
+     *
+     * @param const std::string& iDaysOfOperation Days of operation (for
+     *        the '~' operation), from Monday to Sunday.
+     * @return bool Whether the change could be applied.
+     */
+    static bool applyScheduleChange (const stdair::Inventory&,
+                                     const char iOperation,
+                                     const stdair::FlightNumber_T&,
+                                     const stdair::Date_T& iStartDate,
+                                     const stdair::Date_T& iEndDate,
+                                     const std::string& iDaysOfOperation,
+                                     DeltaOverlay&, DeltaStatsStruct&);
+
+    /**
+     * Get the airline and the departure date of the first flight-date of
+     * the given travel solution.
+     *
+     * @return bool Whether the travel solution has a well-formed first
+     *         segment-date.
+     */
+    static bool getFirstFlightDate (const SymbolTable&,
+                                    const stdair::TravelSolutionStruct&,
+                                    stdair::AirlineCode_T&,
+                                    stdair::Date_T& ioDepartureDate);
+
+    /**
+     * State whether the given fare rule change (of the origin and
+     * destination of the given booking request) applies to a travel
+     * solution of that booking request, given the airline and the
+     * departure date of its first flight-date.
+     */
+    static bool matches (const FareDeltaStruct&,
+                         const stdair::BookingRequestStruct&,
+                         const stdair::AirlineCode_T&,
+                         const stdair::Date_T& iDepartureDate);
+
+  private:
+    /** Constructors. */
+    DeltaManager() {}
+    DeltaManager(const DeltaManager&) {}
+    /** Destructor. */
+    ~DeltaManager() {}
+  };
+
+}
+#endif // __SIMCRS_CMD_DELTAMANAGER_HPP
@@ -0,0 +1,287 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+// Boost
+#include <boost/lexical_cast.hpp>
+#include <boost/property_tree/ptree.hpp>
+// StdAir
+#include <stdair/bom/BomManager.hpp>
+#include <stdair/bom/BomRoot.hpp>
+#include <stdair/bom/BomDisplay.hpp>
+#include <stdair/bom/BomJSONExport.hpp>
+#include <stdair/bom/Inventory.hpp>
+#include <stdair/bom/FlightDate.hpp>
+// SimCRS
+#include <simcrs/basic/BasConst_General.hpp>
+#include <simcrs/command/DisplayManager.hpp>
+
+namespace SIMCRS {
+
+  namespace {
+    /**
+     * Call the given visitor on every flight-date selected by the given
+     * filter, in the order of the BOM tree. The visitor is also given
+     * the (1-based) index of the inventory and of the flight-date,
+     * within the selection.
+     */
+    template <typename VISITOR>
+    void visitFlightDates (const stdair::BomRoot& iBomRoot,
+                           const DisplayFilterStruct& iDisplayFilter,
+                           VISITOR& ioVisitor) {
+      if (stdair::BomManager::hasList<stdair::Inventory> (iBomRoot) == false) {
+        return;
+      }
+
+      unsigned int lInventoryIndex = 0;
+      const stdair::InventoryList_T& lInventoryList =
+        stdair::BomManager::getList<stdair::Inventory> (iBomRoot);
+      for (stdair::InventoryList_T::const_iterator itInv =
+             lInventoryList.begin(); itInv != lInventoryList.end(); ++itInv) {
+        const stdair::Inventory* lInventory_ptr = *itInv;
+        assert (lInventory_ptr != NULL);
+        if (iDisplayFilter.matchesAirline (lInventory_ptr->getAirlineCode())
+            == false
+            || stdair::BomManager::hasList<stdair::FlightDate> (*lInventory_ptr)
+            == false) {
+          continue;
+        }
+
+        unsigned int lFlightDateIndex = 0;
+        const stdair::FlightDateList_T& lFlightDateList =
+          stdair::BomManager::getList<stdair::FlightDate> (*lInventory_ptr);
+        for (stdair::FlightDateList_T::const_iterator itFD =
+               lFlightDateList.begin(); itFD != lFlightDateList.end(); ++itFD) {
+          const stdair::FlightDate* lFlightDate_ptr = *itFD;
+          assert (lFlightDate_ptr != NULL);
+          if (iDisplayFilter.matchesFlight (lFlightDate_ptr->getFlightNumber())
+              == false
+              || iDisplayFilter.matchesDate (lFlightDate_ptr->
+                                             getDepartureDate()) == false) {
+            continue;
+          }
+
+          if (lFlightDateIndex == 0) {
+            ++lInventoryIndex;
+          }
+          ++lFlightDateIndex;
+          ioVisitor (*lFlightDate_ptr, lInventoryIndex, lFlightDateIndex);
+        }
+      }
+    }
+
+    /** Display of the flight-dates, in CSV format, into a stream. */
+    struct CSVStreamVisitor {
+      std::ostream& _stream;
+      CSVStreamVisitor (std::ostream& ioStream) : _stream (ioStream) {
+      }
+      void operator() (const stdair::FlightDate& iFlightDate,
+                       const unsigned int, const unsigned int) {
+        stdair::BomDisplay::csvDisplay (_stream, iFlightDate);
+      }
+    };
+
+    /**
+     * Display of the flight-dates, in CSV format, one chunk per
+     * flight-date. The buffer is re-used from one chunk to the next.
+     */
+    struct CSVChunkVisitor {
+      const DisplayChunkSink_T& _sink;
+      std::ostringstream _chunkStream;
+      CSVChunkVisitor (const DisplayChunkSink_T& iSink) : _sink (iSink) {
+      }
+      void operator() (const stdair::FlightDate& iFlightDate,
+                       const unsigned int, const unsigned int) {
+        _chunkStream.str ("");
+        stdair::BomDisplay::csvDisplay (_chunkStream, iFlightDate);
+        _sink (_chunkStream.str());
+      }
+    };
+
+    /** Listing of the flight-dates, by inventory, into a stream. */
+    struct ListVisitor {
+      std::ostream& _stream;
+      ListVisitor (std::ostream& ioStream) : _stream (ioStream) {
+      }
+      void operator() (const stdair::FlightDate& iFlightDate,
+                       const unsigned int iInventoryIndex,
+                       const unsigned int iFlightDateIndex) {
+        const stdair::AirlineCode_T& lAirlineCode =
+          iFlightDate.getAirlineCode();
+        if (iFlightDateIndex == 1) {
+          _stream << iInventoryIndex << ". " << lAirlineCode << std::endl;
+        }
+        _stream << "  " << iInventoryIndex << "." << iFlightDateIndex << ". "
+                << lAirlineCode << iFlightDate.getFlightNumber() << " / "
+                << iFlightDate.getDepartureDate() << std::endl;
+      }
+    };
+
+    /**
+     * Export, in JSon format, of the given page of the flight-dates.
+     * The flight-dates outside of the page are only counted.
+     */
+    struct JSONPageVisitor {
+      std::ostream& _stream;
+      const bool _exportObjects;
+      const std::size_t _offset;
+      const std::size_t _limit;
+      std::size_t _nbOfFlightDates;
+      JSONPageVisitor (std::ostream& ioStream, const bool iExportObjects,
+                       const std::size_t& iOffset, const std::size_t& iLimit)
+        : _stream (ioStream), _exportObjects (iExportObjects),
+          _offset (iOffset), _limit (iLimit), _nbOfFlightDates (0) {
+      }
+      bool isWithinPage (const std::size_t& iIndex) const {
+        return (iIndex >= _offset
+                && (_limit == 0 || iIndex < _offset + _limit));
+      }
+      void operator() (const stdair::FlightDate& iFlightDate,
+                       const unsigned int, const unsigned int) {
+        const std::size_t lIndex = _nbOfFlightDates;
+        ++_nbOfFlightDates;
+        if (isWithinPage (lIndex) == false) {
+          return;
+        }
+        if (lIndex != _offset) {
+          _stream << ",";
+        }
+
+        if (_exportObjects == true) {
+          stdair::BomJSONExport::jsonExportFlightDateObjects (_stream,
+                                                              iFlightDate);
+          return;
+        }
+        _stream << "{\"airline_code\":\"" << iFlightDate.getAirlineCode()
+                << "\",\"flight_number\":\"" << iFlightDate.getFlightNumber()
+                << "\",\"departure_date\":\""
+                << boost::gregorian::to_iso_extended_string (iFlightDate.
+                                                             getDepartureDate())
+                << "\"}";
+      }
+    };
+
+    /**
+     * Export, in JSon format, of the given page of the flight-dates,
+     * as the given (list) member, followed by the pagination members.
+     */
+    void jsonExportPage (std::ostream& oStream, const char* iListName,
+                         const bool iExportObjects,
+                         const stdair::BomRoot& iBomRoot,
+                         const DisplayFilterStruct& iDisplayFilter,
+                         const std::size_t& iOffset,
+                         const std::size_t& iLimit) {
+      oStream << "{\"" << iListName << "\":[";
+      JSONPageVisitor lVisitor (oStream, iExportObjects, iOffset, iLimit);
+      visitFlightDates (iBomRoot, iDisplayFilter, lVisitor);
+      const bool hasMore = (iLimit != 0
+                            && lVisitor._nbOfFlightDates > iOffset + iLimit);
+      oStream << "],\"offset\":" << iOffset << ",\"limit\":" << iLimit
+              << ",\"nb_of_flight_dates\":" << lVisitor._nbOfFlightDates
+              << ",\"has_more\":" << (hasMore == true ? "true" : "false")
+              << "}";
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DisplayManager::csvDisplay (std::ostream& oStream,
+                                   const stdair::BomRoot& iBomRoot,
+                                   const DisplayFilterStruct& iDisplayFilter) {
+    CSVStreamVisitor lVisitor (oStream);
+    visitFlightDates (iBomRoot, iDisplayFilter, lVisitor);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DisplayManager::csvDisplay (const DisplayChunkSink_T& iSink,
+                                   const stdair::BomRoot& iBomRoot,
+                                   const DisplayFilterStruct& iDisplayFilter) {
+    CSVChunkVisitor lVisitor (iSink);
+    visitFlightDates (iBomRoot, iDisplayFilter, lVisitor);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DisplayManager::list (std::ostream& oStream,
+                             const stdair::BomRoot& iBomRoot,
+                             const DisplayFilterStruct& iDisplayFilter) {
+    ListVisitor lVisitor (oStream);
+    visitFlightDates (iBomRoot, iDisplayFilter, lVisitor);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool DisplayManager::
+  jsonExport (std::ostream& oStream, const stdair::BomRoot& iBomRoot,
+              const std::string& iCommandName,
+              const boost::property_tree::ptree& iParameterTree) {
+    if (iCommandName != "list" && iCommandName != "flight_date") {
+      return false;
+    }
+
+    // Parse the parameters. The malformed commands are left to AirInv,
+    // which reports the errors.
+    DisplayFilterStruct lDisplayFilter;
+    std::size_t lOffset = 0;
+    std::size_t lLimit = DEFAULT_JSON_EXPORT_PAGE_SIZE;
+    try {
+      const stdair::AirlineCode_T lAirlineCode =
+        iParameterTree.get<stdair::AirlineCode_T> ("airline_code", "all");
+      const stdair::FlightNumber_T lFlightNumber =
+        iParameterTree.get<stdair::FlightNumber_T> ("flight_number", 0);
+      stdair::Date_T lDepartureDate;
+      const std::string lDepartureDateStr =
+        iParameterTree.get<std::string> ("departure_date", "");
+      if (lDepartureDateStr.empty() == false) {
+        lDepartureDate = boost::gregorian::from_string (lDepartureDateStr);
+      }
+      lOffset = iParameterTree.get<std::size_t> ("offset", lOffset);
+      lLimit = iParameterTree.get<std::size_t> ("limit", lLimit);
+      lDisplayFilter = DisplayFilterStruct (lAirlineCode, lFlightNumber,
+                                            lDepartureDate, lDepartureDate);
+
+    } catch (const boost::property_tree::ptree_error&) {
+      return false;
+
+    } catch (const std::out_of_range&) {
+      // Invalid departure date
+      return false;
+
+    } catch (const boost::bad_lexical_cast&) {
+      return false;
+    }
+
+    if (iCommandName == "list") {
+      jsonExportFlightDateList (oStream, iBomRoot, lDisplayFilter,
+                                lOffset, lLimit);
+    } else {
+      jsonExportFlightDates (oStream, iBomRoot, lDisplayFilter,
+                             lOffset, lLimit);
+    }
+    return true;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DisplayManager::
+  jsonExportFlightDateList (std::ostream& oStream,
+                            const stdair::BomRoot& iBomRoot,
+                            const DisplayFilterStruct& iDisplayFilter,
+                            const std::size_t& iOffset,
+                            const std::size_t& iLimit) {
+    jsonExportPage (oStream, "flight_list", false, iBomRoot, iDisplayFilter,
+                    iOffset, iLimit);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DisplayManager::
+  jsonExportFlightDates (std::ostream& oStream,
+                         const stdair::BomRoot& iBomRoot,
+                         const DisplayFilterStruct& iDisplayFilter,
+                         const std::size_t& iOffset,
+                         const std::size_t& iLimit) {
+    jsonExportPage (oStream, "flight_date_list", true, iBomRoot,
+                    iDisplayFilter, iOffset, iLimit);
+  }
+
+}
@@ -0,0 +1,105 @@
+#ifndef __SIMCRS_CMD_DISPLAYMANAGER_HPP
+#define __SIMCRS_CMD_DISPLAYMANAGER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+// Boost
+#include <boost/property_tree/ptree_fwd.hpp>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+#include <simcrs/SIMCRS_DisplayFilter.hpp>
+
+// Forward declarations
+namespace stdair {
+  class BomRoot;
+}
+
+namespace SIMCRS {
+
+  /**
+   * @brief Command streaming the display of the (inventory) BOM tree,
+   * one flight-date at a time, so that the memory needed does not
+   * depend on the size of the BOM tree.
+   */
+  class DisplayManager {
+    friend class SIMCRS_Service;
+  private:
+    /**
+     * Recursively display, in CSV format, the flight-dates (of the
+     * given BOM tree) selected by the given filter, into the given
+     * output stream.
+     */
+    static void csvDisplay (std::ostream&, const stdair::BomRoot&,
+                            const DisplayFilterStruct&);
+
+    /**
+     * Recursively display (see above) the selected flight-dates, handing
+     * the display of each of them, as a chunk, to the given sink.
+     */
+    static void csvDisplay (const DisplayChunkSink_T&, const stdair::BomRoot&,
+                            const DisplayFilterStruct&);
+
+    /**
+     * List the flight-dates (of the given BOM tree) selected by the
+     * given filter, by inventory, into the given output stream.
+     */
+    static void list (std::ostream&, const stdair::BomRoot&,
+                      const DisplayFilterStruct&);
+
+    /**
+     * Stream the answer to the given (already parsed) JSon command, given
+     * by its name and its parameters, when it is an inventory (list) or
+     * flight-date export command:
+     * - {"list":{"airline_code":"SQ","flight_number":"12"}}
+     *   lists the (selected) flight-dates;
+     * - {"flight_date":{"airline_code":"SQ","flight_number":"12",
+     *   "departure_date":"2011-01-10"}} exports the objects of the
+     *   (selected) flight-dates.
+     * All the fields are optional (by default, everything is selected).
+     * The answers are paginated, with the optional "offset" (0 by
+     * default) and "limit" (DEFAULT_JSON_EXPORT_PAGE_SIZE by default, 0
+     * meaning no limit) fields: only the page is held in memory, and the
+     * flight-date objects are exported one flight-date at a time.
+     *
+     * @return bool Whether the command has been answered, i.e., whether
+     *         it is a (well-formed) inventory or flight-date export
+     *         command.
+     */
+    static bool jsonExport (std::ostream&, const stdair::BomRoot&,
+                            const std::string& iCommandName,
+                            const boost::property_tree::ptree&);
+
+    /**
+     * Stream (see above) the given page of the list of the selected
+     * flight-dates, in JSon format.
+     */
+    static void jsonExportFlightDateList (std::ostream&,
+                                          const stdair::BomRoot&,
+                                          const DisplayFilterStruct&,
+                                          const std::size_t& iOffset,
+                                          const std::size_t& iLimit);
+
+    /**
+     * Stream (see above) the objects of the given page of the selected
+     * flight-dates, in JSon format.
+     */
+    static void jsonExportFlightDates (std::ostream&, const stdair::BomRoot&,
+                                       const DisplayFilterStruct&,
+                                       const std::size_t& iOffset,
+                                       const std::size_t& iLimit);
+
+  private:
+    /** Constructors. */
+    DisplayManager() {}
+    DisplayManager(const DisplayManager&) {}
+    /** Destructor. */
+    ~DisplayManager() {}
+  };
+
+}
+#endif // __SIMCRS_CMD_DISPLAYMANAGER_HPP
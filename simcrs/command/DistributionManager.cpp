@@ -3,7 +3,9 @@
 // //////////////////////////////////////////////////////////////////////
 // STL
 #include <cassert>
+#include <sstream>
 // StdAir
+#include <stdair/bom/BookingClass.hpp>
 #include <stdair/bom/FareOptionStruct.hpp>
 #include <stdair/bom/TravelSolutionStruct.hpp>
 #include <stdair/bom/CancellationStruct.hpp>
@@ -11,6 +13,10 @@
 // Airline Inventory
 #include <airinv/AIRINV_Master_Service.hpp>
 // SimCRS
+#include <simcrs/basic/BasConst_General.hpp>
+#include <simcrs/basic/BasProbes.hpp>
+#include <simcrs/bom/SymbolTable.hpp>
+#include <simcrs/command/SymbolManager.hpp>
 #include <simcrs/command/DistributionManager.hpp>
 
 namespace SIMCRS {
@@ -19,6 +25,9 @@ namespace SIMCRS {
   void DistributionManager::
   calculateAvailability (AIRINV::AIRINV_Master_Service& ioAIRINV_Master_Service,
                          stdair::TravelSolutionList_T& ioTravelSolutionList) {
+    SIMCRS_PROBE1 (dm_calculate_availability__entry,
+                   ioTravelSolutionList.size());
+
     for (stdair::TravelSolutionList_T::iterator itTS =
            ioTravelSolutionList.begin();
          itTS != ioTravelSolutionList.end(); ++itTS) {
@@ -27,13 +36,18 @@ namespace SIMCRS {
       // Forward the work to the dedicated service.
       ioAIRINV_Master_Service.calculateAvailability (lCurrentTravelSolution);
     }
+
+    SIMCRS_PROBE1 (dm_calculate_availability__return,
+                   ioTravelSolutionList.size());
   }
   
   // ////////////////////////////////////////////////////////////////////
   bool DistributionManager::
   sell (AIRINV::AIRINV_Master_Service& ioAIRINV_Master_Service,
+        SymbolTable& ioSymbolTable, const stdair::BomRoot& iBomRoot,
         const stdair::TravelSolutionStruct& iTravelSolution,
         const stdair::NbOfSeats_T& iPartySize) {
+    SIMCRS_PROBE1 (dm_sell__entry, static_cast<int> (iPartySize));
     bool hasSaleBeenSuccessful = false;
 
     const stdair::ClassObjectIDMapHolder_T& lClassObjectIDMapHolder =
@@ -51,13 +65,10 @@ namespace SIMCRS {
            ++itClassObjectIDMap, ++itClassKeyList) {
         const stdair::ClassObjectIDMap_T& lClassObjectIDMap =
           *itClassObjectIDMap;
-      
-        // TODO: Removed this hardcode.
-        std::ostringstream ostr;
         const stdair::ClassList_String_T& lClassList = *itClassKeyList;
         assert (lClassList.size() > 0);
-        ostr << lClassList.at(0);
-        const stdair::ClassCode_T lClassCode (ostr.str());
+
+        const stdair::ClassCode_T lClassCode (1, lClassList.at(0));
         stdair::ClassObjectIDMap_T::const_iterator itClassID =
           lClassObjectIDMap.find (lClassCode);
         assert (itClassID != lClassObjectIDMap.end());
@@ -75,23 +86,74 @@ namespace SIMCRS {
         lChosenFareOption.getClassPath();
       stdair::ClassList_StringList_T::const_iterator itClassKeyList =
         lClassPath.begin();
+      const CodeDictionary& lClassCodeDictionary =
+        ioSymbolTable.getClassCodeDictionary();
       for (stdair::KeyList_T::const_iterator itKey= lSegmentDateKeyList.begin();
            itKey != lSegmentDateKeyList.end(); ++itKey, ++itClassKeyList) {
         const std::string& lSegmentDateKey = *itKey;
-      
-        // TODO: Removed this hardcode.
-        std::ostringstream ostr;
         const stdair::ClassList_String_T& lClassList = *itClassKeyList;
         assert (lClassList.size() > 0);
-        ostr << lClassList.at(0);
-        const stdair::ClassCode_T lClassCode (ostr.str());
-      
-        hasSaleBeenSuccessful = 
-          ioAIRINV_Master_Service.sell (lSegmentDateKey, lClassCode,
-                                        iPartySize);
+
+        // Retrieve the booking class through the interned identifiers
+        const SegmentDateID_T lSegmentDateID =
+          SymbolManager::internSegmentDate (iBomRoot, ioSymbolTable,
+                                            lSegmentDateKey);
+        // A class code never interned has no identifier, and thus no
+        // bound booking class either
+        const ClassCodeID_T lClassCodeID =
+          lClassCodeDictionary.find (lClassList.at(0));
+        stdair::BookingClass* lBookingClass_ptr = NULL;
+        if (lClassCodeID != DEFAULT_NULL_SYMBOL_ID) {
+          lBookingClass_ptr =
+            ioSymbolTable.getBookingClass (lSegmentDateID, lClassCodeID);
+        }
+
+        if (lBookingClass_ptr != NULL) {
+          const stdair::BookingClassID_T lClassID (*lBookingClass_ptr);
+          hasSaleBeenSuccessful =
+            ioAIRINV_Master_Service.sell (lClassID, iPartySize);
+
+        } else {
+          // The segment-date is not part of the (working) BOM tree of
+          // SimCRS: let AirInv retrieve it from its key
+          const stdair::ClassCode_T lClassCode (1, lClassList.at(0));
+          hasSaleBeenSuccessful =
+            ioAIRINV_Master_Service.sell (lSegmentDateKey, lClassCode,
+                                          iPartySize);
+        }
       }
     }
 
+    SIMCRS_PROBE2 (dm_sell__return, static_cast<int> (iPartySize),
+                   static_cast<int> (hasSaleBeenSuccessful));
+    return hasSaleBeenSuccessful;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool DistributionManager::
+  sell (AIRINV::AIRINV_Master_Service& ioAIRINV_Master_Service,
+        const SymbolTable& iSymbolTable,
+        const SegmentDateID_T& iSegmentDateID,
+        const ClassCodeID_T& iClassCodeID,
+        const stdair::NbOfSeats_T& iPartySize) {
+    SIMCRS_PROBE1 (dm_sell__entry, static_cast<int> (iPartySize));
+
+    stdair::BookingClass* lBookingClass_ptr =
+      iSymbolTable.getBookingClass (iSegmentDateID, iClassCodeID);
+    if (lBookingClass_ptr == NULL) {
+      std::ostringstream oStr;
+      oStr << "No booking class corresponds to the segment-date identifier "
+           << iSegmentDateID << " and booking class identifier "
+           << iClassCodeID;
+      throw SymbolNotFoundException (oStr.str());
+    }
+
+    const stdair::BookingClassID_T lClassID (*lBookingClass_ptr);
+    const bool hasSaleBeenSuccessful =
+      ioAIRINV_Master_Service.sell (lClassID, iPartySize);
+
+    SIMCRS_PROBE2 (dm_sell__return, static_cast<int> (iPartySize),
+                   static_cast<int> (hasSaleBeenSuccessful));
     return hasSaleBeenSuccessful;
   }
 
@@ -102,6 +164,8 @@ namespace SIMCRS {
     bool hasCancellationBeenSuccessful = false;
 
     const stdair::PartySize_T& lPartySize = iCancellation.getPartySize();
+    SIMCRS_PROBE1 (dm_cancel__entry, static_cast<int> (lPartySize));
+
     const stdair::BookingClassIDList_T& lClassIDList =
       iCancellation.getClassIDList();
 
@@ -112,6 +176,9 @@ namespace SIMCRS {
       hasCancellationBeenSuccessful =
         ioAIRINV_Master_Service.cancel (lClassID, lPartySize);
     }    
+
+    SIMCRS_PROBE2 (dm_cancel__return, static_cast<int> (lPartySize),
+                   static_cast<int> (hasCancellationBeenSuccessful));
     return hasCancellationBeenSuccessful;
   }
   
@@ -14,6 +14,7 @@
 
 // Forward declarations
 namespace stdair {
+  class BomRoot;
   struct TravelSolutionStruct;
   struct CancellationStruct;
 }
@@ -24,21 +25,37 @@ namespace AIRINV {
 
 namespace SIMCRS {
 
+  // Forward declarations
+  class SymbolTable;
+
   /**
    * @brief Command wrapping the travel distribution (CRS/GDS) process.
    */
   class DistributionManager {
     friend class SIMCRS_Service;
+    friend class ShoppingManager;
   private:
     /** Get the availability for each travel solution in the list.. */
     static void calculateAvailability (AIRINV::AIRINV_Master_Service&,
                                        stdair::TravelSolutionList_T&);
     
-    /** Register a booking (segment sell). */
-    static bool sell (AIRINV::AIRINV_Master_Service&,
+    /**
+     * Register a booking (segment sell).
+     *
+     * When the availability has not been calculated on the travel solution,
+     * the booking classes are retrieved through the symbol table (interned
+     * identifiers), rather than through their (string) keys.
+     */
+    static bool sell (AIRINV::AIRINV_Master_Service&, SymbolTable&,
+                      const stdair::BomRoot&,
                       const stdair::TravelSolutionStruct&,
                       const stdair::NbOfSeats_T&);
 
+    /** Register a booking on a segment-date given by its identifier. */
+    static bool sell (AIRINV::AIRINV_Master_Service&, const SymbolTable&,
+                      const SegmentDateID_T&, const ClassCodeID_T&,
+                      const stdair::NbOfSeats_T&);
+
     /** Register a cancellation. */
     static bool playCancellation (AIRINV::AIRINV_Master_Service&,
                                   const stdair::CancellationStruct&);
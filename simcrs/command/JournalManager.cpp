@@ -0,0 +1,151 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+#include <string_view>
+// StdAir
+#include <stdair/stdair_exceptions.hpp>
+#include <stdair/bom/BookingClass.hpp>
+#include <stdair/bom/FareOptionStruct.hpp>
+#include <stdair/bom/TravelSolutionStruct.hpp>
+#include <stdair/bom/CancellationStruct.hpp>
+#include <stdair/service/Logger.hpp>
+// Airline Inventory
+#include <airinv/AIRINV_Master_Service.hpp>
+// SimCRS
+#include <simcrs/basic/BasConst_General.hpp>
+#include <simcrs/bom/SymbolTable.hpp>
+#include <simcrs/bom/MappedFile.hpp>
+#include <simcrs/bom/BookingJournal.hpp>
+#include <simcrs/command/SymbolManager.hpp>
+#include <simcrs/command/JournalManager.hpp>
+
+namespace SIMCRS {
+
+  // ////////////////////////////////////////////////////////////////////
+  void JournalManager::
+  journalSell (BookingJournal& ioBookingJournal,
+               const stdair::TravelSolutionStruct& iTravelSolution,
+               const stdair::PartySize_T& iPartySize) {
+    const stdair::KeyList_T& lSegmentDateKeyList =
+      iTravelSolution.getSegmentPath();
+    const stdair::ClassList_StringList_T& lClassPath =
+      iTravelSolution.getChosenFareOption().getClassPath();
+    stdair::ClassList_StringList_T::const_iterator itClassList =
+      lClassPath.begin();
+    for (stdair::KeyList_T::const_iterator itKey = lSegmentDateKeyList.begin();
+         itKey != lSegmentDateKeyList.end() && itClassList != lClassPath.end();
+         ++itKey, ++itClassList) {
+      const stdair::ClassList_String_T& lClassList = *itClassList;
+      assert (lClassList.empty() == false);
+      const stdair::ClassCode_T lClassCode (1, lClassList.at(0));
+      journalSell (ioBookingJournal, *itKey, lClassCode, iPartySize);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void JournalManager::journalSell (BookingJournal& ioBookingJournal,
+                                    const std::string& iSegmentDateKey,
+                                    const stdair::ClassCode_T& iClassCode,
+                                    const stdair::PartySize_T& iPartySize) {
+    JournalRecordStruct lRecord;
+    lRecord._recordType = JournalRecordStruct::SELL;
+    lRecord._segmentDateKey = iSegmentDateKey;
+    lRecord._classCode = iClassCode;
+    lRecord._partySize = iPartySize;
+    ioBookingJournal.append (lRecord);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void JournalManager::
+  journalCancellation (BookingJournal& ioBookingJournal,
+                       const stdair::CancellationStruct& iCancellation) {
+    const stdair::KeyList_T& lSegmentDateKeyList =
+      iCancellation.getSegmentPath();
+    const stdair::BookingClassIDList_T& lClassIDList =
+      iCancellation.getClassIDList();
+
+    JournalRecordStruct lRecord;
+    lRecord._recordType = JournalRecordStruct::CANCELLATION;
+    lRecord._partySize = iCancellation.getPartySize();
+    stdair::BookingClassIDList_T::const_iterator itClassID =
+      lClassIDList.begin();
+    for (stdair::KeyList_T::const_iterator itKey = lSegmentDateKeyList.begin();
+         itKey != lSegmentDateKeyList.end() && itClassID != lClassIDList.end();
+         ++itKey, ++itClassID) {
+      const stdair::BookingClass& lBookingClass = itClassID->getObject();
+      lRecord._segmentDateKey = *itKey;
+      lRecord._classCode = lBookingClass.getClassCode();
+      ioBookingJournal.append (lRecord);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  JournalReplayStatsStruct JournalManager::
+  replay (const stdair::Filename_T& iFilename,
+          AIRINV::AIRINV_Master_Service& ioAIRINV_Master_Service,
+          const stdair::BomRoot& iBomRoot, SymbolTable& ioSymbolTable) {
+    JournalReplayStatsStruct oReplayStats;
+
+    const MappedFile lJournalFile (iFilename);
+    std::string_view lContent = lJournalFile.getContent();
+    const std::string_view lSignature = BookingJournal::getSignature();
+    if (lContent.substr (0, lSignature.size()) != lSignature) {
+      std::ostringstream oMessage;
+      oMessage << "The file '" << iFilename << "' is not a booking journal";
+      STDAIR_LOG_ERROR (oMessage.str());
+      throw stdair::ParserException (oMessage.str());
+    }
+    lContent.remove_prefix (lSignature.size());
+
+    const CodeDictionary& lClassCodeDictionary =
+      ioSymbolTable.getClassCodeDictionary();
+    JournalRecordStruct lRecord;
+    while (lContent.empty() == false) {
+      if (BookingJournal::deserialise (lContent, lRecord) == false) {
+        // Record written (partly) when the process stopped
+        oReplayStats._isTruncated = true;
+        STDAIR_LOG_DEBUG ("The booking journal '" << iFilename << "' ends "
+                          << "with " << lContent.size()
+                          << " bytes of incomplete record, ignored");
+        break;
+      }
+      ++oReplayStats._nbOfRecords;
+
+      // Retrieve the booking class through the interned identifiers
+      const SegmentDateID_T lSegmentDateID =
+        SymbolManager::internSegmentDate (iBomRoot, ioSymbolTable,
+                                          lRecord._segmentDateKey);
+      const ClassCodeID_T lClassCodeID =
+        lClassCodeDictionary.find (lRecord._classCode);
+      stdair::BookingClass* lBookingClass_ptr =
+        (lClassCodeID == DEFAULT_NULL_SYMBOL_ID ? NULL
+         : ioSymbolTable.getBookingClass (lSegmentDateID, lClassCodeID));
+
+      bool isApplied = false;
+      if (lBookingClass_ptr != NULL) {
+        const stdair::BookingClassID_T lClassID (*lBookingClass_ptr);
+        isApplied = (lRecord._recordType == JournalRecordStruct::SELL
+                     ? ioAIRINV_Master_Service.sell (lClassID,
+                                                     lRecord._partySize)
+                     : ioAIRINV_Master_Service.cancel (lClassID,
+                                                       lRecord._partySize));
+      }
+
+      if (isApplied == true) {
+        ++oReplayStats._nbOfAppliedRecords;
+      } else {
+        ++oReplayStats._nbOfFailedRecords;
+        STDAIR_LOG_DEBUG ("The journal record for " << lRecord._partySize
+                          << " seat(s) of the " << lRecord._classCode
+                          << " class of '" << lRecord._segmentDateKey
+                          << "' can not be replayed");
+      }
+    }
+
+    return oReplayStats;
+  }
+
+}
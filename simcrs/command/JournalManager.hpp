@@ -0,0 +1,90 @@
+#ifndef __SIMCRS_CMD_JOURNALMANAGER_HPP
+#define __SIMCRS_CMD_JOURNALMANAGER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+
+// Forward declarations
+namespace stdair {
+  class BomRoot;
+  struct TravelSolutionStruct;
+  struct CancellationStruct;
+}
+
+namespace AIRINV {
+  class AIRINV_Master_Service;
+}
+
+namespace SIMCRS {
+
+  // Forward declarations
+  class SymbolTable;
+  class BookingJournal;
+
+  /**
+   * @brief Command recording the sells and cancellations into the
+   * booking journal, and replaying a booking journal on the inventory.
+   *
+   * The records refer to the booking classes by the keys of their
+   * segment-dates and by their class codes, which do not depend on the
+   * process having made them.
+   */
+  class JournalManager {
+    friend class SIMCRS_Service;
+  private:
+    /**
+     * Record the sell of the given travel solution (one record per
+     * segment, in the class of the chosen fare option).
+     */
+    static void journalSell (BookingJournal&,
+                             const stdair::TravelSolutionStruct&,
+                             const stdair::PartySize_T&);
+
+    /**
+     * Record the sell of the given booking class of the given
+     * segment-date.
+     */
+    static void journalSell (BookingJournal&, const std::string&,
+                             const stdair::ClassCode_T&,
+                             const stdair::PartySize_T&);
+
+    /**
+     * Record the given cancellation (one record per segment).
+     */
+    static void journalCancellation (BookingJournal&,
+                                     const stdair::CancellationStruct&);
+
+    /**
+     * Replay the given booking journal on the inventory, i.e., make
+     * again its sells and cancellations, in the same order. The replay
+     * stops at the first incomplete or corrupted record.
+     *
+     * @param const stdair::Filename_T& Name of the journal file.
+     * @param AIRINV::AIRINV_Master_Service& Inventory to be updated.
+     * @param const stdair::BomRoot& (Working) BOM tree.
+     * @param SymbolTable& Table of the interned codes.
+     * @return JournalReplayStatsStruct Statistics of the replay.
+     * @exception stdair::FileNotFoundException
+     * @exception stdair::ParserException The file is not a journal.
+     */
+    static JournalReplayStatsStruct
+    replay (const stdair::Filename_T&, AIRINV::AIRINV_Master_Service&,
+            const stdair::BomRoot&, SymbolTable&);
+
+  private:
+    /** Constructors. */
+    JournalManager() {}
+    JournalManager(const JournalManager&) {}
+    /** Destructor. */
+    ~JournalManager() {}
+  };
+
+}
+#endif // __SIMCRS_CMD_JOURNALMANAGER_HPP
@@ -0,0 +1,259 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <ostream>
+#include <vector>
+// StdAir
+#include <stdair/bom/BomManager.hpp>
+#include <stdair/bom/BomRoot.hpp>
+#include <stdair/bom/Inventory.hpp>
+#include <stdair/bom/FlightDate.hpp>
+#include <stdair/bom/LegDate.hpp>
+#include <stdair/bom/LegCabin.hpp>
+#include <stdair/bom/Bucket.hpp>
+#include <stdair/bom/SegmentDate.hpp>
+#include <stdair/bom/SegmentCabin.hpp>
+#include <stdair/bom/FareFamily.hpp>
+#include <stdair/bom/BookingClass.hpp>
+#include <stdair/bom/FlightPeriod.hpp>
+#include <stdair/bom/SegmentPeriod.hpp>
+#include <stdair/bom/ReachableUniverse.hpp>
+#include <stdair/bom/OriginDestinationSet.hpp>
+#include <stdair/bom/SegmentPathPeriod.hpp>
+#include <stdair/bom/AirportPair.hpp>
+#include <stdair/bom/PosChannel.hpp>
+#include <stdair/bom/DatePeriod.hpp>
+#include <stdair/bom/TimePeriod.hpp>
+#include <stdair/bom/FareFeatures.hpp>
+#include <stdair/bom/AirlineClassList.hpp>
+// SimCRS
+#include <simcrs/basic/BasConst_General.hpp>
+#include <simcrs/bom/SymbolTable.hpp>
+#include <simcrs/bom/AvailabilityStatusTable.hpp>
+#include <simcrs/bom/FareQuoteCache.hpp>
+#include <simcrs/bom/RequestArena.hpp>
+#include <simcrs/command/MemoryReportManager.hpp>
+
+namespace SIMCRS {
+
+  namespace {
+    /**
+     * Collect the children (of the given type) of all the given parents.
+     */
+    template <typename CHILD, typename PARENT>
+    void collectChildren (const std::vector<const PARENT*>& iParentList,
+                          std::vector<const CHILD*>& ioChildList) {
+      for (typename std::vector<const PARENT*>::const_iterator itParent =
+             iParentList.begin(); itParent != iParentList.end(); ++itParent) {
+        const PARENT* lParent_ptr = *itParent;
+        assert (lParent_ptr != NULL);
+        if (stdair::BomManager::hasList<CHILD> (*lParent_ptr) == false) {
+          continue;
+        }
+        const std::list<CHILD*>& lChildList =
+          stdair::BomManager::getList<CHILD> (*lParent_ptr);
+        ioChildList.insert (ioChildList.end(),
+                            lChildList.begin(), lChildList.end());
+      }
+    }
+
+    /**
+     * Add the given BOM objects to the memory usage list.
+     */
+    template <typename OBJECT>
+    void addBomUsage (const std::string& iComponent,
+                      const std::string& iStructure, const std::string& iType,
+                      const std::vector<const OBJECT*>& iObjectList,
+                      MemoryUsageList_T& ioMemoryUsageList) {
+      const std::size_t lNbOfObjects = iObjectList.size();
+      const std::size_t lNbOfBytes =
+        lNbOfObjects * (sizeof (OBJECT) + BOM_LINK_SIZE);
+      ioMemoryUsageList.push_back (MemoryUsageStruct (iComponent, iStructure,
+                                                      iType, lNbOfObjects,
+                                                      lNbOfBytes));
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void MemoryReportManager::reportBomTree (const stdair::BomRoot& iBomRoot,
+                                           const std::string& iStructure,
+                                           MemoryReportStruct& ioReport) {
+    MemoryUsageList_T& lMemoryUsageList = ioReport._memoryUsageList;
+    std::vector<const stdair::BomRoot*> lBomRootList (1, &iBomRoot);
+
+    // Inventories (AirInv). The booking classes are taken from the
+    // segment-cabins, as the fare families only refer to them.
+    std::vector<const stdair::Inventory*> lInventoryList;
+    collectChildren (lBomRootList, lInventoryList);
+    addBomUsage ("airinv", iStructure, "Inventory", lInventoryList,
+                 lMemoryUsageList);
+
+    std::vector<const stdair::FlightDate*> lFlightDateList;
+    collectChildren (lInventoryList, lFlightDateList);
+    addBomUsage ("airinv", iStructure, "FlightDate", lFlightDateList,
+                 lMemoryUsageList);
+
+    std::vector<const stdair::LegDate*> lLegDateList;
+    collectChildren (lFlightDateList, lLegDateList);
+    addBomUsage ("airinv", iStructure, "LegDate", lLegDateList,
+                 lMemoryUsageList);
+
+    std::vector<const stdair::LegCabin*> lLegCabinList;
+    collectChildren (lLegDateList, lLegCabinList);
+    addBomUsage ("airinv", iStructure, "LegCabin", lLegCabinList,
+                 lMemoryUsageList);
+
+    std::vector<const stdair::Bucket*> lBucketList;
+    collectChildren (lLegCabinList, lBucketList);
+    addBomUsage ("airinv", iStructure, "Bucket", lBucketList,
+                 lMemoryUsageList);
+
+    std::vector<const stdair::SegmentDate*> lSegmentDateList;
+    collectChildren (lFlightDateList, lSegmentDateList);
+    addBomUsage ("airinv", iStructure, "SegmentDate", lSegmentDateList,
+                 lMemoryUsageList);
+
+    std::vector<const stdair::SegmentCabin*> lSegmentCabinList;
+    collectChildren (lSegmentDateList, lSegmentCabinList);
+    addBomUsage ("airinv", iStructure, "SegmentCabin", lSegmentCabinList,
+                 lMemoryUsageList);
+
+    std::vector<const stdair::FareFamily*> lFareFamilyList;
+    collectChildren (lSegmentCabinList, lFareFamilyList);
+    addBomUsage ("airinv", iStructure, "FareFamily", lFareFamilyList,
+                 lMemoryUsageList);
+
+    std::vector<const stdair::BookingClass*> lBookingClassList;
+    collectChildren (lSegmentCabinList, lBookingClassList);
+    addBomUsage ("airinv", iStructure, "BookingClass", lBookingClassList,
+                 lMemoryUsageList);
+
+    // Schedules (AirInv)
+    std::vector<const stdair::FlightPeriod*> lFlightPeriodList;
+    collectChildren (lInventoryList, lFlightPeriodList);
+    addBomUsage ("airinv", iStructure, "FlightPeriod", lFlightPeriodList,
+                 lMemoryUsageList);
+
+    std::vector<const stdair::SegmentPeriod*> lSegmentPeriodList;
+    collectChildren (lFlightPeriodList, lSegmentPeriodList);
+    addBomUsage ("airinv", iStructure, "SegmentPeriod", lSegmentPeriodList,
+                 lMemoryUsageList);
+
+    // Reachable universe (AirTSP)
+    std::vector<const stdair::ReachableUniverse*> lReachableUniverseList;
+    collectChildren (lBomRootList, lReachableUniverseList);
+    addBomUsage ("airtsp", iStructure, "ReachableUniverse",
+                 lReachableUniverseList, lMemoryUsageList);
+
+    std::vector<const stdair::OriginDestinationSet*> lODSetList;
+    collectChildren (lReachableUniverseList, lODSetList);
+    addBomUsage ("airtsp", iStructure, "OriginDestinationSet", lODSetList,
+                 lMemoryUsageList);
+
+    std::vector<const stdair::SegmentPathPeriod*> lSegmentPathPeriodList;
+    collectChildren (lODSetList, lSegmentPathPeriodList);
+    addBomUsage ("airtsp", iStructure, "SegmentPathPeriod",
+                 lSegmentPathPeriodList, lMemoryUsageList);
+
+    // Fare rules (SimFQT)
+    std::vector<const stdair::AirportPair*> lAirportPairList;
+    collectChildren (lBomRootList, lAirportPairList);
+    addBomUsage ("simfqt", iStructure, "AirportPair", lAirportPairList,
+                 lMemoryUsageList);
+
+    std::vector<const stdair::PosChannel*> lPosChannelList;
+    collectChildren (lAirportPairList, lPosChannelList);
+    addBomUsage ("simfqt", iStructure, "PosChannel", lPosChannelList,
+                 lMemoryUsageList);
+
+    std::vector<const stdair::DatePeriod*> lDatePeriodList;
+    collectChildren (lPosChannelList, lDatePeriodList);
+    addBomUsage ("simfqt", iStructure, "DatePeriod", lDatePeriodList,
+                 lMemoryUsageList);
+
+    std::vector<const stdair::TimePeriod*> lTimePeriodList;
+    collectChildren (lDatePeriodList, lTimePeriodList);
+    addBomUsage ("simfqt", iStructure, "TimePeriod", lTimePeriodList,
+                 lMemoryUsageList);
+
+    std::vector<const stdair::FareFeatures*> lFareFeaturesList;
+    collectChildren (lTimePeriodList, lFareFeaturesList);
+    addBomUsage ("simfqt", iStructure, "FareFeatures", lFareFeaturesList,
+                 lMemoryUsageList);
+
+    std::vector<const stdair::AirlineClassList*> lAirlineClassListList;
+    collectChildren (lFareFeaturesList, lAirlineClassListList);
+    addBomUsage ("simfqt", iStructure, "AirlineClassList",
+                 lAirlineClassListList, lMemoryUsageList);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void MemoryReportManager::
+  reportSimCRSStructures (const SymbolTable& iSymbolTable,
+                          const AvailabilityStatusTable& iAVSTable,
+                          const FareQuoteCache& iFareQuoteCache,
+                          const RequestArena& iRequestArena,
+                          MemoryReportStruct& ioReport) {
+    MemoryUsageList_T& lMemoryUsageList = ioReport._memoryUsageList;
+
+    const std::size_t lNbOfCodes =
+      iSymbolTable.getAirportDictionary().size()
+      + iSymbolTable.getAirlineDictionary().size()
+      + iSymbolTable.getClassCodeDictionary().size()
+      + iSymbolTable.getSegmentDateDictionary().size();
+    lMemoryUsageList.push_back (MemoryUsageStruct ("simcrs", "simcrs",
+                                                   "SymbolTable", lNbOfCodes,
+                                                   iSymbolTable.
+                                                   getNbOfBytes()));
+
+    lMemoryUsageList.
+      push_back (MemoryUsageStruct ("simcrs", "simcrs",
+                                    "AvailabilityStatusTable",
+                                    iAVSTable.getNbOfStatuses(),
+                                    iAVSTable.getNbOfBytes()));
+
+    const FareQuoteCacheStatsStruct lCacheStats = iFareQuoteCache.getStats();
+    lMemoryUsageList.
+      push_back (MemoryUsageStruct ("simcrs", "simcrs", "FareQuoteCache",
+                                    lCacheStats._nbOfEntries,
+                                    iFareQuoteCache.getNbOfBytes()));
+
+    lMemoryUsageList.
+      push_back (MemoryUsageStruct ("simcrs", "simcrs", "RequestArena",
+                                    iRequestArena.getNbOfBlocks(),
+                                    iRequestArena.getReservedBytes()));
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void MemoryReportManager::jsonExport (std::ostream& oStream,
+                                        const MemoryReportStruct& iReport) {
+    // The names of the components, structures and types are plain
+    // identifiers: they do not need to be escaped
+    oStream << "{\"memory_report\":{\"nb_of_objects\":"
+            << iReport.getNbOfObjects() << ",\"nb_of_bytes\":"
+            << iReport.getNbOfBytes() << ",\"components\":{\"airinv\":"
+            << iReport.getComponentNbOfBytes ("airinv") << ",\"airtsp\":"
+            << iReport.getComponentNbOfBytes ("airtsp") << ",\"simfqt\":"
+            << iReport.getComponentNbOfBytes ("simfqt") << ",\"simcrs\":"
+            << iReport.getComponentNbOfBytes ("simcrs") << "},\"types\":[";
+
+    const MemoryUsageList_T& lMemoryUsageList = iReport.getMemoryUsageList();
+    for (MemoryUsageList_T::const_iterator itUsage = lMemoryUsageList.begin();
+         itUsage != lMemoryUsageList.end(); ++itUsage) {
+      const MemoryUsageStruct& lMemoryUsage = *itUsage;
+      if (itUsage != lMemoryUsageList.begin()) {
+        oStream << ",";
+      }
+      oStream << "{\"structure\":\"" << lMemoryUsage.getStructure()
+              << "\",\"component\":\"" << lMemoryUsage.getComponent()
+              << "\",\"type\":\"" << lMemoryUsage.getType()
+              << "\",\"nb_of_objects\":" << lMemoryUsage.getNbOfObjects()
+              << ",\"nb_of_bytes\":" << lMemoryUsage.getNbOfBytes() << "}";
+    }
+
+    oStream << "]}}";
+  }
+
+}
@@ -0,0 +1,72 @@
+#ifndef __SIMCRS_CMD_MEMORYREPORTMANAGER_HPP
+#define __SIMCRS_CMD_MEMORYREPORTMANAGER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iosfwd>
+#include <string>
+// SimCRS
+#include <simcrs/SIMCRS_MemoryReport.hpp>
+
+// Forward declarations
+namespace stdair {
+  class BomRoot;
+}
+
+namespace SIMCRS {
+
+  // Forward declarations
+  class SymbolTable;
+  class AvailabilityStatusTable;
+  class FareQuoteCache;
+  class RequestArena;
+
+  /**
+   * @brief Command building the memory footprint report of SimCRS, by
+   * walking the BOM trees and the SimCRS structures.
+   */
+  class MemoryReportManager {
+    friend class SIMCRS_Service;
+  private:
+    /**
+     * Add the objects of the given BOM tree to the report: inventories
+     * and schedules (AirInv), reachable universe (AirTSP) and fare rules
+     * (SimFQT).
+     *
+     * @param const stdair::BomRoot& Root of the BOM tree.
+     * @param const std::string& Name of the BOM tree (e.g., "persistent").
+     * @param MemoryReportStruct& Report to be completed.
+     */
+    static void reportBomTree (const stdair::BomRoot&, const std::string&,
+                               MemoryReportStruct&);
+
+    /**
+     * Add the SimCRS structures to the report (the request arena being
+     * the one of the calling thread).
+     */
+    static void reportSimCRSStructures (const SymbolTable&,
+                                        const AvailabilityStatusTable&,
+                                        const FareQuoteCache&,
+                                        const RequestArena&,
+                                        MemoryReportStruct&);
+
+    /**
+     * Export the report in JSON format, i.e., as
+     * {"memory_report":{"nb_of_objects":..,"nb_of_bytes":..,
+     * "components":{"airinv":..,..},"types":[{"structure":..,
+     * "component":..,"type":..,"nb_of_objects":..,"nb_of_bytes":..},..]}}
+     */
+    static void jsonExport (std::ostream&, const MemoryReportStruct&);
+
+  private:
+    /** Constructors. */
+    MemoryReportManager() {}
+    MemoryReportManager(const MemoryReportManager&) {}
+    /** Destructor. */
+    ~MemoryReportManager() {}
+  };
+
+}
+#endif // __SIMCRS_CMD_MEMORYREPORTMANAGER_HPP
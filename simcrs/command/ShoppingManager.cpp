@@ -0,0 +1,922 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <algorithm>
+#include <cassert>
+#include <mutex>
+#include <sstream>
+#include <vector>
+// Boost
+#include <boost/lexical_cast.hpp>
+// StdAir
+#include <stdair/basic/BasChronometer.hpp>
+#include <stdair/bom/BookingClass.hpp>
+#include <stdair/bom/BookingRequestStruct.hpp>
+#include <stdair/bom/FareOptionStruct.hpp>
+#include <stdair/bom/TravelSolutionStruct.hpp>
+#include <stdair/service/Logger.hpp>
+#include <stdair/STDAIR_Service.hpp>
+// Airline Schedule
+#include <airtsp/AIRTSP_Service.hpp>
+// Fare Quote
+#include <simfqt/SIMFQT_Service.hpp>
+// Airline Inventory
+#include <airinv/AIRINV_Master_Service.hpp>
+// SimCRS
+#include <simcrs/SIMCRS_ShoppingResult.hpp>
+#include <simcrs/SIMCRS_CalendarResult.hpp>
+#include <simcrs/basic/BasConst_General.hpp>
+#include <simcrs/bom/RequestArena.hpp>
+#include <simcrs/bom/SymbolTable.hpp>
+#include <simcrs/bom/AvailabilityStatusTable.hpp>
+#include <simcrs/bom/FareQuoteCache.hpp>
+#include <simcrs/bom/RequestTraceTimer.hpp>
+#include <simcrs/bom/TraceEventRecorder.hpp>
+#include <simcrs/bom/DeltaOverlay.hpp>
+#include <simcrs/command/AvailabilityStatusManager.hpp>
+#include <simcrs/command/DeltaManager.hpp>
+#include <simcrs/command/DistributionManager.hpp>
+#include <simcrs/command/SymbolManager.hpp>
+#include <simcrs/command/ShoppingManager.hpp>
+#include <simcrs/service/SIMCRS_ServiceContext.hpp>
+
+namespace SIMCRS {
+
+  // ////////////////////////////////////////////////////////////////////
+  char& ShoppingManager::
+  getSegmentStatus (SegmentStatusList_T& ioSegmentStatusList,
+                    const SegmentDateID_T& iSegmentDateID) {
+    // The list is sorted by segment-date identifier
+    SegmentStatusList_T::iterator itStatus =
+      std::lower_bound (ioSegmentStatusList.begin(), ioSegmentStatusList.end(),
+                        iSegmentDateID,
+                        [] (const SegmentStatusStruct& iSegmentStatus,
+                            const SegmentDateID_T& iID) {
+                          return (iSegmentStatus._segmentDateID < iID);
+                        });
+    if (itStatus != ioSegmentStatusList.end()
+        && itStatus->_segmentDateID == iSegmentDateID) {
+      return itStatus->_status;
+    }
+
+    // First time the segment-date is met by the request
+    SegmentStatusStruct lSegmentStatus;
+    lSegmentStatus._segmentDateID = iSegmentDateID;
+    lSegmentStatus._status = SEGMENT_UNKNOWN;
+    itStatus = ioSegmentStatusList.insert (itStatus, lSegmentStatus);
+    return itStatus->_status;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool ShoppingManager::
+  maySell (const SymbolTable& iSymbolTable,
+           const AvailabilityStatusTable* iAvailabilityStatusTable_ptr,
+           SegmentStatusList_T& ioSegmentStatusList,
+           const stdair::TravelSolutionStruct& iTravelSolution,
+           const stdair::PartySize_T& iPartySize) {
+    const stdair::KeyList_T& lSegmentDateKeyList =
+      iTravelSolution.getSegmentPath();
+    for (stdair::KeyList_T::const_iterator itKey = lSegmentDateKeyList.begin();
+         itKey != lSegmentDateKeyList.end(); ++itKey) {
+      const std::string& lSegmentDateKey = *itKey;
+      const SegmentDateID_T lSegmentDateID =
+        SymbolManager::findSegmentDate (iSymbolTable, lSegmentDateKey);
+      if (lSegmentDateID == DEFAULT_NULL_SYMBOL_ID) {
+        // The segment-date is unknown to the CRS, which can not sell it
+        return false;
+      }
+
+      // The segment-date may already have been checked
+      char& lSegmentStatus =
+        getSegmentStatus (ioSegmentStatusList, lSegmentDateID);
+      if (lSegmentStatus == SEGMENT_UNKNOWN) {
+        if (iSymbolTable.getSegmentDate (lSegmentDateID) == NULL) {
+          // Nothing is known about that segment-date: keep it
+          lSegmentStatus = SEGMENT_OPEN;
+
+        } else if (iAvailabilityStatusTable_ptr != NULL
+                   && iAvailabilityStatusTable_ptr->
+                   hasSegmentDate (lSegmentDateID) == true) {
+          // The CRS knows the segment-date from its AVS table only
+          const ClassCodeID_T lNbOfClassCodes =
+            iSymbolTable.getClassCodeDictionary().size();
+          lSegmentStatus = SEGMENT_CLOSED;
+          for (ClassCodeID_T lClassCodeID = 0;
+               lClassCodeID != lNbOfClassCodes; ++lClassCodeID) {
+            const AvailabilityStatus_T lStatus =
+              iAvailabilityStatusTable_ptr->getStatus (lSegmentDateID,
+                                                       lClassCodeID);
+            if (lStatus != AvailabilityStatusTable::K_UNKNOWN_STATUS
+                && lStatus >= iPartySize) {
+              lSegmentStatus = SEGMENT_OPEN;
+              break;
+            }
+          }
+
+        } else {
+          const ClassCodeID_T lNbOfClassCodes =
+            iSymbolTable.getClassCodeDictionary().size();
+          lSegmentStatus = SEGMENT_CLOSED;
+          for (ClassCodeID_T lClassCodeID = 0;
+               lClassCodeID != lNbOfClassCodes; ++lClassCodeID) {
+            const stdair::BookingClass* lBookingClass_ptr =
+              iSymbolTable.getBookingClass (lSegmentDateID, lClassCodeID);
+            if (lBookingClass_ptr != NULL
+                && lBookingClass_ptr->getSegmentAvailability() >= iPartySize) {
+              lSegmentStatus = SEGMENT_OPEN;
+              break;
+            }
+          }
+        }
+      }
+
+      if (lSegmentStatus == SEGMENT_CLOSED) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool ShoppingManager::
+  checkSellable (SIMCRS_ServiceContext& ioSIMCRS_ServiceContext,
+                 SegmentStatusList_T& ioSegmentStatusList,
+                 const stdair::TravelSolutionStruct& iTravelSolution,
+                 const stdair::PartySize_T& iPartySize) {
+    RequestTraceStruct* lRequestTrace_ptr =
+      ioSIMCRS_ServiceContext.getCurrentRequestTrace();
+    RequestTraceTimer lTraceTimer (lRequestTrace_ptr,
+                                   RequestTraceStruct::PRUNING);
+    TraceEventScope lTraceEventScope (ioSIMCRS_ServiceContext.
+                                      getTraceEventRecorder(),
+                                      "checkSellable", "simcrs");
+    stdair::BasChronometer lPruningChronometer;
+    lPruningChronometer.start();
+
+    // Retrieve the table of the interned codes
+    const SymbolTable& lSymbolTable = ioSIMCRS_ServiceContext.getSymbolTable();
+
+    // With AVS-based availability, the CRS relies on its AVS table
+    const AvailabilityStatusTable* lAvailabilityStatusTable_ptr = NULL;
+    if (ioSIMCRS_ServiceContext.getAvailabilityMode() == AVS_AVAILABILITY) {
+      lAvailabilityStatusTable_ptr =
+        &ioSIMCRS_ServiceContext.getAvailabilityStatusTable();
+    }
+
+    const bool isSellable = maySell (lSymbolTable,
+                                     lAvailabilityStatusTable_ptr,
+                                     ioSegmentStatusList, iTravelSolution,
+                                     iPartySize);
+
+    // Keep track of the pruning work (the requests may be concurrent)
+    std::lock_guard<std::mutex>
+      lStatsGuard (ioSIMCRS_ServiceContext.getPruningStatsMutex());
+    PruningStatsStruct& lPruningStats =
+      ioSIMCRS_ServiceContext.getPruningStats();
+    ++lPruningStats._nbOfTravelSolutions;
+    if (isSellable == false) {
+      ++lPruningStats._nbOfPrunedTravelSolutions;
+    }
+    lPruningStats._pruningTime += lPruningChronometer.elapsed();
+
+    return isSellable;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ShoppingManager::
+  buildFareQuoteKey (const stdair::BookingRequestStruct& iBookingRequest,
+                     std::string& ioKey) {
+    std::ostringstream oStr;
+    oStr << iBookingRequest.getOrigin() << '|'
+         << iBookingRequest.getDestination() << '|'
+         << iBookingRequest.getPOS() << '|'
+         << iBookingRequest.getBookingChannel() << '|'
+         << iBookingRequest.getTripType() << '|'
+         << iBookingRequest.getStayDuration() << '|'
+         << iBookingRequest.getRequestDateTime().date() << '|'
+         << iBookingRequest.getPreferredCabin() << '|';
+    ioKey = oStr.str();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ShoppingManager::
+  buildFareQuoteKey (const std::string& iRequestKey,
+                     const stdair::TravelSolutionStruct& iTravelSolution,
+                     std::string& ioKey) {
+    ioKey = iRequestKey;
+    const stdair::KeyList_T& lSegmentDateKeyList =
+      iTravelSolution.getSegmentPath();
+    for (stdair::KeyList_T::const_iterator itKey = lSegmentDateKeyList.begin();
+         itKey != lSegmentDateKeyList.end(); ++itKey) {
+      const std::string& lSegmentDateKey = *itKey;
+      ioKey += lSegmentDateKey;
+      ioKey += ';';
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ShoppingManager::
+  buildFareQuoteKey (const stdair::BookingRequestStruct& iBookingRequest,
+                     const stdair::TravelSolutionList_T& iTravelSolutionList,
+                     std::string& ioKey) {
+    buildFareQuoteKey (iBookingRequest, ioKey);
+    for (stdair::TravelSolutionList_T::const_iterator itTS =
+           iTravelSolutionList.begin();
+         itTS != iTravelSolutionList.end(); ++itTS) {
+      const stdair::TravelSolutionStruct& lTravelSolution = *itTS;
+      const stdair::KeyList_T& lSegmentDateKeyList =
+        lTravelSolution.getSegmentPath();
+      for (stdair::KeyList_T::const_iterator itKey =
+             lSegmentDateKeyList.begin();
+           itKey != lSegmentDateKeyList.end(); ++itKey) {
+        const std::string& lSegmentDateKey = *itKey;
+        ioKey += lSegmentDateKey;
+        ioKey += ';';
+      }
+      ioKey += '/';
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ShoppingManager::
+  buildSegmentPathKey (const stdair::BookingRequestStruct& iBookingRequest,
+                       std::string& ioKey) {
+    std::ostringstream oStr;
+    oStr << iBookingRequest.getOrigin() << '|'
+         << iBookingRequest.getDestination() << '|'
+         << iBookingRequest.getPreferedDepartureDate();
+    ioKey = oStr.str();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ShoppingManager::
+  quotePrices (SIMCRS_ServiceContext& ioSIMCRS_ServiceContext,
+               const stdair::BookingRequestStruct& iBookingRequest,
+               stdair::TravelSolutionList_T& ioTravelSolutionList) {
+    RequestTraceStruct* lRequestTrace_ptr =
+      ioSIMCRS_ServiceContext.getCurrentRequestTrace();
+    RequestTraceTimer lTraceTimer (lRequestTrace_ptr,
+                                   RequestTraceStruct::FARE_QUOTE);
+    stdair::BasChronometer lFareQuoteChronometer;
+    lFareQuoteChronometer.start();
+
+    // The temporaries of the fare quote are given back to the request
+    // arena at its end, even when it is nested within a shopping request
+    RequestArena& lRequestArena = ioSIMCRS_ServiceContext.getRequestArena();
+    RequestArenaScope lRequestArenaScope (lRequestArena);
+
+    // Take a reference on the current version of the fares, which is
+    // kept alive until the fare quote is over, even when new fares are
+    // published meanwhile. The version is read first (see
+    // SIMCRS_ServiceContext::publishSIMFQT_Service()).
+    const FareVersion_T lFareVersion =
+      ioSIMCRS_ServiceContext.getFareVersion();
+    const SIMFQT::SIMFQT_ServicePtr_T lSIMFQT_ServicePtr =
+      ioSIMCRS_ServiceContext.getSIMFQT_ServicePtr();
+    assert (lSIMFQT_ServicePtr != NULL);
+    SIMFQT::SIMFQT_Service& lSIMFQT_Service = *lSIMFQT_ServicePtr;
+    FareQuoteCache& lFareQuoteCache =
+      ioSIMCRS_ServiceContext.getFareQuoteCache();
+    TraceEventRecorder& lTraceEventRecorder =
+      ioSIMCRS_ServiceContext.getTraceEventRecorder();
+
+    if (lFareQuoteCache.isEnabled() == false) {
+      TraceEventScope lTraceEventScope (lTraceEventRecorder,
+                                        "SIMFQT::quotePrices", "simfqt");
+      lSIMFQT_Service.quotePrices (iBookingRequest, ioTravelSolutionList);
+
+    } else {
+      /**
+       * The travel solutions not found in the cache are moved (spliced)
+       * into a separate list, to be fare-quoted in one go. The position
+       * of each of them (i.e., the element following it) is kept, so
+       * that they can be moved back to where they were.
+       */
+      std::string lRequestKey;
+      buildFareQuoteKey (iBookingRequest, lRequestKey);
+
+      // The results of the former versions of the fares are never
+      // served again, and get evicted in time
+      lRequestKey += boost::lexical_cast<std::string> (lFareVersion);
+      lRequestKey += '|';
+      std::string lKey;
+
+      stdair::TravelSolutionList_T lMissList;
+      const ArenaAllocator<stdair::TravelSolutionList_T::iterator>
+        lAllocator (lRequestArena);
+      TravelSolutionPositionList_T lPositionList (lAllocator);
+      lPositionList.reserve (ioTravelSolutionList.size());
+      stdair::TravelSolutionList_T::iterator itTS =
+        ioTravelSolutionList.begin();
+      while (itTS != ioTravelSolutionList.end()) {
+        stdair::TravelSolutionStruct& lTravelSolution = *itTS;
+        buildFareQuoteKey (lRequestKey, lTravelSolution, lKey);
+        stdair::FareOptionList_T& lFareOptionList =
+          lTravelSolution.getFareOptionListRef();
+        if (lFareQuoteCache.find (lKey, lFareOptionList) == true) {
+          if (lRequestTrace_ptr != NULL) {
+            ++lRequestTrace_ptr->_nbOfFareQuoteCacheHits;
+          }
+          ++itTS;
+          continue;
+        }
+
+        const stdair::TravelSolutionList_T::iterator itMiss = itTS++;
+        lMissList.splice (lMissList.end(), ioTravelSolutionList, itMiss);
+        lPositionList.push_back (itTS);
+      }
+
+      if (lMissList.empty() == false) {
+        try {
+          TraceEventScope lTraceEventScope (lTraceEventRecorder,
+                                            "SIMFQT::quotePrices", "simfqt");
+          lSIMFQT_Service.quotePrices (iBookingRequest, lMissList);
+
+        } catch (...) {
+          restoreTravelSolutionList (lMissList, lPositionList,
+                                     ioTravelSolutionList);
+          throw;
+        }
+
+        // Store the fare quote results into the cache
+        for (stdair::TravelSolutionList_T::const_iterator itMiss =
+               lMissList.begin(); itMiss != lMissList.end(); ++itMiss) {
+          const stdair::TravelSolutionStruct& lTravelSolution = *itMiss;
+          buildFareQuoteKey (lRequestKey, lTravelSolution, lKey);
+          lFareQuoteCache.insert (lKey, lTravelSolution.getFareOptionList());
+        }
+
+        restoreTravelSolutionList (lMissList, lPositionList,
+                                   ioTravelSolutionList);
+      }
+    }
+
+    // The fare rule changes apply on top of the (cached) fare quotes
+    DeltaManager::applyFareDeltas (ioSIMCRS_ServiceContext.getSymbolTable(),
+                                   ioSIMCRS_ServiceContext.getDeltaOverlay(),
+                                   iBookingRequest, ioTravelSolutionList);
+
+    // Keep track of the fare quote work, for the pruning statistics
+    std::lock_guard<std::mutex>
+      lStatsGuard (ioSIMCRS_ServiceContext.getPruningStatsMutex());
+    PruningStatsStruct& lPruningStats =
+      ioSIMCRS_ServiceContext.getPruningStats();
+    lPruningStats._nbOfQuotedTravelSolutions += ioTravelSolutionList.size();
+    lPruningStats._fareQuoteTime += lFareQuoteChronometer.elapsed();
+
+    // Keep track of the fare quote work, for the request trace
+    if (lRequestTrace_ptr != NULL) {
+      lRequestTrace_ptr->_nbOfQuotedTravelSolutions +=
+        ioTravelSolutionList.size();
+      for (stdair::TravelSolutionList_T::const_iterator itTS =
+             ioTravelSolutionList.begin();
+           itTS != ioTravelSolutionList.end(); ++itTS) {
+        const stdair::TravelSolutionStruct& lTravelSolution = *itTS;
+        lRequestTrace_ptr->_nbOfFareOptions +=
+          lTravelSolution.getFareOptionList().size();
+      }
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ShoppingManager::
+  restoreTravelSolutionList (stdair::TravelSolutionList_T& ioMissList,
+                             const TravelSolutionPositionList_T& iPositionList,
+                             stdair::TravelSolutionList_T& ioTSList) {
+    assert (ioMissList.size() == iPositionList.size());
+
+    /**
+     * The travel solutions are moved back from the last one, so that the
+     * position of each of them refers to an element of the original list
+     * (possibly one which has just been moved back).
+     */
+    TravelSolutionPositionList_T::const_reverse_iterator itPosition =
+      iPositionList.rbegin();
+    while (ioMissList.empty() == false) {
+      assert (itPosition != iPositionList.rend());
+      stdair::TravelSolutionList_T::iterator itLast = ioMissList.end();
+      --itLast;
+      ioTSList.splice (*itPosition, ioMissList, itLast);
+      ++itPosition;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ShoppingManager::
+  buildSegmentPathList (SIMCRS_ServiceContext& ioSIMCRS_ServiceContext,
+                        const stdair::BookingRequestStruct& iBookingRequest,
+                        stdair::TravelSolutionList_T& ioSegmentPathList) {
+    RequestTraceStruct* lRequestTrace_ptr =
+      ioSIMCRS_ServiceContext.getCurrentRequestTrace();
+    RequestTraceTimer lTraceTimer (lRequestTrace_ptr,
+                                   RequestTraceStruct::SEGMENT_PATH);
+
+    AIRTSP::AIRTSP_Service& lAIRTSP_Service =
+      ioSIMCRS_ServiceContext.getAIRTSP_Service();
+    const NbOfTravelSolutions_T lNbOfSegmentPaths = ioSegmentPathList.size();
+    {
+      TraceEventScope lTraceEventScope (ioSIMCRS_ServiceContext.
+                                        getTraceEventRecorder(),
+                                        "AIRTSP::buildSegmentPathList",
+                                        "airtsp");
+      lAIRTSP_Service.buildSegmentPathList (ioSegmentPathList,
+                                            iBookingRequest);
+    }
+
+    // Drop the travel solutions going through closed flight-dates
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      ioSIMCRS_ServiceContext.getSTDAIR_Service();
+    DeltaManager::
+      removeClosedTravelSolutions (lSTDAIR_Service.getBomRoot(),
+                                   ioSIMCRS_ServiceContext.getSymbolTable(),
+                                   ioSIMCRS_ServiceContext.getDeltaOverlay(),
+                                   ioSegmentPathList);
+
+    if (lRequestTrace_ptr != NULL) {
+      lRequestTrace_ptr->_nbOfSegmentPaths +=
+        ioSegmentPathList.size() - lNbOfSegmentPaths;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ShoppingManager::
+  calculateAvailability (SIMCRS_ServiceContext& ioSIMCRS_ServiceContext,
+                         stdair::TravelSolutionList_T& ioTravelSolutionList) {
+    RequestTraceStruct* lRequestTrace_ptr =
+      ioSIMCRS_ServiceContext.getCurrentRequestTrace();
+    RequestTraceTimer lTraceTimer (lRequestTrace_ptr,
+                                   RequestTraceStruct::AVAILABILITY);
+    AIRINV::AIRINV_Master_Service& lAIRINV_Master_Service =
+      ioSIMCRS_ServiceContext.getAIRINV_Service();
+
+    const AvailabilityMode_T& lAvailabilityMode =
+      ioSIMCRS_ServiceContext.getAvailabilityMode();
+    TraceEventRecorder& lTraceEventRecorder =
+      ioSIMCRS_ServiceContext.getTraceEventRecorder();
+    if (lAvailabilityMode == SEAMLESS_AVAILABILITY) {
+      TraceEventScope lTraceEventScope (lTraceEventRecorder,
+                                        "DistributionManager::"
+                                        "calculateAvailability", "airinv");
+      DistributionManager::calculateAvailability (lAIRINV_Master_Service,
+                                                  ioTravelSolutionList);
+      return;
+    }
+
+    // Read the availability from the AVS table
+    assert (lAvailabilityMode == AVS_AVAILABILITY);
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      ioSIMCRS_ServiceContext.getSTDAIR_Service();
+    const stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
+    SymbolTable& lSymbolTable = ioSIMCRS_ServiceContext.getSymbolTable();
+    AvailabilityStatusTable& lAvailabilityStatusTable =
+      ioSIMCRS_ServiceContext.getAvailabilityStatusTable();
+    TraceEventScope lTraceEventScope (lTraceEventRecorder,
+                                      "AvailabilityStatusManager::"
+                                      "calculateAvailability", "simcrs");
+    AvailabilityStatusManager::calculateAvailability (lAIRINV_Master_Service,
+                                                      lBomRoot, lSymbolTable,
+                                                      lAvailabilityStatusTable,
+                                                      ioTravelSolutionList);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  NbOfFareOptions_T ShoppingManager::
+  filterBookableFareOptions (stdair::TravelSolutionStruct& ioTravelSolution,
+                             const stdair::PartySize_T& iPartySize) {
+    NbOfFareOptions_T oNbOfFareOptions = 0;
+
+    stdair::FareOptionList_T& lFareOptionList =
+      ioTravelSolution.getFareOptionListRef();
+    stdair::FareOptionList_T::iterator itFO = lFareOptionList.begin();
+    while (itFO != lFareOptionList.end()) {
+      const stdair::FareOptionStruct& lFareOption = *itFO;
+      if (lFareOption.getAvailability() >= iPartySize) {
+        ++oNbOfFareOptions;
+        ++itFO;
+        continue;
+      }
+      itFO = lFareOptionList.erase (itFO);
+    }
+
+    return oNbOfFareOptions;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool ShoppingManager::
+  getLowestFare (const stdair::TravelSolutionStruct& iTravelSolution,
+                 const bool iCheckAvailability,
+                 const stdair::PartySize_T& iPartySize,
+                 stdair::Fare_T& ioLowestFare) {
+    bool hasFare = false;
+
+    const stdair::FareOptionList_T& lFareOptionList =
+      iTravelSolution.getFareOptionList();
+    for (stdair::FareOptionList_T::const_iterator itFO =
+           lFareOptionList.begin(); itFO != lFareOptionList.end(); ++itFO) {
+      const stdair::FareOptionStruct& lFareOption = *itFO;
+      if (iCheckAvailability == true
+          && lFareOption.getAvailability() < iPartySize) {
+        continue;
+      }
+
+      const stdair::Fare_T& lFare = lFareOption.getFare();
+      if (hasFare == false || lFare < ioLowestFare) {
+        ioLowestFare = lFare;
+        hasFare = true;
+      }
+    }
+
+    return hasFare;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::BookingRequestStruct ShoppingManager::
+  buildDatedBookingRequest (const stdair::BookingRequestStruct& iBookingRequest,
+                            const stdair::Date_T& iDepartureDate) {
+    const stdair::BookingRequestStruct
+      oBookingRequest (iBookingRequest.getOrigin(),
+                       iBookingRequest.getDestination(),
+                       iBookingRequest.getPOS(),
+                       iDepartureDate,
+                       iBookingRequest.getRequestDateTime(),
+                       iBookingRequest.getPreferredCabin(),
+                       iBookingRequest.getPartySize(),
+                       iBookingRequest.getBookingChannel(),
+                       iBookingRequest.getTripType(),
+                       iBookingRequest.getStayDuration(),
+                       iBookingRequest.getFrequentFlyerType(),
+                       iBookingRequest.getPreferredDepartureTime(),
+                       iBookingRequest.getWTP(),
+                       iBookingRequest.getValueOfTime(),
+                       iBookingRequest.getChangeFees(),
+                       iBookingRequest.getChangeFeeDisutility(),
+                       iBookingRequest.getNonRefundable(),
+                       iBookingRequest.getNonRefundableDisutility());
+    return oBookingRequest;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  NbOfTravelSolutions_T ShoppingManager::
+  pruneTravelSolutionList (SIMCRS_ServiceContext& ioSIMCRS_ServiceContext,
+                           const stdair::BookingRequestStruct& iBookingRequest,
+                           stdair::TravelSolutionList_T& ioTravelSolutionList) {
+    NbOfTravelSolutions_T oNbOfPrunedTravelSolutions = 0;
+
+    // Status of the segment-dates, checked while pruning
+    RequestArena& lRequestArena = ioSIMCRS_ServiceContext.getRequestArena();
+    const ArenaAllocator<SegmentStatusStruct> lAllocator (lRequestArena);
+    SegmentStatusList_T lSegmentStatusList (lAllocator);
+    const stdair::PartySize_T& lPartySize = iBookingRequest.getPartySize();
+
+    stdair::TravelSolutionList_T::iterator itTS = ioTravelSolutionList.begin();
+    while (itTS != ioTravelSolutionList.end()) {
+      const stdair::TravelSolutionStruct& lTravelSolution = *itTS;
+      if (checkSellable (ioSIMCRS_ServiceContext, lSegmentStatusList,
+                         lTravelSolution, lPartySize) == true) {
+        ++itTS;
+        continue;
+      }
+
+      itTS = ioTravelSolutionList.erase (itTS);
+      ++oNbOfPrunedTravelSolutions;
+    }
+
+    return oNbOfPrunedTravelSolutions;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  NbOfTravelSolutions_T ShoppingManager::
+  streamTravelSolutions (SIMCRS_ServiceContext& ioSIMCRS_ServiceContext,
+                         const stdair::BookingRequestStruct& iBookingRequest,
+                         const TravelSolutionVisitor_T& iVisitor) {
+    NbOfTravelSolutions_T oNbOfTravelSolutions = 0;
+
+    // Build the (bare) segment paths
+    stdair::TravelSolutionList_T lSegmentPathList;
+    buildSegmentPathList (ioSIMCRS_ServiceContext, iBookingRequest,
+                          lSegmentPathList);
+
+    // Status of the segment-dates, checked while pruning
+    const bool lPruneFirst =
+      ioSIMCRS_ServiceContext.getAvailabilityFirstPruningFlag();
+    RequestArena& lRequestArena = ioSIMCRS_ServiceContext.getRequestArena();
+    const ArenaAllocator<SegmentStatusStruct> lAllocator (lRequestArena);
+    SegmentStatusList_T lSegmentStatusList (lAllocator);
+    const stdair::PartySize_T& lPartySize = iBookingRequest.getPartySize();
+
+    /**
+     * The travel solution being processed is moved (spliced, i.e., without
+     * any copy nor allocation) into a single-element list, as expected
+     * by the fare quote and availability services.
+     */
+    stdair::TravelSolutionList_T lCurrentList;
+    while (lSegmentPathList.empty() == false) {
+      lCurrentList.splice (lCurrentList.begin(), lSegmentPathList,
+                           lSegmentPathList.begin());
+
+      // Availability-first pruning
+      if (lPruneFirst == true
+          && checkSellable (ioSIMCRS_ServiceContext, lSegmentStatusList,
+                            lCurrentList.front(), lPartySize) == false) {
+        lCurrentList.clear();
+        continue;
+      }
+
+      // Fare quote
+      quotePrices (ioSIMCRS_ServiceContext, iBookingRequest, lCurrentList);
+
+      // Availability
+      calculateAvailability (ioSIMCRS_ServiceContext, lCurrentList);
+
+      // Hand the travel solution over to the visitor
+      assert (lCurrentList.size() == 1);
+      stdair::TravelSolutionStruct& lTravelSolution = lCurrentList.front();
+      ++oNbOfTravelSolutions;
+      const bool shouldContinue = iVisitor (lTravelSolution);
+
+      // Discard the travel solution
+      lCurrentList.clear();
+
+      if (shouldContinue == false) {
+        break;
+      }
+    }
+
+    return oNbOfTravelSolutions;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool ShoppingManager::
+  isBudgetSpent (const stdair::BasChronometer& iChronometer,
+                 const double& iLatencyBudget) {
+    if (iLatencyBudget <= 0.0) {
+      return false;
+    }
+    return (iChronometer.elapsed() >= iLatencyBudget);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ShoppingManager::
+  shop (SIMCRS_ServiceContext& ioSIMCRS_ServiceContext,
+        const stdair::BookingRequestStruct& iBookingRequest,
+        const stdair::Duration_T& iLatencyBudget,
+        ShoppingResultStruct& ioShoppingResult) {
+    stdair::BasChronometer lShoppingChronometer;
+    lShoppingChronometer.start();
+    const double lLatencyBudget =
+      static_cast<double> (iLatencyBudget.total_microseconds()) / 1e6;
+
+    // Build the (bare) segment paths
+    stdair::TravelSolutionList_T lSegmentPathList;
+    buildSegmentPathList (ioSIMCRS_ServiceContext, iBookingRequest,
+                          lSegmentPathList);
+    ioShoppingResult._nbOfSegmentPaths += lSegmentPathList.size();
+
+    // Status of the segment-dates, checked while pruning
+    const bool lPruneFirst =
+      ioSIMCRS_ServiceContext.getAvailabilityFirstPruningFlag();
+    RequestArena& lRequestArena = ioSIMCRS_ServiceContext.getRequestArena();
+    const ArenaAllocator<SegmentStatusStruct> lAllocator (lRequestArena);
+    SegmentStatusList_T lSegmentStatusList (lAllocator);
+    const stdair::PartySize_T& lPartySize = iBookingRequest.getPartySize();
+
+    // The bookable travel solutions are kept as interned identifiers
+    const SymbolTable& lSymbolTable = ioSIMCRS_ServiceContext.getSymbolTable();
+
+    stdair::TravelSolutionList_T lCurrentList;
+    while (lSegmentPathList.empty() == false) {
+      // Stop there, when the latency budget has been spent
+      if (isBudgetSpent (lShoppingChronometer, lLatencyBudget) == true) {
+        ioShoppingResult._isTruncated = true;
+        break;
+      }
+
+      lCurrentList.splice (lCurrentList.begin(), lSegmentPathList,
+                           lSegmentPathList.begin());
+      stdair::TravelSolutionStruct& lTravelSolution = lCurrentList.front();
+
+      // Availability-first pruning
+      if (lPruneFirst == true
+          && checkSellable (ioSIMCRS_ServiceContext, lSegmentStatusList,
+                            lTravelSolution, lPartySize) == false) {
+        ++ioShoppingResult._nbOfPrunedTravelSolutions;
+        lCurrentList.clear();
+        continue;
+      }
+
+      // Fare quote
+      quotePrices (ioSIMCRS_ServiceContext, iBookingRequest, lCurrentList);
+      if (lTravelSolution.getFareOptionList().empty() == true) {
+        lCurrentList.clear();
+        continue;
+      }
+      if (isBudgetSpent (lShoppingChronometer, lLatencyBudget) == true) {
+        ioShoppingResult._isTruncated = true;
+        break;
+      }
+
+      // Availability
+      calculateAvailability (ioSIMCRS_ServiceContext, lCurrentList);
+
+      // Keep only the bookable fare options
+      const NbOfFareOptions_T lNbOfFareOptions =
+        filterBookableFareOptions (lTravelSolution, lPartySize);
+      if (lNbOfFareOptions == 0) {
+        lCurrentList.clear();
+        continue;
+      }
+
+      // Add the travel solution to the result
+      ioShoppingResult._nbOfFareOptions +=
+        addTravelSolution (lSymbolTable, lTravelSolution, ioShoppingResult);
+      lCurrentList.clear();
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  NbOfFareOptions_T ShoppingManager::
+  addTravelSolution (const SymbolTable& iSymbolTable,
+                     const stdair::TravelSolutionStruct& iTravelSolution,
+                     ShoppingResultStruct& ioShoppingResult) {
+    ShoppingSolutionStruct lSolution;
+    lSolution._firstSegmentIdx = ioShoppingResult._segmentDateIDList.size();
+    lSolution._firstFareOptionIdx = ioShoppingResult._fareOptionList.size();
+    lSolution._nbOfSegments = 0;
+    lSolution._nbOfFareOptions = 0;
+    const std::size_t lFirstClassIdx = ioShoppingResult._classCodeIDList.size();
+
+    // Segment-dates (interned when the BOM tree was loaded)
+    const stdair::KeyList_T& lSegmentDateKeyList =
+      iTravelSolution.getSegmentPath();
+    for (stdair::KeyList_T::const_iterator itKey = lSegmentDateKeyList.begin();
+         itKey != lSegmentDateKeyList.end(); ++itKey) {
+      const std::string& lSegmentDateKey = *itKey;
+      const SegmentDateID_T lSegmentDateID =
+        SymbolManager::findSegmentDate (iSymbolTable, lSegmentDateKey);
+      if (lSegmentDateID == DEFAULT_NULL_SYMBOL_ID) {
+        // The CRS can not sell a segment-date it does not know
+        ioShoppingResult._segmentDateIDList.resize (lSolution.
+                                                    _firstSegmentIdx);
+        return 0;
+      }
+      ioShoppingResult._segmentDateIDList.push_back (lSegmentDateID);
+      ++lSolution._nbOfSegments;
+    }
+
+    // Fare options, with the booking class of each segment
+    const CodeDictionary& lClassCodeDictionary =
+      iSymbolTable.getClassCodeDictionary();
+    const stdair::FareOptionList_T& lFareOptionList =
+      iTravelSolution.getFareOptionList();
+    for (stdair::FareOptionList_T::const_iterator itFO =
+           lFareOptionList.begin(); itFO != lFareOptionList.end(); ++itFO) {
+      const stdair::FareOptionStruct& lFareOption = *itFO;
+      const stdair::ClassList_StringList_T& lClassPath =
+        lFareOption.getClassPath();
+      assert (lClassPath.size() == lSolution._nbOfSegments);
+
+      ShoppingFareOptionStruct lShoppingFareOption;
+      lShoppingFareOption._fare = lFareOption.getFare();
+      lShoppingFareOption._availability = lFareOption.getAvailability();
+      lShoppingFareOption._firstClassIdx =
+        ioShoppingResult._classCodeIDList.size();
+      bool isKnown = true;
+      for (stdair::ClassList_StringList_T::const_iterator itClassList =
+             lClassPath.begin(); itClassList != lClassPath.end();
+           ++itClassList) {
+        const stdair::ClassList_String_T& lClassList = *itClassList;
+        assert (lClassList.empty() == false);
+
+        // Only the first booking class of the list is sold (see
+        // DistributionManager::sell())
+        const char lClassCode = lClassList.at(0);
+        const ClassCodeID_T lClassCodeID =
+          lClassCodeDictionary.find (lClassCode);
+        if (lClassCodeID == DEFAULT_NULL_SYMBOL_ID) {
+          isKnown = false;
+          break;
+        }
+        ioShoppingResult._classCodeIDList.push_back (lClassCodeID);
+      }
+
+      // The fare options with a booking class unknown to the CRS can not
+      // be sold either
+      if (isKnown == false) {
+        ioShoppingResult._classCodeIDList.resize (lShoppingFareOption.
+                                                  _firstClassIdx);
+        continue;
+      }
+
+      ioShoppingResult._fareOptionList.push_back (lShoppingFareOption);
+      ++lSolution._nbOfFareOptions;
+    }
+
+    if (lSolution._nbOfFareOptions == 0) {
+      ioShoppingResult._segmentDateIDList.resize (lSolution._firstSegmentIdx);
+      ioShoppingResult._classCodeIDList.resize (lFirstClassIdx);
+      return 0;
+    }
+
+    ioShoppingResult._solutionList.push_back (lSolution);
+    return lSolution._nbOfFareOptions;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ShoppingManager::
+  shopCalendar (SIMCRS_ServiceContext& ioSIMCRS_ServiceContext,
+                const stdair::BookingRequestStruct& iBookingRequest,
+                const stdair::DatePeriod_T& iDatePeriod,
+                CalendarResultStruct& ioCalendarResult) {
+
+    // A null (or reversed) date period holds no departure date
+    if (iDatePeriod.begin().is_special() == true
+        || iDatePeriod.end().is_special() == true
+        || iDatePeriod.is_null() == true) {
+      return;
+    }
+
+    /**
+     * Status of the segment-dates, checked while pruning. The identifiers
+     * of the segment-dates do not depend on the departure date of the
+     * request, so that the status list is shared by all the dates.
+     */
+    RequestArena& lRequestArena = ioSIMCRS_ServiceContext.getRequestArena();
+    const ArenaAllocator<SegmentStatusStruct> lAllocator (lRequestArena);
+    SegmentStatusList_T lSegmentStatusList (lAllocator);
+    const stdair::PartySize_T& lPartySize = iBookingRequest.getPartySize();
+
+    CalendarEntryList_T& lCalendarEntryList =
+      ioCalendarResult._calendarEntryList;
+    lCalendarEntryList.reserve (iDatePeriod.length().days());
+
+    const stdair::DateOffset_T lOneDay (1);
+    for (stdair::Date_T lDepartureDate = iDatePeriod.begin();
+         lDepartureDate < iDatePeriod.end(); lDepartureDate += lOneDay) {
+      lCalendarEntryList.push_back (CalendarEntryStruct (lDepartureDate));
+      CalendarEntryStruct& lCalendarEntry = lCalendarEntryList.back();
+
+      // Build the (bare) segment paths for that departure date
+      const stdair::BookingRequestStruct lBookingRequest =
+        buildDatedBookingRequest (iBookingRequest, lDepartureDate);
+      stdair::TravelSolutionList_T lSegmentPathList;
+      buildSegmentPathList (ioSIMCRS_ServiceContext, lBookingRequest,
+                            lSegmentPathList);
+      ioCalendarResult._nbOfSegmentPaths += lSegmentPathList.size();
+
+      stdair::TravelSolutionList_T lCurrentList;
+      while (lSegmentPathList.empty() == false) {
+        lCurrentList.splice (lCurrentList.begin(), lSegmentPathList,
+                             lSegmentPathList.begin());
+        const stdair::TravelSolutionStruct& lTravelSolution =
+          lCurrentList.front();
+
+        // Availability-first pruning
+        if (checkSellable (ioSIMCRS_ServiceContext, lSegmentStatusList,
+                           lTravelSolution, lPartySize) == false) {
+          lCurrentList.clear();
+          continue;
+        }
+
+        // Fare quote
+        quotePrices (ioSIMCRS_ServiceContext, lBookingRequest, lCurrentList);
+
+        /**
+         * The availability can only remove fare options: when none of
+         * the fares is lower than the lowest bookable fare so far, the
+         * travel solution cannot change the calendar entry.
+         */
+        stdair::Fare_T lLowestFare = 0.0;
+        const bool hasFare =
+          getLowestFare (lTravelSolution, false, lPartySize, lLowestFare);
+        if (hasFare == false) {
+          lCurrentList.clear();
+          continue;
+        }
+        if (lCalendarEntry._hasFare == true
+            && lLowestFare >= lCalendarEntry._lowestFare) {
+          ++ioCalendarResult._nbOfSkippedTravelSolutions;
+          lCurrentList.clear();
+          continue;
+        }
+
+        // Availability
+        calculateAvailability (ioSIMCRS_ServiceContext, lCurrentList);
+
+        const bool hasBookableFare =
+          getLowestFare (lTravelSolution, true, lPartySize, lLowestFare);
+        if (hasBookableFare == true
+            && (lCalendarEntry._hasFare == false
+                || lLowestFare < lCalendarEntry._lowestFare)) {
+          lCalendarEntry._lowestFare = lLowestFare;
+          lCalendarEntry._hasFare = true;
+        }
+
+        // Discard the travel solution
+        lCurrentList.clear();
+      }
+    }
+  }
+
+}
@@ -0,0 +1,339 @@
+#ifndef __SIMCRS_CMD_SHOPPINGMANAGER_HPP
+#define __SIMCRS_CMD_SHOPPINGMANAGER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <vector>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/bom/TravelSolutionTypes.hpp>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+#include <simcrs/bom/ArenaAllocator.hpp>
+
+// Forward declarations
+namespace stdair {
+  struct BasChronometer;
+  struct BookingRequestStruct;
+  struct TravelSolutionStruct;
+}
+
+namespace SIMCRS {
+
+  // Forward declarations
+  class SIMCRS_ServiceContext;
+  class SymbolTable;
+  class AvailabilityStatusTable;
+  struct ShoppingResultStruct;
+  struct CalendarResultStruct;
+
+  /**
+   * @brief Command chaining the shopping stages (segment path, fare quote
+   * and availability) for the travel solutions of a booking request.
+   *
+   * The services (AirTSP, SimFQT and AirInv) and the SimCRS structures
+   * (symbol table, request arena, AVS table, statistics) are taken from
+   * the SimCRS service context. The short-lived objects owned by SimCRS
+   * are drawn from the request arena, which is reset by the caller once
+   * the request has been served.
+   */
+  class ShoppingManager {
+    friend class SIMCRS_Service;
+  private:
+    /**
+     * Stream, one at a time, the travel solutions corresponding to the
+     * booking request, through the fare quote and availability stages,
+     * down to the given visitor.
+     *
+     * Only the bare segment paths are built in one go (by AirTSP). Each
+     * travel solution is then taken out of that list, fare-quoted, given
+     * its availability, handed over to the visitor and discarded, so that
+     * at most a single fully-fledged travel solution lives in memory.
+     *
+     * When the availability-first pruning is enabled, the travel solutions
+     * which cannot be sold are discarded before being fare-quoted (and
+     * are not handed over to the visitor).
+     *
+     * @return NbOfTravelSolutions_T Number of travel solutions delivered
+     *         to the visitor.
+     */
+    static NbOfTravelSolutions_T
+    streamTravelSolutions (SIMCRS_ServiceContext&,
+                           const stdair::BookingRequestStruct&,
+                           const TravelSolutionVisitor_T&);
+
+    /**
+     * Serve the booking request in a single pass: each segment path is,
+     * in turn, checked for availability (see maySell(), only when the
+     * availability-first pruning is set), fare-quoted, given its
+     * availability and, when it has bookable fare options (i.e., with
+     * enough seats for the party), added to the result with those fare
+     * options only. The travel solutions disqualified at some stage do
+     * not go through the following stages.
+     *
+     * The result holds the same travel solutions and fare options as
+     * the calculateSegmentPathList(), fareQuote() and
+     * calculateAvailability() sequence, once the non-bookable ones
+     * have been filtered out, as interned identifiers (see
+     * addTravelSolution()).
+     *
+     * When a (positive) latency budget is given, the time spent is
+     * checked before each travel solution and between its stages: once
+     * the budget is spent, the shopping stops, and the result (holding
+     * the travel solutions found so far) is flagged as truncated.
+     */
+    static void shop (SIMCRS_ServiceContext&,
+                      const stdair::BookingRequestStruct&,
+                      const stdair::Duration_T&,
+                      ShoppingResultStruct&);
+
+    /**
+     * Shop for the booking request over every (preferred) departure date
+     * of the given date period, keeping only the lowest bookable fare of
+     * each date.
+     *
+     * The work which does not depend on the departure date is done once
+     * for the whole period: in particular, the segment-dates are checked
+     * for availability only once, whatever the number of departure dates
+     * (and travel solutions) they appear in. Moreover, as only the lowest
+     * fare matters, a fare-quoted travel solution is given its
+     * availability only when one of its fares is lower than the lowest
+     * bookable fare found so far for its date.
+     */
+    static void shopCalendar (SIMCRS_ServiceContext&,
+                              const stdair::BookingRequestStruct&,
+                              const stdair::DatePeriod_T&,
+                              CalendarResultStruct&);
+
+    /**
+     * Remove, from the given list, the travel solutions which cannot be
+     * sold, i.e., for which at least one segment has no booking class
+     * with enough seats left for the party of the booking request.
+     *
+     * That check relies on an upper bound of the availability (the
+     * segment availability of the booking classes), so that no travel
+     * solution which could be sold is ever removed. It is meant to be
+     * called before fare-quoting the travel solutions.
+     *
+     * @return NbOfTravelSolutions_T Number of travel solutions removed.
+     */
+    static NbOfTravelSolutions_T
+    pruneTravelSolutionList (SIMCRS_ServiceContext&,
+                             const stdair::BookingRequestStruct&,
+                             stdair::TravelSolutionList_T&);
+
+    /**
+     * Build the (bare) segment paths matching the booking request, i.e.,
+     * the travel solutions without fare nor availability, by querying
+     * AirTSP. The segment paths are added to the given list.
+     */
+    static void buildSegmentPathList (SIMCRS_ServiceContext&,
+                                      const stdair::BookingRequestStruct&,
+                                      stdair::TravelSolutionList_T&);
+
+    /**
+     * Calculate the availability of the given travel solutions, either
+     * by querying the airline inventory (seamless availability), or from
+     * the AVS table, depending on the availability mode.
+     */
+    static void calculateAvailability (SIMCRS_ServiceContext&,
+                                       stdair::TravelSolutionList_T&);
+
+  private:
+    /**
+     * State of the segment-dates, as found by the availability check.
+     */
+    enum SegmentStatus {
+      SEGMENT_UNKNOWN = 0,
+      SEGMENT_OPEN,
+      SEGMENT_CLOSED
+    };
+
+    /**
+     * State of a segment-date met by a request.
+     */
+    struct SegmentStatusStruct {
+      /** Identifier of the segment-date. */
+      SegmentDateID_T _segmentDateID;
+      /** State of the segment-date (see SegmentStatus). */
+      char _status;
+    };
+
+    /**
+     * States of the segment-dates met by a request, by increasing
+     * segment-date identifier, for the duration of that request. The
+     * list only holds the segment-dates of the segment paths of the
+     * request, whatever the number of segment-dates interned so far.
+     */
+    typedef ArenaVector<SegmentStatusStruct>::Type SegmentStatusList_T;
+
+    /**
+     * Get the state of the given segment-date within the given list,
+     * where it is added (with an unknown state) when not there yet. The
+     * reference is valid until another segment-date is added.
+     */
+    static char& getSegmentStatus (SegmentStatusList_T&,
+                                   const SegmentDateID_T&);
+
+    /**
+     * State whether the travel solution may be sold, i.e., whether every
+     * segment of it has at least one booking class with a segment
+     * availability greater than or equal to the given party size.
+     *
+     * When an AVS table is given, the segment-dates it holds are checked
+     * against it, rather than against the airline inventory.
+     *
+     * The segment-dates are only looked up in the symbol table, which is
+     * left untouched: those never interned are unknown to the CRS, and
+     * can not be sold, while those interned but not bound to the BOM tree
+     * of SimCRS are assumed to be open. The result of the check of every
+     * segment-date is kept in the given list, as the same segment-dates
+     * appear in many travel solutions of the same request.
+     */
+    static bool maySell (const SymbolTable&,
+                         const AvailabilityStatusTable*,
+                         SegmentStatusList_T&,
+                         const stdair::TravelSolutionStruct&,
+                         const stdair::PartySize_T&);
+
+    /**
+     * Same as maySell(), keeping track of the pruning statistics.
+     */
+    static bool checkSellable (SIMCRS_ServiceContext&, SegmentStatusList_T&,
+                               const stdair::TravelSolutionStruct&,
+                               const stdair::PartySize_T&);
+
+    /**
+     * State whether the given latency budget (in seconds) has been spent,
+     * the time being measured by the given chronometer. A budget which is
+     * not positive is never spent.
+     */
+    static bool isBudgetSpent (const stdair::BasChronometer&, const double&);
+
+    /**
+     * Fare-quote the given travel solutions, keeping track of the fare
+     * quote statistics.
+     *
+     * When the fare quote cache is enabled, the travel solutions whose
+     * fingerprint (see buildFareQuoteKey()) is found in the cache are
+     * given the cached fare options; only the other ones are fare-quoted
+     * by SimFQT, and their results are stored into the cache. The order
+     * of the travel solutions within the list is kept.
+     */
+    static void quotePrices (SIMCRS_ServiceContext&,
+                             const stdair::BookingRequestStruct&,
+                             stdair::TravelSolutionList_T&);
+
+    /**
+     * Positions of travel solutions within a list, i.e., for each travel
+     * solution, the element which was following it. The list lives in the
+     * request arena.
+     */
+    typedef ArenaVector<stdair::TravelSolutionList_T::iterator>::Type
+    TravelSolutionPositionList_T;
+
+    /**
+     * Move back the travel solutions of the first list into the last one,
+     * at the given positions (see quotePrices()).
+     */
+    static void
+    restoreTravelSolutionList (stdair::TravelSolutionList_T&,
+                               const TravelSolutionPositionList_T&,
+                               stdair::TravelSolutionList_T&);
+
+    /**
+     * Build the fingerprint of the fare-relevant fields of the booking
+     * request, i.e., the fields on which the fare rules depend: origin and
+     * destination, point of sale, channel, trip type, stay duration,
+     * request date (for the advance purchase, the departure dates being
+     * given by the segment path) and cabin.
+     */
+    static void buildFareQuoteKey (const stdair::BookingRequestStruct&,
+                                   std::string&);
+
+    /**
+     * Append the fingerprint of the segment path of the given travel
+     * solution to the given fingerprint of the booking request.
+     */
+    static void buildFareQuoteKey (const std::string&,
+                                   const stdair::TravelSolutionStruct&,
+                                   std::string&);
+
+    /**
+     * Build the fingerprint of a fare quote request, i.e., of the
+     * fare-relevant fields of the booking request and of the segment
+     * paths of all the given travel solutions (in order).
+     */
+    static void buildFareQuoteKey (const stdair::BookingRequestStruct&,
+                                   const stdair::TravelSolutionList_T&,
+                                   std::string&);
+
+    /**
+     * Build the fingerprint of a segment path request, i.e., of the
+     * fields of the booking request on which the segment paths depend:
+     * origin, destination and preferred departure date.
+     */
+    static void buildSegmentPathKey (const stdair::BookingRequestStruct&,
+                                     std::string&);
+
+    /**
+     * Remove, from the fare options of the given travel solution, those
+     * without enough seats left for the given party size.
+     *
+     * @return NbOfFareOptions_T Number of fare options left.
+     */
+    static NbOfFareOptions_T
+    filterBookableFareOptions (stdair::TravelSolutionStruct&,
+                               const stdair::PartySize_T&);
+
+    /**
+     * Add the given (bookable) travel solution to the shopping result,
+     * i.e., the identifiers of its segment-dates and, for each of its fare
+     * options, the fare, the availability and the identifiers of the
+     * booking classes. The codes are only looked up (they are interned
+     * when the BOM tree is loaded, see SymbolManager::buildSymbolTable()):
+     * the fare options with an unknown booking class, and the travel
+     * solution altogether when one of its segment-dates is unknown, are
+     * left out, as the CRS can not sell them.
+     *
+     * @return NbOfFareOptions_T Number of fare options added.
+     */
+    static NbOfFareOptions_T
+    addTravelSolution (const SymbolTable&,
+                       const stdair::TravelSolutionStruct&,
+                       ShoppingResultStruct&);
+
+    /**
+     * Build a copy of the given booking request, for another (preferred)
+     * departure date.
+     */
+    static stdair::BookingRequestStruct
+    buildDatedBookingRequest (const stdair::BookingRequestStruct&,
+                              const stdair::Date_T&);
+
+    /**
+     * Get the lowest fare of the fare options of the given travel solution.
+     * When the availability is to be checked, only the fare options with
+     * an availability greater than or equal to the given party size are
+     * taken into account.
+     *
+     * @return bool Whether there is at least one such fare option.
+     */
+    static bool getLowestFare (const stdair::TravelSolutionStruct&,
+                               const bool,
+                               const stdair::PartySize_T&,
+                               stdair::Fare_T&);
+
+  private:
+    /** Constructors. */
+    ShoppingManager() {}
+    ShoppingManager(const ShoppingManager&) {}
+    /** Destructor. */
+    ~ShoppingManager() {}
+  };
+
+}
+#endif // __SIMCRS_CMD_SHOPPINGMANAGER_HPP
@@ -0,0 +1,201 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+// StdAir
+#include <stdair/bom/BomManager.hpp>
+#include <stdair/bom/BomRetriever.hpp>
+#include <stdair/bom/BomRoot.hpp>
+#include <stdair/bom/Inventory.hpp>
+#include <stdair/bom/FlightDate.hpp>
+#include <stdair/bom/SegmentDate.hpp>
+#include <stdair/bom/SegmentCabin.hpp>
+#include <stdair/bom/BookingClass.hpp>
+#include <stdair/service/Logger.hpp>
+// SimCRS
+#include <simcrs/basic/BasConst_General.hpp>
+#include <simcrs/bom/SymbolTable.hpp>
+#include <simcrs/command/SymbolManager.hpp>
+
+namespace SIMCRS {
+
+  // ////////////////////////////////////////////////////////////////////
+  void SymbolManager::buildSymbolTable (const stdair::BomRoot& iBomRoot,
+                                        SymbolTable& ioSymbolTable) {
+    // The BOM objects bound so far may no longer exist
+    ioSymbolTable.unbindSegmentDates();
+
+    CodeDictionary& lAirlineDictionary = ioSymbolTable.getAirlineDictionary();
+    CodeDictionary& lSegmentDateDictionary =
+      ioSymbolTable.getSegmentDateDictionary();
+
+    if (stdair::BomManager::hasList<stdair::Inventory> (iBomRoot) == false) {
+      return;
+    }
+
+    // Browse the inventories
+    const stdair::InventoryList_T& lInventoryList =
+      stdair::BomManager::getList<stdair::Inventory> (iBomRoot);
+    for (stdair::InventoryList_T::const_iterator itInv = lInventoryList.begin();
+         itInv != lInventoryList.end(); ++itInv) {
+      const stdair::Inventory* lInv_ptr = *itInv;
+      assert (lInv_ptr != NULL);
+      lAirlineDictionary.intern (lInv_ptr->getAirlineCode());
+
+      if (stdair::BomManager::hasList<stdair::FlightDate> (*lInv_ptr) == false) {
+        continue;
+      }
+
+      // Browse the flight-dates
+      const stdair::FlightDateList_T& lFlightDateList =
+        stdair::BomManager::getList<stdair::FlightDate> (*lInv_ptr);
+      for (stdair::FlightDateList_T::const_iterator itFD =
+             lFlightDateList.begin(); itFD != lFlightDateList.end(); ++itFD) {
+        const stdair::FlightDate* lFD_ptr = *itFD;
+        assert (lFD_ptr != NULL);
+
+        if (stdair::BomManager::hasList<stdair::SegmentDate> (*lFD_ptr)
+            == false) {
+          continue;
+        }
+
+        // Browse the segment-dates. They are all interned (and bound) here,
+        // so that the shopping requests only have to look them up
+        const stdair::SegmentDateList_T& lSegmentDateList =
+          stdair::BomManager::getList<stdair::SegmentDate> (*lFD_ptr);
+        for (stdair::SegmentDateList_T::const_iterator itSD =
+               lSegmentDateList.begin();
+             itSD != lSegmentDateList.end(); ++itSD) {
+          stdair::SegmentDate* lSD_ptr = *itSD;
+          assert (lSD_ptr != NULL);
+
+          const std::string lSegmentDateKey =
+            buildSegmentDateKey (*lInv_ptr, *lFD_ptr, *lSD_ptr);
+          const SegmentDateID_T lSegmentDateID =
+            lSegmentDateDictionary.intern (lSegmentDateKey);
+          bindSegmentDate (ioSymbolTable, lSegmentDateID, *lSD_ptr);
+        }
+      }
+    }
+
+    // DEBUG
+    STDAIR_LOG_DEBUG (ioSymbolTable.describe());
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  std::string SymbolManager::
+  buildSegmentDateKey (const stdair::Inventory& iInventory,
+                       const stdair::FlightDate& iFlightDate,
+                       const stdair::SegmentDate& iSegmentDate) {
+    // Same format as the keys of the segment paths given by AirTSP,
+    // e.g., 'SQ;12,2011-Jan-31;SIN,BKK;08:20:00'
+    std::ostringstream oStr;
+    oStr << iInventory.describeKey() << ";" << iFlightDate.describeKey()
+         << ";" << iSegmentDate.describeKey()
+         << ";" << iSegmentDate.getBoardingTime();
+    return oStr.str();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SymbolManager::bindSegmentDate (SymbolTable& ioSymbolTable,
+                                       const SegmentDateID_T& iSegmentDateID,
+                                       stdair::SegmentDate& iSegmentDate) {
+    CodeDictionary& lAirportDictionary = ioSymbolTable.getAirportDictionary();
+    const AirportID_T lBoardingPointID =
+      lAirportDictionary.intern (iSegmentDate.getBoardingPoint());
+    const AirportID_T lOffPointID =
+      lAirportDictionary.intern (iSegmentDate.getOffPoint());
+    ioSymbolTable.bindSegmentDate (iSegmentDateID, iSegmentDate,
+                                   lBoardingPointID, lOffPointID);
+
+    if (stdair::BomManager::hasList<stdair::SegmentCabin> (iSegmentDate)
+        == false) {
+      return;
+    }
+
+    // Bind the booking classes of the segment-date
+    CodeDictionary& lClassCodeDictionary =
+      ioSymbolTable.getClassCodeDictionary();
+    const stdair::SegmentCabinList_T& lSegmentCabinList =
+      stdair::BomManager::getList<stdair::SegmentCabin> (iSegmentDate);
+    for (stdair::SegmentCabinList_T::const_iterator itSC =
+           lSegmentCabinList.begin();
+         itSC != lSegmentCabinList.end(); ++itSC) {
+      const stdair::SegmentCabin* lSC_ptr = *itSC;
+      assert (lSC_ptr != NULL);
+
+      if (stdair::BomManager::hasList<stdair::BookingClass> (*lSC_ptr)
+          == false) {
+        continue;
+      }
+
+      const stdair::BookingClassList_T& lBookingClassList =
+        stdair::BomManager::getList<stdair::BookingClass> (*lSC_ptr);
+      for (stdair::BookingClassList_T::const_iterator itBC =
+             lBookingClassList.begin();
+           itBC != lBookingClassList.end(); ++itBC) {
+        stdair::BookingClass* lBC_ptr = *itBC;
+        assert (lBC_ptr != NULL);
+        const ClassCodeID_T lClassCodeID =
+          lClassCodeDictionary.intern (lBC_ptr->getClassCode());
+        ioSymbolTable.bindBookingClass (iSegmentDateID, lClassCodeID,
+                                        *lBC_ptr);
+      }
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  SegmentDateID_T SymbolManager::
+  internSegmentDate (const stdair::BomRoot& iBomRoot,
+                     SymbolTable& ioSymbolTable,
+                     const std::string& iSegmentDateKey) {
+    CodeDictionary& lSegmentDateDictionary =
+      ioSymbolTable.getSegmentDateDictionary();
+
+    // Most of the time, the segment-date has already been seen (and bound)
+    SegmentDateID_T oSegmentDateID =
+      lSegmentDateDictionary.find (iSegmentDateKey);
+    if (oSegmentDateID != DEFAULT_NULL_SYMBOL_ID
+        && ioSymbolTable.getSegmentDate (oSegmentDateID) != NULL) {
+      return oSegmentDateID;
+    }
+    oSegmentDateID = lSegmentDateDictionary.intern (iSegmentDateKey);
+
+    // Retrieve the corresponding segment-date object, if any
+    stdair::SegmentDate* lSD_ptr =
+      stdair::BomRetriever::retrieveSegmentDateFromLongKey (iBomRoot,
+                                                            iSegmentDateKey);
+    if (lSD_ptr != NULL) {
+      bindSegmentDate (ioSymbolTable, oSegmentDateID, *lSD_ptr);
+    }
+
+    return oSegmentDateID;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  SegmentDateID_T SymbolManager::
+  findSegmentDate (const SymbolTable& iSymbolTable,
+                   const std::string& iSegmentDateKey) {
+    const CodeDictionary& lSegmentDateDictionary =
+      iSymbolTable.getSegmentDateDictionary();
+    return lSegmentDateDictionary.find (iSegmentDateKey);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SymbolManager::internSegmentPath (const stdair::BomRoot& iBomRoot,
+                                         SymbolTable& ioSymbolTable,
+                                         const stdair::KeyList_T& iSegmentPath,
+                                         SegmentPathID_T& ioSegmentPathID) {
+    ioSegmentPathID.clear();
+    for (stdair::KeyList_T::const_iterator itKey = iSegmentPath.begin();
+         itKey != iSegmentPath.end(); ++itKey) {
+      const std::string& lSegmentDateKey = *itKey;
+      const SegmentDateID_T lSegmentDateID =
+        internSegmentDate (iBomRoot, ioSymbolTable, lSegmentDateKey);
+      ioSegmentPathID.push_back (lSegmentDateID);
+    }
+  }
+
+}
@@ -0,0 +1,99 @@
+#ifndef __SIMCRS_CMD_SYMBOLMANAGER_HPP
+#define __SIMCRS_CMD_SYMBOLMANAGER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+// SimCRS
+#include <simcrs/SIMCRS_Types.hpp>
+
+// Forward declarations
+namespace stdair {
+  class BomRoot;
+  class Inventory;
+  class FlightDate;
+  class SegmentDate;
+}
+
+namespace SIMCRS {
+
+  // Forward declarations
+  class SymbolTable;
+
+  /**
+   * @brief Command interning the codes (airports, airlines, booking classes
+   * and segment-dates) of the BOM tree into the SimCRS symbol table.
+   */
+  class SymbolManager {
+    friend class SIMCRS_Service;
+    friend class DistributionManager;
+    friend class ShoppingManager;
+    friend class AvailabilityStatusManager;
+    friend class DeltaManager;
+    friend class JournalManager;
+  private:
+    /**
+     * (Re-)Build the symbol table from the given BOM tree: all the airline,
+     * airport and booking class codes, as well as all the segment-date
+     * keys, are interned, and the segment-dates are bound to the objects
+     * of that BOM tree (the former bindings being dropped). The shopping
+     * requests then only have to look those codes up.
+     */
+    static void buildSymbolTable (const stdair::BomRoot&, SymbolTable&);
+
+    /**
+     * Get the identifier of the given segment-date key. When that key is
+     * seen for the first time, it is interned, and bound to the
+     * corresponding segment-date object of the given BOM tree (if any).
+     */
+    static SegmentDateID_T internSegmentDate (const stdair::BomRoot&,
+                                              SymbolTable&,
+                                              const std::string&);
+
+    /**
+     * Get the identifier of the given segment-date key, without interning
+     * it (so that the symbol table is left untouched, e.g., by readers).
+     *
+     * @return SegmentDateID_T The identifier, or DEFAULT_NULL_SYMBOL_ID
+     *         when that key has not been interned (yet).
+     */
+    static SegmentDateID_T findSegmentDate (const SymbolTable&,
+                                            const std::string&);
+
+    /**
+     * Convert a segment path (list of segment-date keys) into the list
+     * of the corresponding identifiers.
+     */
+    static void internSegmentPath (const stdair::BomRoot&, SymbolTable&,
+                                   const stdair::KeyList_T&,
+                                   SegmentPathID_T&);
+
+    /**
+     * Build the (long) key of the given segment-date, in the same format
+     * as the keys of the segment paths calculated by AirTSP.
+     */
+    static std::string buildSegmentDateKey (const stdair::Inventory&,
+                                            const stdair::FlightDate&,
+                                            const stdair::SegmentDate&);
+
+    /**
+     * Bind the given segment-date identifier, as well as the booking
+     * classes of that segment-date, to the given BOM objects.
+     */
+    static void bindSegmentDate (SymbolTable&, const SegmentDateID_T&,
+                                 stdair::SegmentDate&);
+
+  private:
+    /** Constructors. */
+    SymbolManager() {}
+    SymbolManager(const SymbolManager&) {}
+    /** Destructor. */
+    ~SymbolManager() {}
+  };
+
+}
+#endif // __SIMCRS_CMD_SYMBOLMANAGER_HPP
@@ -2,22 +2,28 @@
 // Import section
 // //////////////////////////////////////////////////////////////////////
 // STL
+#include <algorithm>
 #include <cassert>
 #include <sstream>
+#include <thread>
 // Boost
 #include <boost/make_shared.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
 // Standard Airline Object Model
 #include <stdair/stdair_exceptions.hpp>
 #include <stdair/stdair_basic_types.hpp>
 #include <stdair/stdair_json.hpp>
 #include <stdair/basic/BasChronometer.hpp>
 #include <stdair/basic/BasFileMgr.hpp>
+#include <stdair/basic/BasLogParams.hpp>
 #include <stdair/bom/BomManager.hpp> 
 #include <stdair/bom/BookingRequestStruct.hpp>
 #include <stdair/bom/TravelSolutionStruct.hpp>
 #include <stdair/bom/CancellationStruct.hpp>
 #include <stdair/bom/BomRoot.hpp>
 #include <stdair/bom/Inventory.hpp>
+#include <stdair/bom/BookingClass.hpp>
 #include <stdair/service/Logger.hpp>
 #include <stdair/STDAIR_Service.hpp>
 // SEvMgr
@@ -29,8 +35,29 @@
 // Fare Quote
 #include <simfqt/SIMFQT_Service.hpp>
 // SimCRS
+#include <simcrs/basic/BasConst_General.hpp>
 #include <simcrs/basic/BasConst_SIMCRS_Service.hpp>
+#include <simcrs/basic/BasProbes.hpp>
+#include <simcrs/bom/SymbolTable.hpp>
+#include <simcrs/bom/AvailabilityStatusTable.hpp>
+#include <simcrs/bom/FareQuoteCache.hpp>
+#include <simcrs/bom/SingleFlightGroup.hpp>
+#include <simcrs/bom/RequestTraceTimer.hpp>
+#include <simcrs/bom/TraceEventRecorder.hpp>
+#include <simcrs/bom/AllocationCounter.hpp>
+#include <simcrs/bom/DeltaOverlay.hpp>
+#include <simcrs/bom/BookingJournal.hpp>
+#include <simcrs/command/AvailabilityStatusManager.hpp>
+#include <simcrs/command/BranchManager.hpp>
+#include <simcrs/command/CheckpointManager.hpp>
+#include <simcrs/command/DatabaseManager.hpp>
+#include <simcrs/command/DeltaManager.hpp>
+#include <simcrs/command/DisplayManager.hpp>
 #include <simcrs/command/DistributionManager.hpp>
+#include <simcrs/command/JournalManager.hpp>
+#include <simcrs/command/MemoryReportManager.hpp>
+#include <simcrs/command/ShoppingManager.hpp>
+#include <simcrs/command/SymbolManager.hpp>
 #include <simcrs/factory/FacSimcrsServiceContext.hpp>
 #include <simcrs/service/SIMCRS_ServiceContext.hpp>
 #include <simcrs/SIMCRS_Service.hpp>
@@ -64,6 +91,11 @@ namespace SIMCRS {
     const bool ownStdairService = true;
     addStdAirService (lSTDAIR_Service_ptr, ownStdairService);
 
+    // Keep its log stream, to be flushed before forking (see
+    // runWhatIfBranches())
+    assert (_simcrsServiceContext != NULL);
+    _simcrsServiceContext->setLogStream (&iLogParams.getLogStream());
+
     // Initalise the SimFQT service.
     initSIMFQTService();
     
@@ -95,6 +127,11 @@ namespace SIMCRS {
     const bool ownStdairService = true;
     addStdAirService (lSTDAIR_Service_ptr, ownStdairService);
 
+    // Keep its log stream, to be flushed before forking (see
+    // runWhatIfBranches())
+    assert (_simcrsServiceContext != NULL);
+    _simcrsServiceContext->setLogStream (&iLogParams.getLogStream());
+
     // Initalise the SIMFQT service.
     initSIMFQTService();
     
@@ -149,6 +186,16 @@ namespace SIMCRS {
   // ////////////////////////////////////////////////////////////////////
   void SIMCRS_Service::finalise() {
     assert (_simcrsServiceContext != NULL);
+
+    // Dump the recorded trace events, if required
+    const stdair::Filename_T& lTraceEventFilename =
+      _simcrsServiceContext->getTraceEventFilename();
+    if (lTraceEventFilename.empty() == false) {
+      const TraceEventRecorder& lTraceEventRecorder =
+        _simcrsServiceContext->getTraceEventRecorder();
+      lTraceEventRecorder.dump (lTraceEventFilename);
+    }
+
     // Reset the (Boost.)Smart pointer pointing on the STDAIR_Service object.
     _simcrsServiceContext->reset();
   }
@@ -398,6 +445,244 @@ namespace SIMCRS {
     }
   }
   
+  // ////////////////////////////////////////////////////////////////////
+  NetworkDatabaseStatsStruct SIMCRS_Service::
+  importNetworkDatabase (const stdair::Filename_T& iDBFilename,
+                         const stdair::ScheduleFilePath& iScheduleInputFilepath,
+                         const stdair::ODFilePath& iODInputFilepath,
+                         const stdair::FRAT5FilePath& iFRAT5InputFilepath,
+                         const stdair::FFDisutilityFilePath&
+                         iFFDisutilityInputFilepath,
+                         const AIRRAC::YieldFilePath& iYieldInputFilepath,
+                         const SIMFQT::FareFilePath& iFareInputFilepath) {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    // The input files, in the order expected by the database manager
+    std::vector<stdair::Filename_T> lInputFilenameList;
+    lInputFilenameList.push_back (iScheduleInputFilepath.name());
+    lInputFilenameList.push_back (iODInputFilepath.name());
+    lInputFilenameList.push_back (iFRAT5InputFilepath.name());
+    lInputFilenameList.push_back (iFFDisutilityInputFilepath.name());
+    lInputFilenameList.push_back (iYieldInputFilepath.name());
+    lInputFilenameList.push_back (iFareInputFilepath.name());
+
+    // Delegate the import to the dedicated command
+    return DatabaseManager::importFiles (iDBFilename, lInputFilenameList);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  NetworkDatabaseStatsStruct SIMCRS_Service::
+  loadFromNetworkDatabase (const stdair::Filename_T& iDBFilename,
+                           const stdair::AirlineCodeList_T& iAirlineCodeList) {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    /**
+     * 1. Extract the records of the selected airlines into temporary
+     *    (CSV) files of a private directory, in the order: schedule,
+     *    O&D, FRAT5, FF disutility, yield and fare.
+     */
+    const stdair::Filename_T lExtractDirectory =
+      DatabaseManager::createExtractDirectory();
+    NetworkDatabaseStatsStruct oDatabaseStats;
+    try {
+      const std::vector<stdair::Filename_T> lInputFilenameList =
+        DatabaseManager::buildExtractFilenameList (lExtractDirectory);
+      oDatabaseStats = DatabaseManager::extractFiles (iDBFilename,
+                                                      iAirlineCodeList,
+                                                      lInputFilenameList);
+
+      /**
+       * 2. Have the components parse them, as for the CSV input files.
+       */
+      const stdair::ScheduleFilePath lScheduleFilePath (lInputFilenameList[0]);
+      const stdair::ODFilePath lODFilePath (lInputFilenameList[1]);
+      const stdair::FRAT5FilePath lFRAT5FilePath (lInputFilenameList[2]);
+      const stdair::FFDisutilityFilePath
+        lFFDisutilityFilePath (lInputFilenameList[3]);
+      const AIRRAC::YieldFilePath lYieldFilePath (lInputFilenameList[4]);
+      const SIMFQT::FareFilePath lFareFilePath (lInputFilenameList[5]);
+      parseAndLoad (lScheduleFilePath, lODFilePath, lFRAT5FilePath,
+                    lFFDisutilityFilePath, lYieldFilePath, lFareFilePath);
+
+    } catch (...) {
+      DatabaseManager::removeExtractDirectory (lExtractDirectory);
+      throw;
+    }
+
+    // 3. The temporary files are no longer needed
+    DatabaseManager::removeExtractDirectory (lExtractDirectory);
+    return oDatabaseStats;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DeltaStatsStruct SIMCRS_Service::
+  applyScheduleDelta (const stdair::Filename_T& iScheduleDeltaFilename) {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // Retrieve the (working) BOM tree, the flight-dates of which get
+    // closed or re-opened
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lSIMCRS_ServiceContext.getSTDAIR_Service();
+    const stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
+    DeltaOverlay& lDeltaOverlay = lSIMCRS_ServiceContext.getDeltaOverlay();
+
+    // Delegate the parsing and the application of the changes to the
+    // dedicated command
+    stdair::BasChronometer lDeltaChronometer;
+    lDeltaChronometer.start();
+    const DeltaStatsStruct oDeltaStats =
+      DeltaManager::applyScheduleDelta (iScheduleDeltaFilename, lBomRoot,
+                                        lDeltaOverlay);
+
+    // DEBUG
+    const double lDeltaMeasure = lDeltaChronometer.elapsed();
+    STDAIR_LOG_DEBUG ("Schedule delta '" << iScheduleDeltaFilename << "': "
+                      << oDeltaStats._nbOfAppliedChanges << " changes applied, "
+                      << oDeltaStats._nbOfRejectedChanges << " rejected, "
+                      << oDeltaStats._nbOfUpdatedFlightDates
+                      << " flight-dates updated (" << lDeltaOverlay.describe()
+                      << ") - " << lDeltaMeasure);
+
+    return oDeltaStats;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DeltaStatsStruct SIMCRS_Service::
+  applyFareDelta (const stdair::Filename_T& iFareDeltaFilename) {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    DeltaOverlay& lDeltaOverlay = lSIMCRS_ServiceContext.getDeltaOverlay();
+
+    // Delegate the parsing of the changes to the dedicated command. As
+    // the changes apply on top of the fare quotes, the fare quote cache
+    // remains valid.
+    stdair::BasChronometer lDeltaChronometer;
+    lDeltaChronometer.start();
+    const DeltaStatsStruct oDeltaStats =
+      DeltaManager::applyFareDelta (iFareDeltaFilename, lDeltaOverlay);
+
+    // DEBUG
+    const double lDeltaMeasure = lDeltaChronometer.elapsed();
+    STDAIR_LOG_DEBUG ("Fare delta '" << iFareDeltaFilename << "': "
+                      << oDeltaStats._nbOfAppliedChanges << " changes applied ("
+                      << lDeltaOverlay.describe() << ") - " << lDeltaMeasure);
+
+    return oDeltaStats;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::
+  publishFares (const SIMFQT::FareFilePath& iFareFilePath) {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // Check the fare file, before building anything
+    const stdair::Filename_T lFareFilename (iFareFilePath.name());
+    if (stdair::BasFileMgr::doesExistAndIsReadable (lFareFilename) == false) {
+      std::ostringstream oMessage;
+      oMessage << "The fare file '" << lFareFilename
+               << "' does not exist or can not be read";
+      STDAIR_LOG_ERROR (oMessage.str());
+      throw stdair::FileNotFoundException (oMessage.str());
+    }
+
+    // A single publication at a time. The computations of the (coalesced)
+    // requests are held off meanwhile, as the fares are parsed by StdAir,
+    // the logger and BOM factories of which are not synchronised; the
+    // fare quotes in progress, if any, keep on reading the former fares.
+    // The computation mutex is taken first (see lockBeforeFork())
+    std::lock_guard<std::mutex>
+      lComputationLock (lSIMCRS_ServiceContext.getComputationMutex());
+    std::lock_guard<std::mutex>
+      lPublicationLock (lSIMCRS_ServiceContext.getFarePublicationMutex());
+    stdair::BasChronometer lPublicationChronometer;
+    lPublicationChronometer.start();
+
+    /**
+     * 1. Build a new SimFQT service, with its own StdAir service (hence,
+     *    its own BOM tree), so that the current fares, which are being
+     *    read, are left untouched.
+     *
+     * \note The (Boost.)Smart Pointers keep track of the references
+     *       on the SimFQT service, and delete it when it is no longer
+     *       referenced (here, by the last reader). That releases, in
+     *       turn, its StdAir service, the deleter of which retires it
+     *       into the context: it can not be deleted right away, as its
+     *       destruction would clean all the BOM objects, including the
+     *       ones of the SimCRS StdAir service (see
+     *       FacSupervisor::cleanAll()). The retired StdAir services are
+     *       deleted when the SimCRS service is finalised.
+     */
+    stdair::STDAIR_Service* lFareSTDAIR_Service_ptr =
+      new stdair::STDAIR_Service();
+    const stdair::STDAIR_ServicePtr_T lFareSTDAIR_ServicePtr =
+      lSIMCRS_ServiceContext.addFareSTDAIR_Service (lFareSTDAIR_Service_ptr);
+    SIMFQT::SIMFQT_ServicePtr_T lSIMFQT_Service_ptr =
+      boost::make_shared<SIMFQT::SIMFQT_Service> (lFareSTDAIR_ServicePtr);
+    lSIMFQT_Service_ptr->parseAndLoad (iFareFilePath);
+    lFareSTDAIR_Service_ptr->clonePersistentBom();
+    lSIMFQT_Service_ptr->clonePersistentBom();
+
+    /**
+     * 2. Swap it in, atomically: the fare quotes in progress keep on
+     *    using (and referencing) the former SimFQT service.
+     */
+    lSIMCRS_ServiceContext.publishSIMFQT_Service (lSIMFQT_Service_ptr);
+
+    // DEBUG
+    const double lPublicationMeasure = lPublicationChronometer.elapsed();
+    STDAIR_LOG_DEBUG ("Fares published from '" << lFareFilename
+                      << "' (version "
+                      << lSIMCRS_ServiceContext.getFareVersion() << "): "
+                      << lPublicationMeasure);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  FareVersion_T SIMCRS_Service::getFareVersion() const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    const SIMCRS_ServiceContext& lSIMCRS_ServiceContext =
+      *_simcrsServiceContext;
+
+    return lSIMCRS_ServiceContext.getFareVersion();
+  }
+
   // ////////////////////////////////////////////////////////////////////
   void SIMCRS_Service::buildSampleBom() {
 
@@ -546,7 +831,34 @@ namespace SIMCRS {
 
   // ////////////////////////////////////////////////////////////////////
   void SIMCRS_Service::buildComplementaryLinks (stdair::BomRoot& ioBomRoot) {
-    // Currently, no more things to do by TravelCCM at that stage.
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // Intern the airline, airport and booking class codes
+    SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+    SymbolManager::buildSymbolTable (ioBomRoot, lSymbolTable);
+
+    // The availability statuses refer to the former BOM tree: they will
+    // be pushed again as the segment-dates get bound to the new one
+    AvailabilityStatusTable& lAvailabilityStatusTable =
+      lSIMCRS_ServiceContext.getAvailabilityStatusTable();
+    lAvailabilityStatusTable.clear();
+
+    // The fares may have been (re-)loaded
+    FareQuoteCache& lFareQuoteCache =
+      lSIMCRS_ServiceContext.getFareQuoteCache();
+    lFareQuoteCache.clear();
+
+    // The schedule and fare changes are superseded by the (re-)loaded
+    // BOM trees
+    DeltaOverlay& lDeltaOverlay = lSIMCRS_ServiceContext.getDeltaOverlay();
+    lDeltaOverlay.clear();
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -592,7 +904,9 @@ namespace SIMCRS {
   // ////////////////////////////////////////////////////////////////////
   bool SIMCRS_Service::sell (const std::string& iSegmentDateKey,
                              const stdair::ClassCode_T& iClassCode,
-                             const stdair::PartySize_T& iPartySize) {
+                             const stdair::PartySize_T& iPartySize,
+                             RequestTraceStruct* ioRequestTrace_ptr) {
+    SIMCRS_PROBE1 (sell__entry, static_cast<int> (iPartySize));
 
     // Retrieve the SimCRS service context
     if (_simcrsServiceContext == NULL) {
@@ -602,17 +916,68 @@ namespace SIMCRS {
     assert (_simcrsServiceContext != NULL);
     SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
 
+    // Reset the request trace, if any, and measure the whole request
+    lSIMCRS_ServiceContext.initRequestTrace (ioRequestTrace_ptr);
+    RequestTraceTimer lTotalTimer (ioRequestTrace_ptr,
+                                   RequestTraceStruct::TOTAL);
+    // Record the begin and end events of the request, and count its heap
+    // allocations, if enabled
+    TraceEventRecorder& lTraceEventRecorder =
+      lSIMCRS_ServiceContext.getTraceEventRecorder();
+    TraceEventScope lTraceEventScope (lTraceEventRecorder,
+                                      "sell", "simcrs");
+    AllocationCountScope
+      lAllocationCountScope (lSIMCRS_ServiceContext.getAllocationCounter(),
+                             "sell");
+
     // Retrieve the AIRINV Master service.
     AIRINV::AIRINV_Master_Service& lAIRINV_Master_Service =
       lSIMCRS_ServiceContext.getAIRINV_Service();
 
-    return lAIRINV_Master_Service.sell (iSegmentDateKey, iClassCode,
-                                        iPartySize);
+    // The flight-date may have been closed to sale by a schedule change
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lSIMCRS_ServiceContext.getSTDAIR_Service();
+    const stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
+    SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+    const DeltaOverlay& lDeltaOverlay =
+      lSIMCRS_ServiceContext.getDeltaOverlay();
+    const stdair::KeyList_T lSegmentPath (1, iSegmentDateKey);
+    if (DeltaManager::isOpen (lBomRoot, lSymbolTable, lDeltaOverlay,
+                              lSegmentPath) == false) {
+      SIMCRS_PROBE2 (sell__return, static_cast<int> (iPartySize), 0);
+      return false;
+    }
+
+    bool hasSaleBeenSuccessful = false;
+    {
+      RequestTraceTimer lSellTimer (ioRequestTrace_ptr,
+                                    RequestTraceStruct::SELL);
+      TraceEventScope lSellEventScope (lTraceEventRecorder,
+                                       "AIRINV::sell", "airinv");
+      hasSaleBeenSuccessful =
+        lAIRINV_Master_Service.sell (iSegmentDateKey, iClassCode, iPartySize);
+    }
+
+    // Record the sale into the booking journal, if open
+    if (hasSaleBeenSuccessful == true) {
+      JournalManager::journalSell (lSIMCRS_ServiceContext.getBookingJournal(),
+                                   iSegmentDateKey, iClassCode, iPartySize);
+    }
+
+    // Push the new availability into the AVS table, if needed
+    pushAvailabilityStatuses (lSegmentPath);
+
+    SIMCRS_PROBE2 (sell__return, static_cast<int> (iPartySize),
+                   static_cast<int> (hasSaleBeenSuccessful));
+    return hasSaleBeenSuccessful;
   }
 
   // ////////////////////////////////////////////////////////////////////
-  std::string SIMCRS_Service::
-  jsonHandler (const stdair::JSONString& iJSONString) const {
+  bool SIMCRS_Service::sell (const SegmentDateID_T& iSegmentDateID,
+                             const ClassCodeID_T& iClassCodeID,
+                             const stdair::PartySize_T& iPartySize,
+                             RequestTraceStruct* ioRequestTrace_ptr) {
+    SIMCRS_PROBE1 (sell__entry, static_cast<int> (iPartySize));
 
     // Retrieve the SimCRS service context
     if (_simcrsServiceContext == NULL) {
@@ -622,36 +987,117 @@ namespace SIMCRS {
     assert (_simcrsServiceContext != NULL);
     SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
 
+    // Reset the request trace, if any, and measure the whole request
+    lSIMCRS_ServiceContext.initRequestTrace (ioRequestTrace_ptr);
+    RequestTraceTimer lTotalTimer (ioRequestTrace_ptr,
+                                   RequestTraceStruct::TOTAL);
+    // Record the begin and end events of the request, and count its heap
+    // allocations, if enabled
+    TraceEventRecorder& lTraceEventRecorder =
+      lSIMCRS_ServiceContext.getTraceEventRecorder();
+    TraceEventScope lTraceEventScope (lTraceEventRecorder,
+                                      "sell", "simcrs");
+    AllocationCountScope
+      lAllocationCountScope (lSIMCRS_ServiceContext.getAllocationCounter(),
+                             "sell");
+
     // Retrieve the AIRINV Master service.
     AIRINV::AIRINV_Master_Service& lAIRINV_Master_Service =
       lSIMCRS_ServiceContext.getAIRINV_Service();
 
-    return lAIRINV_Master_Service.jsonHandler (iJSONString);
-    
+    // Retrieve the table of the interned codes
+    const SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+
+    // The flight-date may have been closed to sale by a schedule change
+    const DeltaOverlay& lDeltaOverlay =
+      lSIMCRS_ServiceContext.getDeltaOverlay();
+    if (DeltaManager::isOpen (lSymbolTable, lDeltaOverlay,
+                              iSegmentDateID) == false) {
+      SIMCRS_PROBE2 (sell__return, static_cast<int> (iPartySize), 0);
+      return false;
+    }
+
+    bool hasSaleBeenSuccessful = false;
+    {
+      RequestTraceTimer lSellTimer (ioRequestTrace_ptr,
+                                    RequestTraceStruct::SELL);
+      TraceEventScope lSellEventScope (lTraceEventRecorder,
+                                       "DistributionManager::sell", "airinv");
+      hasSaleBeenSuccessful =
+        DistributionManager::sell (lAIRINV_Master_Service, lSymbolTable,
+                                   iSegmentDateID, iClassCodeID, iPartySize);
+    }
+
+    // Record the sale into the booking journal, if open
+    BookingJournal& lBookingJournal =
+      lSIMCRS_ServiceContext.getBookingJournal();
+    if (hasSaleBeenSuccessful == true && lBookingJournal.isOpen() == true) {
+      const std::string& lSegmentDateKey =
+        lSymbolTable.getSegmentDateDictionary().getCode (iSegmentDateID);
+      const stdair::ClassCode_T& lClassCode =
+        lSymbolTable.getClassCodeDictionary().getCode (iClassCodeID);
+      JournalManager::journalSell (lBookingJournal, lSegmentDateKey,
+                                   lClassCode, iPartySize);
+    }
+
+    // Push the new availability into the AVS table (at once or with the
+    // next batch), if needed
+    if (lSIMCRS_ServiceContext.getAvailabilityMode() == AVS_AVAILABILITY) {
+      AvailabilityStatusTable& lAvailabilityStatusTable =
+        lSIMCRS_ServiceContext.getAvailabilityStatusTable();
+      AvailabilityStatusManager::notifySegmentDate (lSymbolTable,
+                                                    lAvailabilityStatusTable,
+                                                    iSegmentDateID);
+    }
+
+    SIMCRS_PROBE2 (sell__return, static_cast<int> (iPartySize),
+                   static_cast<int> (hasSaleBeenSuccessful));
+    return hasSaleBeenSuccessful;
   }
 
   // ////////////////////////////////////////////////////////////////////
-  void SIMCRS_Service::
-  initSnapshotAndRMEvents (const stdair::Date_T& iStartDate,
-                           const stdair::Date_T& iEndDate) {
+  stdair::Availability_T SIMCRS_Service::
+  getAvailability (const SegmentDateID_T& iSegmentDateID,
+                   const ClassCodeID_T& iClassCodeID) const {
 
     // Retrieve the SimCRS service context
     if (_simcrsServiceContext == NULL) {
-      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
-                                                    "not been initialised");
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
     }
     assert (_simcrsServiceContext != NULL);
     SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
 
-    // Retrieve the AIRINV Master service.
-    AIRINV::AIRINV_Master_Service& lAIRINV_Master_Service =
-      lSIMCRS_ServiceContext.getAIRINV_Service();
+    // With AVS-based availability, read the AVS table, when it holds
+    // the availability of that booking class
+    if (lSIMCRS_ServiceContext.getAvailabilityMode() == AVS_AVAILABILITY) {
+      const AvailabilityStatusTable& lAvailabilityStatusTable =
+        lSIMCRS_ServiceContext.getAvailabilityStatusTable();
+      const AvailabilityStatus_T lStatus =
+        lAvailabilityStatusTable.getStatus (iSegmentDateID, iClassCodeID);
+      if (lStatus != AvailabilityStatusTable::K_UNKNOWN_STATUS) {
+        return lStatus;
+      }
+    }
 
-    lAIRINV_Master_Service.initSnapshotAndRMEvents (iStartDate, iEndDate);
+    // Retrieve the booking class by a mere array indexing
+    const SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+    const stdair::BookingClass* lBookingClass_ptr =
+      lSymbolTable.getBookingClass (iSegmentDateID, iClassCodeID);
+    if (lBookingClass_ptr == NULL) {
+      std::ostringstream oStr;
+      oStr << "No booking class corresponds to the segment-date identifier "
+           << iSegmentDateID << " and booking class identifier "
+           << iClassCodeID;
+      throw SymbolNotFoundException (oStr.str());
+    }
+
+    return lBookingClass_ptr->getSegmentAvailability();
   }
-  
-  // //////////////////////////////////////////////////////////////////////
-  std::string SIMCRS_Service::csvDisplay() const {
+
+  // ////////////////////////////////////////////////////////////////////
+  AirportID_T SIMCRS_Service::
+  getAirportID (const stdair::AirportCode_T& iAirportCode) const {
 
     // Retrieve the SimCRS service context
     if (_simcrsServiceContext == NULL) {
@@ -659,20 +1105,21 @@ namespace SIMCRS {
                                                     "has not been initialised");
     }
     assert (_simcrsServiceContext != NULL);
-
-    // Retrieve the StdAir service object from the (SimCRS) service context
     SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
-    stdair::STDAIR_Service& lSTDAIR_Service =
-      lSIMCRS_ServiceContext.getSTDAIR_Service(); 
-    const stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
 
-    // Delegate the BOM building to the dedicated service
-    return lSTDAIR_Service.csvDisplay(lBomRoot);
+    const SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+    const AirportID_T oAirportID =
+      lSymbolTable.getAirportDictionary().find (iAirportCode);
+    if (oAirportID == DEFAULT_NULL_SYMBOL_ID) {
+      throw SymbolNotFoundException ("The airport code '" + iAirportCode
+                                     + "' is not known by SimCRS");
+    }
+    return oAirportID;
   }
-  
-  // //////////////////////////////////////////////////////////////////////
-  std::string SIMCRS_Service::
-  csvDisplay (const stdair::TravelSolutionList_T& ioTravelSolutionList) const {
+
+  // ////////////////////////////////////////////////////////////////////
+  AirlineID_T SIMCRS_Service::
+  getAirlineID (const stdair::AirlineCode_T& iAirlineCode) const {
 
     // Retrieve the SimCRS service context
     if (_simcrsServiceContext == NULL) {
@@ -680,130 +1127,1131 @@ namespace SIMCRS {
                                                     "has not been initialised");
     }
     assert (_simcrsServiceContext != NULL);
-
-    // Retrieve the StdAir service object from the (SimCRS) service context
     SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
-    stdair::STDAIR_Service& lSTDAIR_Service =
-      lSIMCRS_ServiceContext.getSTDAIR_Service();
 
-    // Delegate the BOM building to the dedicated service
-    return lSTDAIR_Service.csvDisplay (ioTravelSolutionList);
+    const SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+    const AirlineID_T oAirlineID =
+      lSymbolTable.getAirlineDictionary().find (iAirlineCode);
+    if (oAirlineID == DEFAULT_NULL_SYMBOL_ID) {
+      throw SymbolNotFoundException ("The airline code '" + iAirlineCode
+                                     + "' is not known by SimCRS");
+    }
+    return oAirlineID;
   }
 
   // ////////////////////////////////////////////////////////////////////
-  std::string SIMCRS_Service::
-  list (const stdair::AirlineCode_T& iAirlineCode,
-        const stdair::FlightNumber_T& iFlightNumber) const {
+  ClassCodeID_T SIMCRS_Service::
+  getClassCodeID (const stdair::ClassCode_T& iClassCode) const {
 
     // Retrieve the SimCRS service context
     if (_simcrsServiceContext == NULL) {
-      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
-                                                    "not been initialised");
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
     }
     assert (_simcrsServiceContext != NULL);
     SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
 
-    // Retrieve the AIRINV Master service.
-    AIRINV::AIRINV_Master_Service& lAIRINV_Master_Service =
-      lSIMCRS_ServiceContext.getAIRINV_Service();
-
-    // Delegate the BOM display to the dedicated service
-    return lAIRINV_Master_Service.list (iAirlineCode, iFlightNumber);
+    const SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+    const ClassCodeID_T oClassCodeID =
+      lSymbolTable.getClassCodeDictionary().find (iClassCode);
+    if (oClassCodeID == DEFAULT_NULL_SYMBOL_ID) {
+      throw SymbolNotFoundException ("The booking class code '" + iClassCode
+                                     + "' is not known by SimCRS");
+    }
+    return oClassCodeID;
   }
 
   // ////////////////////////////////////////////////////////////////////
-  std::string SIMCRS_Service::
-  csvDisplay (const stdair::AirlineCode_T& iAirlineCode,
-              const stdair::FlightNumber_T& iFlightNumber,
-              const stdair::Date_T& iDepartureDate) const {
+  SegmentDateID_T SIMCRS_Service::
+  getSegmentDateID (const std::string& iSegmentDateKey) {
 
     // Retrieve the SimCRS service context
     if (_simcrsServiceContext == NULL) {
-      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
-                                                    "not been initialised");
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
     }
     assert (_simcrsServiceContext != NULL);
     SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
 
-    // Retrieve the AIRINV Master service.
-    AIRINV::AIRINV_Master_Service& lAIRINV_Master_Service =
-      lSIMCRS_ServiceContext.getAIRINV_Service();
+    // Retrieve the (working) BOM tree
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lSIMCRS_ServiceContext.getSTDAIR_Service();
+    const stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
 
-    // Delegate the BOM display to the dedicated service
-    return lAIRINV_Master_Service.csvDisplay (iAirlineCode, iFlightNumber,
-                                              iDepartureDate);
+    // Intern the segment-date key, and bind it to the BOM tree
+    SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+    const SegmentDateID_T oSegmentDateID =
+      SymbolManager::internSegmentDate (lBomRoot, lSymbolTable,
+                                        iSegmentDateKey);
+    if (lSymbolTable.getSegmentDate (oSegmentDateID) == NULL) {
+      throw SymbolNotFoundException ("The segment-date '" + iSegmentDateKey
+                                     + "' can not be found in the BOM tree");
+    }
+    return oSegmentDateID;
   }
-   
+
   // ////////////////////////////////////////////////////////////////////
-  stdair::TravelSolutionList_T SIMCRS_Service::
-  calculateSegmentPathList(const stdair::BookingRequestStruct& iBookingRequest){
-     
+  void SIMCRS_Service::
+  getSegmentPathID (const stdair::TravelSolutionStruct& iTravelSolution,
+                    SegmentPathID_T& ioSegmentPathID) {
+
     // Retrieve the SimCRS service context
     if (_simcrsServiceContext == NULL) {
       throw stdair::NonInitialisedServiceException ("The SimCRS service "
                                                     "has not been initialised");
     }
     assert (_simcrsServiceContext != NULL);
-
     SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
 
-    stdair::TravelSolutionList_T oTravelSolutionList;
-    
-    // Get a reference on the AIRTSP service handler
-    AIRTSP::AIRTSP_Service& lAIRTSP_Service =
-      lSIMCRS_ServiceContext.getAIRTSP_Service();
-    
-    // Delegate the booking to the dedicated service
-    stdair::BasChronometer lTravelSolutionRetrievingChronometer;
-    lTravelSolutionRetrievingChronometer.start();
-
-    lAIRTSP_Service.buildSegmentPathList (oTravelSolutionList,
-                                            iBookingRequest);
-      
-    // DEBUG
-    const double lSegmentPathRetrievingMeasure =
-      lTravelSolutionRetrievingChronometer.elapsed();
-    STDAIR_LOG_DEBUG ("Travel solution retrieving: "
-                      << lSegmentPathRetrievingMeasure << " - "
-                      << lSIMCRS_ServiceContext.display());
+    // Retrieve the (working) BOM tree
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lSIMCRS_ServiceContext.getSTDAIR_Service();
+    const stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
 
-    return oTravelSolutionList;
+    SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+    SymbolManager::internSegmentPath (lBomRoot, lSymbolTable,
+                                      iTravelSolution.getSegmentPath(),
+                                      ioSegmentPathID);
   }
 
   // ////////////////////////////////////////////////////////////////////
-  void SIMCRS_Service::
-  fareQuote (const stdair::BookingRequestStruct& iBookingRequest,
-             stdair::TravelSolutionList_T& ioTravelSolutionList) {
-     
+  const std::string& SIMCRS_Service::
+  getAirportCode (const AirportID_T& iAirportID) const {
+
     // Retrieve the SimCRS service context
     if (_simcrsServiceContext == NULL) {
-      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
-                                                    "not been initialised");
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
     }
     assert (_simcrsServiceContext != NULL);
-    
     SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
-    
-    // Get a reference on the SIMFQT service handler
-    SIMFQT::SIMFQT_Service& lSIMFQT_Service =
-      lSIMCRS_ServiceContext.getSIMFQT_Service();
-      
-    // Delegate the action to the dedicated command
-    stdair::BasChronometer lFareQuoteRetrievalChronometer;
-    lFareQuoteRetrievalChronometer.start();
 
-    lSIMFQT_Service.quotePrices (iBookingRequest, ioTravelSolutionList);
+    const SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+    return lSymbolTable.getAirportDictionary().getCode (iAirportID);
+  }
 
-    // DEBUG
-    const double lFareQuoteRetrievalMeasure =
-      lFareQuoteRetrievalChronometer.elapsed();
+  // ////////////////////////////////////////////////////////////////////
+  const std::string& SIMCRS_Service::
+  getAirlineCode (const AirlineID_T& iAirlineID) const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    const SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+    return lSymbolTable.getAirlineDictionary().getCode (iAirlineID);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string& SIMCRS_Service::
+  getClassCode (const ClassCodeID_T& iClassCodeID) const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    const SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+    return lSymbolTable.getClassCodeDictionary().getCode (iClassCodeID);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string& SIMCRS_Service::
+  getSegmentDateKey (const SegmentDateID_T& iSegmentDateID) const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    const SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+    return lSymbolTable.getSegmentDateDictionary().getCode (iSegmentDateID);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  std::string SIMCRS_Service::
+  jsonHandler (const stdair::JSONString& iJSONString) const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // The memory report command is handled by SimCRS itself
+    boost::property_tree::ptree lCommandTree;
+    const std::string lCommandName =
+      parseJSONCommand (iJSONString, lCommandTree);
+    if (lCommandName == "memory_report") {
+      std::ostringstream oStr;
+      MemoryReportManager::jsonExport (oStr, memoryReport());
+      return oStr.str();
+    }
+
+    // Retrieve the AIRINV Master service.
+    AIRINV::AIRINV_Master_Service& lAIRINV_Master_Service =
+      lSIMCRS_ServiceContext.getAIRINV_Service();
+
+    return lAIRINV_Master_Service.jsonHandler (iJSONString);
+    
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::jsonHandler (const stdair::JSONString& iJSONString,
+                                    std::ostream& oStream) const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // The command is parsed once, and dispatched on its name
+    boost::property_tree::ptree lCommandTree;
+    const std::string lCommandName =
+      parseJSONCommand (iJSONString, lCommandTree);
+
+    // The memory report command is handled by SimCRS itself
+    if (lCommandName == "memory_report") {
+      MemoryReportManager::jsonExport (oStream, memoryReport());
+      return;
+    }
+
+    // The inventory and flight-date export commands are streamed, one
+    // flight-date at a time
+    if (lCommandName.empty() == false) {
+      stdair::STDAIR_Service& lSTDAIR_Service =
+        lSIMCRS_ServiceContext.getSTDAIR_Service();
+      const stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
+      const boost::property_tree::ptree& lParameterTree =
+        lCommandTree.front().second;
+      if (DisplayManager::jsonExport (oStream, lBomRoot, lCommandName,
+                                      lParameterTree) == true) {
+        return;
+      }
+    }
+
+    // Retrieve the AIRINV Master service.
+    AIRINV::AIRINV_Master_Service& lAIRINV_Master_Service =
+      lSIMCRS_ServiceContext.getAIRINV_Service();
+
+    oStream << lAIRINV_Master_Service.jsonHandler (iJSONString);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  std::string SIMCRS_Service::
+  parseJSONCommand (const stdair::JSONString& iJSONString,
+                    boost::property_tree::ptree& ioCommandTree) {
+    // Anything not parsed as a JSON object with a single member is left
+    // to AirInv, which reports the errors
+    try {
+      std::istringstream lJSONStream (iJSONString.getString());
+      boost::property_tree::read_json (lJSONStream, ioCommandTree);
+
+    } catch (const boost::property_tree::ptree_error&) {
+      return "";
+    }
+
+    if (ioCommandTree.size() != 1) {
+      return "";
+    }
+    return ioCommandTree.front().first;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::
+  initSnapshotAndRMEvents (const stdair::Date_T& iStartDate,
+                           const stdair::Date_T& iEndDate) {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // Retrieve the AIRINV Master service.
+    AIRINV::AIRINV_Master_Service& lAIRINV_Master_Service =
+      lSIMCRS_ServiceContext.getAIRINV_Service();
+
+    lAIRINV_Master_Service.initSnapshotAndRMEvents (iStartDate, iEndDate);
+  }
+  
+  // //////////////////////////////////////////////////////////////////////
+  std::string SIMCRS_Service::csvDisplay() const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    // Retrieve the StdAir service object from the (SimCRS) service context
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lSIMCRS_ServiceContext.getSTDAIR_Service(); 
+    const stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
+
+    // Delegate the BOM building to the dedicated service
+    return lSTDAIR_Service.csvDisplay(lBomRoot);
+  }
+  
+  // //////////////////////////////////////////////////////////////////////
+  std::string SIMCRS_Service::
+  csvDisplay (const stdair::TravelSolutionList_T& ioTravelSolutionList) const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    // Retrieve the StdAir service object from the (SimCRS) service context
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lSIMCRS_ServiceContext.getSTDAIR_Service();
+
+    // Delegate the BOM building to the dedicated service
+    return lSTDAIR_Service.csvDisplay (ioTravelSolutionList);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  std::string SIMCRS_Service::
+  list (const stdair::AirlineCode_T& iAirlineCode,
+        const stdair::FlightNumber_T& iFlightNumber) const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // Retrieve the AIRINV Master service.
+    AIRINV::AIRINV_Master_Service& lAIRINV_Master_Service =
+      lSIMCRS_ServiceContext.getAIRINV_Service();
+
+    // Delegate the BOM display to the dedicated service
+    return lAIRINV_Master_Service.list (iAirlineCode, iFlightNumber);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  std::string SIMCRS_Service::
+  csvDisplay (const stdair::AirlineCode_T& iAirlineCode,
+              const stdair::FlightNumber_T& iFlightNumber,
+              const stdair::Date_T& iDepartureDate) const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // Retrieve the AIRINV Master service.
+    AIRINV::AIRINV_Master_Service& lAIRINV_Master_Service =
+      lSIMCRS_ServiceContext.getAIRINV_Service();
+
+    // Delegate the BOM display to the dedicated service
+    return lAIRINV_Master_Service.csvDisplay (iAirlineCode, iFlightNumber,
+                                              iDepartureDate);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::
+  csvDisplay (std::ostream& oStream,
+              const DisplayFilterStruct& iDisplayFilter) const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    // Retrieve the StdAir service object from the (SimCRS) service context
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lSIMCRS_ServiceContext.getSTDAIR_Service();
+    const stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
+
+    // Stream the BOM display, one flight-date at a time
+    DisplayManager::csvDisplay (oStream, lBomRoot, iDisplayFilter);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::
+  csvDisplay (const DisplayChunkSink_T& iSink,
+              const DisplayFilterStruct& iDisplayFilter) const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    // Retrieve the StdAir service object from the (SimCRS) service context
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lSIMCRS_ServiceContext.getSTDAIR_Service();
+    const stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
+
+    // Stream the BOM display, one flight-date (chunk) at a time
+    DisplayManager::csvDisplay (iSink, lBomRoot, iDisplayFilter);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::list (std::ostream& oStream,
+                             const DisplayFilterStruct& iDisplayFilter) const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    // Retrieve the StdAir service object from the (SimCRS) service context
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lSIMCRS_ServiceContext.getSTDAIR_Service();
+    const stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
+
+    // Stream the list of the flight-dates
+    DisplayManager::list (oStream, lBomRoot, iDisplayFilter);
+  }
+   
+  // ////////////////////////////////////////////////////////////////////
+  stdair::TravelSolutionList_T SIMCRS_Service::
+  calculateSegmentPathList (const stdair::BookingRequestStruct& iBookingRequest,
+                            RequestTraceStruct* ioRequestTrace_ptr) {
+    SIMCRS_PROBE1 (calculate_segment_path_list__entry,
+                   static_cast<int> (iBookingRequest.getPartySize()));
+     
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // Reset the request trace, if any, and measure the whole request
+    lSIMCRS_ServiceContext.initRequestTrace (ioRequestTrace_ptr);
+    RequestTraceTimer lTotalTimer (ioRequestTrace_ptr,
+                                   RequestTraceStruct::TOTAL);
+    // Record the begin and end events of the request, and count its heap
+    // allocations, if enabled
+    TraceEventRecorder& lTraceEventRecorder =
+      lSIMCRS_ServiceContext.getTraceEventRecorder();
+    TraceEventScope lTraceEventScope (lTraceEventRecorder,
+                                      "calculateSegmentPathList", "simcrs");
+    AllocationCountScope
+      lAllocationCountScope (lSIMCRS_ServiceContext.getAllocationCounter(),
+                             "calculateSegmentPathList");
+
+    stdair::TravelSolutionList_T oTravelSolutionList;
+
+    if (lSIMCRS_ServiceContext.getRequestCoalescingFlag() == false) {
+      buildSegmentPathList (iBookingRequest, oTravelSolutionList,
+                            ioRequestTrace_ptr);
+      SIMCRS_PROBE1 (calculate_segment_path_list__return,
+                     oTravelSolutionList.size());
+      return oTravelSolutionList;
+    }
+
+    // Join the identical in-flight request, if any
+    std::string lKey;
+    ShoppingManager::buildSegmentPathKey (iBookingRequest, lKey);
+    SingleFlightGroup& lSingleFlightGroup =
+      lSIMCRS_ServiceContext.getSegmentPathFlightGroup();
+    const SingleFlightGroup::Computation_T lComputation =
+      [this, &iBookingRequest, ioRequestTrace_ptr]
+      (stdair::TravelSolutionList_T& ioList) {
+      buildSegmentPathList (iBookingRequest, ioList, ioRequestTrace_ptr);
+    };
+    const bool isCoalesced =
+      lSingleFlightGroup.run (lKey, lComputation, oTravelSolutionList);
+    if (ioRequestTrace_ptr != NULL) {
+      ioRequestTrace_ptr->_isCoalesced = isCoalesced;
+    }
+
+    SIMCRS_PROBE1 (calculate_segment_path_list__return,
+                   oTravelSolutionList.size());
+    return oTravelSolutionList;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::
+  buildSegmentPathList (const stdair::BookingRequestStruct& iBookingRequest,
+                        stdair::TravelSolutionList_T& ioTravelSolutionList,
+                        RequestTraceStruct* ioRequestTrace_ptr) {
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // The request trace is filled by the command (it is held, per thread,
+    // by the service context)
+    RequestTraceScope
+      lRequestTraceScope (lSIMCRS_ServiceContext.getCurrentRequestTraceRef(),
+                          ioRequestTrace_ptr);
+
+    // Delegate the segment path building to the dedicated command (which
+    // relies on AirTSP)
+    stdair::BasChronometer lTravelSolutionRetrievingChronometer;
+    lTravelSolutionRetrievingChronometer.start();
+
+    ShoppingManager::buildSegmentPathList (lSIMCRS_ServiceContext,
+                                           iBookingRequest,
+                                           ioTravelSolutionList);
+      
+    // DEBUG
+    const double lSegmentPathRetrievingMeasure =
+      lTravelSolutionRetrievingChronometer.elapsed();
+    STDAIR_LOG_DEBUG ("Travel solution retrieving: "
+                      << lSegmentPathRetrievingMeasure << " - "
+                      << lSIMCRS_ServiceContext.display());
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::
+  fareQuote (const stdair::BookingRequestStruct& iBookingRequest,
+             stdair::TravelSolutionList_T& ioTravelSolutionList,
+             RequestTraceStruct* ioRequestTrace_ptr) {
+    SIMCRS_PROBE1 (fare_quote__entry, ioTravelSolutionList.size());
+     
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // Reset the request trace, if any, and measure the whole request
+    lSIMCRS_ServiceContext.initRequestTrace (ioRequestTrace_ptr);
+    RequestTraceTimer lTotalTimer (ioRequestTrace_ptr,
+                                   RequestTraceStruct::TOTAL);
+    // Record the begin and end events of the request, and count its heap
+    // allocations, if enabled
+    TraceEventRecorder& lTraceEventRecorder =
+      lSIMCRS_ServiceContext.getTraceEventRecorder();
+    TraceEventScope lTraceEventScope (lTraceEventRecorder,
+                                      "fareQuote", "simcrs");
+    AllocationCountScope
+      lAllocationCountScope (lSIMCRS_ServiceContext.getAllocationCounter(),
+                             "fareQuote");
+
+    if (lSIMCRS_ServiceContext.getRequestCoalescingFlag() == false) {
+      quotePrices (iBookingRequest, ioTravelSolutionList, ioRequestTrace_ptr);
+      SIMCRS_PROBE1 (fare_quote__return, ioTravelSolutionList.size());
+      return;
+    }
+
+    // Join the identical in-flight request, if any
+    std::string lKey;
+    ShoppingManager::buildFareQuoteKey (iBookingRequest, ioTravelSolutionList,
+                                        lKey);
+    SingleFlightGroup& lSingleFlightGroup =
+      lSIMCRS_ServiceContext.getFareQuoteFlightGroup();
+    const SingleFlightGroup::Computation_T lComputation =
+      [this, &iBookingRequest, ioRequestTrace_ptr]
+      (stdair::TravelSolutionList_T& ioList) {
+      quotePrices (iBookingRequest, ioList, ioRequestTrace_ptr);
+    };
+    const bool isCoalesced =
+      lSingleFlightGroup.run (lKey, lComputation, ioTravelSolutionList);
+    if (ioRequestTrace_ptr != NULL) {
+      ioRequestTrace_ptr->_isCoalesced = isCoalesced;
+    }
+
+    SIMCRS_PROBE1 (fare_quote__return, ioTravelSolutionList.size());
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::
+  quotePrices (const stdair::BookingRequestStruct& iBookingRequest,
+               stdair::TravelSolutionList_T& ioTravelSolutionList,
+               RequestTraceStruct* ioRequestTrace_ptr) {
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // The request trace is filled by the command (it is held, per thread,
+    // by the service context)
+    RequestTraceScope
+      lRequestTraceScope (lSIMCRS_ServiceContext.getCurrentRequestTraceRef(),
+                          ioRequestTrace_ptr);
+    
+    // Delegate the action to the dedicated command (which keeps track of
+    // the fare quote work, and relies on the fare quote cache, if enabled)
+    stdair::BasChronometer lFareQuoteRetrievalChronometer;
+    lFareQuoteRetrievalChronometer.start();
+
+    ShoppingManager::quotePrices (lSIMCRS_ServiceContext, iBookingRequest,
+                                  ioTravelSolutionList);
+
+    const double lFareQuoteRetrievalMeasure =
+      lFareQuoteRetrievalChronometer.elapsed();
+
+    // DEBUG
     STDAIR_LOG_DEBUG ("Fare Quote retrieving: " << lFareQuoteRetrievalMeasure
                       << " - " << lSIMCRS_ServiceContext.display());
   }
 
   // ////////////////////////////////////////////////////////////////////
-  void SIMCRS_Service::
-  calculateAvailability (stdair::TravelSolutionList_T& ioTravelSolutionList) {
+  ShoppingResultStruct SIMCRS_Service::
+  shop (const stdair::BookingRequestStruct& iBookingRequest,
+        RequestTraceStruct* ioRequestTrace_ptr) {
+    // No latency budget
+    const stdair::Duration_T lNoLatencyBudget (0, 0, 0);
+    return shop (iBookingRequest, lNoLatencyBudget, ioRequestTrace_ptr);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  ShoppingResultStruct SIMCRS_Service::
+  shop (const stdair::BookingRequestStruct& iBookingRequest,
+        const stdair::Duration_T& iLatencyBudget,
+        RequestTraceStruct* ioRequestTrace_ptr) {
+    SIMCRS_PROBE1 (shop__entry,
+                   static_cast<int> (iBookingRequest.getPartySize()));
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // The memory of the request is given back in one go, at the end
+    RequestArena& lRequestArena = lSIMCRS_ServiceContext.getRequestArena();
+    RequestArenaScope lRequestArenaScope (lRequestArena);
+    // Reset the request trace, if any, and measure the whole request
+    lSIMCRS_ServiceContext.initRequestTrace (ioRequestTrace_ptr);
+    RequestTraceTimer lTotalTimer (ioRequestTrace_ptr,
+                                   RequestTraceStruct::TOTAL);
+    // Record the begin and end events of the request, and count its heap
+    // allocations, if enabled
+    TraceEventRecorder& lTraceEventRecorder =
+      lSIMCRS_ServiceContext.getTraceEventRecorder();
+    TraceEventScope lTraceEventScope (lTraceEventRecorder,
+                                      "shop", "simcrs");
+    AllocationCountScope
+      lAllocationCountScope (lSIMCRS_ServiceContext.getAllocationCounter(),
+                             "shop");
+    RequestTraceScope
+      lRequestTraceScope (lSIMCRS_ServiceContext.getCurrentRequestTraceRef(),
+                          ioRequestTrace_ptr);
+
+    // Delegate the shopping to the dedicated command
+    stdair::BasChronometer lShoppingChronometer;
+    lShoppingChronometer.start();
+
+    ShoppingResultStruct oShoppingResult;
+    ShoppingManager::shop (lSIMCRS_ServiceContext, iBookingRequest,
+                           iLatencyBudget, oShoppingResult);
+
+    // DEBUG
+    const double lShoppingMeasure = lShoppingChronometer.elapsed();
+    STDAIR_LOG_DEBUG ("Shopping (" << oShoppingResult.describe() << "): "
+                      << lShoppingMeasure << " - "
+                      << lSIMCRS_ServiceContext.display());
+
+    SIMCRS_PROBE2 (shop__return,
+                   oShoppingResult.getNbOfTravelSolutions(),
+                   static_cast<int> (oShoppingResult.isTruncated()));
+    return oShoppingResult;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  CalendarResultStruct SIMCRS_Service::
+  shopCalendar (const stdair::BookingRequestStruct& iBookingRequest,
+                const stdair::DatePeriod_T& iDatePeriod,
+                RequestTraceStruct* ioRequestTrace_ptr) {
+    SIMCRS_PROBE2 (shop_calendar__entry,
+                   static_cast<int> (iBookingRequest.getPartySize()),
+                   iDatePeriod.length().days());
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // The memory of the request is given back in one go, at the end
+    RequestArena& lRequestArena = lSIMCRS_ServiceContext.getRequestArena();
+    RequestArenaScope lRequestArenaScope (lRequestArena);
+    // Reset the request trace, if any, and measure the whole request
+    lSIMCRS_ServiceContext.initRequestTrace (ioRequestTrace_ptr);
+    RequestTraceTimer lTotalTimer (ioRequestTrace_ptr,
+                                   RequestTraceStruct::TOTAL);
+    // Record the begin and end events of the request, and count its heap
+    // allocations, if enabled
+    TraceEventRecorder& lTraceEventRecorder =
+      lSIMCRS_ServiceContext.getTraceEventRecorder();
+    TraceEventScope lTraceEventScope (lTraceEventRecorder,
+                                      "shopCalendar", "simcrs");
+    AllocationCountScope
+      lAllocationCountScope (lSIMCRS_ServiceContext.getAllocationCounter(),
+                             "shopCalendar");
+    RequestTraceScope
+      lRequestTraceScope (lSIMCRS_ServiceContext.getCurrentRequestTraceRef(),
+                          ioRequestTrace_ptr);
+
+    // Delegate the calendar shopping to the dedicated command
+    stdair::BasChronometer lShoppingChronometer;
+    lShoppingChronometer.start();
+
+    CalendarResultStruct oCalendarResult;
+    ShoppingManager::shopCalendar (lSIMCRS_ServiceContext, iBookingRequest,
+                                   iDatePeriod, oCalendarResult);
+
+    // DEBUG
+    const double lShoppingMeasure = lShoppingChronometer.elapsed();
+    STDAIR_LOG_DEBUG ("Calendar shopping (" << oCalendarResult.describe()
+                      << "): " << lShoppingMeasure << " - "
+                      << lSIMCRS_ServiceContext.display());
+
+    SIMCRS_PROBE1 (shop_calendar__return,
+                   oCalendarResult.getCalendarEntryList().size());
+    return oCalendarResult;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  NbOfTravelSolutions_T SIMCRS_Service::
+  pruneTravelSolutionList (const stdair::BookingRequestStruct& iBookingRequest,
+                           stdair::TravelSolutionList_T& ioTravelSolutionList) {
+    SIMCRS_PROBE1 (prune_travel_solution_list__entry,
+                   ioTravelSolutionList.size());
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // Record the begin and end events of the request, and count its heap
+    // allocations, if enabled
+    TraceEventRecorder& lTraceEventRecorder =
+      lSIMCRS_ServiceContext.getTraceEventRecorder();
+    TraceEventScope lTraceEventScope (lTraceEventRecorder,
+                                      "pruneTravelSolutionList", "simcrs");
+    AllocationCountScope
+      lAllocationCountScope (lSIMCRS_ServiceContext.getAllocationCounter(),
+                             "pruneTravelSolutionList");
+
+    // Delegate the pruning to the dedicated command
+    RequestArena& lRequestArena = lSIMCRS_ServiceContext.getRequestArena();
+    RequestArenaScope lRequestArenaScope (lRequestArena);
+
+    const NbOfTravelSolutions_T oNbOfPrunedTravelSolutions =
+      ShoppingManager::pruneTravelSolutionList (lSIMCRS_ServiceContext,
+                                                iBookingRequest,
+                                                ioTravelSolutionList);
+
+    // DEBUG
+    STDAIR_LOG_DEBUG ("Availability-first pruning: "
+                      << oNbOfPrunedTravelSolutions
+                      << " travel solutions pruned, "
+                      << ioTravelSolutionList.size() << " left - "
+                      << lSIMCRS_ServiceContext.display());
+
+    SIMCRS_PROBE1 (prune_travel_solution_list__return,
+                   oNbOfPrunedTravelSolutions);
+    return oNbOfPrunedTravelSolutions;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::
+  calculateAvailability (stdair::TravelSolutionList_T& ioTravelSolutionList,
+                         RequestTraceStruct* ioRequestTrace_ptr) {
+    SIMCRS_PROBE1 (calculate_availability__entry,
+                   ioTravelSolutionList.size());
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // Retrieve the CRS code
+    //const CRSCode_T& lCRSCode = lSIMCRS_ServiceContext.getCRSCode();
+
+    // Reset the request trace, if any, and measure the whole request
+    lSIMCRS_ServiceContext.initRequestTrace (ioRequestTrace_ptr);
+    RequestTraceTimer lTotalTimer (ioRequestTrace_ptr,
+                                   RequestTraceStruct::TOTAL);
+    // Record the begin and end events of the request, and count its heap
+    // allocations, if enabled
+    TraceEventRecorder& lTraceEventRecorder =
+      lSIMCRS_ServiceContext.getTraceEventRecorder();
+    TraceEventScope lTraceEventScope (lTraceEventRecorder,
+                                      "calculateAvailability", "simcrs");
+    AllocationCountScope
+      lAllocationCountScope (lSIMCRS_ServiceContext.getAllocationCounter(),
+                             "calculateAvailability");
+    RequestTraceScope
+      lRequestTraceScope (lSIMCRS_ServiceContext.getCurrentRequestTraceRef(),
+                          ioRequestTrace_ptr);
+
+    // Delegate the availability retrieval to the dedicated command
+    // (from AirInv or from the AVS table, depending on the availability mode)
+    stdair::BasChronometer lAvlChronometer;
+    lAvlChronometer.start();
+
+    ShoppingManager::calculateAvailability (lSIMCRS_ServiceContext,
+                                            ioTravelSolutionList);
+    
+    // DEBUG
+    const double lAvlMeasure = lAvlChronometer.elapsed();
+    STDAIR_LOG_DEBUG ("Availability retrieval: " << lAvlMeasure << " - "
+                      << lSIMCRS_ServiceContext.display());
+
+    SIMCRS_PROBE1 (calculate_availability__return,
+                   ioTravelSolutionList.size());
+  }
+  
+  // ////////////////////////////////////////////////////////////////////
+  NbOfTravelSolutions_T SIMCRS_Service::
+  streamTravelSolutions (const stdair::BookingRequestStruct& iBookingRequest,
+                         const TravelSolutionVisitor_T& iVisitor,
+                         RequestTraceStruct* ioRequestTrace_ptr) {
+    SIMCRS_PROBE1 (stream_travel_solutions__entry,
+                   static_cast<int> (iBookingRequest.getPartySize()));
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // The memory of the request is given back in one go, at the end
+    RequestArena& lRequestArena = lSIMCRS_ServiceContext.getRequestArena();
+    NbOfTravelSolutions_T oNbOfTravelSolutions = 0;
+    {
+      RequestArenaScope lRequestArenaScope (lRequestArena);
+
+      // Reset the request trace, if any, and measure the whole request
+      lSIMCRS_ServiceContext.initRequestTrace (ioRequestTrace_ptr);
+      RequestTraceTimer lTotalTimer (ioRequestTrace_ptr,
+                                     RequestTraceStruct::TOTAL);
+      // Record the begin and end events of the request, and count its heap
+      // allocations, if enabled
+      TraceEventRecorder& lTraceEventRecorder =
+        lSIMCRS_ServiceContext.getTraceEventRecorder();
+      TraceEventScope lTraceEventScope (lTraceEventRecorder,
+                                        "streamTravelSolutions", "simcrs");
+      AllocationCountScope
+        lAllocationCountScope (lSIMCRS_ServiceContext.getAllocationCounter(),
+                               "streamTravelSolutions");
+      RequestTraceScope
+        lRequestTraceScope (lSIMCRS_ServiceContext.getCurrentRequestTraceRef(),
+                            ioRequestTrace_ptr);
+
+      // Delegate the streaming to the dedicated command
+      stdair::BasChronometer lStreamingChronometer;
+      lStreamingChronometer.start();
+
+      oNbOfTravelSolutions =
+        ShoppingManager::streamTravelSolutions (lSIMCRS_ServiceContext,
+                                                iBookingRequest, iVisitor);
+
+      // DEBUG
+      const double lStreamingMeasure = lStreamingChronometer.elapsed();
+      STDAIR_LOG_DEBUG ("Travel solution streaming (" << oNbOfTravelSolutions
+                        << " travel solutions): " << lStreamingMeasure
+                        << " - " << lSIMCRS_ServiceContext.display());
+    }
+
+    // DEBUG
+    STDAIR_LOG_DEBUG (lRequestArena.describe());
+
+    SIMCRS_PROBE1 (stream_travel_solutions__return, oNbOfTravelSolutions);
+    return oNbOfTravelSolutions;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  ArenaStatsStruct SIMCRS_Service::getLastRequestArenaStats() const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    const RequestArena& lRequestArena =
+      lSIMCRS_ServiceContext.getRequestArena();
+    return lRequestArena.getLastRequestStats();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::
+  setAvailabilityMode (const AvailabilityMode_T& iAvailabilityMode) {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    lSIMCRS_ServiceContext.setAvailabilityMode (iAvailabilityMode);
+
+    // The AVS table has not been kept up to date so far: (re-)load it
+    // from the segment-dates known by SimCRS
+    if (iAvailabilityMode == AVS_AVAILABILITY) {
+      const SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+      AvailabilityStatusTable& lAvailabilityStatusTable =
+        lSIMCRS_ServiceContext.getAvailabilityStatusTable();
+      AvailabilityStatusManager::pushAll (lSymbolTable,
+                                          lAvailabilityStatusTable);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::
+  setAvailabilityPushInterval (const unsigned int iPushInterval) {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    AvailabilityStatusTable& lAvailabilityStatusTable =
+      lSIMCRS_ServiceContext.getAvailabilityStatusTable();
+    lAvailabilityStatusTable.setPushInterval (iPushInterval);
+
+    // With a shorter interval, the pending pushes may already be due
+    if (lAvailabilityStatusTable.getNbOfPendingChanges()
+        >= lAvailabilityStatusTable.getPushInterval()) {
+      const SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+      AvailabilityStatusManager::flush (lSymbolTable,
+                                        lAvailabilityStatusTable);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::flushAvailabilityStatuses() {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    if (lSIMCRS_ServiceContext.getAvailabilityMode() != AVS_AVAILABILITY) {
+      return;
+    }
+    const SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+    AvailabilityStatusTable& lAvailabilityStatusTable =
+      lSIMCRS_ServiceContext.getAvailabilityStatusTable();
+    AvailabilityStatusManager::flush (lSymbolTable, lAvailabilityStatusTable);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  AvailabilityMode_T SIMCRS_Service::getAvailabilityMode() const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    return lSIMCRS_ServiceContext.getAvailabilityMode();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::
+  setAvailabilityFirstPruning (const bool iAvailabilityFirstPruning) {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    lSIMCRS_ServiceContext.
+      setAvailabilityFirstPruningFlag (iAvailabilityFirstPruning);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  PruningStatsStruct SIMCRS_Service::getPruningStats() const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    std::lock_guard<std::mutex>
+      lStatsGuard (lSIMCRS_ServiceContext.getPruningStatsMutex());
+    return lSIMCRS_ServiceContext.getPruningStats();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::
+  setFareQuoteCacheCapacity (const std::size_t& iCapacity) {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    FareQuoteCache& lFareQuoteCache =
+      lSIMCRS_ServiceContext.getFareQuoteCache();
+    lFareQuoteCache.setCapacity (iCapacity);
+
+    // DEBUG
+    STDAIR_LOG_DEBUG (lFareQuoteCache.describe());
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  FareQuoteCacheStatsStruct SIMCRS_Service::getFareQuoteCacheStats() const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    const FareQuoteCache& lFareQuoteCache =
+      lSIMCRS_ServiceContext.getFareQuoteCache();
+    return lFareQuoteCache.getStats();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::setRequestCoalescing (const bool iRequestCoalescing) {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    lSIMCRS_ServiceContext.setRequestCoalescingFlag (iRequestCoalescing);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  CoalescingStatsStruct SIMCRS_Service::getSegmentPathCoalescingStats() const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    const SingleFlightGroup& lSingleFlightGroup =
+      lSIMCRS_ServiceContext.getSegmentPathFlightGroup();
+    return lSingleFlightGroup.getStats();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  CoalescingStatsStruct SIMCRS_Service::getFareQuoteCoalescingStats() const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    const SingleFlightGroup& lSingleFlightGroup =
+      lSIMCRS_ServiceContext.getFareQuoteFlightGroup();
+    return lSingleFlightGroup.getStats();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::setTraceEventRecording (const bool iIsEnabled) {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    TraceEventRecorder& lTraceEventRecorder =
+      lSIMCRS_ServiceContext.getTraceEventRecorder();
+    lTraceEventRecorder.setEnabled (iIsEnabled);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::
+  setTraceEventFilename (const stdair::Filename_T& iTraceEventFilename) {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    lSIMCRS_ServiceContext.setTraceEventFilename (iTraceEventFilename);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::dumpTraceEvents (std::ostream& oStream) const {
 
     // Retrieve the SimCRS service context
     if (_simcrsServiceContext == NULL) {
@@ -811,33 +2259,142 @@ namespace SIMCRS {
                                                     "not been initialised");
     }
     assert (_simcrsServiceContext != NULL);
-    
+
     SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    const TraceEventRecorder& lTraceEventRecorder =
+      lSIMCRS_ServiceContext.getTraceEventRecorder();
+    lTraceEventRecorder.dump (oStream);
+  }
 
-    // Retrieve the CRS code
-    //const CRSCode_T& lCRSCode = lSIMCRS_ServiceContext.getCRSCode();
+  // ////////////////////////////////////////////////////////////////////
+  std::size_t SIMCRS_Service::getNbOfTraceEvents() const {
 
-    // Retrieve the AIRINV Master service.
-    AIRINV::AIRINV_Master_Service& lAIRINV_Master_Service =
-      lSIMCRS_ServiceContext.getAIRINV_Service();
-    
-    // Delegate the availability retrieval to the dedicated command
-    stdair::BasChronometer lAvlChronometer;
-    lAvlChronometer.start();
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
 
-    DistributionManager::calculateAvailability (lAIRINV_Master_Service,
-                                                ioTravelSolutionList);
-    
-    // DEBUG
-    const double lAvlMeasure = lAvlChronometer.elapsed();
-    STDAIR_LOG_DEBUG ("Availability retrieval: " << lAvlMeasure << " - "
-                      << lSIMCRS_ServiceContext.display());
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    const TraceEventRecorder& lTraceEventRecorder =
+      lSIMCRS_ServiceContext.getTraceEventRecorder();
+    return lTraceEventRecorder.getNbOfEvents();
   }
-  
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::clearTraceEvents() {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    TraceEventRecorder& lTraceEventRecorder =
+      lSIMCRS_ServiceContext.getTraceEventRecorder();
+    lTraceEventRecorder.clear();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::setAllocationCounting (const bool iIsEnabled) {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    AllocationCounter& lAllocationCounter =
+      lSIMCRS_ServiceContext.getAllocationCounter();
+    lAllocationCounter.setEnabled (iIsEnabled);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool SIMCRS_Service::isAllocationCountingSupported() const {
+    return AllocationCounter::isHookCompiledIn();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  AllocationStatsList_T SIMCRS_Service::getAllocationStats() const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    const AllocationCounter& lAllocationCounter =
+      lSIMCRS_ServiceContext.getAllocationCounter();
+    return lAllocationCounter.getStats();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::clearAllocationStats() {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    AllocationCounter& lAllocationCounter =
+      lSIMCRS_ServiceContext.getAllocationCounter();
+    lAllocationCounter.clear();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  MemoryReportStruct SIMCRS_Service::memoryReport() const {
+    MemoryReportStruct oMemoryReport;
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service has "
+                                                    "not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lSIMCRS_ServiceContext.getSTDAIR_Service();
+
+    // Walk the persistent and working BOM trees (the latter being
+    // skipped when it is not distinct from the former)
+    const stdair::BomRoot& lPersistentBomRoot =
+      lSTDAIR_Service.getPersistentBomRoot();
+    MemoryReportManager::reportBomTree (lPersistentBomRoot, "persistent",
+                                        oMemoryReport);
+    const stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
+    if (&lBomRoot != &lPersistentBomRoot) {
+      MemoryReportManager::reportBomTree (lBomRoot, "working", oMemoryReport);
+    }
+
+    // SimCRS structures
+    MemoryReportManager::
+      reportSimCRSStructures (lSIMCRS_ServiceContext.getSymbolTable(),
+                              lSIMCRS_ServiceContext.
+                              getAvailabilityStatusTable(),
+                              lSIMCRS_ServiceContext.getFareQuoteCache(),
+                              lSIMCRS_ServiceContext.getRequestArena(),
+                              oMemoryReport);
+
+    return oMemoryReport;
+  }
+
   // ////////////////////////////////////////////////////////////////////
   bool SIMCRS_Service::
   sell (const stdair::TravelSolutionStruct& iTravelSolution,
-        const stdair::PartySize_T& iPartySize) {
+        const stdair::PartySize_T& iPartySize,
+        RequestTraceStruct* ioRequestTrace_ptr) {
+    SIMCRS_PROBE1 (sell__entry, static_cast<int> (iPartySize));
     bool hasSaleBeenSuccessful = false;
 
     // Retrieve the SimCRS service context
@@ -856,13 +2413,59 @@ namespace SIMCRS {
     AIRINV::AIRINV_Master_Service& lAIRINV_Master_Service =
       lSIMCRS_ServiceContext.getAIRINV_Service();
     
+    // Reset the request trace, if any, and measure the whole request
+    lSIMCRS_ServiceContext.initRequestTrace (ioRequestTrace_ptr);
+    RequestTraceTimer lTotalTimer (ioRequestTrace_ptr,
+                                   RequestTraceStruct::TOTAL);
+    // Record the begin and end events of the request, and count its heap
+    // allocations, if enabled
+    TraceEventRecorder& lTraceEventRecorder =
+      lSIMCRS_ServiceContext.getTraceEventRecorder();
+    TraceEventScope lTraceEventScope (lTraceEventRecorder,
+                                      "sell", "simcrs");
+    AllocationCountScope
+      lAllocationCountScope (lSIMCRS_ServiceContext.getAllocationCounter(),
+                             "sell");
+
     // Delegate the booking to the dedicated command
     stdair::BasChronometer lSellChronometer;
     lSellChronometer.start();
 
-    hasSaleBeenSuccessful = DistributionManager::sell (lAIRINV_Master_Service,
-                                                       iTravelSolution,
-                                                       iPartySize);
+    // Retrieve the (working) BOM tree and the table of the interned codes
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lSIMCRS_ServiceContext.getSTDAIR_Service();
+    const stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
+    SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+
+    // The flight-dates may have been closed to sale by a schedule change
+    const DeltaOverlay& lDeltaOverlay =
+      lSIMCRS_ServiceContext.getDeltaOverlay();
+    if (DeltaManager::isOpen (lBomRoot, lSymbolTable, lDeltaOverlay,
+                              iTravelSolution.getSegmentPath()) == false) {
+      STDAIR_LOG_DEBUG ("The travel solution " << iTravelSolution.describe()
+                        << " goes through flight-dates closed to sale");
+      SIMCRS_PROBE2 (sell__return, static_cast<int> (iPartySize), 0);
+      return false;
+    }
+
+    {
+      RequestTraceTimer lSellTimer (ioRequestTrace_ptr,
+                                    RequestTraceStruct::SELL);
+      TraceEventScope lSellEventScope (lTraceEventRecorder,
+                                       "DistributionManager::sell", "airinv");
+      hasSaleBeenSuccessful =
+        DistributionManager::sell (lAIRINV_Master_Service, lSymbolTable,
+                                   lBomRoot, iTravelSolution, iPartySize);
+    }
+
+    // Record the sale into the booking journal, if open
+    if (hasSaleBeenSuccessful == true) {
+      JournalManager::journalSell (lSIMCRS_ServiceContext.getBookingJournal(),
+                                   iTravelSolution, iPartySize);
+    }
+
+    // Push the new availability into the AVS table, if needed
+    pushAvailabilityStatuses (iTravelSolution.getSegmentPath());
 
     // DEBUG
     STDAIR_LOG_DEBUG ("Made a sell of " << iPartySize
@@ -877,6 +2480,8 @@ namespace SIMCRS {
     STDAIR_LOG_DEBUG ("Booking sell: " << lSellMeasure << " - "
                       << lSIMCRS_ServiceContext.display());
 
+    SIMCRS_PROBE2 (sell__return, static_cast<int> (iPartySize),
+                   static_cast<int> (hasSaleBeenSuccessful));
     return hasSaleBeenSuccessful;
   }
 
@@ -884,6 +2489,8 @@ namespace SIMCRS {
   // ////////////////////////////////////////////////////////////////////
   bool SIMCRS_Service::
   playCancellation (const stdair::CancellationStruct& iCancellation) {
+    SIMCRS_PROBE1 (cancel__entry,
+                   static_cast<int> (iCancellation.getPartySize()));
     bool hasCancellationBeenSuccessful = false;
 
     // Retrieve the SimCRS service context
@@ -898,6 +2505,11 @@ namespace SIMCRS {
     // Retrieve the CRS code
     //const CRSCode_T& lCRSCode = lSIMCRS_ServiceContext.getCRSCode();
 
+    // Count the heap allocations of the cancellation, if enabled
+    AllocationCountScope
+      lAllocationCountScope (lSIMCRS_ServiceContext.getAllocationCounter(),
+                             "playCancellation");
+
     // Retrieve the AIRINV Master service.
     AIRINV::AIRINV_Master_Service& lAIRINV_Master_Service =
       lSIMCRS_ServiceContext.getAIRINV_Service();
@@ -909,6 +2521,16 @@ namespace SIMCRS {
     hasCancellationBeenSuccessful =
       DistributionManager::playCancellation (lAIRINV_Master_Service,
                                              iCancellation);
+
+    // Record the cancellation into the booking journal, if open
+    if (hasCancellationBeenSuccessful == true) {
+      JournalManager::
+        journalCancellation (lSIMCRS_ServiceContext.getBookingJournal(),
+                             iCancellation);
+    }
+
+    // Push the new availability into the AVS table, if needed
+    pushAvailabilityStatuses (iCancellation.getSegmentPath());
                                              
     // DEBUG
     STDAIR_LOG_DEBUG ("Made a cancellation of " << iCancellation.describe());
@@ -918,11 +2540,254 @@ namespace SIMCRS {
     STDAIR_LOG_DEBUG ("Booking cancellation: " << lCancellationMeasure << " - "
                       << lSIMCRS_ServiceContext.display());
 
+    SIMCRS_PROBE2 (cancel__return,
+                   static_cast<int> (iCancellation.getPartySize()),
+                   static_cast<int> (hasCancellationBeenSuccessful));
     return hasCancellationBeenSuccessful;
   }
   
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::
+  openBookingJournal (const stdair::Filename_T& iJournalFilename,
+                      const unsigned int iCommitInterval) {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    BookingJournal& lBookingJournal =
+      lSIMCRS_ServiceContext.getBookingJournal();
+    lBookingJournal.open (iJournalFilename, iCommitInterval);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::
+  openBookingJournal (const stdair::Filename_T& iJournalFilename) {
+    openBookingJournal (iJournalFilename, DEFAULT_JOURNAL_COMMIT_INTERVAL);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::flushBookingJournal() {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    BookingJournal& lBookingJournal =
+      lSIMCRS_ServiceContext.getBookingJournal();
+    lBookingJournal.flush();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::closeBookingJournal() {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    BookingJournal& lBookingJournal =
+      lSIMCRS_ServiceContext.getBookingJournal();
+    lBookingJournal.close();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  JournalStatsStruct SIMCRS_Service::getBookingJournalStats() const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    const SIMCRS_ServiceContext& lSIMCRS_ServiceContext =
+      *_simcrsServiceContext;
+
+    const BookingJournal& lBookingJournal =
+      lSIMCRS_ServiceContext.getBookingJournal();
+    return lBookingJournal.getStats();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  JournalReplayStatsStruct SIMCRS_Service::
+  replayBookingJournal (const stdair::Filename_T& iJournalFilename) {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // Retrieve the AIRINV Master service, the (working) BOM tree and the
+    // table of the interned codes
+    AIRINV::AIRINV_Master_Service& lAIRINV_Master_Service =
+      lSIMCRS_ServiceContext.getAIRINV_Service();
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lSIMCRS_ServiceContext.getSTDAIR_Service();
+    const stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
+    SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+
+    // Delegate the replay to the dedicated command
+    const JournalReplayStatsStruct oReplayStats =
+      JournalManager::replay (iJournalFilename, lAIRINV_Master_Service,
+                              lBomRoot, lSymbolTable);
+
+    // Push the new availability into the AVS table, if needed
+    if (lSIMCRS_ServiceContext.getAvailabilityMode() == AVS_AVAILABILITY) {
+      AvailabilityStatusTable& lAvailabilityStatusTable =
+        lSIMCRS_ServiceContext.getAvailabilityStatusTable();
+      AvailabilityStatusManager::pushAll (lSymbolTable,
+                                          lAvailabilityStatusTable);
+    }
+
+    STDAIR_LOG_DEBUG ("Replayed " << oReplayStats._nbOfAppliedRecords
+                      << " out of " << oReplayStats._nbOfRecords
+                      << " records of the booking journal '"
+                      << iJournalFilename << "'");
+    return oReplayStats;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  CheckpointStatsStruct SIMCRS_Service::
+  checkpoint (const stdair::Filename_T& iCheckpointFilename) const {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    const SIMCRS_ServiceContext& lSIMCRS_ServiceContext =
+      *_simcrsServiceContext;
+
+    // Retrieve the (working) BOM tree
+    const stdair::STDAIR_Service& lSTDAIR_Service =
+      lSIMCRS_ServiceContext.getSTDAIR_Service();
+    const stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
+
+    // Delegate the checkpoint to the dedicated command
+    const CheckpointStatsStruct oCheckpointStats =
+      CheckpointManager::checkpoint (iCheckpointFilename, lBomRoot);
+
+    STDAIR_LOG_DEBUG ("Checkpointed " << oCheckpointStats._nbOfBookingClasses
+                      << " booking classes of "
+                      << oCheckpointStats._nbOfSegmentDates
+                      << " segment-dates and "
+                      << oCheckpointStats._nbOfLegCabins
+                      << " leg-cabins into '" << iCheckpointFilename
+                      << "' (" << oCheckpointStats._nbOfBytes << " bytes, "
+                      << oCheckpointStats._elapsedTime << " s)");
+    return oCheckpointStats;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  CheckpointStatsStruct SIMCRS_Service::
+  restore (const stdair::Filename_T& iCheckpointFilename) {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // Retrieve the (working) BOM tree
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lSIMCRS_ServiceContext.getSTDAIR_Service();
+    const stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
+
+    // Delegate the restore to the dedicated command
+    const CheckpointStatsStruct oRestoreStats =
+      CheckpointManager::restore (iCheckpointFilename, lBomRoot);
+
+    // The schedule and fare changes were not checkpointed, and the fare
+    // quote results may depend on the former availability
+    lSIMCRS_ServiceContext.getDeltaOverlay().clear();
+    lSIMCRS_ServiceContext.getFareQuoteCache().clear();
+
+    // Push the restored availability into the AVS table, if needed
+    if (lSIMCRS_ServiceContext.getAvailabilityMode() == AVS_AVAILABILITY) {
+      SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+      AvailabilityStatusTable& lAvailabilityStatusTable =
+        lSIMCRS_ServiceContext.getAvailabilityStatusTable();
+      AvailabilityStatusManager::pushAll (lSymbolTable,
+                                          lAvailabilityStatusTable);
+    }
+
+    STDAIR_LOG_DEBUG ("Restored " << oRestoreStats._nbOfBookingClasses
+                      << " booking classes of "
+                      << oRestoreStats._nbOfSegmentDates
+                      << " segment-dates and "
+                      << oRestoreStats._nbOfLegCabins
+                      << " leg-cabins from '" << iCheckpointFilename
+                      << "' (" << oRestoreStats._nbOfFailedBookingClasses
+                      << " failed, " << oRestoreStats._elapsedTime << " s)");
+    return oRestoreStats;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  WhatIfResultList_T SIMCRS_Service::
+  runWhatIfBranches (const WhatIfVariantList_T& iVariantList,
+                     const unsigned int iMaxNbOfConcurrentBranches) {
+
+    // Retrieve the SimCRS service context
+    if (_simcrsServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The SimCRS service "
+                                                    "has not been initialised");
+    }
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // Commit the records of the booking journal, and stop its writer
+    // while branching, so that the children are not forked in the
+    // middle of a commit
+    BookingJournal& lBookingJournal =
+      lSIMCRS_ServiceContext.getBookingJournal();
+    lBookingJournal.flush();
+    lBookingJournal.suspendWriter();
+
+    unsigned int lMaxNbOfConcurrentBranches = iMaxNbOfConcurrentBranches;
+    if (lMaxNbOfConcurrentBranches == 0) {
+      lMaxNbOfConcurrentBranches =
+        std::max (1U, std::thread::hardware_concurrency());
+    }
+
+    // Delegate the branching to the dedicated command
+    WhatIfResultList_T oResultList;
+    try {
+      oResultList =
+        BranchManager::runBranches (*this, lSIMCRS_ServiceContext,
+                                    iVariantList, lMaxNbOfConcurrentBranches);
+
+    } catch (...) {
+      lBookingJournal.resumeWriter();
+      throw;
+    }
+    lBookingJournal.resumeWriter();
+
+    STDAIR_LOG_DEBUG ("Ran " << oResultList.size()
+                      << " what-if branch(es), at most "
+                      << lMaxNbOfConcurrentBranches << " at a time");
+    return oResultList;
+  }
+
   // ////////////////////////////////////////////////////////////////////
   void SIMCRS_Service::takeSnapshots (const stdair::SnapshotStruct& iSnapshot) {
+    SIMCRS_PROBE0 (take_snapshots__entry);
 
     // Retrieve the SimCRS service context
     if (_simcrsServiceContext == NULL) {
@@ -937,11 +2802,14 @@ namespace SIMCRS {
       lSIMCRS_ServiceContext.getAIRINV_Service();
 
     lAIRINV_Master_Service.takeSnapshots (iSnapshot);
+
+    SIMCRS_PROBE0 (take_snapshots__return);
   }
 
   // ////////////////////////////////////////////////////////////////////
   void SIMCRS_Service::
   optimise (const stdair::RMEventStruct& iRMEvent) {
+    SIMCRS_PROBE0 (optimise__entry);
 
     // Retrieve the SimCRS service context
     if (_simcrsServiceContext == NULL) {
@@ -956,5 +2824,40 @@ namespace SIMCRS {
       lSIMCRS_ServiceContext.getAIRINV_Service();
 
     lAIRINV_Master_Service.optimise (iRMEvent);
+
+    // The optimisation may have changed the availability of any booking
+    // class: push the whole AVS table again (at once or with the next
+    // batch), if needed
+    if (lSIMCRS_ServiceContext.getAvailabilityMode() == AVS_AVAILABILITY) {
+      const SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+      AvailabilityStatusTable& lAvailabilityStatusTable =
+        lSIMCRS_ServiceContext.getAvailabilityStatusTable();
+      AvailabilityStatusManager::notifyAll (lSymbolTable,
+                                            lAvailabilityStatusTable);
+    }
+
+    SIMCRS_PROBE0 (optimise__return);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SIMCRS_Service::
+  pushAvailabilityStatuses (const stdair::KeyList_T& iSegmentPath) {
+    assert (_simcrsServiceContext != NULL);
+    SIMCRS_ServiceContext& lSIMCRS_ServiceContext = *_simcrsServiceContext;
+
+    // Nothing to be done with seamless availability
+    if (lSIMCRS_ServiceContext.getAvailabilityMode() != AVS_AVAILABILITY) {
+      return;
+    }
+
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lSIMCRS_ServiceContext.getSTDAIR_Service();
+    const stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
+    SymbolTable& lSymbolTable = lSIMCRS_ServiceContext.getSymbolTable();
+    AvailabilityStatusTable& lAvailabilityStatusTable =
+      lSIMCRS_ServiceContext.getAvailabilityStatusTable();
+    AvailabilityStatusManager::notifySegmentPath (lBomRoot, lSymbolTable,
+                                                  lAvailabilityStatusTable,
+                                                  iSegmentPath);
   }
 }
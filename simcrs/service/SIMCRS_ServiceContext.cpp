@@ -3,6 +3,9 @@
 // //////////////////////////////////////////////////////////////////////
 // STL
 #include <cassert>
+#include <algorithm>
+#include <cstdio>
+#include <ostream>
 // Standard Airline Object Model
 #include <stdair/STDAIR_Service.hpp>
 #include <stdair/service/Logger.hpp>
@@ -12,20 +15,43 @@
 
 namespace SIMCRS {
 
+  // //////////////////////////////////////////////////////////////////////
+  thread_local RequestTraceStruct*
+  SIMCRS_ServiceContext::_currentRequestTrace = NULL;
+
+  // //////////////////////////////////////////////////////////////////////
+  thread_local RequestArena SIMCRS_ServiceContext::_requestArena;
+
   // //////////////////////////////////////////////////////////////////////
   SIMCRS_ServiceContext::SIMCRS_ServiceContext ()
-    : _ownStdairService (false), _ownSEVMGRService (true),
-      _CRSCode (DEFAULT_CRS_CODE) {
+    : _ownStdairService (false), _logStream_ptr (NULL),
+      _ownSEVMGRService (true),
+      _CRSCode (DEFAULT_CRS_CODE), _availabilityFirstPruning (false),
+      _availabilityMode (SEAMLESS_AVAILABILITY), _requestCoalescing (false),
+      _segmentPathFlightGroup (_computationMutex),
+      _fareQuoteFlightGroup (_computationMutex), _fareVersion (0),
+      _lastRequestID (0) {
   }
 
   // //////////////////////////////////////////////////////////////////////
   SIMCRS_ServiceContext::SIMCRS_ServiceContext (const SIMCRS_ServiceContext&)
-    : _ownStdairService (false), _ownSEVMGRService (true) {
+    : _ownStdairService (false), _logStream_ptr (NULL),
+      _ownSEVMGRService (true),
+      _availabilityFirstPruning (false),
+      _availabilityMode (SEAMLESS_AVAILABILITY), _requestCoalescing (false),
+      _segmentPathFlightGroup (_computationMutex),
+      _fareQuoteFlightGroup (_computationMutex), _fareVersion (0),
+      _lastRequestID (0) {
   }
 
   // //////////////////////////////////////////////////////////////////////
   SIMCRS_ServiceContext::SIMCRS_ServiceContext (const CRSCode_T& iCRSCode)
-    : _ownSEVMGRService (true),_CRSCode (iCRSCode) {
+    : _logStream_ptr (NULL), _ownSEVMGRService (true),_CRSCode (iCRSCode),
+      _availabilityFirstPruning (false),
+      _availabilityMode (SEAMLESS_AVAILABILITY), _requestCoalescing (false),
+      _segmentPathFlightGroup (_computationMutex),
+      _fareQuoteFlightGroup (_computationMutex), _fareVersion (0),
+      _lastRequestID (0) {
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -73,6 +99,124 @@ namespace SIMCRS {
 
     // Reset the SEvMgr shared pointer
     _sevmgrService.reset();
+
+    // Delete the StdAir services of the published fares which have been
+    // retired (the SimFQT service above, if no longer referenced, has just
+    // retired its own). The ones still referenced by a reader are left
+    // alone: they are retired, and deleted, by a later reset, if any.
+    // As the destruction of a StdAir service cleans all the BOM objects,
+    // that is done only when the StdAir service is owned (otherwise, its
+    // BOM objects are still in use, and those StdAir services are given
+    // up until the end of the process)
+    std::vector<stdair::STDAIR_Service*> lRetiredSTDAIR_ServiceList;
+    {
+      std::lock_guard<std::mutex> lGuard (_fareSTDAIR_ServiceMutex);
+      lRetiredSTDAIR_ServiceList.swap (_retiredFareSTDAIR_ServiceList);
+    }
+    if (_ownStdairService == true) {
+      for (std::vector<stdair::STDAIR_Service*>::iterator itService =
+             lRetiredSTDAIR_ServiceList.begin();
+           itService != lRetiredSTDAIR_ServiceList.end(); ++itService) {
+        delete *itService;
+      }
+    }
+
+    // Forget the interned codes, as the BOM objects are no longer valid
+    _symbolTable.clear();
+
+    // Give the memory blocks of the request arena (of the calling thread)
+    // back to the system
+    _requestArena.clear();
+
+    // The availability statuses refer to the interned codes
+    _availabilityStatusTable.clear();
+
+    // The fares may no longer be the same
+    _fareQuoteCache.clear();
+
+    // The closed flight-dates refer to the BOM objects
+    _deltaOverlay.clear();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  stdair::STDAIR_ServicePtr_T SIMCRS_ServiceContext::
+  addFareSTDAIR_Service (stdair::STDAIR_Service* ioSTDAIR_Service_ptr) {
+    assert (ioSTDAIR_Service_ptr != NULL);
+    {
+      std::lock_guard<std::mutex> lGuard (_fareSTDAIR_ServiceMutex);
+      _fareSTDAIR_ServiceList.push_back (ioSTDAIR_Service_ptr);
+    }
+    return stdair::STDAIR_ServicePtr_T (ioSTDAIR_Service_ptr,
+                                        FareSTDAIR_ServiceRetirer (*this));
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SIMCRS_ServiceContext::
+  retireFareSTDAIR_Service (stdair::STDAIR_Service* ioSTDAIR_Service_ptr) {
+    std::lock_guard<std::mutex> lGuard (_fareSTDAIR_ServiceMutex);
+    std::vector<stdair::STDAIR_Service*>::iterator itService =
+      std::find (_fareSTDAIR_ServiceList.begin(),
+                 _fareSTDAIR_ServiceList.end(), ioSTDAIR_Service_ptr);
+    if (itService != _fareSTDAIR_ServiceList.end()) {
+      _fareSTDAIR_ServiceList.erase (itService);
+    }
+    _retiredFareSTDAIR_ServiceList.push_back (ioSTDAIR_Service_ptr);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SIMCRS_ServiceContext::FareSTDAIR_ServiceRetirer::
+  operator() (stdair::STDAIR_Service* ioSTDAIR_Service_ptr) const {
+    assert (_context_ptr != NULL);
+    _context_ptr->retireFareSTDAIR_Service (ioSTDAIR_Service_ptr);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SIMCRS_ServiceContext::lockBeforeFork() {
+    // The computations record trace events and count allocations: their
+    // mutex is taken first
+    _computationMutex.lock();
+    _farePublicationMutex.lock();
+    _segmentPathFlightGroup.lockBeforeFork();
+    _fareQuoteFlightGroup.lockBeforeFork();
+    _traceEventRecorder.lockBeforeFork();
+    _allocationCounter.lockBeforeFork();
+    _bookingJournal.lockBeforeFork();
+
+    // The logger is not used concurrently with the computations: once
+    // their mutex is held, what has been logged so far can be flushed
+    flushLogStream();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SIMCRS_ServiceContext::unlockAfterFork() {
+    _bookingJournal.unlockAfterFork();
+    _allocationCounter.unlockAfterFork();
+    _traceEventRecorder.unlockAfterFork();
+    _fareQuoteFlightGroup.unlockAfterFork();
+    _segmentPathFlightGroup.unlockAfterFork();
+    _farePublicationMutex.unlock();
+    _computationMutex.unlock();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SIMCRS_ServiceContext::resetAfterFork() {
+    // The locks have been taken, when forking, by the thread which the
+    // child is a copy of
+    _bookingJournal.detachAfterFork();
+    _allocationCounter.unlockAfterFork();
+    _traceEventRecorder.unlockAfterFork();
+    _fareQuoteFlightGroup.resetAfterFork();
+    _segmentPathFlightGroup.resetAfterFork();
+    _farePublicationMutex.unlock();
+    _computationMutex.unlock();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SIMCRS_ServiceContext::flushLogStream() {
+    if (_logStream_ptr != NULL) {
+      _logStream_ptr->flush();
+    }
+    std::fflush (NULL);
   }
 
 }
@@ -5,8 +5,12 @@
 // Import section
 // //////////////////////////////////////////////////////////////////////
 // STL
+#include <atomic>
+#include <iosfwd>
+#include <mutex>
 #include <string>
 #include <map>
+#include <vector>
 // Boost
 #include <boost/shared_ptr.hpp>
 // StdAir
@@ -22,6 +26,16 @@
 #include <simfqt/SIMFQT_Types.hpp>
 // SimCRS
 #include <simcrs/SIMCRS_Types.hpp>
+#include <simcrs/bom/SymbolTable.hpp>
+#include <simcrs/bom/RequestArena.hpp>
+#include <simcrs/bom/AvailabilityStatusTable.hpp>
+#include <simcrs/bom/FareQuoteCache.hpp>
+#include <simcrs/bom/SingleFlightGroup.hpp>
+#include <simcrs/bom/TraceEventRecorder.hpp>
+#include <simcrs/bom/AllocationCounter.hpp>
+#include <simcrs/bom/DeltaOverlay.hpp>
+#include <simcrs/bom/BookingJournal.hpp>
+#include <simcrs/SIMCRS_RequestTrace.hpp>
 #include <simcrs/service/ServiceAbstract.hpp>
 
 namespace SIMCRS {
@@ -37,6 +51,8 @@ namespace SIMCRS {
      */
     friend class SIMCRS_Service;
     friend class FacSimcrsServiceContext;
+    friend class ShoppingManager;
+    friend class BranchManager;
     
   private:
     // ///////////////// Getters ///////////////////
@@ -111,12 +127,198 @@ namespace SIMCRS {
 
     /**
      * Get the SimFQT service handler.
+     *
+     * \note The reference is valid only as long as that SimFQT service
+     *       is not replaced (see publishSIMFQT_Service()). The
+     *       concurrent readers take a reference on the pointer instead
+     *       (see getSIMFQT_ServicePtr()).
      */
     SIMFQT::SIMFQT_Service& getSIMFQT_Service() const {
       assert (_simfqtService != NULL);
       return *_simfqtService;
     }
 
+    /**
+     * Get the (smart) pointer on the current SimFQT service handler.
+     * The pointer is read atomically, and keeps the SimFQT service
+     * alive, even when another one is published meanwhile.
+     */
+    SIMFQT::SIMFQT_ServicePtr_T getSIMFQT_ServicePtr() const {
+      return boost::atomic_load (&_simfqtService);
+    }
+
+    /**
+     * Get the version of the fares, i.e., the number of SimFQT services
+     * published since the initialisation.
+     */
+    FareVersion_T getFareVersion() const {
+      return _fareVersion.load();
+    }
+
+    /**
+     * Get the mutex serialising the publications of the fares.
+     */
+    std::mutex& getFarePublicationMutex() {
+      return _farePublicationMutex;
+    }
+
+    /**
+     * Get the mutex serialising the computations of the (coalesced)
+     * requests. The publications of the fares take it as well, as the
+     * (StdAir) logger and BOM factories are not synchronised.
+     */
+    std::mutex& getComputationMutex() {
+      return _computationMutex;
+    }
+
+    /**
+     * Get the table of the interned codes.
+     */
+    SymbolTable& getSymbolTable() {
+      return _symbolTable;
+    }
+
+    /**
+     * Get the memory arena of the (shopping) requests served by the
+     * calling thread.
+     */
+    RequestArena& getRequestArena() {
+      return _requestArena;
+    }
+
+    /**
+     * State whether the travel solutions which cannot be sold are
+     * discarded before being fare-quoted.
+     */
+    bool getAvailabilityFirstPruningFlag() const {
+      return _availabilityFirstPruning;
+    }
+
+    /**
+     * Get the (cumulated) statistics of the availability-first pruning.
+     */
+    PruningStatsStruct& getPruningStats() {
+      return _pruningStats;
+    }
+
+    /**
+     * Get the mutex guarding the statistics of the availability-first
+     * pruning, which are updated by the concurrent requests.
+     */
+    std::mutex& getPruningStatsMutex() {
+      return _pruningStatsMutex;
+    }
+
+    /**
+     * Get the way the availability is calculated (seamless or AVS).
+     */
+    const AvailabilityMode_T& getAvailabilityMode() const {
+      return _availabilityMode;
+    }
+
+    /**
+     * Get the availability status (AVS) table.
+     */
+    AvailabilityStatusTable& getAvailabilityStatusTable() {
+      return _availabilityStatusTable;
+    }
+
+    /**
+     * Get the cache of the fare quote results.
+     */
+    FareQuoteCache& getFareQuoteCache() {
+      return _fareQuoteCache;
+    }
+
+    /**
+     * State whether the identical concurrent requests are coalesced.
+     */
+    bool getRequestCoalescingFlag() const {
+      return _requestCoalescing.load();
+    }
+
+    /**
+     * Get the single-flight group of the segment path requests.
+     */
+    SingleFlightGroup& getSegmentPathFlightGroup() {
+      return _segmentPathFlightGroup;
+    }
+
+    /**
+     * Get the single-flight group of the fare quote requests.
+     */
+    SingleFlightGroup& getFareQuoteFlightGroup() {
+      return _fareQuoteFlightGroup;
+    }
+
+    /**
+     * Get the trace of the request being served by the calling thread,
+     * if any (NULL otherwise).
+     */
+    RequestTraceStruct* getCurrentRequestTrace() const {
+      return _currentRequestTrace;
+    }
+
+    /**
+     * Get the (reference on the) trace of the request being served by
+     * the calling thread, so that it may be set for the duration of the
+     * request.
+     */
+    RequestTraceStruct*& getCurrentRequestTraceRef() {
+      return _currentRequestTrace;
+    }
+
+    /**
+     * Get the recorder of the trace events.
+     */
+    TraceEventRecorder& getTraceEventRecorder() {
+      return _traceEventRecorder;
+    }
+
+    /**
+     * Get the name of the file the trace events are dumped into, when
+     * the service is finalised (empty when they are not dumped).
+     */
+    const stdair::Filename_T& getTraceEventFilename() const {
+      return _traceEventFilename;
+    }
+
+    /**
+     * Get the counter of the heap allocations of the operations.
+     */
+    AllocationCounter& getAllocationCounter() {
+      return _allocationCounter;
+    }
+
+    /**
+     * Get the schedule and fare changes applied on top of the BOM trees.
+     */
+    DeltaOverlay& getDeltaOverlay() {
+      return _deltaOverlay;
+    }
+
+    /**
+     * Get the journal of the sells and cancellations.
+     */
+    BookingJournal& getBookingJournal() {
+      return _bookingJournal;
+    }
+
+    /**
+     * Get the journal of the sells and cancellations.
+     */
+    const BookingJournal& getBookingJournal() const {
+      return _bookingJournal;
+    }
+
+    /**
+     * Get the log stream of the owned StdAir service (NULL when the
+     * StdAir service is not owned).
+     */
+    std::ostream* getLogStream() const {
+      return _logStream_ptr;
+    }
+
 
   private:
     // ///////////////// Setters ///////////////////
@@ -163,8 +365,132 @@ namespace SIMCRS {
      * Set the pointer on the SimFQT service handler.
      */
     void setSIMFQT_Service (SIMFQT::SIMFQT_ServicePtr_T ioServicePtr) {
-      _simfqtService = ioServicePtr;
+      boost::atomic_store (&_simfqtService, ioServicePtr);
+    }
+
+    /**
+     * Replace, atomically, the SimFQT service handler, and increment the
+     * version of the fares. The former SimFQT service is released as
+     * soon as the last reader drops its reference on it.
+     *
+     * The version is incremented after the pointer has been replaced:
+     * a reader reading the version before the pointer (see
+     * ShoppingManager::quotePrices()) can therefore not see the new
+     * version along with the former SimFQT service.
+     */
+    void publishSIMFQT_Service (SIMFQT::SIMFQT_ServicePtr_T ioServicePtr) {
+      boost::atomic_store (&_simfqtService, ioServicePtr);
+      ++_fareVersion;
+    }
+
+    /**
+     * Keep track of the given StdAir service, built for published fares
+     * (see SIMCRS_Service::publishFares()), and hand it over through a
+     * (smart) pointer, the deleter of which retires that StdAir service
+     * once the last SimFQT service using it has been released.
+     */
+    stdair::STDAIR_ServicePtr_T
+    addFareSTDAIR_Service (stdair::STDAIR_Service* ioSTDAIR_Service_ptr);
+
+    /**
+     * Retire the given StdAir service of published fares: it is no
+     * longer used, and is deleted when the context is reset.
+     */
+    void
+    retireFareSTDAIR_Service (stdair::STDAIR_Service* ioSTDAIR_Service_ptr);
+
+    /**
+     * Deleter of the (smart) pointers on the StdAir services of the
+     * published fares: it retires the StdAir service, rather than
+     * deleting it (see addFareSTDAIR_Service()).
+     */
+    struct FareSTDAIR_ServiceRetirer {
+      /** Constructor. */
+      FareSTDAIR_ServiceRetirer (SIMCRS_ServiceContext& ioContext)
+        : _context_ptr (&ioContext) {
+      }
+      /** Retire the given StdAir service. */
+      void operator() (stdair::STDAIR_Service* ioSTDAIR_Service_ptr) const;
+      /** Context keeping track of the StdAir service. */
+      SIMCRS_ServiceContext* _context_ptr;
+    };
+
+    /**
+     * Set whether the travel solutions which cannot be sold are
+     * discarded before being fare-quoted.
+     */
+    void setAvailabilityFirstPruningFlag (const bool iAvailabilityFirstPruning) {
+      _availabilityFirstPruning = iAvailabilityFirstPruning;
+    }
+
+    /**
+     * Set the way the availability is calculated (seamless or AVS).
+     */
+    void setAvailabilityMode (const AvailabilityMode_T& iAvailabilityMode) {
+      _availabilityMode = iAvailabilityMode;
+    }
+
+    /**
+     * Set whether the identical concurrent requests are coalesced.
+     */
+    void setRequestCoalescingFlag (const bool iRequestCoalescing) {
+      _requestCoalescing.store (iRequestCoalescing);
+    }
+
+    /**
+     * Reset the given request trace (if any), with a new request
+     * identifier.
+     */
+    void initRequestTrace (RequestTraceStruct* ioRequestTrace_ptr) {
+      if (ioRequestTrace_ptr != NULL) {
+        ioRequestTrace_ptr->reset (++_lastRequestID);
+      }
     }
+
+    /**
+     * Set the name of the file the trace events are dumped into, when
+     * the service is finalised.
+     */
+    void setTraceEventFilename (const stdair::Filename_T& iTraceEventFilename) {
+      _traceEventFilename = iTraceEventFilename;
+    }
+
+    /**
+     * Set the log stream of the owned StdAir service.
+     */
+    void setLogStream (std::ostream* ioLogStream_ptr) {
+      _logStream_ptr = ioLogStream_ptr;
+    }
+
+
+  private:
+    // //////////////////// Fork Support /////////////////////
+    /**
+     * Take all the locks of the context, in the order in which they may
+     * be nested, and then flush the log stream (and the C standard
+     * streams), before forking the process: the child then inherits
+     * neither a lock held by another thread, nor the buffered output of
+     * the parent (which it would write again).
+     */
+    void lockBeforeFork();
+
+    /**
+     * Release the locks taken by lockBeforeFork(), in the parent process.
+     */
+    void unlockAfterFork();
+
+    /**
+     * Reset the context in the child process, after forking: the state
+     * left by the other threads of the parent (in-flight computations,
+     * booking journal) is forgotten, and the locks taken by
+     * lockBeforeFork() are released.
+     */
+    void resetAfterFork();
+
+    /**
+     * Flush the log stream (if known) and the C standard streams.
+     */
+    void flushLogStream();
     
 
   private:
@@ -222,6 +548,12 @@ namespace SIMCRS {
      */
     bool _ownStdairService;   
 
+    /**
+     * Log stream of the owned StdAir service (NULL when the StdAir
+     * service is not owned).
+     */
+    std::ostream* _logStream_ptr;
+
     /**
      * Standard event queue (SEvMgr) Service Handler.
      */
@@ -243,10 +575,32 @@ namespace SIMCRS {
     AIRINV::AIRINV_Master_ServicePtr_T _airinvService;
 
     /**
-     * Fare Quote Service Handler.
+     * Fare Quote Service Handler. As it may be replaced while being read
+     * (see publishSIMFQT_Service()), it is accessed atomically.
      */
     SIMFQT::SIMFQT_ServicePtr_T _simfqtService;
 
+    /**
+     * StdAir services of the published fares, still used by a SimFQT
+     * service (current or being read).
+     */
+    std::vector<stdair::STDAIR_Service*> _fareSTDAIR_ServiceList;
+
+    /**
+     * StdAir services of the published fares, no longer used. As the
+     * destruction of any StdAir service cleans all the BOM objects (of
+     * all the StdAir services, see FacSupervisor::cleanAll()), they can
+     * not be deleted as soon as they are retired, but only when the
+     * context is reset.
+     */
+    std::vector<stdair::STDAIR_Service*> _retiredFareSTDAIR_ServiceList;
+
+    /**
+     * Mutex guarding the lists of the StdAir services of the published
+     * fares, which are retired by the (concurrent) readers.
+     */
+    std::mutex _fareSTDAIR_ServiceMutex;
+
     
   private:
     // /////////////// Attributes //////////////////
@@ -256,6 +610,129 @@ namespace SIMCRS {
      * \note: this identifier is not used for now.
      */
     CRSCode_T _CRSCode;
+
+    /**
+     * Table of the interned codes (airports, airlines, booking classes
+     * and segment-dates).
+     */
+    SymbolTable _symbolTable;
+
+    /**
+     * Memory arena, holding the short-lived objects of the (shopping)
+     * request being served. There is one arena per thread, as requests
+     * may be served concurrently (see
+     * SIMCRS_Service::setRequestCoalescing()).
+     */
+    static thread_local RequestArena _requestArena;
+
+    /**
+     * State whether the travel solutions which cannot be sold are
+     * discarded before being fare-quoted (availability-first pruning).
+     */
+    bool _availabilityFirstPruning;
+
+    /**
+     * Statistics of the availability-first pruning, cumulated over the
+     * shopping requests.
+     */
+    PruningStatsStruct _pruningStats;
+
+    /**
+     * Mutex guarding the statistics of the availability-first pruning.
+     */
+    std::mutex _pruningStatsMutex;
+
+    /**
+     * Way the availability is calculated: by querying the airline
+     * inventory (seamless), or from the AVS table.
+     */
+    AvailabilityMode_T _availabilityMode;
+
+    /**
+     * Availability status (AVS) table, pushed by the airline inventory.
+     */
+    AvailabilityStatusTable _availabilityStatusTable;
+
+    /**
+     * Cache of the fare quote results.
+     */
+    FareQuoteCache _fareQuoteCache;
+
+    /**
+     * State whether the identical concurrent (segment path and fare quote)
+     * requests are coalesced. It is read by the concurrent requests.
+     */
+    std::atomic<bool> _requestCoalescing;
+
+    /**
+     * Mutex serialising the computations of the coalesced requests.
+     */
+    std::mutex _computationMutex;
+
+    /**
+     * Single-flight group of the segment path requests.
+     */
+    SingleFlightGroup _segmentPathFlightGroup;
+
+    /**
+     * Single-flight group of the fare quote requests.
+     */
+    SingleFlightGroup _fareQuoteFlightGroup;
+
+    /**
+     * Version of the fares (number of SimFQT services published).
+     */
+    std::atomic<FareVersion_T> _fareVersion;
+
+    /**
+     * Mutex serialising the publications of the fares (the readers
+     * never take it).
+     */
+    std::mutex _farePublicationMutex;
+
+    /**
+     * Identifier of the last traced request.
+     */
+    std::atomic<unsigned long> _lastRequestID;
+
+    /**
+     * Trace of the request being served by the calling thread, if any.
+     * It is kept per thread, so that the requests served concurrently
+     * (see SIMCRS_Service::setRequestCoalescing()) do not overwrite the
+     * trace of each other; as every request restores the former trace
+     * when it is over (see RequestTraceScope), it may be shared by the
+     * SimCRS services of the thread.
+     */
+    static thread_local RequestTraceStruct* _currentRequestTrace;
+
+    /**
+     * Recorder of the trace events (disabled by default).
+     */
+    TraceEventRecorder _traceEventRecorder;
+
+    /**
+     * Name of the file the trace events are dumped into, when the service
+     * is finalised (empty when they are not dumped).
+     */
+    stdair::Filename_T _traceEventFilename;
+
+    /**
+     * Counter of the heap allocations of the operations (disabled by
+     * default).
+     */
+    AllocationCounter _allocationCounter;
+
+    /**
+     * Schedule and fare changes applied on top of the BOM trees (see
+     * SIMCRS_Service::applyScheduleDelta() and applyFareDelta()).
+     */
+    DeltaOverlay _deltaOverlay;
+
+    /**
+     * Journal of the sells and cancellations (not open by default; see
+     * SIMCRS_Service::openBookingJournal()).
+     */
+    BookingJournal _bookingJournal;
   };
   
 }
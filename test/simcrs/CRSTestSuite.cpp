@@ -6,20 +6,31 @@
 // Import section
 // //////////////////////////////////////////////////////////////////////
 // STL
+#include <cstdio>
 #include <sstream>
 #include <fstream>
 #include <string>
 #include <cmath>
+#include <algorithm>
+#include <thread>
+#include <vector>
 // Boost Unit Test Framework (UTF)
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_MODULE CRSTestSuite
 #include <boost/test/unit_test.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
 // StdAir
+#include <stdair/stdair_json.hpp>
 #include <stdair/basic/BasLogParams.hpp>
 #include <stdair/basic/BasDBParams.hpp>
 #include <stdair/basic/BasFileMgr.hpp>
+#include <stdair/basic/BasChronometer.hpp>
 #include <stdair/bom/TravelSolutionStruct.hpp>
+#include <stdair/bom/FareOptionStruct.hpp>
 #include <stdair/bom/BookingRequestStruct.hpp>
 #include <stdair/service/Logger.hpp>
 // SimFQT
@@ -54,6 +65,171 @@ struct UnitTestConfig {
   }
 };
 
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Travel solution visitor, keeping track of the streamed travel solutions
+ */
+struct TravelSolutionCounter {
+  /** Constructor. */
+  TravelSolutionCounter (std::ostringstream& ioStr, unsigned int& ioCount,
+                         const unsigned int iMaxCount)
+    : _str (ioStr), _count (ioCount), _maxCount (iMaxCount) {
+  }
+
+  /** Call-back, invoked for every streamed travel solution. */
+  bool operator() (stdair::TravelSolutionStruct& iTravelSolution) {
+    _str << iTravelSolution.describe() << std::endl;
+    ++_count;
+    return (_count < _maxCount);
+  }
+
+  std::ostringstream& _str;
+  unsigned int& _count;
+  const unsigned int _maxCount;
+};
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Full display of a list of travel solutions
+ */
+std::string
+describeTravelSolutions (const stdair::TravelSolutionList_T& iTSList) {
+  std::ostringstream oStr;
+  for (stdair::TravelSolutionList_T::const_iterator itTS = iTSList.begin();
+       itTS != iTSList.end(); ++itTS) {
+    oStr << itTS->display();
+  }
+  return oStr.str();
+}
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Key of the first segment-date of the first travel solution of the
+ * given shopping result
+ */
+std::string
+getFirstSegmentDateKey (const SIMCRS::SIMCRS_Service& iSIMCRS_Service,
+                        const SIMCRS::ShoppingResultStruct& iShoppingResult) {
+  BOOST_REQUIRE (iShoppingResult.empty() == false);
+  const SIMCRS::ShoppingSolutionStruct& lSolution =
+    iShoppingResult.getTravelSolution (0);
+  const SIMCRS::SegmentDateID_T& lSegmentDateID =
+    iShoppingResult.getSegmentDateID (lSolution, 0);
+  return iSIMCRS_Service.getSegmentDateKey (lSegmentDateID);
+}
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Lowest fare of the given shopping result (false when the result is
+ * empty)
+ */
+bool getLowestFare (const SIMCRS::ShoppingResultStruct& iShoppingResult,
+                    stdair::Fare_T& ioLowestFare) {
+  bool hasFare = false;
+  for (SIMCRS::NbOfTravelSolutions_T idxTS = 0;
+       idxTS != iShoppingResult.getNbOfTravelSolutions(); ++idxTS) {
+    const SIMCRS::ShoppingSolutionStruct& lSolution =
+      iShoppingResult.getTravelSolution (idxTS);
+    for (unsigned short idxFO = 0; idxFO != lSolution._nbOfFareOptions;
+         ++idxFO) {
+      const stdair::Fare_T& lFare =
+        iShoppingResult.getFareOption (lSolution, idxFO)._fare;
+      if (hasFare == false || lFare < ioLowestFare) {
+        ioLowestFare = lFare;
+        hasFare = true;
+      }
+    }
+  }
+  return hasFare;
+}
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Count the records of the given CSV file, read line by line (the blank
+ * and comment lines are not records)
+ */
+unsigned long countInputRecords (const stdair::Filename_T& iFilename,
+                                 unsigned long& ioNbOfBytes) {
+  unsigned long oNbOfRecords = 0;
+  std::ifstream lInputStream (iFilename.c_str());
+  std::string lLine;
+  while (std::getline (lInputStream, lLine)) {
+    ioNbOfBytes += lLine.size() + 1;
+    const std::string::size_type lFirstChar =
+      lLine.find_first_not_of (" \t\r");
+    if (lFirstChar == std::string::npos || lLine[lFirstChar] == '#') {
+      continue;
+    }
+    ++oNbOfRecords;
+  }
+  return oNbOfRecords;
+}
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Build the booking request used by the tests (SIN-BKK, for 3 persons
+ * by default)
+ */
+stdair::BookingRequestStruct
+buildBookingRequest (const bool isBuiltin,
+                     const stdair::Date_T& iPreferredDepartureDate =
+                     stdair::Date_T(),
+                     const stdair::PartySize_T& iPartySize = 3) {
+
+  stdair::Date_T lPreferredDepartureDate;
+  stdair::Date_T lRequestDate;
+  stdair::TripType_T lTripType;
+
+  if (isBuiltin == true) {
+    lPreferredDepartureDate = boost::gregorian::from_string ("2010/02/08");
+    lRequestDate = boost::gregorian::from_string ("2010/01/21");
+    lTripType = "OW";
+
+  } else {
+    lPreferredDepartureDate = boost::gregorian::from_string ("2011/01/31");
+    lRequestDate = boost::gregorian::from_string ("2011/01/22");
+    lTripType = "RI";
+  }
+
+  // Another departure date may be given (e.g., for calendar shopping)
+  if (iPreferredDepartureDate.is_not_a_date() == false) {
+    lPreferredDepartureDate = iPreferredDepartureDate;
+  }
+
+  const stdair::AirportCode_T lOrigin ("SIN");
+  const stdair::AirportCode_T lDestination ("BKK");
+  const stdair::AirportCode_T lPOS ("SIN");
+  const stdair::Duration_T lRequestTime (boost::posix_time::hours(10));
+  const stdair::DateTime_T lRequestDateTime (lRequestDate, lRequestTime);
+  const stdair::CabinCode_T lPreferredCabin ("Eco");
+  const stdair::PartySize_T lPartySize (iPartySize);
+  const stdair::ChannelLabel_T lChannel ("IN");
+  const stdair::DayDuration_T lStayDuration (7);
+  const stdair::FrequentFlyer_T lFrequentFlyerType ("M");
+  const stdair::Duration_T lPreferredDepartureTime (boost::posix_time::hours(10));
+  const stdair::WTP_T lWTP (1000.0);
+  const stdair::PriceValue_T lValueOfTime (100.0);
+  const stdair::ChangeFees_T lChangeFees (true);
+  const stdair::Disutility_T lChangeFeeDisutility (50);
+  const stdair::NonRefundable_T lNonRefundable (true);
+  const stdair::Disutility_T lNonRefundableDisutility (50);
+  const stdair::BookingRequestStruct lBookingRequest (lOrigin, lDestination,
+                                                      lPOS,
+                                                      lPreferredDepartureDate,
+                                                      lRequestDateTime,
+                                                      lPreferredCabin,
+                                                      lPartySize, lChannel,
+                                                      lTripType, lStayDuration,
+                                                      lFrequentFlyerType,
+                                                      lPreferredDepartureTime,
+                                                      lWTP, lValueOfTime,
+                                                      lChangeFees,
+                                                      lChangeFeeDisutility,
+                                                      lNonRefundable,
+                                                      lNonRefundableDisutility);
+  return lBookingRequest;
+}
+
 // //////////////////////////////////////////////////////////////////////
 /**
  * Perform a simple simulation
@@ -87,20 +263,12 @@ const unsigned int testSimCRSHelper (const unsigned short iTestFlag,
   const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
   SIMCRS::SIMCRS_Service simcrsService (lLogParams, lCRSCode);
 
-  stdair::Date_T lPreferredDepartureDate;;
-  stdair::Date_T lRequestDate;
-  stdair::TripType_T lTripType;
-
   // Check wether or not a (CSV) input file should be read
   if (isBuiltin == true) {
 
     // Build the default sample BOM tree
     simcrsService.buildSampleBom();
 
-    lPreferredDepartureDate = boost::gregorian::from_string ("2010/02/08");
-    lRequestDate = boost::gregorian::from_string ("2010/01/21");
-    lTripType = "OW";
-
   } else {
 
     // Build the BOM tree from parsing input files
@@ -113,44 +281,13 @@ const unsigned int testSimCRSHelper (const unsigned short iTestFlag,
     simcrsService.parseAndLoad (lScheduleFilePath, lODFilePath,
                                 lFRAT5FilePath, lFFDisutilityFilePath,
                                 lYieldFilePath, lFareFilePath);
-
-    lPreferredDepartureDate = boost::gregorian::from_string ("2011/01/31");
-    lRequestDate = boost::gregorian::from_string ("2011/01/22");
-    lTripType = "RI";
   }
 
-  // Create an empty booking request structure
-  const stdair::AirportCode_T lOrigin ("SIN");
-  const stdair::AirportCode_T lDestination ("BKK");
-  const stdair::AirportCode_T lPOS ("SIN");
-  const stdair::Duration_T lRequestTime (boost::posix_time::hours(10));
-  const stdair::DateTime_T lRequestDateTime (lRequestDate, lRequestTime);
-  const stdair::CabinCode_T lPreferredCabin ("Eco");
-  const stdair::PartySize_T lPartySize (3);
-  const stdair::ChannelLabel_T lChannel ("IN");
-  const stdair::DayDuration_T lStayDuration (7);
-  const stdair::FrequentFlyer_T lFrequentFlyerType ("M");
-  const stdair::Duration_T lPreferredDepartureTime (boost::posix_time::hours(10));
-  const stdair::WTP_T lWTP (1000.0);
-  const stdair::PriceValue_T lValueOfTime (100.0);
-  const stdair::ChangeFees_T lChangeFees (true);
-  const stdair::Disutility_T lChangeFeeDisutility (50);
-  const stdair::NonRefundable_T lNonRefundable (true);
-  const stdair::Disutility_T lNonRefundableDisutility (50);
-  const stdair::BookingRequestStruct lBookingRequest (lOrigin, lDestination,
-                                                      lPOS,
-                                                      lPreferredDepartureDate,
-                                                      lRequestDateTime,
-                                                      lPreferredCabin,
-                                                      lPartySize, lChannel,
-                                                      lTripType, lStayDuration,
-                                                      lFrequentFlyerType,
-                                                      lPreferredDepartureTime,
-                                                      lWTP, lValueOfTime,
-                                                      lChangeFees,
-                                                      lChangeFeeDisutility,
-                                                      lNonRefundable,
-                                                      lNonRefundableDisutility);
+  // Create the booking request structure
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  const stdair::PartySize_T& lPartySize = lBookingRequest.getPartySize();
+
   stdair::TravelSolutionList_T lTravelSolutionList =
     simcrsService.calculateSegmentPathList (lBookingRequest);
   
@@ -343,6 +480,2176 @@ BOOST_AUTO_TEST_CASE (simcrs_simple_default_bom_simulation_test) {
   BOOST_CHECK_MESSAGE (isSellSuccessful == true, oMessageSell.str());
 }
 
+/**
+ * Test a booking made through the interned (integer) codes
+ */
+BOOST_AUTO_TEST_CASE (simcrs_interned_codes_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_interned_codes.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the SimCRS service, with the default sample BOM tree
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  simcrsService.buildSampleBom();
+
+  // The codes of the BOM tree are interned when it is loaded
+  SIMCRS::AirportID_T lSINID = 0;
+  BOOST_CHECK_NO_THROW (lSINID = simcrsService.getAirportID ("SIN"));
+  BOOST_CHECK_EQUAL (simcrsService.getAirportCode (lSINID), "SIN");
+  BOOST_CHECK_THROW (simcrsService.getAirportID ("XYZ"),
+                     SIMCRS::SymbolNotFoundException);
+
+  // Retrieve the travel solutions
+  const bool isBuiltin = true;
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  stdair::TravelSolutionList_T lTravelSolutionList =
+    simcrsService.calculateSegmentPathList (lBookingRequest);
+  BOOST_REQUIRE (lTravelSolutionList.empty() == false);
+
+  // Express the segment path with interned identifiers
+  const stdair::TravelSolutionStruct& lTravelSolution =
+    lTravelSolutionList.front();
+  SIMCRS::SegmentPathID_T lSegmentPathID;
+  simcrsService.getSegmentPathID (lTravelSolution, lSegmentPathID);
+  BOOST_REQUIRE_EQUAL (lSegmentPathID.size(),
+                       lTravelSolution.getSegmentPath().size());
+
+  const SIMCRS::SegmentDateID_T& lSegmentDateID = lSegmentPathID.front();
+  BOOST_CHECK_EQUAL (simcrsService.getSegmentDateKey (lSegmentDateID),
+                     lTravelSolution.getSegmentPath().front());
+
+  // Make a booking (party size of 3) in the M class, through identifiers
+  const SIMCRS::ClassCodeID_T lClassCodeID =
+    simcrsService.getClassCodeID ("M");
+  BOOST_CHECK_NO_THROW (simcrsService.getAvailability (lSegmentDateID,
+                                                       lClassCodeID));
+  const bool isSellSuccessful =
+    simcrsService.sell (lSegmentDateID, lClassCodeID,
+                        lBookingRequest.getPartySize());
+  BOOST_CHECK_EQUAL (isSellSuccessful, true);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test the streaming of the travel solutions down to a visitor
+ */
+BOOST_AUTO_TEST_CASE (simcrs_streaming_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_streaming.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the SimCRS service, with the default sample BOM tree
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  simcrsService.buildSampleBom();
+
+  // Retrieve the whole list of travel solutions, the usual way
+  const bool isBuiltin = true;
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  stdair::TravelSolutionList_T lTravelSolutionList =
+    simcrsService.calculateSegmentPathList (lBookingRequest);
+  simcrsService.fareQuote (lBookingRequest, lTravelSolutionList);
+  simcrsService.calculateAvailability (lTravelSolutionList);
+  BOOST_REQUIRE (lTravelSolutionList.empty() == false);
+
+  // Stream the same travel solutions
+  std::ostringstream oStreamedStr;
+  unsigned int lNbOfVisits = 0;
+  TravelSolutionCounter lVisitor (oStreamedStr, lNbOfVisits, 1000);
+  const SIMCRS::NbOfTravelSolutions_T lNbOfStreamed =
+    simcrsService.streamTravelSolutions (lBookingRequest, lVisitor);
+  BOOST_CHECK_EQUAL (lNbOfStreamed, lTravelSolutionList.size());
+  BOOST_CHECK_EQUAL (lNbOfVisits, lNbOfStreamed);
+
+  std::ostringstream oListStr;
+  for (stdair::TravelSolutionList_T::const_iterator itTS =
+         lTravelSolutionList.begin();
+       itTS != lTravelSolutionList.end(); ++itTS) {
+    oListStr << itTS->describe() << std::endl;
+  }
+  BOOST_CHECK_EQUAL (oStreamedStr.str(), oListStr.str());
+
+  // The visitor may stop the streaming early
+  std::ostringstream oFirstStr;
+  unsigned int lNbOfFirstVisits = 0;
+  TravelSolutionCounter lFirstVisitor (oFirstStr, lNbOfFirstVisits, 1);
+  BOOST_CHECK_EQUAL (simcrsService.streamTravelSolutions (lBookingRequest,
+                                                          lFirstVisitor),
+                     1);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test the availability-first pruning of the travel solutions
+ */
+BOOST_AUTO_TEST_CASE (simcrs_pruning_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_pruning.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the SimCRS service, with the default sample BOM tree
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  simcrsService.buildSampleBom();
+
+  // No travel solution can be pruned on a fresh inventory
+  const bool isBuiltin = true;
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  stdair::TravelSolutionList_T lTravelSolutionList =
+    simcrsService.calculateSegmentPathList (lBookingRequest);
+  const stdair::TravelSolutionList_T::size_type lNbOfTravelSolutions =
+    lTravelSolutionList.size();
+  BOOST_REQUIRE (lNbOfTravelSolutions > 0);
+
+  const SIMCRS::NbOfTravelSolutions_T lNbOfPruned =
+    simcrsService.pruneTravelSolutionList (lBookingRequest,
+                                           lTravelSolutionList);
+  BOOST_CHECK_EQUAL (lNbOfPruned, 0);
+  BOOST_CHECK_EQUAL (lTravelSolutionList.size(), lNbOfTravelSolutions);
+
+  // The streaming, with pruning, delivers the same travel solutions
+  simcrsService.setAvailabilityFirstPruning (true);
+  std::ostringstream oStreamedStr;
+  unsigned int lNbOfVisits = 0;
+  TravelSolutionCounter lVisitor (oStreamedStr, lNbOfVisits, 1000);
+  BOOST_CHECK_EQUAL (simcrsService.streamTravelSolutions (lBookingRequest,
+                                                          lVisitor),
+                     lNbOfTravelSolutions);
+
+  const SIMCRS::PruningStatsStruct& lPruningStats =
+    simcrsService.getPruningStats();
+  BOOST_CHECK_EQUAL (lPruningStats._nbOfTravelSolutions,
+                     2 * lNbOfTravelSolutions);
+  BOOST_CHECK_EQUAL (lPruningStats._nbOfPrunedTravelSolutions, 0);
+  BOOST_CHECK_EQUAL (lPruningStats._nbOfQuotedTravelSolutions,
+                     lNbOfTravelSolutions);
+
+  // No booking class has that many seats left: all the travel solutions
+  // are closed for such a party, and get pruned
+  const stdair::PartySize_T lHugePartySize (10000);
+  const stdair::BookingRequestStruct lHugeBookingRequest =
+    buildBookingRequest (isBuiltin, stdair::Date_T(), lHugePartySize);
+  stdair::TravelSolutionList_T lClosedTravelSolutionList =
+    simcrsService.calculateSegmentPathList (lHugeBookingRequest);
+  BOOST_REQUIRE_EQUAL (lClosedTravelSolutionList.size(),
+                       lNbOfTravelSolutions);
+
+  const SIMCRS::NbOfTravelSolutions_T lNbOfClosed =
+    simcrsService.pruneTravelSolutionList (lHugeBookingRequest,
+                                           lClosedTravelSolutionList);
+  BOOST_CHECK_EQUAL (lNbOfClosed, lNbOfTravelSolutions);
+  BOOST_CHECK (lClosedTravelSolutionList.empty() == true);
+
+  // Nor does the streaming deliver (nor fare-quote) any of them
+  unsigned int lNbOfClosedVisits = 0;
+  TravelSolutionCounter lClosedVisitor (oStreamedStr, lNbOfClosedVisits,
+                                        1000);
+  BOOST_CHECK_EQUAL (simcrsService.streamTravelSolutions (lHugeBookingRequest,
+                                                          lClosedVisitor),
+                     0);
+  BOOST_CHECK_EQUAL (lNbOfClosedVisits, 0);
+
+  const SIMCRS::PruningStatsStruct& lClosedPruningStats =
+    simcrsService.getPruningStats();
+  BOOST_CHECK_EQUAL (lClosedPruningStats._nbOfTravelSolutions,
+                     4 * lNbOfTravelSolutions);
+  BOOST_CHECK_EQUAL (lClosedPruningStats._nbOfPrunedTravelSolutions,
+                     2 * lNbOfTravelSolutions);
+  BOOST_CHECK_EQUAL (lClosedPruningStats._nbOfQuotedTravelSolutions,
+                     lNbOfTravelSolutions);
+
+  // Without pruning, the shopping does not check the travel solutions
+  // before fare-quoting them, nor does it update the pruning statistics
+  simcrsService.setAvailabilityFirstPruning (false);
+  const SIMCRS::ShoppingResultStruct lUnprunedResult =
+    simcrsService.shop (lHugeBookingRequest);
+  BOOST_CHECK (lUnprunedResult.empty() == true);
+  BOOST_CHECK_EQUAL (lUnprunedResult.getNbOfPrunedTravelSolutions(), 0);
+  BOOST_CHECK_EQUAL (simcrsService.getPruningStats()._nbOfTravelSolutions,
+                     4 * lNbOfTravelSolutions);
+
+  // With pruning, they are all disqualified before being fare-quoted
+  simcrsService.setAvailabilityFirstPruning (true);
+  const SIMCRS::ShoppingResultStruct lPrunedResult =
+    simcrsService.shop (lHugeBookingRequest);
+  BOOST_CHECK (lPrunedResult.empty() == true);
+  BOOST_CHECK_EQUAL (lPrunedResult.getNbOfPrunedTravelSolutions(),
+                     lNbOfTravelSolutions);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test the fused (single-pass) shopping against the three-call sequence
+ */
+BOOST_AUTO_TEST_CASE (simcrs_shop_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_shop.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the SimCRS service, with the default sample BOM tree
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  simcrsService.buildSampleBom();
+
+  // Three-call sequence
+  const bool isBuiltin = true;
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  stdair::TravelSolutionList_T lTravelSolutionList =
+    simcrsService.calculateSegmentPathList (lBookingRequest);
+  simcrsService.fareQuote (lBookingRequest, lTravelSolutionList);
+  simcrsService.calculateAvailability (lTravelSolutionList);
+
+  // Keep track of the bookable fare options
+  const stdair::PartySize_T& lPartySize = lBookingRequest.getPartySize();
+  std::ostringstream oExpectedStr;
+  SIMCRS::NbOfFareOptions_T lNbOfFareOptions = 0;
+  for (stdair::TravelSolutionList_T::const_iterator itTS =
+         lTravelSolutionList.begin();
+       itTS != lTravelSolutionList.end(); ++itTS) {
+    const stdair::FareOptionList_T& lFareOptionList =
+      itTS->getFareOptionList();
+    for (stdair::FareOptionList_T::const_iterator itFO =
+           lFareOptionList.begin(); itFO != lFareOptionList.end(); ++itFO) {
+      if (itFO->getAvailability() >= lPartySize) {
+        oExpectedStr << itTS->getSegmentPath().front() << " - "
+                     << itFO->getFare() << std::endl;
+        ++lNbOfFareOptions;
+      }
+    }
+  }
+
+  // Fused shopping
+  const SIMCRS::ShoppingResultStruct lShoppingResult =
+    simcrsService.shop (lBookingRequest);
+  BOOST_CHECK_EQUAL (lShoppingResult.getNbOfSegmentPaths(),
+                     lTravelSolutionList.size());
+  BOOST_CHECK_EQUAL (lShoppingResult.getNbOfFareOptions(), lNbOfFareOptions);
+
+  std::ostringstream oShoppedStr;
+  for (SIMCRS::NbOfTravelSolutions_T idxTS = 0;
+       idxTS != lShoppingResult.getNbOfTravelSolutions(); ++idxTS) {
+    const SIMCRS::ShoppingSolutionStruct& lSolution =
+      lShoppingResult.getTravelSolution (idxTS);
+    BOOST_CHECK (lSolution._nbOfFareOptions > 0);
+    const std::string& lSegmentDateKey = simcrsService.
+      getSegmentDateKey (lShoppingResult.getSegmentDateID (lSolution, 0));
+    for (unsigned short idxFO = 0; idxFO != lSolution._nbOfFareOptions;
+         ++idxFO) {
+      const SIMCRS::ShoppingFareOptionStruct& lFareOption =
+        lShoppingResult.getFareOption (lSolution, idxFO);
+      BOOST_CHECK (lFareOption._availability >= lPartySize);
+      oShoppedStr << lSegmentDateKey << " - " << lFareOption._fare
+                  << std::endl;
+    }
+  }
+  BOOST_CHECK_EQUAL (oShoppedStr.str(), oExpectedStr.str());
+
+  // The result is much more compact than the travel solutions
+  STDAIR_LOG_DEBUG ("Shopping result: " << lShoppingResult.describe()
+                    << ", " << lShoppingResult.getNbOfBytes() << " bytes");
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test the availability read from the AVS table of the CRS
+ */
+BOOST_AUTO_TEST_CASE (simcrs_avs_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_avs.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the SimCRS service, with the default sample BOM tree
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  simcrsService.buildSampleBom();
+
+  // Seamless availability
+  const bool isBuiltin = true;
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  const SIMCRS::ShoppingResultStruct lSeamlessResult =
+    simcrsService.shop (lBookingRequest);
+  BOOST_REQUIRE (lSeamlessResult.empty() == false);
+
+  // AVS-based availability: the same fare options are bookable
+  simcrsService.setAvailabilityMode (SIMCRS::AVS_AVAILABILITY);
+  BOOST_CHECK_EQUAL (simcrsService.getAvailabilityMode(),
+                     SIMCRS::AVS_AVAILABILITY);
+  const SIMCRS::ShoppingResultStruct lFirstAVSResult =
+    simcrsService.shop (lBookingRequest);
+  const SIMCRS::ShoppingResultStruct lAVSResult =
+    simcrsService.shop (lBookingRequest);
+  BOOST_CHECK_EQUAL (lFirstAVSResult.getNbOfFareOptions(),
+                     lSeamlessResult.getNbOfFareOptions());
+  BOOST_CHECK_EQUAL (lAVSResult.getNbOfFareOptions(),
+                     lSeamlessResult.getNbOfFareOptions());
+
+  // A sale is pushed into the AVS table, which stays in line with
+  // the airline inventory
+  const SIMCRS::SegmentDateID_T& lSegmentDateID =
+    lAVSResult.getSegmentDateID (lAVSResult.getTravelSolution (0), 0);
+  const SIMCRS::ClassCodeID_T lClassCodeID =
+    simcrsService.getClassCodeID ("M");
+  const bool isSellSuccessful =
+    simcrsService.sell (lSegmentDateID, lClassCodeID,
+                        lBookingRequest.getPartySize());
+  BOOST_REQUIRE (isSellSuccessful == true);
+  const stdair::Availability_T lAVSAvailability =
+    simcrsService.getAvailability (lSegmentDateID, lClassCodeID);
+
+  simcrsService.setAvailabilityMode (SIMCRS::SEAMLESS_AVAILABILITY);
+  const stdair::Availability_T lSeamlessAvailability =
+    simcrsService.getAvailability (lSegmentDateID, lClassCodeID);
+  BOOST_CHECK_EQUAL (lAVSAvailability,
+                     std::max (0.0, std::floor (lSeamlessAvailability)));
+
+  // Deferred pushes: a sale is not pushed into the AVS table before the
+  // third inventory change (or an explicit flush), so that the AVS-based
+  // availability is stale meanwhile
+  simcrsService.setAvailabilityMode (SIMCRS::AVS_AVAILABILITY);
+  simcrsService.setAvailabilityPushInterval (3);
+  const bool isDeferredSellSuccessful =
+    simcrsService.sell (lSegmentDateID, lClassCodeID, 1);
+  BOOST_REQUIRE (isDeferredSellSuccessful == true);
+  const stdair::Availability_T lStaleAvailability =
+    simcrsService.getAvailability (lSegmentDateID, lClassCodeID);
+  BOOST_CHECK_EQUAL (lStaleAvailability, lAVSAvailability);
+
+  simcrsService.flushAvailabilityStatuses();
+  const stdair::Availability_T lFlushedAvailability =
+    simcrsService.getAvailability (lSegmentDateID, lClassCodeID);
+  simcrsService.setAvailabilityMode (SIMCRS::SEAMLESS_AVAILABILITY);
+  const stdair::Availability_T lSoldAvailability =
+    simcrsService.getAvailability (lSegmentDateID, lClassCodeID);
+  BOOST_CHECK_EQUAL (lFlushedAvailability,
+                     std::max (0.0, std::floor (lSoldAvailability)));
+  BOOST_CHECK (lSoldAvailability < lSeamlessAvailability);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Calendar shopping, checked (and timed) against shopping for each
+ * departure date in turn.
+ */
+BOOST_AUTO_TEST_CASE (simcrs_calendar_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_calendar.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the SimCRS service, with the default sample BOM tree
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  simcrsService.buildSampleBom();
+
+  // +/- 3 days around the preferred departure date
+  const bool isBuiltin = true;
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  const stdair::Date_T& lPreferredDepartureDate =
+    lBookingRequest.getPreferedDepartureDate();
+  const stdair::DateOffset_T lThreeDays (3);
+  const stdair::DatePeriod_T lDatePeriod (lPreferredDepartureDate - lThreeDays,
+                                          lPreferredDepartureDate + lThreeDays
+                                          + stdair::DateOffset_T (1));
+
+  // Naive loop: shop for each departure date in turn
+  stdair::BasChronometer lNaiveChronometer;
+  lNaiveChronometer.start();
+  std::ostringstream oExpectedStr;
+  const stdair::DateOffset_T lOneDay (1);
+  for (stdair::Date_T lDepartureDate = lDatePeriod.begin();
+       lDepartureDate < lDatePeriod.end(); lDepartureDate += lOneDay) {
+    const stdair::BookingRequestStruct lDatedBookingRequest =
+      buildBookingRequest (isBuiltin, lDepartureDate);
+    const SIMCRS::ShoppingResultStruct lShoppingResult =
+      simcrsService.shop (lDatedBookingRequest);
+
+    stdair::Fare_T lLowestFare = 0.0;
+    const bool hasFare = getLowestFare (lShoppingResult, lLowestFare);
+
+    oExpectedStr << lDepartureDate << ": ";
+    if (hasFare == true) {
+      oExpectedStr << lLowestFare;
+    } else {
+      oExpectedStr << "-";
+    }
+    oExpectedStr << std::endl;
+  }
+  const double lNaiveMeasure = lNaiveChronometer.elapsed();
+
+  // Calendar shopping
+  stdair::BasChronometer lCalendarChronometer;
+  lCalendarChronometer.start();
+  const SIMCRS::CalendarResultStruct lCalendarResult =
+    simcrsService.shopCalendar (lBookingRequest, lDatePeriod);
+  const double lCalendarMeasure = lCalendarChronometer.elapsed();
+
+  const SIMCRS::CalendarEntryList_T& lCalendarEntryList =
+    lCalendarResult.getCalendarEntryList();
+  BOOST_CHECK_EQUAL (lCalendarEntryList.size(), 7U);
+
+  std::ostringstream oCalendarStr;
+  for (SIMCRS::CalendarEntryList_T::const_iterator itEntry =
+         lCalendarEntryList.begin();
+       itEntry != lCalendarEntryList.end(); ++itEntry) {
+    oCalendarStr << itEntry->describe() << std::endl;
+  }
+  BOOST_CHECK_EQUAL (oCalendarStr.str(), oExpectedStr.str());
+
+  // A null (or reversed) date period holds no departure date
+  const stdair::DatePeriod_T lNullDatePeriod (lPreferredDepartureDate,
+                                              lPreferredDepartureDate);
+  BOOST_CHECK (simcrsService.shopCalendar (lBookingRequest, lNullDatePeriod).
+               getCalendarEntryList().empty() == true);
+  const stdair::DatePeriod_T
+    lReversedDatePeriod (lPreferredDepartureDate + lThreeDays,
+                         lPreferredDepartureDate - lThreeDays);
+  BOOST_CHECK (simcrsService.shopCalendar (lBookingRequest,
+                                           lReversedDatePeriod).
+               getCalendarEntryList().empty() == true);
+
+  // DEBUG
+  STDAIR_LOG_DEBUG ("Calendar shopping: " << lCalendarMeasure
+                    << " (per-date loop: " << lNaiveMeasure << ") - "
+                    << lCalendarResult.display());
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test the fare quote cache: the cached fare options are the same as the
+ * ones quoted by SimFQT.
+ */
+BOOST_AUTO_TEST_CASE (simcrs_fare_quote_cache_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_fare_quote_cache.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the SimCRS service, with the default sample BOM tree
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  simcrsService.buildSampleBom();
+
+  // Loading the fares has dropped the (empty) cache
+  SIMCRS::FareQuoteCacheStatsStruct lCacheStats =
+    simcrsService.getFareQuoteCacheStats();
+  BOOST_CHECK (lCacheStats._nbOfFlushes >= 1);
+  BOOST_CHECK_EQUAL (lCacheStats._nbOfEntries, 0U);
+
+  // Fare quote without cache
+  const bool isBuiltin = true;
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  stdair::TravelSolutionList_T lTravelSolutionList =
+    simcrsService.calculateSegmentPathList (lBookingRequest);
+  simcrsService.fareQuote (lBookingRequest, lTravelSolutionList);
+  const unsigned int lNbOfTravelSolutions = lTravelSolutionList.size();
+
+  std::ostringstream oExpectedStr;
+  for (stdair::TravelSolutionList_T::const_iterator itTS =
+         lTravelSolutionList.begin();
+       itTS != lTravelSolutionList.end(); ++itTS) {
+    oExpectedStr << itTS->display();
+  }
+
+  // Twice the same fare quote, with the cache: the second one is served
+  // by the cache only
+  simcrsService.setFareQuoteCacheCapacity (100);
+  for (unsigned short idx = 0; idx != 2; ++idx) {
+    stdair::TravelSolutionList_T lCachedList =
+      simcrsService.calculateSegmentPathList (lBookingRequest);
+    simcrsService.fareQuote (lBookingRequest, lCachedList);
+
+    std::ostringstream oCachedStr;
+    for (stdair::TravelSolutionList_T::const_iterator itTS =
+           lCachedList.begin(); itTS != lCachedList.end(); ++itTS) {
+      oCachedStr << itTS->display();
+    }
+    BOOST_CHECK_EQUAL (oCachedStr.str(), oExpectedStr.str());
+  }
+
+  lCacheStats = simcrsService.getFareQuoteCacheStats();
+  BOOST_CHECK_EQUAL (lCacheStats._nbOfLookups, 2 * lNbOfTravelSolutions);
+  BOOST_CHECK_EQUAL (lCacheStats._nbOfHits, lNbOfTravelSolutions);
+  BOOST_CHECK_EQUAL (lCacheStats._nbOfEntries, lNbOfTravelSolutions);
+
+  // A smaller capacity evicts the least recently used entries
+  simcrsService.setFareQuoteCacheCapacity (1);
+  lCacheStats = simcrsService.getFareQuoteCacheStats();
+  BOOST_CHECK (lCacheStats._nbOfEntries <= 1);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test the coalescing of identical concurrent requests, with a synthetic
+ * hot-market workload: many workers shopping the same market at the same
+ * time.
+ */
+BOOST_AUTO_TEST_CASE (simcrs_request_coalescing_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_coalescing.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the SimCRS service, with the default sample BOM tree
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  simcrsService.buildSampleBom();
+
+  // Reference result, without coalescing
+  const bool isBuiltin = true;
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  stdair::TravelSolutionList_T lTravelSolutionList =
+    simcrsService.calculateSegmentPathList (lBookingRequest);
+  simcrsService.fareQuote (lBookingRequest, lTravelSolutionList);
+  const std::string lExpectedStr =
+    describeTravelSolutions (lTravelSolutionList);
+
+  // Hot market: all the workers shop the same market at the same time
+  simcrsService.setRequestCoalescing (true);
+  const unsigned int lNbOfWorkers = 8;
+  const unsigned int lNbOfRequestsPerWorker = 20;
+  std::vector<unsigned int> lNbOfMismatchList (lNbOfWorkers, 0);
+  std::vector<std::thread> lWorkerList;
+  for (unsigned int idx = 0; idx != lNbOfWorkers; ++idx) {
+    unsigned int& lNbOfMismatches = lNbOfMismatchList[idx];
+    lWorkerList.push_back (std::thread ([&simcrsService, &lBookingRequest,
+                                         &lExpectedStr, &lNbOfMismatches,
+                                         lNbOfRequestsPerWorker] () {
+      for (unsigned int jdx = 0; jdx != lNbOfRequestsPerWorker; ++jdx) {
+        stdair::TravelSolutionList_T lWorkerTSList =
+          simcrsService.calculateSegmentPathList (lBookingRequest);
+        simcrsService.fareQuote (lBookingRequest, lWorkerTSList);
+        if (describeTravelSolutions (lWorkerTSList) != lExpectedStr) {
+          ++lNbOfMismatches;
+        }
+      }
+    }));
+  }
+  for (std::vector<std::thread>::iterator itWorker = lWorkerList.begin();
+       itWorker != lWorkerList.end(); ++itWorker) {
+    itWorker->join();
+  }
+
+  // Every worker got the same result as without coalescing
+  for (unsigned int idx = 0; idx != lNbOfWorkers; ++idx) {
+    BOOST_CHECK_EQUAL (lNbOfMismatchList[idx], 0U);
+  }
+
+  // Every request has either been computed or been coalesced
+  const SIMCRS::CoalescingStatsStruct lSegmentPathStats =
+    simcrsService.getSegmentPathCoalescingStats();
+  const SIMCRS::CoalescingStatsStruct lFareQuoteStats =
+    simcrsService.getFareQuoteCoalescingStats();
+  const unsigned long lNbOfRequests = lNbOfWorkers * lNbOfRequestsPerWorker;
+  BOOST_CHECK_EQUAL (lSegmentPathStats._nbOfRequests, lNbOfRequests);
+  BOOST_CHECK_EQUAL (lSegmentPathStats._nbOfComputations
+                     + lSegmentPathStats._nbOfCoalescedRequests,
+                     lNbOfRequests);
+  BOOST_CHECK_EQUAL (lFareQuoteStats._nbOfRequests, lNbOfRequests);
+  BOOST_CHECK_EQUAL (lFareQuoteStats._nbOfComputations
+                     + lFareQuoteStats._nbOfCoalescedRequests,
+                     lNbOfRequests);
+
+  // DEBUG
+  STDAIR_LOG_DEBUG ("Coalescing ratio: "
+                    << lSegmentPathStats.getCoalescingRatio()
+                    << " (segment paths), "
+                    << lFareQuoteStats.getCoalescingRatio()
+                    << " (fare quotes)");
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test the shopping within a latency budget
+ */
+BOOST_AUTO_TEST_CASE (simcrs_latency_budget_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_latency_budget.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the SimCRS service, with the default sample BOM tree
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  simcrsService.buildSampleBom();
+
+  const bool isBuiltin = true;
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  const SIMCRS::ShoppingResultStruct lShoppingResult =
+    simcrsService.shop (lBookingRequest);
+  BOOST_CHECK (lShoppingResult.isTruncated() == false);
+
+  // A generous budget does not change anything
+  const stdair::Duration_T lGenerousBudget (boost::posix_time::hours (1));
+  const SIMCRS::ShoppingResultStruct lGenerousResult =
+    simcrsService.shop (lBookingRequest, lGenerousBudget);
+  BOOST_CHECK (lGenerousResult.isTruncated() == false);
+  BOOST_CHECK_EQUAL (lGenerousResult.display(), lShoppingResult.display());
+
+  // A budget spent (almost) at once truncates the result
+  const stdair::Duration_T lTinyBudget (boost::posix_time::microseconds (1));
+  const SIMCRS::ShoppingResultStruct lTruncatedResult =
+    simcrsService.shop (lBookingRequest, lTinyBudget);
+  BOOST_CHECK_EQUAL (lTruncatedResult.getNbOfSegmentPaths(),
+                     lShoppingResult.getNbOfSegmentPaths());
+  BOOST_CHECK (lTruncatedResult.getNbOfTravelSolutions()
+               <= lShoppingResult.getNbOfTravelSolutions());
+  if (lShoppingResult.getNbOfSegmentPaths() != 0) {
+    BOOST_CHECK (lTruncatedResult.isTruncated() == true);
+  }
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Fill a request trace while shopping and selling, and check that the
+ * timing breakdown and the counts match the result of the requests,
+ * including when the requests are served concurrently.
+ */
+BOOST_AUTO_TEST_CASE (simcrs_request_trace_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_request_trace.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the SimCRS service, with the default sample BOM tree
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  simcrsService.buildSampleBom();
+
+  // Shop, filling the request trace
+  const bool isBuiltin = true;
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  SIMCRS::RequestTraceStruct lShoppingTrace;
+  const SIMCRS::ShoppingResultStruct lShoppingResult =
+    simcrsService.shop (lBookingRequest, &lShoppingTrace);
+  STDAIR_LOG_DEBUG (lShoppingTrace.describe());
+
+  BOOST_CHECK (lShoppingTrace._requestID != 0);
+  BOOST_CHECK (lShoppingTrace._isCoalesced == false);
+  BOOST_CHECK_EQUAL (lShoppingTrace._nbOfSegmentPaths,
+                     lShoppingResult.getNbOfSegmentPaths());
+  BOOST_CHECK_EQUAL (lShoppingTrace._nbOfQuotedTravelSolutions
+                     + lShoppingResult.getNbOfPrunedTravelSolutions(),
+                     lShoppingResult.getNbOfSegmentPaths());
+  BOOST_CHECK (lShoppingTrace._nbOfFareOptions
+               >= lShoppingResult.getNbOfFareOptions());
+
+  // The stages are part of the whole request
+  const SIMCRS::RequestTraceStruct::Nanoseconds_T& lTotalTime =
+    lShoppingTrace.getStageTime (SIMCRS::RequestTraceStruct::TOTAL);
+  BOOST_CHECK (lTotalTime > 0);
+  BOOST_CHECK (lShoppingTrace.getStageTime (SIMCRS::RequestTraceStruct::
+                                            SEGMENT_PATH)
+               + lShoppingTrace.getStageTime (SIMCRS::RequestTraceStruct::
+                                              FARE_QUOTE)
+               + lShoppingTrace.getStageTime (SIMCRS::RequestTraceStruct::
+                                              AVAILABILITY)
+               <= lTotalTime);
+  BOOST_CHECK_EQUAL (lShoppingTrace.getStageTime (SIMCRS::RequestTraceStruct::
+                                                  SELL), 0);
+
+  // Sell on the first travel solution, filling another request trace
+  BOOST_REQUIRE (lShoppingResult.empty() == false);
+  const SIMCRS::SegmentDateID_T& lSegmentDateID =
+    lShoppingResult.getSegmentDateID (lShoppingResult.getTravelSolution (0),
+                                      0);
+  const SIMCRS::ClassCodeID_T lClassCodeID =
+    simcrsService.getClassCodeID ("M");
+  SIMCRS::RequestTraceStruct lSellTrace;
+  simcrsService.sell (lSegmentDateID, lClassCodeID, 1, &lSellTrace);
+  STDAIR_LOG_DEBUG (lSellTrace.describe());
+
+  BOOST_CHECK_EQUAL (lSellTrace._requestID, lShoppingTrace._requestID + 1);
+  BOOST_CHECK (lSellTrace.getStageTime (SIMCRS::RequestTraceStruct::SELL)
+               <= lSellTrace.getStageTime (SIMCRS::RequestTraceStruct::TOTAL));
+  BOOST_CHECK_EQUAL (lSellTrace._nbOfSegmentPaths, 0);
+
+  // Without any request trace, nothing changes
+  const SIMCRS::ShoppingResultStruct lUntracedResult =
+    simcrsService.shop (lBookingRequest);
+  BOOST_CHECK_EQUAL (lUntracedResult.getNbOfSegmentPaths(),
+                     lShoppingResult.getNbOfSegmentPaths());
+
+  // Concurrent (coalesced) requests fill their own request trace only
+  simcrsService.setRequestCoalescing (true);
+  const unsigned int lNbOfWorkers = 4;
+  std::vector<SIMCRS::RequestTraceStruct> lWorkerTraceList (lNbOfWorkers);
+  std::vector<SIMCRS::NbOfTravelSolutions_T>
+    lNbOfSegmentPathList (lNbOfWorkers, 0);
+  std::vector<std::thread> lWorkerList;
+  for (unsigned int idx = 0; idx != lNbOfWorkers; ++idx) {
+    SIMCRS::RequestTraceStruct& lWorkerTrace = lWorkerTraceList[idx];
+    SIMCRS::NbOfTravelSolutions_T& lNbOfSegmentPaths =
+      lNbOfSegmentPathList[idx];
+    lWorkerList.push_back (std::thread ([&simcrsService, &lBookingRequest,
+                                         &lWorkerTrace, &lNbOfSegmentPaths]
+                                        () {
+      const stdair::TravelSolutionList_T lWorkerTSList =
+        simcrsService.calculateSegmentPathList (lBookingRequest,
+                                                &lWorkerTrace);
+      lNbOfSegmentPaths = lWorkerTSList.size();
+    }));
+  }
+  for (std::vector<std::thread>::iterator itWorker = lWorkerList.begin();
+       itWorker != lWorkerList.end(); ++itWorker) {
+    itWorker->join();
+  }
+
+  std::vector<unsigned long> lRequestIDList;
+  for (unsigned int idx = 0; idx != lNbOfWorkers; ++idx) {
+    const SIMCRS::RequestTraceStruct& lWorkerTrace = lWorkerTraceList[idx];
+    lRequestIDList.push_back (lWorkerTrace._requestID);
+    // A coalesced request has not built any segment path by itself
+    const SIMCRS::NbOfTravelSolutions_T lNbOfBuiltSegmentPaths =
+      (lWorkerTrace._isCoalesced == true) ? 0 : lNbOfSegmentPathList[idx];
+    BOOST_CHECK_EQUAL (lWorkerTrace._nbOfSegmentPaths,
+                       lNbOfBuiltSegmentPaths);
+  }
+  std::sort (lRequestIDList.begin(), lRequestIDList.end());
+  BOOST_CHECK (std::adjacent_find (lRequestIDList.begin(),
+                                   lRequestIDList.end())
+               == lRequestIDList.end());
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Record the trace events of a few requests, and dump them in the
+ * Chrome trace event format.
+ */
+BOOST_AUTO_TEST_CASE (simcrs_trace_event_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_trace_event.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the SimCRS service, with the default sample BOM tree
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  simcrsService.buildSampleBom();
+
+  // Nothing is recorded by default
+  const bool isBuiltin = true;
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  simcrsService.shop (lBookingRequest);
+  BOOST_CHECK_EQUAL (simcrsService.getNbOfTraceEvents(), 0);
+
+  // Record the events of a shopping and of a sell request
+  simcrsService.setTraceEventRecording (true);
+  const SIMCRS::ShoppingResultStruct lShoppingResult =
+    simcrsService.shop (lBookingRequest);
+  simcrsService.sell (getFirstSegmentDateKey (simcrsService, lShoppingResult),
+                      "M", 1);
+  simcrsService.setTraceEventRecording (false);
+
+  // Every stage has a begin and an end event
+  const std::size_t lNbOfEvents = simcrsService.getNbOfTraceEvents();
+  BOOST_CHECK (lNbOfEvents >= 4);
+  BOOST_CHECK_EQUAL (lNbOfEvents % 2, 0);
+
+  std::ostringstream oStr;
+  simcrsService.dumpTraceEvents (oStr);
+  const std::string lTraceEvents = oStr.str();
+  STDAIR_LOG_DEBUG ("Trace events: " << lTraceEvents);
+  BOOST_CHECK (lTraceEvents.find ("\"traceEvents\"") != std::string::npos);
+  BOOST_CHECK (lTraceEvents.find ("\"name\":\"shop\"") != std::string::npos);
+  BOOST_CHECK (lTraceEvents.find ("\"cat\":\"airtsp\"") != std::string::npos);
+  BOOST_CHECK (lTraceEvents.find ("\"name\":\"sell\"") != std::string::npos);
+
+  // Nothing more is recorded once the recording is stopped
+  simcrsService.shop (lBookingRequest);
+  BOOST_CHECK_EQUAL (simcrsService.getNbOfTraceEvents(), lNbOfEvents);
+
+  simcrsService.clearTraceEvents();
+  BOOST_CHECK_EQUAL (simcrsService.getNbOfTraceEvents(), 0);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Count the heap allocations of the shopping and sell operations (when
+ * the allocation hook has been compiled in), so that the allocation
+ * regressions show up in the test logs.
+ */
+BOOST_AUTO_TEST_CASE (simcrs_allocation_count_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_allocation_count.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the SimCRS service, with the default sample BOM tree
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  simcrsService.buildSampleBom();
+
+  // Nothing is counted by default
+  const bool isBuiltin = true;
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  simcrsService.shop (lBookingRequest);
+  BOOST_CHECK (simcrsService.getAllocationStats().empty() == true);
+
+  // Count the allocations of two shopping requests and of a sell
+  simcrsService.setAllocationCounting (true);
+  simcrsService.shop (lBookingRequest);
+  const SIMCRS::ShoppingResultStruct lShoppingResult =
+    simcrsService.shop (lBookingRequest);
+  simcrsService.sell (getFirstSegmentDateKey (simcrsService, lShoppingResult),
+                      "M", 1);
+  simcrsService.setAllocationCounting (false);
+
+  const SIMCRS::AllocationStatsList_T lAllocationStatsList =
+    simcrsService.getAllocationStats();
+  for (SIMCRS::AllocationStatsList_T::const_iterator itStats =
+         lAllocationStatsList.begin();
+       itStats != lAllocationStatsList.end(); ++itStats) {
+    const SIMCRS::AllocationStatsStruct& lStats = itStats->second;
+    STDAIR_LOG_DEBUG ("Heap allocations of '" << itStats->first << "': "
+                      << lStats._nbOfAllocations << " allocations ("
+                      << lStats._allocatedBytes << " bytes) for "
+                      << lStats._nbOfOperations << " operations, i.e., "
+                      << lStats.getAverageNbOfAllocations()
+                      << " allocations per operation");
+  }
+
+  SIMCRS::AllocationStatsList_T::const_iterator itShopStats =
+    lAllocationStatsList.find ("shop");
+  BOOST_REQUIRE (itShopStats != lAllocationStatsList.end());
+  BOOST_CHECK_EQUAL (itShopStats->second._nbOfOperations, 2);
+  SIMCRS::AllocationStatsList_T::const_iterator itSellStats =
+    lAllocationStatsList.find ("sell");
+  BOOST_REQUIRE (itSellStats != lAllocationStatsList.end());
+  BOOST_CHECK_EQUAL (itSellStats->second._nbOfOperations, 1);
+
+  if (simcrsService.isAllocationCountingSupported() == true) {
+    BOOST_CHECK (itShopStats->second._nbOfAllocations > 0);
+  } else {
+    BOOST_CHECK_EQUAL (itShopStats->second._nbOfAllocations, 0);
+  }
+
+  simcrsService.clearAllocationStats();
+  BOOST_CHECK (simcrsService.getAllocationStats().empty() == true);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test the request arena: the short-lived objects of the shopping
+ * requests are drawn from it, and its memory blocks are re-used from one
+ * request to the next
+ */
+BOOST_AUTO_TEST_CASE (simcrs_request_arena_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_request_arena.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the SimCRS service, with the default sample BOM tree
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  simcrsService.buildSampleBom();
+
+  // Stream the travel solutions a few times, counting the heap
+  // allocations (those not served by the arena)
+  const bool isBuiltin = true;
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  const unsigned int lNbOfRequests = 5;
+  SIMCRS::ArenaStatsStruct lFirstArenaStats;
+  SIMCRS::ArenaStatsStruct lArenaStats;
+  simcrsService.setAllocationCounting (true);
+  for (unsigned int idx = 0; idx != lNbOfRequests; ++idx) {
+    std::ostringstream oStreamedStr;
+    unsigned int lNbOfVisits = 0;
+    TravelSolutionCounter lVisitor (oStreamedStr, lNbOfVisits, 1000);
+    const SIMCRS::NbOfTravelSolutions_T lNbOfStreamed =
+      simcrsService.streamTravelSolutions (lBookingRequest, lVisitor);
+    BOOST_REQUIRE (lNbOfStreamed > 0);
+
+    lArenaStats = simcrsService.getLastRequestArenaStats();
+    if (idx == 0) {
+      lFirstArenaStats = lArenaStats;
+    }
+  }
+  simcrsService.setAllocationCounting (false);
+
+  // The temporaries of the requests are served by the arena, and given
+  // back at the end of the request
+  BOOST_CHECK (lArenaStats._nbOfAllocations > 0);
+  BOOST_CHECK (lArenaStats._peakBytes > 0);
+  BOOST_CHECK (lArenaStats._peakBytes >= lArenaStats._allocatedBytes);
+  BOOST_CHECK (lArenaStats._peakBytes <= lArenaStats._reservedBytes);
+
+  // Once warmed up, the arena no longer reserves any memory
+  BOOST_CHECK_EQUAL (lArenaStats._reservedBytes,
+                     lFirstArenaStats._reservedBytes);
+  BOOST_CHECK_EQUAL (lArenaStats._nbOfBlocks, lFirstArenaStats._nbOfBlocks);
+
+  const SIMCRS::AllocationStatsList_T lAllocationStatsList =
+    simcrsService.getAllocationStats();
+  SIMCRS::AllocationStatsList_T::const_iterator itStreamStats =
+    lAllocationStatsList.find ("streamTravelSolutions");
+  BOOST_REQUIRE (itStreamStats != lAllocationStatsList.end());
+  BOOST_CHECK_EQUAL (itStreamStats->second._nbOfOperations, lNbOfRequests);
+  STDAIR_LOG_DEBUG ("Per request: "
+                    << itStreamStats->second.getAverageNbOfAllocations()
+                    << " heap allocations, and "
+                    << lArenaStats._nbOfAllocations
+                    << " allocations served by the arena ("
+                    << lArenaStats._peakBytes << " bytes at peak, within "
+                    << lArenaStats._reservedBytes << " reserved bytes)");
+
+  // Every thread has its own arena
+  SIMCRS::ArenaStatsStruct lOtherThreadArenaStats;
+  std::thread lOtherThread ([&simcrsService, &lOtherThreadArenaStats]() {
+      lOtherThreadArenaStats = simcrsService.getLastRequestArenaStats();
+    });
+  lOtherThread.join();
+  BOOST_CHECK_EQUAL (lOtherThreadArenaStats._nbOfAllocations, 0);
+  BOOST_CHECK_EQUAL (lOtherThreadArenaStats._reservedBytes, 0);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test the memory footprint report, and how it scales with the size of
+ * the network (sample BOM tree versus RDS01 schedule and fares)
+ */
+BOOST_AUTO_TEST_CASE (simcrs_memory_report_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_memory_report.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Small network: the default sample BOM tree
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service lSmallSimcrsService (lLogParams, "1P");
+  lSmallSimcrsService.buildSampleBom();
+  const SIMCRS::MemoryReportStruct lSmallReport =
+    lSmallSimcrsService.memoryReport();
+  STDAIR_LOG_DEBUG ("Sample BOM tree: " << lSmallReport.display());
+
+  // Larger network: the RDS01 schedule, O&D, yields and fares
+  SIMCRS::SIMCRS_Service lLargeSimcrsService (lLogParams, "1P");
+  const stdair::ScheduleFilePath lScheduleFilePath (STDAIR_SAMPLE_DIR
+                                                    "/rds01/schedule.csv");
+  const stdair::ODFilePath lODFilePath (STDAIR_SAMPLE_DIR "/ond01.csv");
+  const stdair::FRAT5FilePath lFRAT5FilePath (STDAIR_SAMPLE_DIR "/frat5.csv");
+  const stdair::FFDisutilityFilePath
+    lFFDisutilityFilePath (STDAIR_SAMPLE_DIR "/ffDisutility.csv");
+  const AIRRAC::YieldFilePath lYieldFilePath (STDAIR_SAMPLE_DIR
+                                              "/rds01/yield.csv");
+  const SIMFQT::FareFilePath lFareFilePath (STDAIR_SAMPLE_DIR
+                                            "/rds01/fare.csv");
+  lLargeSimcrsService.parseAndLoad (lScheduleFilePath, lODFilePath,
+                                    lFRAT5FilePath, lFFDisutilityFilePath,
+                                    lYieldFilePath, lFareFilePath);
+  const SIMCRS::MemoryReportStruct lLargeReport =
+    lLargeSimcrsService.memoryReport();
+  STDAIR_LOG_DEBUG ("RDS01 BOM tree: " << lLargeReport.display());
+
+  // Track the footprint against the size of the network
+  const std::size_t lSmallNbOfFlightDates =
+    lSmallReport.getNbOfObjects ("persistent", "FlightDate");
+  const std::size_t lLargeNbOfFlightDates =
+    lLargeReport.getNbOfObjects ("persistent", "FlightDate");
+  STDAIR_LOG_DEBUG ("Flight-dates: " << lSmallNbOfFlightDates << " -> "
+                    << lLargeNbOfFlightDates << "; bytes: "
+                    << lSmallReport.getNbOfBytes() << " -> "
+                    << lLargeReport.getNbOfBytes() << "; AirInv bytes: "
+                    << lSmallReport.getComponentNbOfBytes ("airinv") << " -> "
+                    << lLargeReport.getComponentNbOfBytes ("airinv"));
+  BOOST_CHECK (lSmallNbOfFlightDates > 0);
+  BOOST_CHECK (lLargeNbOfFlightDates > lSmallNbOfFlightDates);
+  BOOST_CHECK (lLargeReport.getNbOfObjects ("persistent", "BookingClass")
+               > lSmallReport.getNbOfObjects ("persistent", "BookingClass"));
+  BOOST_CHECK (lLargeReport.getComponentNbOfBytes ("airinv")
+               > lSmallReport.getComponentNbOfBytes ("airinv"));
+  BOOST_CHECK (lLargeReport.getNbOfBytes() > lSmallReport.getNbOfBytes());
+
+  // The same report is available through the JSON handler
+  const stdair::JSONString lJSONCommand ("{\"memory_report\":{}}");
+  const std::string lJSONReport =
+    lLargeSimcrsService.jsonHandler (lJSONCommand);
+  STDAIR_LOG_DEBUG ("JSON memory report: " << lJSONReport);
+  BOOST_CHECK (lJSONReport.find ("\"memory_report\"") != std::string::npos);
+  BOOST_CHECK (lJSONReport.find ("\"FlightDate\"") != std::string::npos);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Chunk sink appending the chunks it receives to a string.
+ */
+struct ChunkCollector {
+  std::string& _dump;
+  unsigned int& _nbOfChunks;
+  ChunkCollector (std::string& ioDump, unsigned int& ioNbOfChunks)
+    : _dump (ioDump), _nbOfChunks (ioNbOfChunks) {
+  }
+  void operator() (const std::string& iChunk) {
+    _dump += iChunk;
+    ++_nbOfChunks;
+  }
+};
+
+/**
+ * Test the streaming (and filtered) displays of the BOM tree
+ */
+BOOST_AUTO_TEST_CASE (simcrs_streaming_display_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_streaming_display.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the SimCRS service, with the default sample BOM tree
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  simcrsService.buildSampleBom();
+
+  // Stream the whole BOM tree, into a stream and by chunks
+  std::ostringstream lCSVStream;
+  simcrsService.csvDisplay (lCSVStream);
+  std::string lChunkDump;
+  unsigned int lNbOfChunks = 0;
+  simcrsService.csvDisplay (ChunkCollector (lChunkDump, lNbOfChunks));
+  BOOST_CHECK (lCSVStream.str().empty() == false);
+  BOOST_CHECK_EQUAL (lChunkDump, lCSVStream.str());
+
+  // One chunk per flight-date
+  std::ostringstream lListStream;
+  simcrsService.list (lListStream);
+  STDAIR_LOG_DEBUG ("Flight-dates:" << std::endl << lListStream.str());
+  std::istringstream lListLines (lListStream.str());
+  unsigned int lNbOfFlightDates = 0;
+  std::string lListLine;
+  while (std::getline (lListLines, lListLine)) {
+    if (lListLine.compare (0, 2, "  ") == 0) {
+      ++lNbOfFlightDates;
+    }
+  }
+  BOOST_CHECK (lNbOfFlightDates > 0);
+  BOOST_CHECK_EQUAL (lNbOfChunks, lNbOfFlightDates);
+
+  // Filter by airline
+  const SIMCRS::DisplayFilterStruct lSQFilter ("SQ");
+  std::ostringstream lSQStream;
+  simcrsService.csvDisplay (lSQStream, lSQFilter);
+  STDAIR_LOG_DEBUG ("SQ flight-dates:" << std::endl << lSQStream.str());
+  BOOST_CHECK (lSQStream.str().empty() == false);
+  BOOST_CHECK (lSQStream.str().size() < lCSVStream.str().size());
+
+  // Filter by departure dates: nothing departs in 2030
+  const stdair::Date_T lStartDate (2030, boost::gregorian::Jan, 1);
+  const SIMCRS::DisplayFilterStruct lDateFilter ("all", 0, lStartDate);
+  std::ostringstream lDateStream;
+  simcrsService.list (lDateStream, lDateFilter);
+  BOOST_CHECK (lDateStream.str().empty() == true);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test the streamed (and paginated) JSON exports
+ */
+BOOST_AUTO_TEST_CASE (simcrs_streaming_json_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_streaming_json.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the SimCRS service, with the default sample BOM tree
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  simcrsService.buildSampleBom();
+
+  // Whole list of the flight-dates
+  std::ostringstream lListStream;
+  simcrsService.jsonHandler (stdair::JSONString ("{\"list\":{\"limit\":0}}"),
+                             lListStream);
+  STDAIR_LOG_DEBUG ("Flight-date list: " << lListStream.str());
+  boost::property_tree::ptree lListTree;
+  std::istringstream lListJSON (lListStream.str());
+  boost::property_tree::read_json (lListJSON, lListTree);
+  const unsigned int lNbOfFlightDates =
+    lListTree.get<unsigned int> ("nb_of_flight_dates");
+  BOOST_REQUIRE (lNbOfFlightDates > 0);
+  BOOST_CHECK_EQUAL (lListTree.get_child ("flight_list").size(),
+                     lNbOfFlightDates);
+  BOOST_CHECK_EQUAL (lListTree.get<bool> ("has_more"), false);
+
+  // Page by page, one flight-date at a time
+  unsigned int lNbOfPagedFlightDates = 0;
+  bool hasMore = true;
+  while (hasMore == true) {
+    std::ostringstream lPageCommand;
+    lPageCommand << "{\"list\":{\"offset\":" << lNbOfPagedFlightDates
+                 << ",\"limit\":1}}";
+    std::ostringstream lPageStream;
+    simcrsService.jsonHandler (stdair::JSONString (lPageCommand.str()),
+                               lPageStream);
+    boost::property_tree::ptree lPageTree;
+    std::istringstream lPageJSON (lPageStream.str());
+    boost::property_tree::read_json (lPageJSON, lPageTree);
+    BOOST_REQUIRE_EQUAL (lPageTree.get_child ("flight_list").size(), 1);
+    ++lNbOfPagedFlightDates;
+    hasMore = lPageTree.get<bool> ("has_more");
+    BOOST_REQUIRE (lNbOfPagedFlightDates <= lNbOfFlightDates);
+  }
+  BOOST_CHECK_EQUAL (lNbOfPagedFlightDates, lNbOfFlightDates);
+
+  // Objects of the SQ flight-dates
+  std::ostringstream lFlightDateStream;
+  simcrsService.jsonHandler (stdair::JSONString ("{\"flight_date\":"
+                                                 "{\"airline_code\":\"SQ\"}}"),
+                             lFlightDateStream);
+  STDAIR_LOG_DEBUG ("SQ flight-dates: " << lFlightDateStream.str());
+  boost::property_tree::ptree lFlightDateTree;
+  std::istringstream lFlightDateJSON (lFlightDateStream.str());
+  boost::property_tree::read_json (lFlightDateJSON, lFlightDateTree);
+  BOOST_CHECK (lFlightDateTree.get_child ("flight_date_list").empty()
+               == false);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test the incremental schedule and fare reloads (delta files)
+ */
+BOOST_AUTO_TEST_CASE (simcrs_delta_reload_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_delta_reload.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the SimCRS service, with the default sample BOM tree
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  simcrsService.buildSampleBom();
+
+  const bool isBuiltin = true;
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  const SIMCRS::ShoppingResultStruct lShoppingResult =
+    simcrsService.shop (lBookingRequest);
+
+  // Flight of the first travel solution (e.g., 'SQ;747,2010-Feb-08;...')
+  const std::string lSegmentDateKey =
+    getFirstSegmentDateKey (simcrsService, lShoppingResult);
+  const std::string::size_type lAirlineEnd = lSegmentDateKey.find (';');
+  const std::string::size_type lFlightEnd = lSegmentDateKey.find (',');
+  BOOST_REQUIRE (lAirlineEnd != std::string::npos
+                 && lFlightEnd != std::string::npos);
+  const std::string lFlight = lSegmentDateKey.substr (0, lFlightEnd + 1);
+  const std::string lAirlineCode = lSegmentDateKey.substr (0, lAirlineEnd);
+  const std::string lFlightNumber =
+    lSegmentDateKey.substr (lAirlineEnd + 1, lFlightEnd - lAirlineEnd - 1);
+
+  // Close the flight; a change on an unknown flight is rejected
+  const stdair::Filename_T lCloseFilename ("CRSTestSuite_delta_close.csv");
+  std::ofstream lCloseFile (lCloseFilename.c_str());
+  lCloseFile << "# Operation; airline; flight number; start date; end date"
+             << std::endl
+             << "-; " << lAirlineCode << "; " << lFlightNumber
+             << "; 2010-01-01; 2011-12-31" << std::endl
+             << "+; " << lAirlineCode << "; 9999; 2010-01-01; 2010-01-31"
+             << std::endl;
+  lCloseFile.close();
+  const SIMCRS::DeltaStatsStruct lCloseStats =
+    simcrsService.applyScheduleDelta (lCloseFilename);
+  BOOST_CHECK_EQUAL (lCloseStats._nbOfChanges, 2);
+  BOOST_CHECK_EQUAL (lCloseStats._nbOfAppliedChanges, 1);
+  BOOST_CHECK_EQUAL (lCloseStats._nbOfRejectedChanges, 1);
+  BOOST_CHECK (lCloseStats._nbOfUpdatedFlightDates > 0);
+
+  // The closed flight is neither shopped nor sold
+  const SIMCRS::ShoppingResultStruct lClosedResult =
+    simcrsService.shop (lBookingRequest);
+  for (SIMCRS::NbOfTravelSolutions_T idxTS = 0;
+       idxTS != lClosedResult.getNbOfTravelSolutions(); ++idxTS) {
+    const SIMCRS::ShoppingSolutionStruct& lSolution =
+      lClosedResult.getTravelSolution (idxTS);
+    for (unsigned short idxSegment = 0;
+         idxSegment != lSolution._nbOfSegments; ++idxSegment) {
+      const std::string& lKey = simcrsService.
+        getSegmentDateKey (lClosedResult.getSegmentDateID (lSolution,
+                                                           idxSegment));
+      BOOST_CHECK (lKey.compare (0, lFlight.size(), lFlight) != 0);
+    }
+  }
+  BOOST_CHECK (simcrsService.sell (lSegmentDateKey, "M", 1) == false);
+
+  // Re-open the flight
+  const stdair::Filename_T lOpenFilename ("CRSTestSuite_delta_open.csv");
+  std::ofstream lOpenFile (lOpenFilename.c_str());
+  lOpenFile << "+; " << lAirlineCode << "; " << lFlightNumber
+            << "; 2010-01-01; 2011-12-31" << std::endl;
+  lOpenFile.close();
+  const SIMCRS::DeltaStatsStruct lOpenStats =
+    simcrsService.applyScheduleDelta (lOpenFilename);
+  BOOST_CHECK_EQUAL (lOpenStats._nbOfAppliedChanges, 1);
+  BOOST_CHECK_EQUAL (lOpenStats._nbOfUpdatedFlightDates,
+                     lCloseStats._nbOfUpdatedFlightDates);
+  const SIMCRS::ShoppingResultStruct lOpenResult =
+    simcrsService.shop (lBookingRequest);
+  BOOST_CHECK_EQUAL (lOpenResult.getNbOfTravelSolutions(),
+                     lShoppingResult.getNbOfTravelSolutions());
+
+  // Modify the flight period: the flight no longer operates (on any day
+  // of the date range), and then operates again every day
+  const stdair::Filename_T lModifyFilename ("CRSTestSuite_delta_modify.csv");
+  std::ofstream lModifyFile (lModifyFilename.c_str());
+  lModifyFile << "~; " << lAirlineCode << "; " << lFlightNumber
+              << "; 2010-01-01; 2011-12-31; 0000000" << std::endl;
+  lModifyFile.close();
+  const SIMCRS::DeltaStatsStruct lModifyStats =
+    simcrsService.applyScheduleDelta (lModifyFilename);
+  BOOST_CHECK_EQUAL (lModifyStats._nbOfUpdatedFlightDates,
+                     lCloseStats._nbOfUpdatedFlightDates);
+  BOOST_CHECK (simcrsService.sell (lSegmentDateKey, "M", 1) == false);
+
+  lModifyFile.open (lModifyFilename.c_str());
+  lModifyFile << "~; " << lAirlineCode << "; " << lFlightNumber
+              << "; 2010-01-01; 2011-12-31; 1111111" << std::endl;
+  lModifyFile.close();
+  const SIMCRS::DeltaStatsStruct lReopenStats =
+    simcrsService.applyScheduleDelta (lModifyFilename);
+  BOOST_CHECK_EQUAL (lReopenStats._nbOfUpdatedFlightDates,
+                     lCloseStats._nbOfUpdatedFlightDates);
+
+  // Re-price all the fare options of the O&D
+  const stdair::Filename_T lFareFilename ("CRSTestSuite_delta_fare.csv");
+  std::ofstream lFareFile (lFareFilename.c_str());
+  lFareFile << "~; SIN; BKK; 2010-01-01; 2011-12-31; *; *; *; *; 1234.5"
+            << std::endl;
+  lFareFile.close();
+  const SIMCRS::DeltaStatsStruct lFareStats =
+    simcrsService.applyFareDelta (lFareFilename);
+  BOOST_CHECK_EQUAL (lFareStats._nbOfAppliedChanges, 1);
+  const SIMCRS::ShoppingResultStruct lFareResult =
+    simcrsService.shop (lBookingRequest);
+  BOOST_REQUIRE (lFareResult.empty() == false);
+  for (SIMCRS::NbOfTravelSolutions_T idxTS = 0;
+       idxTS != lFareResult.getNbOfTravelSolutions(); ++idxTS) {
+    const SIMCRS::ShoppingSolutionStruct& lSolution =
+      lFareResult.getTravelSolution (idxTS);
+    for (unsigned short idxFO = 0; idxFO != lSolution._nbOfFareOptions;
+         ++idxFO) {
+      BOOST_CHECK_CLOSE (lFareResult.getFareOption (lSolution, idxFO)._fare,
+                         1234.5, 0.001);
+    }
+  }
+
+  // Re-price them again: the former change is superseded
+  lFareFile.open (lFareFilename.c_str());
+  lFareFile << "~; SIN; BKK; 2010-01-01; 2011-12-31; *; *; *; *; 987.5"
+            << std::endl;
+  lFareFile.close();
+  const SIMCRS::DeltaStatsStruct lRepriceStats =
+    simcrsService.applyFareDelta (lFareFilename);
+  BOOST_CHECK_EQUAL (lRepriceStats._nbOfAppliedChanges, 1);
+  const SIMCRS::ShoppingResultStruct lRepriceResult =
+    simcrsService.shop (lBookingRequest);
+  BOOST_REQUIRE_EQUAL (lRepriceResult.getNbOfTravelSolutions(),
+                       lFareResult.getNbOfTravelSolutions());
+  for (SIMCRS::NbOfTravelSolutions_T idxTS = 0;
+       idxTS != lRepriceResult.getNbOfTravelSolutions(); ++idxTS) {
+    const SIMCRS::ShoppingSolutionStruct& lSolution =
+      lRepriceResult.getTravelSolution (idxTS);
+    for (unsigned short idxFO = 0; idxFO != lSolution._nbOfFareOptions;
+         ++idxFO) {
+      BOOST_CHECK_CLOSE (lRepriceResult.getFareOption (lSolution,
+                                                       idxFO)._fare,
+                         987.5, 0.001);
+    }
+  }
+
+  // Malformed delta files are reported
+  const stdair::Filename_T lWrongFilename ("CRSTestSuite_delta_wrong.csv");
+  std::ofstream lWrongFile (lWrongFilename.c_str());
+  lWrongFile << "-; " << lAirlineCode << "; not a number" << std::endl;
+  lWrongFile.close();
+  BOOST_CHECK_THROW (simcrsService.applyScheduleDelta (lWrongFilename),
+                     stdair::ParserException);
+
+  // A new fare option needs a class list for every segment
+  const stdair::Filename_T
+    lWrongFareFilename ("CRSTestSuite_delta_wrong_fare.csv");
+  std::ofstream lWrongFareFile (lWrongFareFilename.c_str());
+  lWrongFareFile << "+; SIN; BKK; 2010-01-01; 2011-12-31; *; *; *; M//Y; 100"
+                 << std::endl;
+  lWrongFareFile.close();
+  BOOST_CHECK_THROW (simcrsService.applyFareDelta (lWrongFareFilename),
+                     stdair::ParserException);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test the publication of new fares while the SimCRS service is running:
+ * the fare quotes use the new fares as soon as they are published, and
+ * the fare options cached for the former ones are no longer served.
+ */
+BOOST_AUTO_TEST_CASE (simcrs_fare_publication_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_fare_publication.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the SimCRS service with the RDS01 files
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  const stdair::ScheduleFilePath lScheduleFilePath (STDAIR_SAMPLE_DIR
+                                                    "/rds01/schedule.csv");
+  const stdair::ODFilePath lODFilePath (STDAIR_SAMPLE_DIR "/ond01.csv");
+  const stdair::FRAT5FilePath lFRAT5FilePath (STDAIR_SAMPLE_DIR "/frat5.csv");
+  const stdair::FFDisutilityFilePath
+    lFFDisutilityFilePath (STDAIR_SAMPLE_DIR "/ffDisutility.csv");
+  const AIRRAC::YieldFilePath lYieldFilePath (STDAIR_SAMPLE_DIR
+                                              "/rds01/yield.csv");
+  const SIMFQT::FareFilePath lFareFilePath (STDAIR_SAMPLE_DIR
+                                            "/rds01/fare.csv");
+  simcrsService.parseAndLoad (lScheduleFilePath, lODFilePath,
+                              lFRAT5FilePath, lFFDisutilityFilePath,
+                              lYieldFilePath, lFareFilePath);
+  simcrsService.setFareQuoteCacheCapacity (100);
+  BOOST_CHECK_EQUAL (simcrsService.getFareVersion(), 0UL);
+
+  // Fare quote, twice, so that the second one is served by the cache
+  const bool isBuiltin = false;
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  std::string lExpectedDisplay;
+  for (unsigned short idx = 0; idx != 2; ++idx) {
+    stdair::TravelSolutionList_T lTravelSolutionList =
+      simcrsService.calculateSegmentPathList (lBookingRequest);
+    simcrsService.fareQuote (lBookingRequest, lTravelSolutionList);
+
+    std::ostringstream oStr;
+    for (stdair::TravelSolutionList_T::const_iterator itTS =
+           lTravelSolutionList.begin();
+         itTS != lTravelSolutionList.end(); ++itTS) {
+      oStr << itTS->display();
+    }
+    lExpectedDisplay = oStr.str();
+  }
+  const SIMCRS::FareQuoteCacheStatsStruct lCacheStats =
+    simcrsService.getFareQuoteCacheStats();
+
+  // Publish the (same) fares again
+  simcrsService.publishFares (lFareFilePath);
+  BOOST_CHECK_EQUAL (simcrsService.getFareVersion(), 1UL);
+
+  // The new fares are quoted by SimFQT, not served by the cache
+  stdair::TravelSolutionList_T lTravelSolutionList =
+    simcrsService.calculateSegmentPathList (lBookingRequest);
+  simcrsService.fareQuote (lBookingRequest, lTravelSolutionList);
+  std::ostringstream oStr;
+  for (stdair::TravelSolutionList_T::const_iterator itTS =
+         lTravelSolutionList.begin();
+       itTS != lTravelSolutionList.end(); ++itTS) {
+    oStr << itTS->display();
+  }
+  BOOST_CHECK_EQUAL (oStr.str(), lExpectedDisplay);
+  BOOST_CHECK_EQUAL (simcrsService.getFareQuoteCacheStats()._nbOfHits,
+                     lCacheStats._nbOfHits);
+
+  // Publish the fares twice more, while fare quotes are in progress: the
+  // readers always get the same fares, and the former fares are released
+  // without any harm to the BOM tree of the SimCRS service. The readers
+  // are concurrent, hence coalesced; each of them never sees the version
+  // of the fares going backwards
+  simcrsService.setRequestCoalescing (true);
+  const unsigned int lNbOfReaders = 4;
+  const unsigned int lNbOfRequestsPerReader = 20;
+  std::vector<unsigned int> lNbOfMismatchList (lNbOfReaders, 0);
+  std::vector<unsigned int> lNbOfRegressionList (lNbOfReaders, 0);
+  std::vector<std::thread> lReaderList;
+  for (unsigned int idx = 0; idx != lNbOfReaders; ++idx) {
+    unsigned int& lNbOfMismatches = lNbOfMismatchList[idx];
+    unsigned int& lNbOfRegressions = lNbOfRegressionList[idx];
+    lReaderList.push_back (std::thread ([&simcrsService, &lBookingRequest,
+                                         &lExpectedDisplay, &lNbOfMismatches,
+                                         &lNbOfRegressions,
+                                         lNbOfRequestsPerReader] () {
+      SIMCRS::FareVersion_T lLastFareVersion = 0;
+      for (unsigned int jdx = 0; jdx != lNbOfRequestsPerReader; ++jdx) {
+        stdair::TravelSolutionList_T lReaderTSList =
+          simcrsService.calculateSegmentPathList (lBookingRequest);
+        simcrsService.fareQuote (lBookingRequest, lReaderTSList);
+        const SIMCRS::FareVersion_T lFareVersion =
+          simcrsService.getFareVersion();
+        if (lFareVersion < lLastFareVersion) {
+          ++lNbOfRegressions;
+        }
+        lLastFareVersion = lFareVersion;
+        std::ostringstream oReaderStr;
+        for (stdair::TravelSolutionList_T::const_iterator itTS =
+               lReaderTSList.begin(); itTS != lReaderTSList.end(); ++itTS) {
+          oReaderStr << itTS->display();
+        }
+        if (oReaderStr.str() != lExpectedDisplay) {
+          ++lNbOfMismatches;
+        }
+      }
+    }));
+  }
+  simcrsService.publishFares (lFareFilePath);
+  simcrsService.publishFares (lFareFilePath);
+  for (std::vector<std::thread>::iterator itReader = lReaderList.begin();
+       itReader != lReaderList.end(); ++itReader) {
+    itReader->join();
+  }
+  BOOST_CHECK_EQUAL (simcrsService.getFareVersion(), 3UL);
+  for (unsigned int idx = 0; idx != lNbOfReaders; ++idx) {
+    BOOST_CHECK_EQUAL (lNbOfMismatchList[idx], 0);
+    BOOST_CHECK_EQUAL (lNbOfRegressionList[idx], 0);
+  }
+  simcrsService.setRequestCoalescing (false);
+
+  // The inventory (of the SimCRS BOM tree) is still there
+  const stdair::TravelSolutionList_T lAfterTSList =
+    simcrsService.calculateSegmentPathList (lBookingRequest);
+  BOOST_CHECK (lAfterTSList.empty() == false);
+
+  // A missing fare file is reported, and the current fares are kept
+  const SIMFQT::FareFilePath lMissingFilePath ("missing_fare_file.csv");
+  BOOST_CHECK_THROW (simcrsService.publishFares (lMissingFilePath),
+                     stdair::FileNotFoundException);
+  BOOST_CHECK_EQUAL (simcrsService.getFareVersion(), 3UL);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Benchmark the ingestion of the CSV input files: load throughput (in
+ * MB/s) of a fare delta file, read through memory-mapped, zero-copy
+ * records, compared with the one of a stream-based tokenisation into
+ * strings. The RDS01 input files, read through the same records, give
+ * the same records, hence BOM trees, as when read from the files.
+ */
+BOOST_AUTO_TEST_CASE (simcrs_ingestion_throughput_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_ingestion.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  simcrsService.buildSampleBom();
+
+  // Blank lines, comments, blanks around the fields and DOS line endings
+  const stdair::Filename_T lSmallFilename ("CRSTestSuite_ingestion.csv");
+  std::ofstream lSmallFile (lSmallFilename.c_str());
+  lSmallFile << "# Comment; not a record" << std::endl
+             << std::endl
+             << " ~ ; SIN; BKK; 2010-01-01; 2010-12-31; *; *; *; * ; 100 \r"
+             << std::endl
+             << "  \t" << std::endl
+             << "-;SIN;BKK;2011-01-01;2011-12-31;*;*;*;Y;0";
+  lSmallFile.close();
+  const SIMCRS::DeltaStatsStruct lSmallStats =
+    simcrsService.applyFareDelta (lSmallFilename);
+  BOOST_CHECK_EQUAL (lSmallStats._nbOfChanges, 2);
+  BOOST_CHECK_EQUAL (lSmallStats._nbOfAppliedChanges, 2);
+  BOOST_CHECK (lSmallStats._nbOfBytes > 0);
+  BOOST_CHECK_THROW (simcrsService.applyFareDelta ("missing_input_file.csv"),
+                     stdair::FileNotFoundException);
+
+  // Large fare delta file
+  const stdair::Filename_T lLargeFilename ("CRSTestSuite_ingestion_large.csv");
+  const unsigned long lNbOfRecords = 100000;
+  std::ofstream lLargeFile (lLargeFilename.c_str());
+  for (unsigned long idx = 0; idx != lNbOfRecords; ++idx) {
+    lLargeFile << "~; SIN; BKK; 2010-01-01; 2011-12-31; *; *; SQ; Y; "
+               << 100 + idx % 1000 << std::endl;
+  }
+  lLargeFile.close();
+
+  // Stream-based tokenisation, into strings
+  stdair::BasChronometer lStreamChronometer;
+  lStreamChronometer.start();
+  std::ifstream lInputStream (lLargeFilename.c_str());
+  std::string lLine;
+  std::vector<std::string> lFieldList;
+  unsigned long lNbOfStreamRecords = 0;
+  unsigned long lNbOfBytes = 0;
+  while (std::getline (lInputStream, lLine)) {
+    lNbOfBytes += lLine.size() + 1;
+    const std::string::size_type lFirstChar =
+      lLine.find_first_not_of (" \t\r");
+    if (lFirstChar == std::string::npos || lLine[lFirstChar] == '#') {
+      continue;
+    }
+    boost::algorithm::split (lFieldList, lLine,
+                             boost::algorithm::is_any_of (";"));
+    ++lNbOfStreamRecords;
+  }
+  const double lStreamTime = lStreamChronometer.elapsed();
+  BOOST_CHECK_EQUAL (lNbOfStreamRecords, lNbOfRecords);
+
+  // Memory-mapped, zero-copy records, fed to the fare delta loader
+  const SIMCRS::DeltaStatsStruct lLargeStats =
+    simcrsService.applyFareDelta (lLargeFilename);
+  BOOST_CHECK_EQUAL (lLargeStats._nbOfChanges, lNbOfRecords);
+  BOOST_CHECK_EQUAL (lLargeStats._nbOfBytes, lNbOfBytes);
+
+  const double lStreamThroughput =
+    (lStreamTime > 0.0 ? lNbOfBytes / 1e6 / lStreamTime : 0.0);
+  STDAIR_LOG_DEBUG ("Ingestion of " << lLargeFilename << ": "
+                    << lLargeStats._nbOfChanges << " records, "
+                    << lLargeStats.getThroughput()
+                    << " MB/s, changes applied (streams, tokenisation only: "
+                    << lStreamThroughput << " MB/s)");
+
+  // The RDS01 input files, read through the memory-mapped records (by the
+  // import into a network database): the records are the ones read line
+  // by line
+  const stdair::ScheduleFilePath lScheduleFilePath (STDAIR_SAMPLE_DIR
+                                                    "/rds01/schedule.csv");
+  const stdair::ODFilePath lODFilePath (STDAIR_SAMPLE_DIR "/ond01.csv");
+  const stdair::FRAT5FilePath lFRAT5FilePath (STDAIR_SAMPLE_DIR "/frat5.csv");
+  const stdair::FFDisutilityFilePath
+    lFFDisutilityFilePath (STDAIR_SAMPLE_DIR "/ffDisutility.csv");
+  const AIRRAC::YieldFilePath lYieldFilePath (STDAIR_SAMPLE_DIR
+                                              "/rds01/yield.csv");
+  const SIMFQT::FareFilePath lFareFilePath (STDAIR_SAMPLE_DIR
+                                            "/rds01/fare.csv");
+  unsigned long lNbOfInputBytes = 0;
+  const unsigned long lNbOfScheduleRecords =
+    countInputRecords (lScheduleFilePath.name(), lNbOfInputBytes);
+  const unsigned long lNbOfInputRecords = lNbOfScheduleRecords
+    + countInputRecords (lODFilePath.name(), lNbOfInputBytes)
+    + countInputRecords (lFRAT5FilePath.name(), lNbOfInputBytes)
+    + countInputRecords (lFFDisutilityFilePath.name(), lNbOfInputBytes)
+    + countInputRecords (lYieldFilePath.name(), lNbOfInputBytes)
+    + countInputRecords (lFareFilePath.name(), lNbOfInputBytes);
+  BOOST_CHECK (lNbOfScheduleRecords > 0);
+
+  const stdair::Filename_T lDBFilename ("CRSTestSuite_ingestion.sqlite");
+  SIMCRS::SIMCRS_Service lMappedSimcrsService (lLogParams, "1P");
+  const SIMCRS::NetworkDatabaseStatsStruct lImportStats =
+    lMappedSimcrsService.importNetworkDatabase (lDBFilename,
+                                                lScheduleFilePath,
+                                                lODFilePath, lFRAT5FilePath,
+                                                lFFDisutilityFilePath,
+                                                lYieldFilePath,
+                                                lFareFilePath);
+  BOOST_CHECK_EQUAL (lImportStats._nbOfScheduleRecords, lNbOfScheduleRecords);
+  BOOST_CHECK_EQUAL (lImportStats._nbOfRecords, lNbOfInputRecords);
+
+  // The contents of the records: the BOM trees, and the fare quotes, are
+  // the same as when the files are parsed by the components
+  const stdair::AirlineCodeList_T lAllAirlineCodeList;
+  const SIMCRS::NetworkDatabaseStatsStruct lLoadStats =
+    lMappedSimcrsService.loadFromNetworkDatabase (lDBFilename,
+                                                  lAllAirlineCodeList);
+  BOOST_CHECK_EQUAL (lLoadStats._nbOfRecords, lNbOfInputRecords);
+  SIMCRS::SIMCRS_Service lFileSimcrsService (lLogParams, "1P");
+  lFileSimcrsService.parseAndLoad (lScheduleFilePath, lODFilePath,
+                                   lFRAT5FilePath, lFFDisutilityFilePath,
+                                   lYieldFilePath, lFareFilePath);
+  BOOST_CHECK_EQUAL (lMappedSimcrsService.csvDisplay(),
+                     lFileSimcrsService.csvDisplay());
+
+  const bool isBuiltin = false;
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  stdair::TravelSolutionList_T lMappedTSList =
+    lMappedSimcrsService.calculateSegmentPathList (lBookingRequest);
+  lMappedSimcrsService.fareQuote (lBookingRequest, lMappedTSList);
+  stdair::TravelSolutionList_T lFileTSList =
+    lFileSimcrsService.calculateSegmentPathList (lBookingRequest);
+  lFileSimcrsService.fareQuote (lBookingRequest, lFileTSList);
+  BOOST_CHECK (lFileTSList.empty() == false);
+  BOOST_CHECK_EQUAL (lMappedSimcrsService.csvDisplay (lMappedTSList),
+                     lFileSimcrsService.csvDisplay (lFileTSList));
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test the SQLite network database: the BOM trees built from the
+ * database are the same as the ones built from the CSV files, and only
+ * the flights of the selected airlines are loaded.
+ */
+BOOST_AUTO_TEST_CASE (simcrs_network_database_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_network_database.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Import the RDS01 files into the database
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service lCSVSimcrsService (lLogParams, "1P");
+  const stdair::ScheduleFilePath lScheduleFilePath (STDAIR_SAMPLE_DIR
+                                                    "/rds01/schedule.csv");
+  const stdair::ODFilePath lODFilePath (STDAIR_SAMPLE_DIR "/ond01.csv");
+  const stdair::FRAT5FilePath lFRAT5FilePath (STDAIR_SAMPLE_DIR "/frat5.csv");
+  const stdair::FFDisutilityFilePath
+    lFFDisutilityFilePath (STDAIR_SAMPLE_DIR "/ffDisutility.csv");
+  const AIRRAC::YieldFilePath lYieldFilePath (STDAIR_SAMPLE_DIR
+                                              "/rds01/yield.csv");
+  const SIMFQT::FareFilePath lFareFilePath (STDAIR_SAMPLE_DIR
+                                            "/rds01/fare.csv");
+  const stdair::Filename_T lDBFilename ("CRSTestSuite_network.sqlite");
+  const SIMCRS::NetworkDatabaseStatsStruct lImportStats =
+    lCSVSimcrsService.importNetworkDatabase (lDBFilename, lScheduleFilePath,
+                                             lODFilePath, lFRAT5FilePath,
+                                             lFFDisutilityFilePath,
+                                             lYieldFilePath, lFareFilePath);
+  BOOST_CHECK (lImportStats._nbOfScheduleRecords > 0);
+  BOOST_CHECK (lImportStats._nbOfRecords > lImportStats._nbOfScheduleRecords);
+
+  // Reference: the BOM trees built from the CSV files
+  lCSVSimcrsService.parseAndLoad (lScheduleFilePath, lODFilePath,
+                                  lFRAT5FilePath, lFFDisutilityFilePath,
+                                  lYieldFilePath, lFareFilePath);
+  const bool isBuiltin = false;
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  const SIMCRS::ShoppingResultStruct lCSVResult =
+    lCSVSimcrsService.shop (lBookingRequest);
+
+  // The whole network, loaded from the database
+  SIMCRS::SIMCRS_Service lDBSimcrsService (lLogParams, "1P");
+  const stdair::AirlineCodeList_T lAllAirlineCodeList;
+  const SIMCRS::NetworkDatabaseStatsStruct lLoadStats =
+    lDBSimcrsService.loadFromNetworkDatabase (lDBFilename,
+                                              lAllAirlineCodeList);
+  BOOST_CHECK_EQUAL (lLoadStats._nbOfRecords, lImportStats._nbOfRecords);
+  const SIMCRS::ShoppingResultStruct lDBResult =
+    lDBSimcrsService.shop (lBookingRequest);
+  BOOST_CHECK_EQUAL (lDBResult.getNbOfTravelSolutions(),
+                     lCSVResult.getNbOfTravelSolutions());
+
+  // A single airline, loaded from the database
+  SIMCRS::SIMCRS_Service lSQSimcrsService (lLogParams, "1P");
+  stdair::AirlineCodeList_T lSQAirlineCodeList;
+  lSQAirlineCodeList.push_back ("SQ");
+  const SIMCRS::NetworkDatabaseStatsStruct lSQLoadStats =
+    lSQSimcrsService.loadFromNetworkDatabase (lDBFilename,
+                                              lSQAirlineCodeList);
+  BOOST_CHECK (lSQLoadStats._nbOfScheduleRecords > 0);
+  BOOST_CHECK (lSQLoadStats._nbOfScheduleRecords
+               <= lImportStats._nbOfScheduleRecords);
+  BOOST_CHECK (lSQLoadStats._nbOfRecords - lSQLoadStats._nbOfScheduleRecords
+               <= lImportStats._nbOfRecords
+               - lImportStats._nbOfScheduleRecords);
+  const SIMCRS::ShoppingResultStruct lSQResult =
+    lSQSimcrsService.shop (lBookingRequest);
+  for (SIMCRS::NbOfTravelSolutions_T idxTS = 0;
+       idxTS != lSQResult.getNbOfTravelSolutions(); ++idxTS) {
+    const SIMCRS::ShoppingSolutionStruct& lSolution =
+      lSQResult.getTravelSolution (idxTS);
+    for (unsigned short idxSegment = 0;
+         idxSegment != lSolution._nbOfSegments; ++idxSegment) {
+      const std::string& lKey = lSQSimcrsService.
+        getSegmentDateKey (lSQResult.getSegmentDateID (lSolution,
+                                                       idxSegment));
+      BOOST_CHECK (lKey.compare (0, 3, "SQ;") == 0);
+    }
+  }
+
+  // A database without network is reported
+  const stdair::Filename_T lEmptyDBFilename ("CRSTestSuite_empty.sqlite");
+  std::remove (lEmptyDBFilename.c_str());
+  SIMCRS::SIMCRS_Service lEmptySimcrsService (lLogParams, "1P");
+  BOOST_CHECK_THROW (lEmptySimcrsService.
+                     loadFromNetworkDatabase (lEmptyDBFilename,
+                                              lAllAirlineCodeList),
+                     stdair::SQLDatabaseException);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Journal the sells, with group commits, and rebuild the inventory state
+ * from the journal
+ */
+BOOST_AUTO_TEST_CASE (simcrs_booking_journal_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_booking_journal.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the SimCRS service, and open a brand new journal
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  simcrsService.buildSampleBom();
+  const stdair::Filename_T lJournalFilename ("CRSTestSuite_booking.journal");
+  std::remove (lJournalFilename.c_str());
+
+  // Retrieve a segment-date to be sold
+  const bool isBuiltin = true;
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  const SIMCRS::ShoppingResultStruct lShoppingResult =
+    simcrsService.shop (lBookingRequest);
+  const std::string lSegmentDateKey =
+    getFirstSegmentDateKey (simcrsService, lShoppingResult);
+
+  // Sells without journal, as a reference for the overhead
+  const unsigned int lNbOfSells = 20;
+  stdair::BasChronometer lReferenceChronometer;
+  lReferenceChronometer.start();
+  for (unsigned int i = 0; i != lNbOfSells; ++i) {
+    simcrsService.sell (lSegmentDateKey, "M", 1);
+  }
+  const double lReferenceTime = lReferenceChronometer.elapsed();
+
+  // Sells recorded into the journal
+  simcrsService.openBookingJournal (lJournalFilename);
+  unsigned int lNbOfSuccessfulSells = 0;
+  stdair::BasChronometer lJournalChronometer;
+  lJournalChronometer.start();
+  for (unsigned int i = 0; i != lNbOfSells; ++i) {
+    if (simcrsService.sell (lSegmentDateKey, "M", 1) == true) {
+      ++lNbOfSuccessfulSells;
+    }
+  }
+  const double lJournalTime = lJournalChronometer.elapsed();
+  simcrsService.flushBookingJournal();
+
+  // Only the successful sells are recorded, grouped into few commits
+  const SIMCRS::JournalStatsStruct lJournalStats =
+    simcrsService.getBookingJournalStats();
+  BOOST_CHECK_EQUAL (lJournalStats._nbOfRecords, lNbOfSuccessfulSells);
+  BOOST_CHECK_EQUAL (lJournalStats._nbOfCommittedRecords,
+                     lNbOfSuccessfulSells);
+  BOOST_CHECK_EQUAL (lJournalStats._nbOfFailedCommits, 0);
+  if (lNbOfSuccessfulSells != 0) {
+    BOOST_CHECK (lJournalStats._nbOfCommits >= 1);
+    BOOST_CHECK (lJournalStats._nbOfCommits <= lNbOfSuccessfulSells);
+  }
+  STDAIR_LOG_DEBUG ("Sells without journal: " << lReferenceTime
+                    << " s, with journal: " << lJournalTime
+                    << " s; average group size: "
+                    << lJournalStats.getAverageGroupSize()
+                    << ", average append time: "
+                    << lJournalStats.getAverageAppendTime() << " s");
+
+  // Availability after the sells
+  const SIMCRS::SegmentDateID_T lSegmentDateID =
+    simcrsService.getSegmentDateID (lSegmentDateKey);
+  const SIMCRS::ClassCodeID_T lClassCodeID =
+    simcrsService.getClassCodeID ("M");
+  const stdair::Availability_T lAvailability =
+    simcrsService.getAvailability (lSegmentDateID, lClassCodeID);
+  simcrsService.closeBookingJournal();
+
+  // Rebuild the inventory state, on a fresh service, from the journal.
+  // The reference sells, not recorded, are sold again first.
+  SIMCRS::SIMCRS_Service lReplaySimcrsService (lLogParams, "1P");
+  lReplaySimcrsService.buildSampleBom();
+  for (unsigned int i = 0; i != lNbOfSells; ++i) {
+    lReplaySimcrsService.sell (lSegmentDateKey, "M", 1);
+  }
+  const SIMCRS::JournalReplayStatsStruct lReplayStats =
+    lReplaySimcrsService.replayBookingJournal (lJournalFilename);
+  BOOST_CHECK_EQUAL (lReplayStats._nbOfRecords, lNbOfSuccessfulSells);
+  BOOST_CHECK_EQUAL (lReplayStats._nbOfAppliedRecords, lNbOfSuccessfulSells);
+  BOOST_CHECK (lReplayStats._isTruncated == false);
+  const SIMCRS::SegmentDateID_T lReplaySegmentDateID =
+    lReplaySimcrsService.getSegmentDateID (lSegmentDateKey);
+  const SIMCRS::ClassCodeID_T lReplayClassCodeID =
+    lReplaySimcrsService.getClassCodeID ("M");
+  BOOST_CHECK_EQUAL (lReplaySimcrsService.
+                     getAvailability (lReplaySegmentDateID,
+                                      lReplayClassCodeID),
+                     lAvailability);
+
+  // A torn record, at the end of the journal, is detected and ignored
+  std::ofstream lJournalFile (lJournalFilename.c_str(),
+                              std::ios::binary | std::ios::app);
+  lJournalFile << "torn";
+  lJournalFile.close();
+  SIMCRS::SIMCRS_Service lTornSimcrsService (lLogParams, "1P");
+  lTornSimcrsService.buildSampleBom();
+  const SIMCRS::JournalReplayStatsStruct lTornReplayStats =
+    lTornSimcrsService.replayBookingJournal (lJournalFilename);
+  BOOST_CHECK (lTornReplayStats._isTruncated == true);
+  BOOST_CHECK_EQUAL (lTornReplayStats._nbOfAppliedRecords,
+                     lNbOfSuccessfulSells);
+
+  // A file which is not a journal is reported
+  BOOST_CHECK_THROW (lTornSimcrsService.replayBookingJournal (lLogFilename),
+                     stdair::ParserException);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Checkpoint the inventory state in the middle of a simulation, and
+ * restore it onto a freshly loaded network
+ */
+BOOST_AUTO_TEST_CASE (simcrs_checkpoint_restore_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_checkpoint.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the SimCRS service, and simulate a few sells
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  simcrsService.buildSampleBom();
+  const bool isBuiltin = true;
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  const SIMCRS::ShoppingResultStruct lShoppingResult =
+    simcrsService.shop (lBookingRequest);
+  const std::string lSegmentDateKey =
+    getFirstSegmentDateKey (simcrsService, lShoppingResult);
+  for (unsigned int i = 0; i != 5; ++i) {
+    simcrsService.sell (lSegmentDateKey, "M", 2);
+  }
+
+  // Sell the first fare option as well
+  const SIMCRS::ShoppingSolutionStruct& lSolution =
+    lShoppingResult.getTravelSolution (0);
+  const SIMCRS::ShoppingFareOptionStruct& lFareOption =
+    lShoppingResult.getFareOption (lSolution, 0);
+  simcrsService.sell (lShoppingResult.getSegmentDateID (lSolution, 0),
+                      lShoppingResult.getClassCodeID (lFareOption, 0), 1);
+
+  // Checkpoint the inventory state
+  const stdair::Filename_T lCheckpointFilename ("CRSTestSuite.checkpoint");
+  const SIMCRS::CheckpointStatsStruct lCheckpointStats =
+    simcrsService.checkpoint (lCheckpointFilename);
+  BOOST_CHECK (lCheckpointStats._nbOfSegmentDates > 0);
+  BOOST_CHECK (lCheckpointStats._nbOfBookingClasses
+               >= lCheckpointStats._nbOfSegmentDates);
+  BOOST_CHECK (lCheckpointStats._nbOfLegCabins > 0);
+  BOOST_CHECK (lCheckpointStats._nbOfBytes > 0);
+  const SIMCRS::SegmentDateID_T lSegmentDateID =
+    simcrsService.getSegmentDateID (lSegmentDateKey);
+  const SIMCRS::ClassCodeID_T lClassCodeID =
+    simcrsService.getClassCodeID ("M");
+  const stdair::Availability_T lAvailability =
+    simcrsService.getAvailability (lSegmentDateID, lClassCodeID);
+
+  // Restore it onto a freshly loaded network
+  SIMCRS::SIMCRS_Service lRestoredSimcrsService (lLogParams, "1P");
+  lRestoredSimcrsService.buildSampleBom();
+  const SIMCRS::CheckpointStatsStruct lRestoreStats =
+    lRestoredSimcrsService.restore (lCheckpointFilename);
+  BOOST_CHECK_EQUAL (lRestoreStats._nbOfSegmentDates,
+                     lCheckpointStats._nbOfSegmentDates);
+  BOOST_CHECK_EQUAL (lRestoreStats._nbOfBookingClasses,
+                     lCheckpointStats._nbOfBookingClasses);
+  BOOST_CHECK_EQUAL (lRestoreStats._nbOfLegCabins,
+                     lCheckpointStats._nbOfLegCabins);
+  BOOST_CHECK_EQUAL (lRestoreStats._nbOfUnmatchedSegmentDates, 0);
+  BOOST_CHECK_EQUAL (lRestoreStats._nbOfFailedBookingClasses, 0);
+  BOOST_CHECK_EQUAL (lRestoreStats._nbOfBytes, lCheckpointStats._nbOfBytes);
+  const SIMCRS::SegmentDateID_T lRestoredSegmentDateID =
+    lRestoredSimcrsService.getSegmentDateID (lSegmentDateKey);
+  const SIMCRS::ClassCodeID_T lRestoredClassCodeID =
+    lRestoredSimcrsService.getClassCodeID ("M");
+  BOOST_CHECK_EQUAL (lRestoredSimcrsService.
+                     getAvailability (lRestoredSegmentDateID,
+                                      lRestoredClassCodeID),
+                     lAvailability);
+  STDAIR_LOG_DEBUG ("Checkpoint: " << lCheckpointStats._elapsedTime
+                    << " s, restore: " << lRestoreStats._elapsedTime
+                    << " s, for " << lCheckpointStats._nbOfBytes
+                    << " bytes");
+
+  // Restoring the same checkpoint again, after more sells, sets the
+  // counters back as they were
+  for (unsigned int i = 0; i != 3; ++i) {
+    lRestoredSimcrsService.sell (lSegmentDateKey, "M", 2);
+  }
+  const SIMCRS::CheckpointStatsStruct lSecondRestoreStats =
+    lRestoredSimcrsService.restore (lCheckpointFilename);
+  BOOST_CHECK_EQUAL (lSecondRestoreStats._nbOfFailedBookingClasses, 0);
+  BOOST_CHECK_EQUAL (lRestoredSimcrsService.
+                     getAvailability (lRestoredSegmentDateID,
+                                      lRestoredClassCodeID),
+                     lAvailability);
+
+  // A file which is not a checkpoint is reported
+  BOOST_CHECK_THROW (lRestoredSimcrsService.restore (lLogFilename),
+                     stdair::ParserException);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Branch the simulation into what-if variants, run in child processes,
+ * leaving the state of the current process unchanged
+ */
+BOOST_AUTO_TEST_CASE (simcrs_whatif_branching_test) {
+
+  // Output log File
+  const stdair::Filename_T lLogFilename ("CRSTestSuite_whatif.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the SimCRS service, and simulate a few sells
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  SIMCRS::SIMCRS_Service simcrsService (lLogParams, "1P");
+  simcrsService.buildSampleBom();
+  const bool isBuiltin = true;
+  const stdair::BookingRequestStruct lBookingRequest =
+    buildBookingRequest (isBuiltin);
+  const SIMCRS::ShoppingResultStruct lShoppingResult =
+    simcrsService.shop (lBookingRequest);
+  const std::string lSegmentDateKey =
+    getFirstSegmentDateKey (simcrsService, lShoppingResult);
+  simcrsService.sell (lSegmentDateKey, "M", 2);
+  const SIMCRS::SegmentDateID_T lSegmentDateID =
+    simcrsService.getSegmentDateID (lSegmentDateKey);
+  const SIMCRS::ClassCodeID_T lClassCodeID =
+    simcrsService.getClassCodeID ("M");
+  const stdair::Availability_T lAvailability =
+    simcrsService.getAvailability (lSegmentDateID, lClassCodeID);
+
+  // Variants: selling a few more seats, selling nothing, and failing
+  SIMCRS::WhatIfVariantList_T lVariantList;
+  lVariantList.push_back ([&] (SIMCRS::SIMCRS_Service& ioSimcrsService,
+                               SIMCRS::WhatIfMetricList_T& ioMetricList) {
+      ioSimcrsService.sell (lSegmentDateKey, "M", 3);
+      ioMetricList.push_back (ioSimcrsService.
+                              getAvailability (lSegmentDateID,
+                                               lClassCodeID));
+    });
+  lVariantList.push_back ([&] (SIMCRS::SIMCRS_Service& ioSimcrsService,
+                               SIMCRS::WhatIfMetricList_T& ioMetricList) {
+      ioMetricList.push_back (ioSimcrsService.
+                              getAvailability (lSegmentDateID,
+                                               lClassCodeID));
+    });
+  lVariantList.push_back ([] (SIMCRS::SIMCRS_Service&,
+                              SIMCRS::WhatIfMetricList_T&) {
+      throw stdair::RootException ("Failing what-if variant");
+    });
+
+  // Branch with a booking journal open and the trace events recorded:
+  // the children must inherit neither their locks nor the journal
+  // writer, and must not log again what the parent has logged
+  const stdair::Filename_T lJournalFilename ("CRSTestSuite_whatif.journal");
+  std::remove (lJournalFilename.c_str());
+  simcrsService.openBookingJournal (lJournalFilename);
+  simcrsService.setTraceEventRecording (true);
+  STDAIR_LOG_DEBUG ("Branching the simulation");
+  const unsigned int lMaxNbOfConcurrentBranches = 2;
+  const SIMCRS::WhatIfResultList_T lResultList =
+    simcrsService.runWhatIfBranches (lVariantList,
+                                     lMaxNbOfConcurrentBranches);
+  BOOST_REQUIRE_EQUAL (lResultList.size(), lVariantList.size());
+
+  BOOST_CHECK (lResultList[0]._isSuccessful == true);
+  BOOST_REQUIRE_EQUAL (lResultList[0]._metricList.size(), 1);
+  BOOST_CHECK (lResultList[0]._metricList.front() <= lAvailability);
+  BOOST_CHECK (lResultList[1]._isSuccessful == true);
+  BOOST_REQUIRE_EQUAL (lResultList[1]._metricList.size(), 1);
+  BOOST_CHECK_EQUAL (lResultList[1]._metricList.front(), lAvailability);
+  BOOST_CHECK (lResultList[2]._isSuccessful == false);
+  BOOST_CHECK (lResultList[2]._metricList.empty() == true);
+  STDAIR_LOG_DEBUG ("Private memory of the what-if branches: "
+                    << lResultList[0]._privateMemorySize << ", "
+                    << lResultList[1]._privateMemorySize << " bytes");
+
+  // The state of the current process is left unchanged
+  BOOST_CHECK_EQUAL (simcrsService.getAvailability (lSegmentDateID,
+                                                    lClassCodeID),
+                     lAvailability);
+  BOOST_CHECK (simcrsService.getNbOfTraceEvents() > 0);
+
+  // The journal writer runs again, and the sells of the branches have
+  // not been recorded
+  const unsigned int lNbOfRecords =
+    (simcrsService.sell (lSegmentDateKey, "M", 1) == true) ? 1 : 0;
+  simcrsService.flushBookingJournal();
+  const SIMCRS::JournalStatsStruct lJournalStats =
+    simcrsService.getBookingJournalStats();
+  BOOST_CHECK_EQUAL (lJournalStats._nbOfRecords, lNbOfRecords);
+  BOOST_CHECK_EQUAL (lJournalStats._nbOfCommittedRecords, lNbOfRecords);
+  BOOST_CHECK_EQUAL (lJournalStats._nbOfFailedCommits, 0);
+  simcrsService.setTraceEventRecording (false);
+  simcrsService.closeBookingJournal();
+
+  // The parent log has been written only once
+  logOutputFile.flush();
+  std::ifstream lLogFile (lLogFilename.c_str());
+  std::string lLogLine;
+  unsigned int lNbOfBranchingLines = 0;
+  while (std::getline (lLogFile, lLogLine)) {
+    if (lLogLine.find ("Branching the simulation") != std::string::npos) {
+      ++lNbOfBranchingLines;
+    }
+  }
+  BOOST_CHECK_EQUAL (lNbOfBranchingLines, 1);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
 // End the test suite
 BOOST_AUTO_TEST_SUITE_END()
 